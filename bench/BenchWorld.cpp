@@ -0,0 +1,120 @@
+#include <BenchWorld.h>
+
+#include <filesystem>
+
+#include <content/Content.h>
+#include <engine/Engine.h>
+#include <lighting/Lighting.h>
+#include <lighting/Lightmap.h>
+#include <logic/EngineController.h>
+#include <voxels/Chunk.h>
+#include <voxels/Chunks.h>
+#include <voxels/GlobalChunks.h>
+#include <world/Level.h>
+#include <world/generator/WorldGenerator.h>
+
+namespace fs = std::filesystem;
+
+BenchWorld::BenchWorld() {
+    // Пользовательская папка пересоздаётся, чтобы мир не загружался
+    // из прошлого запуска
+    auto userFolder = fs::temp_directory_path() / "chromaforge_bench";
+    fs::remove_all(userFolder);
+    fs::create_directories(userFolder);
+
+    CoreParameters params;
+    params.headless = true;
+    params.resFolder = BENCH_RES_DIR;
+    params.userFolder = userFolder;
+
+    auto& engine = Engine::getInstance();
+    engine.initialize(std::move(params));
+    engine.setLevelConsumer([this](auto level, int64_t) {
+        this->level = std::move(level);
+    });
+    engine.getController()->createWorld("bench", SEED, GENERATOR);
+
+    const auto& indices = *level->content.getIndices();
+    chunks = std::make_unique<Chunks>(
+        3, 3, 0, 0, level->events.get(), indices
+    );
+    chunks->configure(0, 0, AREA_RADIUS + 1);
+    lighting = std::make_unique<Lighting>(indices, *chunks);
+
+    auto generator = createGenerator();
+    generator->update(0, 0, AREA_RADIUS + 1);
+    for (int z = -AREA_RADIUS; z <= AREA_RADIUS; ++z) {
+        for (int x = -AREA_RADIUS; x <= AREA_RADIUS; ++x) {
+            auto chunk = level->chunks->create(x, z, true);
+            generator->generate(chunk->voxels, x, z);
+            chunk->updateHeights();
+            chunk->flags.unsaved = true;
+            chunk->flags.loaded = true;
+            chunk->flags.ready = true;
+            chunks->putChunk(chunk);
+        }
+    }
+    rebuildLights();
+}
+
+BenchWorld::~BenchWorld() {
+    lighting.reset();
+    chunks.reset();
+    level.reset();
+    Engine::terminate();
+}
+
+BenchWorld& BenchWorld::get() {
+    static BenchWorld instance;
+    return instance;
+}
+
+const Content& BenchWorld::getContent() const {
+    return level->content;
+}
+
+const Generator& BenchWorld::getGeneratorDef() const {
+    return level->content.generators.require(level->environment.generator);
+}
+
+std::unique_ptr<WorldGenerator> BenchWorld::createGenerator(int workers) const {
+    return std::make_unique<WorldGenerator>(
+        getGeneratorDef(),
+        level->content,
+        std::stoull(SEED),
+        workers
+    );
+}
+
+std::vector<std::shared_ptr<Chunk>> BenchWorld::getInnerChunks() const {
+    std::vector<std::shared_ptr<Chunk>> inner;
+    for (int z = -AREA_RADIUS + 1; z < AREA_RADIUS; ++z) {
+        for (int x = -AREA_RADIUS + 1; x < AREA_RADIUS; ++x) {
+            inner.push_back(level->chunks->fetch(x, z));
+        }
+    }
+    return inner;
+}
+
+int BenchWorld::getSurfaceY(int x, int z) {
+    for (int y = CHUNK_HEIGHT - 1; y > 0; --y) {
+        if (chunks->isObstacleBlock(x, y - 1, z)) {
+            return y;
+        }
+    }
+    return 0;
+}
+
+void BenchWorld::rebuildLights() {
+    const auto& indices = *level->content.getIndices();
+    for (const auto& chunk : chunks->getChunks()) {
+        if (chunk == nullptr) continue;
+        chunk->lightmap->clear();
+        Lighting::preBuildSkyLight(*chunk, indices);
+    }
+    for (const auto& chunk : getInnerChunks()) {
+        lighting->buildSkyLight(chunk->chunk_x, chunk->chunk_z);
+        lighting->onChunkLoaded(chunk->chunk_x, chunk->chunk_z, true);
+        chunk->flags.lighted = true;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Chunk;
+class Chunks;
+class Content;
+class Level;
+class Lighting;
+class WorldGenerator;
+struct Generator;
+
+/// @brief Мир на встроенном контенте (res) с постоянным сидом, общий для
+/// всех бенчмарков. Движок запускается без окна при первом обращении,
+/// вокруг (0, 0) генерируется и освещается квадрат чанков, как это
+/// делает ChunksController
+class BenchWorld {
+    std::unique_ptr<Level> level;
+    std::unique_ptr<Chunks> chunks;
+    std::unique_ptr<Lighting> lighting;
+
+    BenchWorld();
+public:
+    static inline const std::string SEED = "1337";
+    static inline const std::string GENERATOR = "chromaforge:standart";
+    /// Чанки от -AREA_RADIUS до AREA_RADIUS по обеим осям
+    static constexpr int AREA_RADIUS = 3;
+
+    ~BenchWorld();
+
+    static BenchWorld& get();
+
+    Level& getLevel() {
+        return *level;
+    }
+
+    const Content& getContent() const;
+
+    const Generator& getGeneratorDef() const;
+
+    /// @brief Чанки квадрата в локальной матрице
+    Chunks& getChunks() {
+        return *chunks;
+    }
+
+    Lighting& getLighting() {
+        return *lighting;
+    }
+
+    /// @brief Новый генератор с сидом мира; прототипы не закэшированы
+    std::unique_ptr<WorldGenerator> createGenerator(int workers = 1) const;
+
+    /// @brief Чанки, у которых сгенерированы все соседи: только для них
+    /// строится освещение
+    std::vector<std::shared_ptr<Chunk>> getInnerChunks() const;
+
+    /// @return высота первого блока без препятствия над поверхностью
+    int getSurfaceY(int x, int z);
+
+    /// @brief Сбрасывает и строит заново освещение всего квадрата
+    void rebuildLights();
+};
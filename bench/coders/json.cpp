@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include <coders/json.h>
+#include <coders/json_structural.h>
+
+namespace fs = std::filesystem;
+
+/// Все JSON-файлы встроенного контента (res)
+static const std::vector<std::string>& res_documents() {
+    static std::vector<std::string> documents = []() {
+        std::vector<std::string> documents;
+        for (const auto& entry : fs::recursive_directory_iterator(BENCH_RES_DIR)) {
+            if (entry.path().extension() != ".json") continue;
+            std::ifstream file(entry.path(), std::ios::binary);
+            std::stringstream ss;
+            ss << file.rdbuf();
+            documents.push_back(ss.str());
+        }
+        return documents;
+    }();
+    return documents;
+}
+
+/// Пак с count определениями блоков
+static std::string make_defs(int count) {
+    std::mt19937 random(count);
+    std::stringstream ss;
+    ss << "{\n";
+    for (int i = 0; i < count; ++i) {
+        ss << "    \"block_" << i << "\": {\n"
+           << "        \"texture-faces\": [\"side\", \"side\", \"top_" << i
+           << "\", \"bottom\", \"side\", \"side\"],\n"
+           << "        \"material\": \"base:stone\",\n"
+           << "        \"hitboxes\": [[0.0, 0.0, 0.0, 1.0, 0.5, 1.0]],\n"
+           << "        \"draw-group\": " << random() % 8 << ",\n"
+           << "        \"light-passing\": " << (random() % 2 ? "true" : "false")
+           << ",\n"
+           << "        \"caption\": \"Block \\\"" << i << "\\\"\"\n"
+           << "    }" << (i + 1 < count ? "," : "") << "\n";
+    }
+    ss << "}\n";
+    return ss.str();
+}
+
+static void BM_JsonParseResContent(benchmark::State& state) {
+    const auto& documents = res_documents();
+    size_t bytes = 0;
+    for (const auto& document : documents) {
+        bytes += document.size();
+    }
+    for (auto _ : state) {
+        for (const auto& document : documents) {
+            benchmark::DoNotOptimize(json::parse(document));
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["files"] = documents.size();
+}
+BENCHMARK(BM_JsonParseResContent);
+
+static void BM_JsonParseDefs(benchmark::State& state) {
+    auto source = make_defs(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::parse(source));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_JsonParseDefs)->Arg(64)->Arg(4096);
+
+/// Тот же документ с комментарием: разбирается посимвольным парсером
+static void BM_JsonParseDefsFallback(benchmark::State& state) {
+    auto source = make_defs(state.range(0));
+    source.insert(1, "# generated\n");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::parse(source));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_JsonParseDefsFallback)->Arg(64)->Arg(4096);
+
+static void BM_JsonStructuralIndex(benchmark::State& state) {
+    auto source = make_defs(state.range(0));
+    json::StructuralIndex index;
+    for (auto _ : state) {
+        json::build_structural_index(source, index);
+        benchmark::DoNotOptimize(index.positions.data());
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_JsonStructuralIndex)->Arg(4096);
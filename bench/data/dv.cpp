@@ -0,0 +1,368 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <new>
+#include <random>
+#include <unordered_map>
+
+#include <coders/binary_json.h>
+#include <coders/json.h>
+#include <coders/byte_utils.h>
+#include <data/dv.h>
+
+static std::atomic<size_t> allocations {0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+/// Число выделений памяти за итерацию
+class AllocationsCounter {
+    benchmark::State& state;
+    size_t start = allocations.load();
+public:
+    AllocationsCounter(benchmark::State& state) : state(state) {}
+
+    ~AllocationsCounter() {
+        state.counters["allocs"] = benchmark::Counter(
+            allocations.load() - start, benchmark::Counter::kAvgIterations
+        );
+    }
+};
+
+inline constexpr int INVENTORY_SIZE = 40;
+
+/// Инвентарь в формате Inventory::serialize
+static dv::value make_inventory(std::mt19937& random, int id) {
+    auto map = dv::object();
+    map["id"] = id;
+    auto& slotsarr = map.list("slots");
+    for (int i = 0; i < INVENTORY_SIZE; ++i) {
+        auto& slotmap = slotsarr.object();
+        slotmap["id"] = random() % 300;
+        if (random() % 3) {
+            slotmap["count"] = random() % 64 + 1;
+        }
+        if (random() % 8 == 0) {
+            slotmap["fields"] = dv::object({{"durability", 0.75}});
+        }
+    }
+    return map;
+}
+
+/// Сущность в формате Entt_Entity::serialize
+static dv::value make_entity(std::mt19937& random, int uid) {
+    auto root = dv::object();
+    root["def"] = "base:drop";
+    root["uid"] = uid;
+    auto& transform = root.object("transform");
+    transform["pos"] = dv::list({
+        random() % 1000 * 0.5, random() % 256 * 0.5, random() % 1000 * 0.5
+    });
+    auto& body = root.object("rigidbody");
+    body["vel"] = dv::list({0.0, -9.8, 0.0});
+    body["damping"] = 0.5;
+    body["type"] = "dynamic";
+    body["mass"] = 1.0;
+    body["elasticity"] = 0.0;
+    auto& comps = root.object("comps");
+    auto& drop = comps.object("base:drop");
+    drop["item"] = random() % 300;
+    drop["count"] = random() % 64 + 1;
+    return root;
+}
+
+/// Данные мира: игроки с инвентарями и сущности региона
+static dv::value make_save(int entitiesCount) {
+    std::mt19937 random(entitiesCount);
+    auto root = dv::object();
+    auto& players = root.list("players");
+    for (int i = 0; i < 4; ++i) {
+        auto& player = players.object();
+        player["id"] = i;
+        player["name"] = "player" + std::to_string(i);
+        player["inventory"] = make_inventory(random, i + 1);
+    }
+    auto& entities = root.list("entities");
+    for (int i = 0; i < entitiesCount; ++i) {
+        entities.add(make_entity(random, i + 1));
+    }
+    return root;
+}
+
+static void BM_DvSaveSerialize(benchmark::State& state) {
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(make_save(state.range(0)));
+    }
+}
+BENCHMARK(BM_DvSaveSerialize)->Arg(16)->Arg(256);
+
+/// Слоты инвентаря на std::unordered_map (представление объектов до
+/// плоского хранения) для сравнения числа выделений
+static void BM_DvInventoryHashMap(benchmark::State& state) {
+    using HashObject = std::unordered_map<std::string, dv::value>;
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        std::vector<HashObject> slots;
+        slots.reserve(INVENTORY_SIZE);
+        for (int i = 0; i < INVENTORY_SIZE; ++i) {
+            auto& slot = slots.emplace_back();
+            slot["id"] = i;
+            slot["count"] = i + 1;
+        }
+        benchmark::DoNotOptimize(slots);
+    }
+}
+BENCHMARK(BM_DvInventoryHashMap);
+
+static void BM_DvInventoryFlat(benchmark::State& state) {
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        std::vector<dv::objects::Object> slots;
+        slots.reserve(INVENTORY_SIZE);
+        for (int i = 0; i < INVENTORY_SIZE; ++i) {
+            auto& slot = slots.emplace_back();
+            slot["id"] = i;
+            slot["count"] = i + 1;
+        }
+        benchmark::DoNotOptimize(slots);
+    }
+}
+BENCHMARK(BM_DvInventoryFlat);
+
+static void BM_JsonParseSave(benchmark::State& state) {
+    auto source = json::stringify(make_save(state.range(0)), false);
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::parse(source));
+    }
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_JsonParseSave)->Arg(16)->Arg(256);
+
+static void BM_JsonStringifySave(benchmark::State& state) {
+    auto save = make_save(state.range(0));
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::stringify(save, false));
+    }
+}
+BENCHMARK(BM_JsonStringifySave)->Arg(16)->Arg(256);
+
+static void BM_BinaryJsonParseSave(benchmark::State& state) {
+    auto bytes = json::to_binary(make_save(state.range(0)), false);
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::from_binary(bytes.data(), bytes.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_BinaryJsonParseSave)->Arg(16)->Arg(256);
+
+static void BM_BinaryJsonEncodeSave(benchmark::State& state) {
+    auto save = make_save(state.range(0));
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(json::to_binary(save, false));
+    }
+}
+BENCHMARK(BM_BinaryJsonEncodeSave)->Arg(16)->Arg(256);
+
+/// Сущность, восстанавливаемая из BJSON без промежуточного дерева
+struct EntityState {
+    std::string def;
+    int64_t uid = 0;
+    float pos[3] {};
+    float vel[3] {};
+    float damping = 0.0f;
+    dv::value comps;
+};
+
+static std::vector<EntityState> make_entities(int count) {
+    std::mt19937 random(count);
+    std::vector<EntityState> entities(count);
+    for (int i = 0; i < count; ++i) {
+        auto& entity = entities[i];
+        entity.def = "base:drop";
+        entity.uid = i + 1;
+        for (int j = 0; j < 3; ++j) {
+            entity.pos[j] = random() % 1000 * 0.5f;
+        }
+        entity.vel[1] = -9.8f;
+        entity.damping = 0.5f;
+        entity.comps = dv::object({{"base:drop", dv::object({
+            {"item", static_cast<int>(random() % 300)},
+            {"count", static_cast<int>(random() % 64 + 1)}
+        })}});
+    }
+    return entities;
+}
+
+/// Запись чанка сущностей в формате GlobalChunks::save
+static void write_entities(
+    ByteBuilder& builder, const std::vector<EntityState>& entities
+) {
+    json::BinaryWriter writer(builder);
+    writer.beginObject();
+    writer.beginList("data");
+    for (const auto& entity : entities) {
+        writer.beginObject();
+        writer.put("def", entity.def);
+        writer.put("uid", entity.uid);
+        writer.beginObject("transform");
+        writer.beginList("pos");
+        for (float coord : entity.pos) writer.add(coord);
+        writer.endList();
+        writer.endObject();
+        writer.beginObject("rigidbody");
+        writer.beginList("vel");
+        for (float coord : entity.vel) writer.add(coord);
+        writer.endList();
+        writer.put("damping", entity.damping);
+        writer.endObject();
+        writer.put("comps", entity.comps);
+        writer.endObject();
+    }
+    writer.endList();
+    writer.endObject();
+}
+
+/// Запись чанка сущностей через дерево dv (прежний путь сохранения)
+static void BM_BinaryJsonTreeEncodeEntities(benchmark::State& state) {
+    auto entities = make_entities(state.range(0));
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        auto root = dv::object();
+        auto& list = root.list("data");
+        for (const auto& entity : entities) {
+            auto& map = list.object();
+            map["def"] = entity.def;
+            map["uid"] = entity.uid;
+            map.object("transform")["pos"] =
+                dv::list({entity.pos[0], entity.pos[1], entity.pos[2]});
+            auto& body = map.object("rigidbody");
+            body["vel"] = dv::list({entity.vel[0], entity.vel[1], entity.vel[2]});
+            body["damping"] = entity.damping;
+            map["comps"] = entity.comps;
+        }
+        benchmark::DoNotOptimize(json::to_binary(root, false));
+    }
+}
+BENCHMARK(BM_BinaryJsonTreeEncodeEntities)->Arg(16)->Arg(256);
+
+static void BM_BinaryJsonStreamEncodeEntities(benchmark::State& state) {
+    auto entities = make_entities(state.range(0));
+    ByteBuilder builder;
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        builder.clear();
+        write_entities(builder, entities);
+        benchmark::DoNotOptimize(builder.data());
+    }
+}
+BENCHMARK(BM_BinaryJsonStreamEncodeEntities)->Arg(16)->Arg(256);
+
+static std::vector<ubyte> encode_entities(int count) {
+    ByteBuilder builder;
+    write_entities(builder, make_entities(count));
+    return builder.build();
+}
+
+/// Чтение чанка сущностей через дерево dv (прежний путь загрузки)
+static void BM_BinaryJsonTreeDecodeEntities(benchmark::State& state) {
+    auto bytes = encode_entities(state.range(0));
+    std::vector<EntityState> entities;
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        entities.clear();
+        auto root = json::from_binary(bytes.data(), bytes.size());
+        for (const auto& map : root["data"]) {
+            auto& entity = entities.emplace_back();
+            entity.def = map["def"].asString();
+            entity.uid = map["uid"].asInteger();
+            const auto& pos = map["transform"]["pos"];
+            const auto& vel = map["rigidbody"]["vel"];
+            for (int j = 0; j < 3; ++j) {
+                entity.pos[j] = pos[j].asNumber();
+                entity.vel[j] = vel[j].asNumber();
+            }
+            entity.damping = map["rigidbody"]["damping"].asNumber();
+            entity.comps = map["comps"];
+        }
+        benchmark::DoNotOptimize(entities.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_BinaryJsonTreeDecodeEntities)->Arg(16)->Arg(256);
+
+static void read_vec3(json::BinaryReader& reader, float (&dst)[3]) {
+    reader.beginList();
+    for (int j = 0; reader.hasNext(); ++j) {
+        float value = reader.readNumber();
+        if (j < 3) dst[j] = value;
+    }
+    reader.endList();
+}
+
+static void BM_BinaryJsonStreamDecodeEntities(benchmark::State& state) {
+    auto bytes = encode_entities(state.range(0));
+    std::vector<EntityState> entities;
+    AllocationsCounter counter(state);
+    for (auto _ : state) {
+        entities.clear();
+        json::BinaryReader reader(bytes.data(), bytes.size());
+        reader.beginObject();
+        reader.readKey();
+        reader.beginList();
+        while (reader.hasNext()) {
+            auto& entity = entities.emplace_back();
+            reader.beginObject();
+            while (reader.hasNext()) {
+                auto key = reader.readKey();
+                if (key == "def") {
+                    entity.def = reader.readString();
+                } else if (key == "uid") {
+                    entity.uid = reader.readInteger();
+                } else if (key == "transform") {
+                    reader.beginObject();
+                    reader.readKey();
+                    read_vec3(reader, entity.pos);
+                    reader.endObject();
+                } else if (key == "rigidbody") {
+                    reader.beginObject();
+                    while (reader.hasNext()) {
+                        if (reader.readKey() == "vel") {
+                            read_vec3(reader, entity.vel);
+                        } else {
+                            entity.damping = reader.readNumber();
+                        }
+                    }
+                    reader.endObject();
+                } else if (key == "comps") {
+                    entity.comps = reader.readValue();
+                } else {
+                    reader.skipValue();
+                }
+            }
+            reader.endObject();
+        }
+        reader.endList();
+        reader.endObject();
+        benchmark::DoNotOptimize(entities.data());
+    }
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_BinaryJsonStreamDecodeEntities)->Arg(16)->Arg(256);
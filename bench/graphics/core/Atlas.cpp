@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <graphics/core/Atlas.h>
+#include <graphics/core/ImageData.h>
+#include <math/SkylinePacker.h>
+
+/// Синтетический набор текстур крупного пака: в основном 16x16 и 32x32,
+/// с небольшой долей крупных изображений
+static std::vector<uint32_t> make_sizes(size_t count) {
+    std::vector<uint32_t> sizes;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t size = i % 10 == 0 ? 64 : (i % 3 == 0 ? 32 : 16);
+        sizes.push_back(size);
+        sizes.push_back(i % 17 == 0 ? size * 2 : size);
+    }
+    return sizes;
+}
+
+static AtlasBuilder make_builder(const std::vector<uint32_t>& sizes) {
+    AtlasBuilder builder;
+    for (size_t i = 0; i < sizes.size() / 2; ++i) {
+        auto image = std::make_unique<ImageData>(
+            ImageFormat::rgba8888, sizes[i * 2], sizes[i * 2 + 1]
+        );
+        ubyte* data = image->getData();
+        for (size_t j = 0; j < image->getDataSize(); ++j) {
+            data[j] = static_cast<ubyte>(j + i);
+        }
+        builder.add("texture" + std::to_string(i), std::move(image));
+    }
+    return builder;
+}
+
+static void BM_SkylinePack(benchmark::State& state) {
+    auto sizes = make_sizes(state.range(0));
+    for (auto _ : state) {
+        SkylinePacker packer(sizes.data(), sizes.size());
+        benchmark::DoNotOptimize(packer.build(4096, 4096, 2));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SkylinePack)->Arg(256)->Arg(4096);
+
+/// Упаковка и копирование в холст без GL; второй аргумент - число потоков
+static void BM_AtlasBuild(benchmark::State& state) {
+    auto sizes = make_sizes(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto builder = make_builder(sizes);
+        state.ResumeTiming();
+        auto atlas = builder.build(2, false, 8192, state.range(1));
+        benchmark::DoNotOptimize(atlas->getImage()->getData());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AtlasBuild)
+    ->Args({4096, 1})
+    ->Args({4096, 0})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,143 @@
+#include <graphics/render/BlocksRenderer.h>
+
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <assets/Assets.h>
+#include <content/Content.h>
+#include <core_content_defs.h>
+#include <engine/Engine.h>
+#include <frontend/ContentGfxCache.h>
+#include <graphics/commons/Model.h>
+#include <graphics/core/Atlas.h>
+#include <graphics/core/ImageData.h>
+#include <graphics/render/MeshBuffersPool.h>
+#include <voxels/Block.h>
+#include <voxels/Chunk.h>
+#include <voxels/Chunks.h>
+#include <settings.h>
+
+/// @brief Кэш UV без текстур: все грани ссылаются на пустую область
+/// атласа, пользовательские модели пусты. Число граней и вершин такое же,
+/// как с настоящими ресурсами, кроме блоков с пользовательскими моделями
+struct MeshingScene {
+    Assets assets {nullptr};
+    std::unique_ptr<ContentGfxCache> cache;
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::vector<std::unique_ptr<VoxelsRenderVolume>> volumes;
+
+    MeshingScene() {
+        auto& world = BenchWorld::get();
+        const auto& content = world.getContent();
+        const auto& settings = Engine::getInstance().getSettings();
+
+        assets.store(
+            std::make_unique<Atlas>(
+                std::make_unique<ImageData>(ImageFormat::rgba8888, 1, 1),
+                std::unordered_map<std::string, UVRegion> {
+                    {TEXTURE_NOTFOUND, UVRegion()}},
+                false
+            ),
+            "blocks"
+        );
+        for (const auto def : content.getIndices()->blocks.getIterable()) {
+            if (def->defaults.model.type == BlockModelType::Custom) {
+                assets.store(
+                    std::make_unique<model::Model>(), def->defaults.model.name
+                );
+            }
+            if (def->variants) {
+                for (const auto& variant : def->variants->variants) {
+                    if (variant.model.type == BlockModelType::Custom) {
+                        assets.store(
+                            std::make_unique<model::Model>(),
+                            variant.model.name
+                        );
+                    }
+                }
+            }
+        }
+        cache = std::make_unique<ContentGfxCache>(
+            content, assets, settings.graphics
+        );
+
+        bool backlight = settings.graphics.backlight.get();
+        chunks = world.getInnerChunks();
+        for (const auto& chunk : chunks) {
+            auto volume = std::make_unique<VoxelsRenderVolume>();
+            volume->setPosition(
+                chunk->chunk_x * CHUNK_WIDTH - VOXELS_BUFFER_PADDING, 0,
+                chunk->chunk_z * CHUNK_DEPTH - VOXELS_BUFFER_PADDING
+            );
+            world.getChunks().getVoxels(*volume, backlight, chunk->top + 1);
+            volumes.push_back(std::move(volume));
+        }
+    }
+
+    static MeshingScene& get() {
+        static MeshingScene scene;
+        return scene;
+    }
+
+    std::unique_ptr<BlocksRenderer> createRenderer() const {
+        const auto& settings = Engine::getInstance().getSettings();
+        return std::make_unique<BlocksRenderer>(
+            settings.graphics.chunkMaxVertices.get(),
+            BenchWorld::get().getContent().getIndices()->blocks.getDefs(),
+            BenchWorld::get().getContent().getIndices()->getBlockProps(),
+            *cache,
+            settings
+        );
+    }
+
+    static size_t getBuffersLimit() {
+        const auto& settings = Engine::getInstance().getSettings();
+        return static_cast<size_t>(settings.graphics.meshBuffersLimit.get())
+               << 20;
+    }
+};
+
+/// Меши всех секций чанка, как в рабочем потоке ChunksRenderer
+static void BM_BlocksRendererChunk(benchmark::State& state) {
+    auto& scene = MeshingScene::get();
+    auto renderer = scene.createRenderer();
+    MeshBuffersPool pool(MeshingScene::getBuffersLimit());
+    size_t index = 0;
+    size_t vertices = 0;
+    for (auto _ : state) {
+        const auto& chunk = scene.chunks[index];
+        const auto& volume = *scene.volumes[index];
+        for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+            renderer->build(chunk.get(), volume, section);
+            // Меш освобождается сразу, поэтому лимит пула не достигается
+            auto mesh = renderer->createMesh(pool, false);
+            vertices += mesh->vertices.size();
+        }
+        index = (index + 1) % scene.chunks.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["vertices"] = benchmark::Counter(
+        vertices, benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_BlocksRendererChunk);
+
+static void BM_BlocksRendererLod(benchmark::State& state) {
+    auto& scene = MeshingScene::get();
+    auto renderer = scene.createRenderer();
+    MeshBuffersPool pool(MeshingScene::getBuffersLimit());
+    int lod = state.range(0);
+    size_t index = 0;
+    for (auto _ : state) {
+        renderer->buildLod(
+            scene.chunks[index].get(), *scene.volumes[index], lod
+        );
+        benchmark::DoNotOptimize(renderer->createMesh(pool, false));
+        index = (index + 1) % scene.chunks.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BlocksRendererLod)->DenseRange(1, MAX_LOD);
@@ -0,0 +1,203 @@
+#include <graphics/render/SectionsOcclusion.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+#include <glm/gtc/noise.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <voxels/Block.h>
+#include <math/FrustumCulling.h>
+
+static constexpr int AREA_SIZE = 12;
+static constexpr blockid_t AIR = 0;
+static constexpr blockid_t STONE = 1;
+
+/// Сгенерированная область чанков с предрассчитанной связностью секций
+struct OcclusionScene {
+    Block air {"core:air"};
+    Block stone {"base:stone"};
+    const Block* defs[2] {&air, &stone};
+    std::vector<std::unique_ptr<voxel[]>> chunks;
+    std::vector<SectionVisibility> visibility;
+    /// Секции, у которых есть хотя бы одна видимая грань блока
+    std::vector<bool> meshed;
+
+    OcclusionScene() {
+        air.lightPassing = true;
+        air.defaults.rt.solid = false;
+
+        for (int cz = 0; cz < AREA_SIZE; ++cz) {
+            for (int cx = 0; cx < AREA_SIZE; ++cx) {
+                chunks.push_back(generate(cx, cz));
+            }
+        }
+        for (int cz = 0; cz < AREA_SIZE; ++cz) {
+            for (int cx = 0; cx < AREA_SIZE; ++cx) {
+                for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+                    visibility.push_back(compute_section_visibility(
+                        chunks[cz * AREA_SIZE + cx].get(), defs, section
+                    ));
+                    meshed.push_back(hasExposedFaces(cx, section, cz));
+                }
+            }
+        }
+    }
+
+    static size_t sectionIndex(int x, int section, int z) {
+        return (z * AREA_SIZE + x) * CHUNK_SECTIONS + section;
+    }
+
+    blockid_t get(int x, int y, int z) const {
+        if (x < 0 || z < 0 || y < 0 ||
+            x >= AREA_SIZE * CHUNK_WIDTH || z >= AREA_SIZE * CHUNK_DEPTH ||
+            y >= CHUNK_HEIGHT) {
+            return AIR;
+        }
+        const auto& chunk = chunks[
+            (z / CHUNK_DEPTH) * AREA_SIZE + x / CHUNK_WIDTH
+        ];
+        return chunk[vox_index(x % CHUNK_WIDTH, y, z % CHUNK_DEPTH)].id;
+    }
+private:
+    /// Холмистый рельеф с пещерами; детерминирован координатами
+    static std::unique_ptr<voxel[]> generate(int cx, int cz) {
+        auto voxels = std::make_unique<voxel[]>(CHUNK_VOLUME);
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                float gx = cx * CHUNK_WIDTH + x;
+                float gz = cz * CHUNK_DEPTH + z;
+                float height = 96.0f +
+                    glm::simplex(glm::vec2(gx, gz) * 0.01f) * 48.0f +
+                    glm::simplex(glm::vec2(gx, gz) * 0.05f) * 8.0f;
+                for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                    bool solid = y < height;
+                    if (solid && y > 4) {
+                        float cave = glm::simplex(
+                            glm::vec3(gx, y * 1.5f, gz) * 0.04f
+                        );
+                        solid = cave < 0.55f;
+                    }
+                    auto& vox = voxels[vox_index(x, y, z)];
+                    vox.id = solid ? STONE : AIR;
+                    vox.state = {};
+                }
+            }
+        }
+        return voxels;
+    }
+
+    bool hasExposedFaces(int cx, int section, int cz) const {
+        int y0 = section * CHUNK_SECTION_HEIGHT;
+        for (int y = y0; y < y0 + CHUNK_SECTION_HEIGHT; ++y) {
+            for (int lz = 0; lz < CHUNK_DEPTH; ++lz) {
+                for (int lx = 0; lx < CHUNK_WIDTH; ++lx) {
+                    int x = cx * CHUNK_WIDTH + lx;
+                    int z = cz * CHUNK_DEPTH + lz;
+                    if (get(x, y, z) == AIR) continue;
+                    if (get(x - 1, y, z) == AIR || get(x + 1, y, z) == AIR ||
+                        get(x, y - 1, z) == AIR || get(x, y + 1, z) == AIR ||
+                        get(x, y, z - 1) == AIR || get(x, y, z + 1) == AIR) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+};
+
+static const OcclusionScene& get_scene() {
+    static OcclusionScene scene;
+    return scene;
+}
+
+/// Камеры: над рельефом, у поверхности и под землёй
+static const glm::vec3 CAMERA_POSITIONS[] {
+    {96.5f, 180.0f, 96.5f},
+    {96.5f, 110.0f, 96.5f},
+    {96.5f, 40.0f, 96.5f},
+};
+
+static Frustum make_frustum(const glm::vec3& position, float yaw) {
+    glm::mat4 proj = glm::perspective(
+        glm::radians(90.0f), 16.0f / 9.0f, 0.05f, 1500.0f
+    );
+    glm::vec3 dir(glm::cos(yaw), -0.2f, glm::sin(yaw));
+    glm::mat4 view = glm::lookAt(position, position + dir, glm::vec3(0, 1, 0));
+    Frustum frustum;
+    frustum.update(proj * view);
+    return frustum;
+}
+
+static void BM_SubmittedSections(benchmark::State& state) {
+    const auto& scene = get_scene();
+    const auto& cameraPos = CAMERA_POSITIONS[state.range(0)];
+    bool occlusionCulling = state.range(1);
+
+    SectionsOcclusion occlusion;
+    std::vector<bool> visible(scene.meshed.size());
+    size_t submitted = 0;
+    size_t frames = 0;
+    for (auto _ : state) {
+        auto frustum = make_frustum(cameraPos, frames * 0.1f);
+        if (occlusionCulling) {
+            std::fill(visible.begin(), visible.end(), false);
+            occlusion.collect(
+                cameraPos,
+                {0, 0},
+                {AREA_SIZE, AREA_SIZE},
+                &frustum,
+                [&scene](int x, int section, int z) {
+                    return scene.visibility[
+                        OcclusionScene::sectionIndex(x, section, z)
+                    ];
+                },
+                [&visible](int x, int section, int z) {
+                    visible[OcclusionScene::sectionIndex(x, section, z)] = true;
+                }
+            );
+        }
+        for (int z = 0; z < AREA_SIZE; ++z) {
+            for (int x = 0; x < AREA_SIZE; ++x) {
+                for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+                    size_t index = OcclusionScene::sectionIndex(x, section, z);
+                    if (!scene.meshed[index]) continue;
+                    if (occlusionCulling && !visible[index]) continue;
+                    glm::vec3 min(
+                        x * CHUNK_WIDTH,
+                        section * CHUNK_SECTION_HEIGHT,
+                        z * CHUNK_DEPTH
+                    );
+                    glm::vec3 max = min + glm::vec3(
+                        CHUNK_WIDTH, CHUNK_SECTION_HEIGHT, CHUNK_DEPTH
+                    );
+                    if (frustum.isBoxVisible(min, max)) {
+                        submitted++;
+                    }
+                }
+            }
+        }
+        frames++;
+    }
+    state.counters["sections"] = benchmark::Counter(
+        static_cast<double>(submitted) / frames
+    );
+}
+BENCHMARK(BM_SubmittedSections)
+    ->ArgsProduct({{0, 1, 2}, {0, 1}})
+    ->ArgNames({"camera", "occlusion"});
+
+static void BM_ComputeSectionVisibility(benchmark::State& state) {
+    const auto& scene = get_scene();
+    size_t index = 0;
+    for (auto _ : state) {
+        int chunk = (index / CHUNK_SECTIONS) % scene.chunks.size();
+        int section = index % CHUNK_SECTIONS;
+        benchmark::DoNotOptimize(compute_section_visibility(
+            scene.chunks[chunk].get(), scene.defs, section
+        ));
+        index++;
+    }
+}
+BENCHMARK(BM_ComputeSectionVisibility);
@@ -0,0 +1,58 @@
+#include <lighting/LightSolver.h>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <content/Content.h>
+#include <lighting/Lighting.h>
+#include <voxels/Block.h>
+#include <voxels/Chunks.h>
+#include <voxels/voxel.h>
+
+/// Освещение квадрата с нуля: небесный свет и источники всех чанков
+static void BM_LightingArea(benchmark::State& state) {
+    auto& world = BenchWorld::get();
+    for (auto _ : state) {
+        world.rebuildLights();
+    }
+    state.SetItemsProcessed(state.iterations() * world.getInnerChunks().size());
+}
+BENCHMARK(BM_LightingArea)->Unit(benchmark::kMillisecond);
+
+/// @return блок с самым ярким свечением или nullptr
+static const Block* find_emitter(const Content& content) {
+    const Block* emitter = nullptr;
+    int maxEmission = 0;
+    for (const auto def : content.getIndices()->blocks.getIterable()) {
+        int emission = def->emission[0] + def->emission[1] + def->emission[2];
+        if (emission > maxEmission) {
+            emitter = def;
+            maxEmission = emission;
+        }
+    }
+    return emitter;
+}
+
+/// Установка и удаление светящегося блока на поверхности: распространение
+/// и снятие света по всем каналам, как при Lighting::onBlockSet
+static void BM_LightingEmitter(benchmark::State& state) {
+    auto& world = BenchWorld::get();
+    auto emitter = find_emitter(world.getContent());
+    if (emitter == nullptr) {
+        state.SkipWithError("no light emitting blocks in content");
+        return;
+    }
+    auto& chunks = world.getChunks();
+    auto& lighting = world.getLighting();
+    int y = world.getSurfaceY(0, 0);
+    voxel* vox = chunks.getVoxel(0, y, 0);
+    voxel previous = *vox;
+    for (auto _ : state) {
+        vox->id = emitter->rt.id;
+        lighting.onBlockSet(0, y, 0, emitter->rt.id);
+        *vox = previous;
+        lighting.onBlockSet(0, y, 0, previous.id);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_LightingEmitter);
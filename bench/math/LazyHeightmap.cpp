@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <math/LazyHeightmap.h>
+#include <math/Heightmap.h>
+
+using Type = HeightmapOp::Type;
+
+inline constexpr int PASSES = 24;
+
+static HeightmapOp make_op(int index, const std::shared_ptr<LazyHeightmap>& other) {
+    static const Type types[] {Type::Add, Type::Mul, Type::Max, Type::Min};
+    HeightmapOp op(types[index % 4]);
+    if (index % 3 == 0) {
+        op.maps[0] = other;
+    } else {
+        op.values[0] = 0.5f + index * 0.01f;
+    }
+    return op;
+}
+
+/// Цепочка операций, выполняемых по одной (как до отложенных вычислений)
+static void BM_HeightmapEager(benchmark::State& state) {
+    uint size = state.range(0);
+    auto other = std::make_shared<LazyHeightmap>(std::make_shared<Heightmap>(size, size));
+    for (auto _ : state) {
+        auto map = std::make_shared<LazyHeightmap>(std::make_shared<Heightmap>(size, size));
+        for (int i = 0; i < PASSES; ++i) {
+            map->apply(make_op(i, other));
+            map->evaluate();
+        }
+        benchmark::DoNotOptimize(map->getValues());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * PASSES);
+}
+BENCHMARK(BM_HeightmapEager)->Arg(16)->Arg(256)->Arg(1024);
+
+/// Та же цепочка одним проходом по блокам
+static void BM_HeightmapFused(benchmark::State& state) {
+    uint size = state.range(0);
+    auto other = std::make_shared<LazyHeightmap>(std::make_shared<Heightmap>(size, size));
+    for (auto _ : state) {
+        auto map = std::make_shared<LazyHeightmap>(std::make_shared<Heightmap>(size, size));
+        for (int i = 0; i < PASSES; ++i) {
+            map->apply(make_op(i, other));
+        }
+        benchmark::DoNotOptimize(map->getValues());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * PASSES);
+}
+BENCHMARK(BM_HeightmapFused)->Arg(16)->Arg(256)->Arg(1024);
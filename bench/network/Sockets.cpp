@@ -0,0 +1,108 @@
+#include <network/Network.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+/// Сервер и клиенты, соединённые через loopback
+struct Loopback {
+    network::Network network {nullptr};
+    std::vector<network::ReadableConnection*> clients;
+    std::vector<network::ReadableConnection*> accepted;
+
+    explicit Loopback(int count) {
+        int port = network.findFreePort();
+        std::atomic<int> acceptedCount = 0;
+        std::vector<uint64_t> acceptedIds(count);
+        network.openTcpServer(port, [&](uint64_t, uint64_t id) {
+            acceptedIds[acceptedCount++] = id;
+        });
+        std::atomic<int> connected = 0;
+        for (int i = 0; i < count; ++i) {
+            uint64_t id = network.connectTcp(
+                "127.0.0.1", port, [&](uint64_t) { connected++; }, nullptr
+            );
+            clients.push_back(get(id));
+        }
+        while (connected < count || acceptedCount < count) {
+            std::this_thread::yield();
+        }
+        for (uint64_t id : acceptedIds) {
+            accepted.push_back(get(id));
+        }
+    }
+
+    network::ReadableConnection* get(uint64_t id) {
+        return dynamic_cast<network::ReadableConnection*>(
+            network.getConnection(id, true)
+        );
+    }
+};
+
+/// Пропускная способность одного соединения при разных размерах сообщений
+static void BM_TcpThroughput(benchmark::State& state) {
+    constexpr size_t BATCH_SIZE = 1024 * 1024;
+
+    size_t messageSize = state.range(0);
+    Loopback loopback(1);
+    auto client = loopback.clients[0];
+    auto server = loopback.accepted[0];
+    std::vector<char> message(messageSize, 'x');
+    std::vector<char> buffer(64 * 1024);
+
+    for (auto _ : state) {
+        for (size_t sent = 0; sent < BATCH_SIZE; sent += messageSize) {
+            client->send(message.data(), messageSize);
+        }
+        size_t received = 0;
+        while (received < BATCH_SIZE) {
+            int size = server->recv(buffer.data(), buffer.size());
+            if (size > 0) {
+                received += size;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * BATCH_SIZE);
+}
+BENCHMARK(BM_TcpThroughput)
+    ->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(64 * 1024)
+    ->UseRealTime();
+
+/// Все клиенты отправляют по сообщению; время до приёма всех сообщений
+static void BM_TcpConnections(benchmark::State& state) {
+    constexpr size_t MESSAGE_SIZE = 256;
+
+    int count = state.range(0);
+    Loopback loopback(count);
+    std::vector<char> message(MESSAGE_SIZE, 'x');
+    std::vector<char> buffer(MESSAGE_SIZE);
+    std::vector<size_t> received(count);
+
+    for (auto _ : state) {
+        for (auto client : loopback.clients) {
+            client->send(message.data(), MESSAGE_SIZE);
+        }
+        std::fill(received.begin(), received.end(), 0);
+        int pending = count;
+        while (pending) {
+            for (int i = 0; i < count; ++i) {
+                if (received[i] == MESSAGE_SIZE) continue;
+                int size = loopback.accepted[i]->recv(
+                    buffer.data(), MESSAGE_SIZE - received[i]
+                );
+                if (size > 0 && (received[i] += size) == MESSAGE_SIZE) {
+                    pending--;
+                }
+            }
+        }
+    }
+    state.counters["clients"] = count;
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_TcpConnections)
+    ->RangeMultiplier(4)->Range(1, 256)
+    ->UseRealTime();
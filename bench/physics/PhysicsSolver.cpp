@@ -0,0 +1,74 @@
+#include <physics/PhysicsSolver.h>
+
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <physics/Hitbox.h>
+#include <voxels/GlobalChunks.h>
+#include <world/Level.h>
+#include <constants.h>
+
+/// Тики физики за итерацию (секунда при 20 тиках в секунду)
+inline constexpr int TICKS = 20;
+inline constexpr float TICK_DELTA = 1.0f / TICKS;
+
+/// @brief Тела размером с моба, падающие на рельеф с горизонтальной
+/// скоростью; положения детерминированы
+static std::vector<Hitbox> make_bodies(int count) {
+    auto& world = BenchWorld::get();
+    int range = (BenchWorld::AREA_RADIUS - 1) * CHUNK_WIDTH;
+    std::mt19937 random(count);
+    std::uniform_int_distribution<int> coord(-range, range - 1);
+    std::uniform_real_distribution<float> speed(-4.0f, 4.0f);
+
+    std::vector<Hitbox> bodies;
+    bodies.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int x = coord(random);
+        int z = coord(random);
+        int y = world.getSurfaceY(x, z) + 2;
+        auto& hitbox = bodies.emplace_back(
+            i + 1,
+            BodyType::Dynamic,
+            glm::vec3(x + 0.5f, y + 0.9f, z + 0.5f),
+            glm::vec3(0.3f, 0.9f, 0.3f)
+        );
+        hitbox.velocity = glm::vec3(speed(random), 0.0f, speed(random));
+    }
+    return bodies;
+}
+
+/// Шаги физики, как в Entities::updatePhysics, с коллизиями тел между
+/// собой и с блоками
+static void BM_PhysicsStep(benchmark::State& state) {
+    auto& level = BenchWorld::get().getLevel();
+    const auto initial = make_bodies(state.range(0));
+    // Подшаги для дельты тика по формуле Entities::updatePhysics
+    int substeps = std::max<int>(std::min<int>(TICK_DELTA * 1000, 200), 8);
+
+    // Солвер уровня: сущностей в мире бенчмарка нет
+    auto& solver = *level.physics;
+    auto& hitboxes = solver.getHitboxesWriteable();
+    auto& solidHitboxes = solver.getSolidHitboxesWriteable();
+    auto bodies = initial;
+    for (auto& body : bodies) {
+        hitboxes.push_back(&body);
+        solidHitboxes.push_back(&body);
+    }
+    for (auto _ : state) {
+        std::copy(initial.begin(), initial.end(), bodies.begin());
+        for (int i = 0; i < TICKS; ++i) {
+            solver.step(*level.chunks, TICK_DELTA, substeps);
+        }
+    }
+    hitboxes.clear();
+    solidHitboxes.clear();
+    state.SetItemsProcessed(state.iterations() * bodies.size() * TICKS);
+}
+BENCHMARK(BM_PhysicsStep)
+    ->RangeMultiplier(4)->Range(4, 256)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,38 @@
+#include <voxels/Pathfinding.h>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <world/Level.h>
+
+/// Ограничение обхода, при котором маршрут на рельефе квадрата находится
+inline constexpr int MAX_VISITED_BLOCKS = 100'000;
+
+/// Поиск маршрута A* по поверхности на заданное расстояние по диагонали
+static void BM_PathfindingRoute(benchmark::State& state) {
+    auto& world = BenchWorld::get();
+    auto& pathfinding = *world.getLevel().pathfinding;
+    int distance = state.range(0);
+    int from = -distance / 2;
+    int to = from + distance;
+
+    voxels::Agent agent {};
+    agent.enabled = true;
+    agent.maxVisitedBlocks = MAX_VISITED_BLOCKS;
+    agent.start = {from, world.getSurfaceY(from, from), from};
+    agent.target = {to, world.getSurfaceY(to, to), to};
+
+    size_t visited = 0;
+    for (auto _ : state) {
+        agent.state = {};
+        auto route = pathfinding.perform(agent);
+        visited += route.totalVisited;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["visited"] = benchmark::Counter(
+        visited, benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_PathfindingRoute)
+    ->Arg(8)->Arg(24)->Arg(48)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,43 @@
+#include <voxels/compressed_chunks.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <content/Content.h>
+
+/// Сжатие сгенерированных чанков в формат world.get_chunk_data
+static void BM_CompressedChunksEncode(benchmark::State& state) {
+    auto chunks = BenchWorld::get().getInnerChunks();
+    size_t index = 0;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        auto data = compressed_chunks::encode(*chunks[index]);
+        bytes += data.size();
+        index = (index + 1) % chunks.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes"] = benchmark::Counter(
+        bytes, benchmark::Counter::kAvgIterations
+    );
+}
+BENCHMARK(BM_CompressedChunksEncode);
+
+static void BM_CompressedChunksDecode(benchmark::State& state) {
+    auto& world = BenchWorld::get();
+    const auto& indices = *world.getContent().getIndices();
+    std::vector<std::vector<ubyte>> encoded;
+    for (const auto& chunk : world.getInnerChunks()) {
+        encoded.push_back(compressed_chunks::encode(*chunk));
+    }
+    Chunk chunk(0, 0);
+    size_t index = 0;
+    for (auto _ : state) {
+        const auto& data = encoded[index];
+        compressed_chunks::decode(chunk, data.data(), data.size(), indices);
+        index = (index + 1) % encoded.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompressedChunksDecode);
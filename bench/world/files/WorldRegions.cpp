@@ -0,0 +1,55 @@
+#include <world/files/WorldRegions.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <lighting/Lightmap.h>
+#include <voxels/Chunk.h>
+
+/// Регионы бенчмарка пишутся рядом с миром, не затрагивая его файлы
+static const io::path REGIONS_FOLDER = "world:bench_regions";
+
+/// Сжатие вокселей и света всех чанков квадрата и запись файлов регионов
+static void BM_WorldRegionsSave(benchmark::State& state) {
+    auto chunks = BenchWorld::get().getInnerChunks();
+    for (auto _ : state) {
+        WorldRegions regions(REGIONS_FOLDER);
+        for (const auto& chunk : chunks) {
+            regions.put(chunk.get(), {});
+        }
+        regions.writeAll();
+    }
+    state.SetItemsProcessed(state.iterations() * chunks.size());
+}
+BENCHMARK(BM_WorldRegionsSave)->Unit(benchmark::kMillisecond);
+
+/// Чтение и распаковка чанков из файлов, как при загрузке мира
+static void BM_WorldRegionsLoad(benchmark::State& state) {
+    auto chunks = BenchWorld::get().getInnerChunks();
+    {
+        WorldRegions regions(REGIONS_FOLDER);
+        for (const auto& chunk : chunks) {
+            regions.put(chunk.get(), {});
+        }
+        regions.writeAll();
+    }
+    auto voxelData = std::make_unique<ubyte[]>(CHUNK_DATA_LEN);
+    auto lightData = std::make_unique<ubyte[]>(LIGHTMAP_MAX_ENCODED_LEN);
+    for (auto _ : state) {
+        WorldRegions regions(REGIONS_FOLDER);
+        for (const auto& chunk : chunks) {
+            int x = chunk->chunk_x;
+            int z = chunk->chunk_z;
+            uint32_t lightsSize;
+            if (!regions.getVoxels(x, z, voxelData.get()) ||
+                !regions.getLights(x, z, lightData.get(), lightsSize)) {
+                state.SkipWithError("chunk is missing in regions");
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * chunks.size());
+}
+BENCHMARK(BM_WorldRegionsLoad)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,43 @@
+#include <world/generator/WorldGenerator.h>
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include <BenchWorld.h>
+#include <voxels/voxel.h>
+#include <constants.h>
+
+/// Дистанция загрузки, с которой ChunksController обновляет генератор
+inline constexpr int LOAD_DISTANCE = 4;
+
+/// Новые чанки вдоль линии, как при движении игрока; время на чанк
+/// включает прототипы соседей (биомы, карты высот, структуры)
+static void BM_WorldGenChunk(benchmark::State& state) {
+    auto generator = BenchWorld::get().createGenerator(state.range(0));
+    auto voxels = std::make_unique<voxel[]>(CHUNK_VOLUME);
+    int x = 0;
+    for (auto _ : state) {
+        generator->update(x, 0, LOAD_DISTANCE);
+        generator->generate(voxels.get(), x, 0);
+        benchmark::DoNotOptimize(voxels.get());
+        x++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldGenChunk)->Arg(1)->Arg(0)->UseRealTime();
+
+/// Повторная генерация чанка с готовыми прототипами: только заполнение
+/// вокселей и размещение структур
+static void BM_WorldGenChunkCached(benchmark::State& state) {
+    auto generator = BenchWorld::get().createGenerator();
+    auto voxels = std::make_unique<voxel[]>(CHUNK_VOLUME);
+    generator->update(0, 0, LOAD_DISTANCE);
+    generator->generate(voxels.get(), 0, 0);
+    for (auto _ : state) {
+        generator->generate(voxels.get(), 0, 0);
+        benchmark::DoNotOptimize(voxels.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldGenChunkCached);
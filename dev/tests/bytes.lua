@@ -0,0 +1,37 @@
+local bytes = Bytes(8)
+assert(#bytes == 8)
+assert(bytes[1] == 0)
+assert(bytes[9] == nil)
+
+local pos = byteutil.pack_into(bytes, 1, ">Hi", 513, -7)
+assert(pos == 7)
+assert(bytes[1] == 2 and bytes[2] == 1)
+
+local a, b = byteutil.unpack(">Hi", bytes)
+assert(a == 513 and b == -7)
+
+-- срезы разделяют память с исходным буфером
+local tail = bytes:slice(3, 6)
+assert(#tail == 4)
+assert(byteutil.unpack(">i", tail) == -7)
+tail[4] = 0
+assert(bytes[6] == 0)
+assert(#bytes:slice(-2) == 2)
+assert(#bytes:slice(5, 2) == 0)
+
+local copy = Bytes(bytes)
+copy[1] = 255
+assert(bytes[1] == 2)
+
+local str = Bytes("hello")
+assert(str:string() == "hello")
+assert(utf8.tostring(str:slice(2, 3)) == "el")
+
+local arr = Bytes({1, 2, 3}):bytearray()
+assert(#arr == 3 and arr[3] == 3)
+assert(tostring(Bytes(3)) == "Bytes[3]")
+
+local ok = pcall(function() bytes[9] = 1 end)
+assert(not ok)
+ok = pcall(byteutil.pack_into, bytes, 7, "i", 1)
+assert(not ok)
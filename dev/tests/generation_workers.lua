@@ -0,0 +1,50 @@
+-- Генерация с рабочими потоками должна совпадать с однопоточной
+local util = require "builtin:tests_util"
+
+local RADIUS = 2
+local MAX_SPARKS = 500
+
+local function generate(workers)
+    app.set_setting("chunks.generator-workers", workers)
+    app.set_setting("chunks.load-distance", RADIUS + 3)
+    util.create_demo_world("chromaforge:standart")
+
+    local pid = player.create("Ezhovnik")
+    player.set_pos(pid, 8, 100, 8)
+
+    local chunks = {}
+    local missing = (RADIUS * 2 + 1) ^ 2
+    for _=1, MAX_SPARKS do
+        app.spark()
+        for z=-RADIUS, RADIUS do
+            for x=-RADIUS, RADIUS do
+                local key = x..":"..z
+                if not chunks[key] then
+                    local data = world.get_chunk_data(x, z)
+                    if data then
+                        chunks[key] = utf8.tostring(data)
+                        missing = missing - 1
+                    end
+                end
+            end
+        end
+        if missing == 0 then
+            break
+        end
+    end
+    assert(missing == 0, missing.." chunk(s) were not generated")
+
+    app.close_world(false)
+    app.delete_world("demo")
+    return chunks
+end
+
+local expected = generate(1)
+local actual = generate(4)
+for key, data in pairs(expected) do
+    assert(actual[key] == data, "chunk "..key.." differs")
+end
+app.set_setting(
+    "chunks.generator-workers",
+    app.get_setting_info("chunks.generator-workers").def
+)
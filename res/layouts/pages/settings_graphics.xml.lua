@@ -37,6 +37,7 @@ end
 function on_open()
     create_trackbar_setting("chunks.load-distance", "Load Distance", 1)
     create_trackbar_setting("chunks.load-speed", "Load Speed", 1)
+    create_trackbar_setting("graphics.lod-distance", "LOD Distance", 1, "", "graphics.lod-distance.tooltip")
     create_trackbar_setting("graphics.fog-curve", "Fog Curve", 0.1)
     create_checkbox("graphics.backlight", "Backlight", "graphics.backlight.tooltip")
     create_checkbox("graphics.soft-lighting", "Soft lighting", "graphics.soft-lighting.tooltip")
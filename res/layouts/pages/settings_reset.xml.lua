@@ -34,6 +34,7 @@ end
 function reset_graphics()
 	reset_setting("chunks.load-distance")
     reset_setting("chunks.load-speed")
+    reset_setting("graphics.lod-distance")
     reset_setting("graphics.fog-curve")
     reset_setting("graphics.gamma")
     reset_setting("graphics.backlight")
@@ -294,3 +294,55 @@ console.add_command(
         end
     end
 )
+
+console.add_command(
+    "pregen.radius radius:int x:num~pos.x z:num~pos.z",
+    "Pre-generate chunks in radius (in chunks) around the position",
+    function(args, kwargs)
+        local radius, x, z = unpack(args)
+        local cx, cz = math.floor(x / 16), math.floor(z / 16)
+        world.pregenerate_radius(cx, cz, radius)
+        return string.format(
+            "Pre-generation of radius %s around chunk %s, %s started",
+            radius, cx, cz
+        )
+    end, true
+)
+
+console.add_command(
+    "pregen.area x1:num~pos.x z1:num~pos.z x2:num~pos.x z2:num~pos.z",
+    "Pre-generate chunks of the specified zone",
+    function(args, kwargs)
+        local x1, z1, x2, z2 = unpack(args)
+        world.pregenerate(
+            math.floor(x1 / 16), math.floor(z1 / 16),
+            math.floor(x2 / 16), math.floor(z2 / 16)
+        )
+        return "Pre-generation started"
+    end, true
+)
+
+console.add_command(
+    "pregen.status",
+    "Show pre-generation progress",
+    function(args, kwargs)
+        local progress = world.get_pregen_progress()
+        if not progress then
+            return "Pre-generation is not running"
+        end
+        return string.format(
+            "%s/%s chunks (%s generated, %s skipped), %.1f chunks/s",
+            progress.done, progress.total, progress.generated,
+            progress.skipped, progress.speed
+        )
+    end
+)
+
+console.add_command(
+    "pregen.stop",
+    "Stop pre-generation",
+    function(args, kwargs)
+        world.stop_pregen()
+        return "Pre-generation stopped"
+    end, true
+)
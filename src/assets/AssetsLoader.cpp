@@ -1,6 +1,10 @@
 #include <assets/AssetsLoader.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include <assets/Assets.h>
@@ -399,6 +403,96 @@ std::shared_ptr<Task> AssetsLoader::startTask(runnable onDone, int maxWorkers) {
     return pool;
 }
 
+AssetsLoader::~AssetsLoader() = default;
+
+class HelperWorker : public util::Worker<runnable, int> {
+public:
+    int operator()(const runnable& job) override {
+        job();
+        return 0;
+    }
+};
+
+/// Состояние одного вызова parallelFor, общее для всех его потоков
+struct ParallelBatch {
+    const consumer<size_t>& func;
+    size_t count;
+    std::atomic<size_t> next {0};
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    size_t finished = 0;
+    std::exception_ptr error;
+
+    ParallelBatch(const consumer<size_t>& func, size_t count)
+        : func(func), count(count) {
+    }
+
+    /// Выполняет вызовы, пока не разобраны все индексы
+    void run() {
+        size_t done = 0;
+        std::exception_ptr firstError;
+        size_t index;
+        while ((index = next++) < count) {
+            try {
+                func(index);
+            } catch (...) {
+                if (!firstError) firstError = std::current_exception();
+            }
+            done++;
+        }
+        if (done == 0) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        if (firstError && !error) {
+            error = firstError;
+        }
+        finished += done;
+        if (finished == count) {
+            finishedCondition.notify_all();
+        }
+    }
+};
+
+void AssetsLoader::parallelFor(size_t count, const consumer<size_t>& func) {
+    if (count == 0) {
+        return;
+    }
+    util::ThreadPool<runnable, int>* pool;
+    {
+        std::lock_guard lock(helpersMutex);
+        if (helpers == nullptr) {
+            int workers = std::max(1U, std::thread::hardware_concurrency() / 2);
+            helpers = std::make_unique<util::ThreadPool<runnable, int>>(
+                "assets-loader-helpers",
+                []() { return std::make_unique<HelperWorker>(); },
+                [](int&&) {},
+                workers
+            );
+        }
+        pool = helpers.get();
+    }
+    // Помощник, взявшийся за работу после завершения, не найдёт индексов,
+    // но может обратиться к состоянию - поэтому оно разделяемое
+    auto batch = std::make_shared<ParallelBatch>(func, count);
+    size_t helpersCount = std::min<size_t>(count - 1, pool->getWorkersCount());
+    for (size_t i = 0; i < helpersCount; ++i) {
+        pool->enqueueJob([batch]() { batch->run(); });
+    }
+    batch->run();
+    {
+        std::unique_lock lock(batch->mutex);
+        batch->finishedCondition.wait(lock, [&batch]() {
+            return batch->finished == batch->count;
+        });
+    }
+    // Результаты помощников не нужны, очередь результатов лишь очищается
+    pool->pullResults();
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
 Engine& AssetsLoader::getEngine() {
     return engine;
 }
@@ -6,6 +6,8 @@
 #include <queue>
 #include <utility>
 #include <set>
+#include <memory>
+#include <mutex>
 
 #include <assets/Assets.h>
 #include <interfaces/Task.h>
@@ -19,6 +21,11 @@ class Content;
 class AssetsLoader;
 class Engine;
 
+namespace util {
+     template<class T, class R>
+     class ThreadPool;
+}
+
 namespace gui {
      class GUI;
 }
@@ -101,6 +108,9 @@ private:
 	std::map<AssetType, aloader_func> loaders; ///< Зарегистрированные загрузчики по типам
 	std::queue<aloader_entry> entries; ///< Очередь заданий на загрузку
      std::set<std::pair<AssetType, std::string>> enqueued;
+     /// Общий ограниченный пул для параллельных частей загрузчиков
+     std::unique_ptr<util::ThreadPool<runnable, int>> helpers;
+     std::mutex helpersMutex;
 
 	const ResPaths& paths; ///< Пути для поиска файлов
 
@@ -117,6 +127,7 @@ public:
      * @param paths Объект с путями (не должен быть nullptr).
      */
 	AssetsLoader(Engine& engine, Assets& assets, const ResPaths& paths);
+     ~AssetsLoader();
 
 	/**
      * @brief Регистрирует функцию-загрузчик для указанного типа ресурса.
@@ -177,6 +188,16 @@ public:
           const std::vector<io::path>& alternatives
      );
 
+     /**
+      * @brief Вызывает func для индексов [0, count) параллельно.
+      *
+      * Вызывающий поток выполняет вызовы вместе с общим пулом помощников,
+      * число потоков которого ограничено половиной ядер, поэтому загрузчики
+      * из пула загрузки не умножают число потоков. Возвращается, когда
+      * выполнены все вызовы; первое исключение выбрасывается после этого.
+      */
+     void parallelFor(size_t count, const consumer<size_t>& func);
+
      Assets& getAssets();
      Engine& getEngine();
 };
@@ -1,5 +1,6 @@
 #include <assets/asset_loaders.h>
 
+#include <set>
 #include <filesystem>
 #include <stdexcept>
 #include <array>
@@ -178,33 +179,81 @@ asset_loader::postfunc asset_loader::posteffect(
 }
 
 /**
- * Вспомогательная функция для добавления одного изображения в строитель атласа.
- * Проверяет расширение .png, уникальность имени и загружает изображение.
+ * Загружает изображение элемента атласа.
  * При необходимости конвертирует в формат RGBA и исправляет альфа-канал.
  */
-static bool append_atlas(AtlasBuilder& atlas, const io::path& file) {
-    std::string name = file.stem();
-    if (atlas.has(name)) return false;
-
-    // Загружаем изображение
+static std::unique_ptr<ImageData> read_atlas_image(const io::path& file) {
     auto image = imageio::read(file);
     if (image == nullptr) {
-        logger.error() << "Failed to load atlas entry '" << name << "'";
-        return false;
+        return nullptr;
     }
-
     // Если формат не RGBA, конвертируем
     if (image->getFormat() != ImageFormat::rgba8888) image.reset(toRGBA(image.get())); 
 
     // Исправляем "чёрный" альфа-канал
     image->fixAlphaColor(); 
+    return image;
+}
+
+/**
+ * Вспомогательная функция для добавления одного изображения в строитель атласа.
+ * Проверяет расширение .png, уникальность имени и загружает изображение.
+ */
+static bool append_atlas(AtlasBuilder& atlas, const io::path& file) {
+    std::string name = file.stem();
+    if (atlas.has(name)) return false;
 
+    auto image = read_atlas_image(file);
+    if (image == nullptr) {
+        logger.error() << "Failed to load atlas entry '" << name << "'";
+        return false;
+    }
     // Добавляем изображение в строитель атласа
     atlas.add(name, std::move(image));
 
     return true;
 }
 
+/// Меньшее число изображений декодируется в вызывающем потоке
+inline constexpr size_t MIN_PARALLEL_ATLAS_IMAGES = 32;
+
+/**
+ * Декодирует изображения атласа параллельно в общем пуле загрузчика
+ * и добавляет их в строитель в исходном порядке. Первая ошибка
+ * декодирования выбрасывается после завершения всех заданий.
+ */
+static void append_atlas_files(
+    AssetsLoader& loader,
+    AtlasBuilder& atlas,
+    const std::vector<io::path>& files
+) {
+    std::vector<io::path> unique;
+    std::set<std::string> names;
+    for (const auto& file : files) {
+        if (!atlas.has(file.stem()) && names.insert(file.stem()).second) {
+            unique.push_back(file);
+        }
+    }
+    if (unique.size() < MIN_PARALLEL_ATLAS_IMAGES) {
+        for (const auto& file : unique) {
+            append_atlas(atlas, file);
+        }
+        return;
+    }
+    std::vector<std::unique_ptr<ImageData>> images(unique.size());
+    loader.parallelFor(unique.size(), [&](size_t index) {
+        images[index] = read_atlas_image(unique[index]);
+    });
+    for (size_t i = 0; i < unique.size(); ++i) {
+        std::string name = unique[i].stem();
+        if (images[i] == nullptr) {
+            logger.error() << "Failed to load atlas entry '" << name << "'";
+            continue;
+        }
+        atlas.add(name, std::move(images[i]));
+    }
+}
+
 asset_loader::postfunc asset_loader::atlas(
     AssetsLoader* loader,
     const ResPaths& paths, 
@@ -227,14 +276,23 @@ asset_loader::postfunc asset_loader::atlas(
 
     AtlasBuilder builder;
 
-    // Проходим по всем файлам в указанной директории и пытаемся добавить каждый PNG в атлас
+    // Собираем все PNG в указанной директории и декодируем их параллельно
+    std::vector<io::path> files;
     for (auto const& file : paths.listdir(directory)) {
         if (!imageio::is_read_supported(file.extension())) continue;
-        if (!append_atlas(builder, file)) continue;
+        files.push_back(file);
     }
+    append_atlas_files(*loader, builder, files);
 
     std::set<std::string> names = builder.getNames();
-    Atlas* atlas = builder.build(ATLAS_EXTRUSION, false).release();
+    Atlas* atlas = builder.build(
+        ATLAS_EXTRUSION,
+        false,
+        0,
+        [loader](size_t count, const consumer<size_t>& func) {
+            loader->parallelFor(count, func);
+        }
+    ).release();
     return [=](auto assets) {
         atlas->prepare();
         assets->store(std::unique_ptr<Atlas>(atlas), name);
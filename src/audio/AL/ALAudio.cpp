@@ -149,11 +149,17 @@ ALStream::ALStream(
     std::shared_ptr<PCMStream> source,
     bool keepSource
 ) : al(al),
-    source(std::move(source)),
-    keepSource(keepSource) {}
+    source(source),
+    prefetch(std::make_shared<PrefetchStream>(
+        std::move(source), BUFFER_SIZE, PREFETCH_BLOCKS
+    )),
+    keepSource(keepSource) {
+    al->getDecoder().add(prefetch);
+}
 
 ALStream::~ALStream() {
     bindSpeaker(0);
+    prefetch->close();
     source = nullptr;
 
     while (!unusedBuffers.empty()) {
@@ -167,22 +173,28 @@ std::shared_ptr<PCMStream> ALStream::getSource() const {
     return nullptr;
 }
 
-bool ALStream::preloadBuffer(uint buffer, bool loop) {
-    size_t read = source->readFully(this->buffer, BUFFER_SIZE, loop);
-    if (!read) return false;
+bool ALStream::preloadBuffer(uint buffer) {
+    const auto* block = prefetch->front();
+    if (block == nullptr) return false;
     ALenum format = AL::to_al_format(source->getChannels(), source->getBitsPerSample());
-    AL_CHECK(alBufferData(buffer, format, this->buffer, read, source->getSampleRate()));
+    AL_CHECK(alBufferData(
+        buffer, format, block->data.data(), block->size, source->getSampleRate()
+    ));
+    prefetch->pop();
+    al->getDecoder().notify();
     return true;
 }
 
 std::unique_ptr<Speaker> ALStream::createSpeaker(bool loop, int channel) {
-    this->loop = loop;
+    prefetch->setLoop(loop);
     uint free_source = al->getFreeSource();
     if (free_source == 0) return nullptr;
 
+    // Начало декодируется сразу, если декодер ещё не успел
+    prefetch->fill(ALStream::STREAM_BUFFERS);
     for (uint i = 0; i < ALStream::STREAM_BUFFERS; ++i) {
         uint free_buffer = al->getFreeBuffer();
-        if (!preloadBuffer(free_buffer, loop)) {
+        if (!preloadBuffer(free_buffer)) {
             unusedBuffers.push(free_buffer);
         } else {
             AL_CHECK(alSourceQueueBuffers(free_source, 1, &free_buffer));
@@ -230,13 +242,14 @@ void ALStream::unqueueBuffers(uint alsource) {
 
 uint ALStream::enqueueBuffers(uint alsource) {
     uint preloaded = 0;
-    if (!unusedBuffers.empty()) {
+    while (!unusedBuffers.empty()) {
         uint firstBuffer = unusedBuffers.front();
-        if (preloadBuffer(firstBuffer, loop)) {
-            preloaded++;
-            unusedBuffers.pop();
-            AL_CHECK(alSourceQueueBuffers(alsource, 1, &firstBuffer));
+        if (!preloadBuffer(firstBuffer)) {
+            break;
         }
+        preloaded++;
+        unusedBuffers.pop();
+        AL_CHECK(alSourceQueueBuffers(alsource, 1, &firstBuffer));
     }
     return preloaded;
 }
@@ -263,8 +276,12 @@ void ALStream::update(double delta) {
     if (speaker->isStopped() && !alspeaker->manuallyStopped) {
         if (preloaded) {
             speaker->play();
-        } else if (isStopOnEnd()){
+        } else if (isStopOnEnd() && prefetch->isExhausted() &&
+                   prefetch->available() == 0) {
             speaker->stop();
+        } else {
+            // Опустошение буферов: декодер не успел, ждём данных
+            al->getDecoder().notify();
         }
     }
 }
@@ -283,13 +300,14 @@ duration_t ALStream::getTime() const {
 void ALStream::setTime(duration_t time) {
     if (!source->isSeekable()) return;
     uint sample = time * source->getSampleRate();
-    source->seek(sample);
+    prefetch->seek(sample);
     auto alspeaker = dynamic_cast<ALSpeaker*>(audio::get_speaker(this->speaker));
     if (alspeaker) {
         bool paused = alspeaker->isPaused();
         AL_CHECK(alSourceStop(alspeaker->source));
         unqueueBuffers(alspeaker->source);
         totalPlayedSamples = sample;
+        prefetch->fill(1);
         enqueueBuffers(alspeaker->source);
         AL_CHECK(alSourcePlay(alspeaker->source));
         if (paused) {
@@ -14,6 +14,7 @@
 
 #include <audio/audio.h>
 #include <audio/effects.h>
+#include <audio/StreamPrefetch.h>
 #include <typedefs.h>
 
 struct AudioSettings;
@@ -49,20 +50,24 @@ namespace audio {
         std::unique_ptr<Speaker> newInstance(Priority priority, int channel) const override;
     };
 
+    /// @brief Потоковое воспроизведение. Источник декодируется наперёд
+    /// потоком декодирования ALAudio; update только передаёт готовые
+    /// блоки в буферы OpenAL
     class ALStream : public Stream {
     private:
         static inline constexpr size_t BUFFER_SIZE = 44100;
+        /// Число блоков BUFFER_SIZE, декодируемых наперёд
+        static inline constexpr size_t PREFETCH_BLOCKS = 4;
 
         ALAudio* al;
         std::shared_ptr<PCMStream> source;
+        std::shared_ptr<PrefetchStream> prefetch;
         std::queue<uint> unusedBuffers;
         speakerid_t speaker = 0;
         bool keepSource;
-        char buffer[BUFFER_SIZE];
-        bool loop = false;
         bool stopOnEnd = false;
 
-        bool preloadBuffer(uint buffer, bool loop);
+        bool preloadBuffer(uint buffer);
         void unqueueBuffers(uint alsource);
         uint enqueueBuffers(uint alsource);
     public:
@@ -193,6 +198,7 @@ namespace audio {
         uint maxEffectSlots = 64;
 
         const AudioSettings& settings;
+        StreamDecoder decoder;
 
         bool initEffects();
     public:
@@ -215,6 +221,10 @@ namespace audio {
         void freeSource(uint source);
         void freeBuffer(uint buffer);
 
+        StreamDecoder& getDecoder() {
+            return decoder;
+        }
+
         std::unique_ptr<Sound> createSound(std::shared_ptr<PCM> pcm, bool keepPCM) override;
 
         std::unique_ptr<Stream> openStream(std::shared_ptr<PCMStream> stream, bool keepSource) override;
@@ -13,19 +13,23 @@ MemoryPCMStream::MemoryPCMStream(
     bitsPerSample(bitsPerSample) {}
 
 void MemoryPCMStream::feed(util::span<ubyte> bytes) {
+    std::lock_guard lock(mutex);
     buffer.insert(buffer.end(), bytes.begin(), bytes.end());
 }
 
 bool MemoryPCMStream::isOpen() const {
+    std::lock_guard lock(mutex);
     return open;
 }
 
 void MemoryPCMStream::close() {
+    std::lock_guard lock(mutex);
     open = false;
     buffer = {};
 }
 
 size_t MemoryPCMStream::read(char* dst, size_t bufferSize) {
+    std::lock_guard lock(mutex);
     if (!open || buffer.empty()) return PCMStream::ERR;
 
     size_t count = std::min<size_t>(bufferSize, buffer.size());
@@ -61,5 +65,6 @@ bool MemoryPCMStream::isSeekable() const {
 void MemoryPCMStream::seek(size_t position) {}
 
 size_t MemoryPCMStream::available() const {
+    std::lock_guard lock(mutex);
     return buffer.size();
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include <audio/audio.h>
 #include <util/span.h>
 
 namespace audio {
+    /// @brief Поток PCM из данных, подаваемых извне. Подача и чтение
+    /// возможны из разных потоков (чтение - в потоке декодирования)
     class MemoryPCMStream : public PCMStream {
     public:
         MemoryPCMStream(uint sampleRate, uint channels, uint bitsPerSample);
@@ -39,6 +42,7 @@ namespace audio {
         uint bitsPerSample;
         bool open = true;
 
+        mutable std::mutex mutex;
         std::vector<ubyte> buffer;
     };
 }
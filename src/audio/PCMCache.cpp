@@ -0,0 +1,72 @@
+#include <audio/PCMCache.h>
+
+using namespace audio;
+
+PCMCache::PCMCache(size_t capacity) : capacity(capacity) {
+}
+
+void PCMCache::evict(size_t limit) {
+    while (memoryUsage > limit && !entries.empty()) {
+        const auto& [key, pcm] = entries.back();
+        memoryUsage -= pcm->data.size();
+        index.erase(key);
+        entries.pop_back();
+    }
+}
+
+std::shared_ptr<PCM> PCMCache::get(const std::string& key) {
+    std::lock_guard lock(mutex);
+    auto found = index.find(key);
+    if (found == index.end()) {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->second;
+}
+
+bool PCMCache::put(const std::string& key, std::shared_ptr<PCM> pcm) {
+    std::lock_guard lock(mutex);
+    size_t size = pcm->data.size();
+    if (size > capacity / 8) {
+        return false;
+    }
+    auto found = index.find(key);
+    if (found != index.end()) {
+        memoryUsage -= found->second->second->data.size();
+        entries.erase(found->second);
+        index.erase(found);
+    }
+    evict(capacity - size);
+    entries.emplace_front(key, std::move(pcm));
+    index[key] = entries.begin();
+    memoryUsage += size;
+    return true;
+}
+
+void PCMCache::setCapacity(size_t capacity) {
+    std::lock_guard lock(mutex);
+    this->capacity = capacity;
+    evict(capacity);
+}
+
+size_t PCMCache::getCapacity() const {
+    std::lock_guard lock(mutex);
+    return capacity;
+}
+
+size_t PCMCache::getMemoryUsage() const {
+    std::lock_guard lock(mutex);
+    return memoryUsage;
+}
+
+size_t PCMCache::size() const {
+    std::lock_guard lock(mutex);
+    return entries.size();
+}
+
+void PCMCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    index.clear();
+    memoryUsage = 0;
+}
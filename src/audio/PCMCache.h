@@ -0,0 +1,47 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <audio/audio.h>
+
+namespace audio {
+    /// @brief Кэш декодированных коротких звуков с вытеснением давно не
+    /// использованных (LRU) при превышении лимита памяти.
+    /// Звук крупнее восьмой части лимита не кэшируется
+    class PCMCache {
+        using Entry = std::pair<std::string, std::shared_ptr<PCM>>;
+
+        mutable std::mutex mutex;
+        /// От недавно использованных к давним
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        size_t capacity;
+        size_t memoryUsage = 0;
+
+        void evict(size_t limit);
+    public:
+        /// @param capacity лимит памяти в байтах
+        explicit PCMCache(size_t capacity);
+
+        /// @return закэшированный PCM или nullptr
+        std::shared_ptr<PCM> get(const std::string& key);
+
+        /// @return false, если звук слишком велик для кэша
+        bool put(const std::string& key, std::shared_ptr<PCM> pcm);
+
+        void setCapacity(size_t capacity);
+
+        size_t getCapacity() const;
+
+        /// @return суммарный размер закэшированных данных в байтах
+        size_t getMemoryUsage() const;
+
+        size_t size() const;
+
+        void clear();
+    };
+}
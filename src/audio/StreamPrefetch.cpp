@@ -0,0 +1,162 @@
+#include <audio/StreamPrefetch.h>
+
+#include <chrono>
+#include <algorithm>
+
+#include <debug/Profiler.h>
+
+using namespace audio;
+
+/// Интервал проверки колец без уведомлений (источники, которые пополняются
+/// извне, как MemoryPCMStream)
+static inline constexpr auto DECODER_POLL_INTERVAL =
+    std::chrono::milliseconds(20);
+
+PrefetchStream::PrefetchStream(
+    std::shared_ptr<PCMStream> source, size_t blockSize, size_t blocksCount
+) : source(std::move(source)), blocks(std::max<size_t>(blocksCount, 1)) {
+    for (auto& block : blocks) {
+        block.data.resize(blockSize);
+    }
+}
+
+size_t PrefetchStream::fill(size_t target) {
+    std::lock_guard lock(sourceMutex);
+    if (closed) {
+        return 0;
+    }
+    size_t decoded = 0;
+    size_t end = tail.load(std::memory_order_relaxed);
+    while (true) {
+        size_t ready = end - head.load(std::memory_order_acquire);
+        if (ready >= blocks.size() || ready >= target) {
+            break;
+        }
+        auto& block = blocks[end % blocks.size()];
+        size_t size = source->readFully(
+            block.data.data(), block.data.size(), loop
+        );
+        if (size == 0) {
+            exhausted = !loop &&
+                        (source->isSeekable() || !source->isOpen());
+            break;
+        }
+        exhausted = false;
+        block.size = size;
+        tail.store(++end, std::memory_order_release);
+        decoded++;
+    }
+    return decoded;
+}
+
+const PCMBlock* PrefetchStream::front() const {
+    size_t index = head.load(std::memory_order_relaxed);
+    if (index == tail.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &blocks[index % blocks.size()];
+}
+
+void PrefetchStream::pop() {
+    size_t index = head.load(std::memory_order_relaxed);
+    if (index != tail.load(std::memory_order_acquire)) {
+        head.store(index + 1, std::memory_order_release);
+    }
+}
+
+void PrefetchStream::seek(size_t position) {
+    std::lock_guard lock(sourceMutex);
+    source->seek(position);
+    exhausted = false;
+    head.store(tail.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+size_t PrefetchStream::available() const {
+    return tail.load(std::memory_order_acquire) -
+           head.load(std::memory_order_relaxed);
+}
+
+void PrefetchStream::setLoop(bool flag) {
+    loop = flag;
+    if (flag) {
+        exhausted = false;
+    }
+}
+
+bool PrefetchStream::isExhausted() const {
+    return exhausted;
+}
+
+void PrefetchStream::close() {
+    closed = true;
+}
+
+bool PrefetchStream::isClosed() const {
+    return closed;
+}
+
+StreamDecoder::StreamDecoder() : thread([this]() { run(); }) {
+}
+
+StreamDecoder::~StreamDecoder() {
+    {
+        std::lock_guard lock(mutex);
+        running = false;
+    }
+    condition.notify_one();
+    thread.join();
+}
+
+void StreamDecoder::add(std::shared_ptr<PrefetchStream> stream) {
+    {
+        std::lock_guard lock(mutex);
+        streams.push_back(std::move(stream));
+        pending = true;
+    }
+    condition.notify_one();
+}
+
+void StreamDecoder::notify() {
+    {
+        std::lock_guard lock(mutex);
+        pending = true;
+    }
+    condition.notify_one();
+}
+
+size_t StreamDecoder::countStreams() {
+    std::lock_guard lock(mutex);
+    return streams.size();
+}
+
+void StreamDecoder::run() {
+    debug::Profiler::setThreadName("audio-decoder");
+
+    std::vector<std::shared_ptr<PrefetchStream>> active;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            condition.wait_for(lock, DECODER_POLL_INTERVAL, [this]() {
+                return pending || !running;
+            });
+            if (!running) {
+                break;
+            }
+            pending = false;
+            streams.erase(
+                std::remove_if(
+                    streams.begin(),
+                    streams.end(),
+                    [](const auto& stream) { return stream->isClosed(); }
+                ),
+                streams.end()
+            );
+            active = streams;
+        }
+        PROFILE_ZONE("audio.decode");
+        for (const auto& stream : active) {
+            stream->fill();
+        }
+        active.clear();
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <condition_variable>
+
+#include <audio/audio.h>
+
+namespace audio {
+    /// @brief Блок декодированных PCM-данных
+    struct PCMBlock {
+        std::vector<char> data;
+        /// Число заполненных байт
+        size_t size = 0;
+    };
+
+    /// @brief Источник PCM, декодируемый наперёд в кольцо блоков.
+    ///
+    /// Блоки пишутся только под sourceMutex (обычно потоком декодирования),
+    /// читаются одним потоком-потребителем (главным) без блокировок
+    class PrefetchStream {
+        std::shared_ptr<PCMStream> source;
+        std::vector<PCMBlock> blocks;
+        /// Счётчики растут монотонно; блок - счётчик % blocks.size()
+        std::atomic<size_t> head {0};
+        std::atomic<size_t> tail {0};
+        std::mutex sourceMutex;
+        std::atomic<bool> loop {false};
+        std::atomic<bool> closed {false};
+        std::atomic<bool> exhausted {false};
+    public:
+        PrefetchStream(
+            std::shared_ptr<PCMStream> source,
+            size_t blockSize,
+            size_t blocksCount
+        );
+
+        /// @brief Декодирует блоки, пока готовых меньше target, кольцо
+        /// не заполнено и источник отдаёт данные
+        /// @return число декодированных блоков
+        size_t fill(size_t target = std::numeric_limits<size_t>::max());
+
+        /// @brief Первый готовый блок или nullptr. Только для потребителя
+        const PCMBlock* front() const;
+
+        /// @brief Возвращает первый блок декодеру. Только для потребителя
+        void pop();
+
+        /// @brief Перематывает источник и отбрасывает готовые блоки.
+        /// Только для потребителя
+        void seek(size_t position);
+
+        /// @return число готовых блоков
+        size_t available() const;
+
+        size_t getCapacity() const {
+            return blocks.size();
+        }
+
+        void setLoop(bool flag);
+
+        /// @brief Источник закончился: последнее чтение без повтора ничего
+        /// не вернуло. Пустой открытый источник без перемотки (данные
+        /// подаются извне) не считается закончившимся
+        bool isExhausted() const;
+
+        /// @brief Отключает поток от декодера
+        void close();
+
+        bool isClosed() const;
+
+        const std::shared_ptr<PCMStream>& getSource() const {
+            return source;
+        }
+    };
+
+    /// @brief Поток декодирования, заполняющий кольца открытых потоков.
+    /// Закрытые потоки забываются при следующем проходе
+    class StreamDecoder {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<std::shared_ptr<PrefetchStream>> streams;
+        bool running = true;
+        bool pending = false;
+        std::thread thread;
+
+        void run();
+    public:
+        StreamDecoder();
+        ~StreamDecoder();
+
+        void add(std::shared_ptr<PrefetchStream> stream);
+
+        /// @brief Будит поток декодирования (например, после освобождения
+        /// блоков); иначе кольца проверяются с небольшим интервалом
+        void notify();
+
+        size_t countStreams();
+    };
+}
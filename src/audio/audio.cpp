@@ -5,6 +5,7 @@
 
 #include <audio/AL/ALAudio.h>
 #include <audio/NoAudio.h>
+#include <audio/PCMCache.h>
 #include <debug/Logger.h>
 #include <coders/wav.h>
 #include <coders/ogg.h>
@@ -22,6 +23,8 @@ namespace audio {
     util::ObjectsKeeper objects_keeper {};
     std::unique_ptr<InputDevice> input_device = nullptr;
     static bool input_enabled = false;
+    /// Декодированные короткие звуки; переживают перезагрузку контента
+    static PCMCache pcm_cache {0};
 }
 
 using namespace audio;
@@ -184,6 +187,10 @@ void audio::initialize(
         }, true));
     }
 
+    objects_keeper.keepAlive(settings.pcmCacheLimit.observe([](auto value) {
+        pcm_cache.setCapacity(static_cast<size_t>(value) << 20);
+    }, true));
+
     objects_keeper.keepAlive(settings.acousticEffects.observe([=](bool value) {
         if (value) return;
         backend->setAcoustics(audio::Acoustics {});
@@ -233,9 +240,17 @@ std::unique_ptr<PCM> audio::load_PCM(const io::path& file, bool headerOnly) {
 }
 
 std::unique_ptr<Sound> audio::load_sound(const io::path& file, bool keepPCM) {
-    std::shared_ptr<PCM> pcm(
-        load_PCM(file, !keepPCM && backend->isDummy())
-    );
+    // Время изменения в ключе: изменённый файл декодируется заново
+    auto key = file.string() + "@" +
+               std::to_string(io::last_write_time(file).time_since_epoch().count());
+    auto pcm = pcm_cache.get(key);
+    if (pcm == nullptr) {
+        bool headerOnly = !keepPCM && backend->isDummy();
+        pcm = load_PCM(file, headerOnly);
+        if (!headerOnly) {
+            pcm_cache.put(key, pcm);
+        }
+    }
     return create_sound(pcm, keepPCM);
 }
 
@@ -536,4 +551,5 @@ void audio::close() {
     delete backend;
     backend = nullptr;
     objects_keeper.clearKeepedObjects();
+    pcm_cache.clear();
 }
@@ -1,5 +1,6 @@
 #include <coders/binary_json.h>
 
+#include <cstring>
 #include <stdexcept>
 
 #include <coders/byte_utils.h>
@@ -10,88 +11,192 @@
 
 using namespace json;
 
-static void to_binary(ByteBuilder& builder, const dv::value& value) {
+BinaryWriter::BinaryWriter(ByteBuilder& builder) : builder(builder) {}
+
+void BinaryWriter::beginObject() {
+    documents.push_back(builder.size());
+    builder.put(BJSON_TYPE_DOCUMENT);
+    builder.putInt32(0);
+}
+
+void BinaryWriter::beginObject(std::string_view key) {
+    putKey(key);
+    beginObject();
+}
+
+void BinaryWriter::endObject() {
+    builder.put(BJSON_END);
+    size_t start = documents.back();
+    documents.pop_back();
+    builder.setInt32(start + 1, builder.size() - start);
+}
+
+void BinaryWriter::beginList() {
+    builder.put(BJSON_TYPE_LIST);
+}
+
+void BinaryWriter::beginList(std::string_view key) {
+    putKey(key);
+    beginList();
+}
+
+void BinaryWriter::endList() {
+    builder.put(BJSON_END);
+}
+
+void BinaryWriter::putKey(std::string_view key) {
+    builder.putCStr(key);
+}
+
+void BinaryWriter::putInteger(dv::integer_t value) {
+    if (value >= 0 && value <= 255) {
+        builder.put(BJSON_TYPE_BYTE);
+        builder.put(value);
+    } else if (value >= INT16_MIN && value <= INT16_MAX) {
+        builder.put(BJSON_TYPE_INT16);
+        builder.putInt16(value);
+    } else if (value >= INT32_MIN && value <= INT32_MAX) {
+        builder.put(BJSON_TYPE_INT32);
+        builder.putInt32(value);
+    } else {
+        builder.put(BJSON_TYPE_INT64);
+        builder.putInt64(value);
+    }
+}
+
+void BinaryWriter::putNumber(dv::number_t value) {
+    builder.put(BJSON_TYPE_NUMBER);
+    builder.putFloat64(value);
+}
+
+void BinaryWriter::putBoolean(bool value) {
+    builder.put(BJSON_TYPE_FALSE + value);
+}
+
+void BinaryWriter::putString(std::string_view value) {
+    builder.put(BJSON_TYPE_STRING);
+    builder.putInt32(value.size());
+    builder.put(reinterpret_cast<const ubyte*>(value.data()), value.size());
+}
+
+void BinaryWriter::putValue(const dv::value& value) {
     switch (value.getType()) {
-        case dv::value_type::None: {
+        case dv::value_type::None:
             throw std::runtime_error("None value is not implemented");
-        } case dv::value_type::Object: {
-            const auto bytes = json::to_binary(value);
-            builder.put(bytes.data(), bytes.size());
+        case dv::value_type::Object:
+            beginObject();
+            for (const auto& [key, elem] : value.asObject()) {
+                put(key, elem);
+            }
+            endObject();
             break;
-        } case dv::value_type::List: {
-            builder.put(BJSON_TYPE_LIST);
-            for (const auto& element : value) {
-                to_binary(builder, element);
+        case dv::value_type::List:
+            beginList();
+            for (const auto& elem : value) {
+                putValue(elem);
             }
-            builder.put(BJSON_END);
+            endList();
             break;
-        } case dv::value_type::Bytes: {
+        case dv::value_type::Bytes: {
             const auto& bytes = value.asBytes();
             builder.put(BJSON_TYPE_BYTES);
             builder.putInt32(bytes.size());
             builder.put(bytes.data(), bytes.size());
             break;
-        } case dv::value_type::Integer: {
-            auto val = value.asInteger();
-            if (val >= 0 && val <= 255) {
-                builder.put(BJSON_TYPE_BYTE);
-                builder.put(val);
-            } else if (val >= INT16_MIN && val <= INT16_MAX){
-                builder.put(BJSON_TYPE_INT16);
-                builder.putInt16(val);
-            } else if (val >= INT32_MIN && val <= INT32_MAX) {
-                builder.put(BJSON_TYPE_INT32);
-                builder.putInt32(val);
-            } else {
-                builder.put(BJSON_TYPE_INT64);
-                builder.putInt64(val);
-            }
-            break;
         }
+        case dv::value_type::Integer:
+            putInteger(value.asInteger());
+            break;
         case dv::value_type::Number:
-            builder.put(BJSON_TYPE_NUMBER);
-            builder.putFloat64(value.asNumber());
+            putNumber(value.asNumber());
             break;
         case dv::value_type::Boolean:
-            builder.put(BJSON_TYPE_FALSE + value.asBoolean());
+            putBoolean(value.asBoolean());
             break;
         case dv::value_type::String:
-            builder.put(BJSON_TYPE_STRING);
-            builder.put(value.asString());
+            putString(value.asString());
             break;
     }
 }
 
 std::vector<ubyte> json::to_binary(const dv::value& object, bool compress) {
-    if (compress) {
-        auto bytes = to_binary(object, false);
-        return zip::compress(bytes.data(), bytes.size());
-    }
     ByteBuilder builder;
-    builder.put(BJSON_TYPE_DOCUMENT);
-    builder.putInt32(0);
-
+    BinaryWriter writer(builder);
+    writer.beginObject();
     for (const auto& [key, value] : object.asObject()) {
-        builder.putCStr(key.c_str());
-        to_binary(builder, value);
+        writer.put(key, value);
     }
-    builder.put(BJSON_END);
+    writer.endObject();
 
-    builder.setInt32(1, builder.size());
+    if (compress) {
+        return zip::compress(builder.data(), builder.size());
+    }
     return builder.build();
 }
 
-static dv::value list_from_binary(ByteReader& reader);
-static dv::value object_from_binary(ByteReader& reader);
+static bool is_compressed(const ubyte* src, size_t size) {
+    return size >= 2 && src[0] == zip::MAGIC[0] && src[1] == zip::MAGIC[1];
+}
+
+BinaryReader::BinaryReader(const ubyte* src, size_t size)
+    : unpacked(
+          is_compressed(src, size) ? zip::decompress(src, size)
+                                   : std::vector<ubyte>()
+      ),
+      reader(
+          is_compressed(src, size) ? unpacked.data() : src,
+          is_compressed(src, size) ? unpacked.size() : size
+      ) {
+}
+
+ubyte BinaryReader::peekType() {
+    return reader.peek();
+}
+
+bool BinaryReader::hasNext() {
+    return reader.peek() != BJSON_END;
+}
+
+static void expect_type(ubyte typecode, ubyte expected) {
+    if (typecode != expected) {
+        throw std::runtime_error(
+            "BJSON type <" + std::to_string(expected) + "> expected, got <" +
+            std::to_string(typecode) + ">"
+        );
+    }
+}
+
+void BinaryReader::beginObject() {
+    expect_type(reader.get(), BJSON_TYPE_DOCUMENT);
+    reader.getInt32();
+}
+
+void BinaryReader::endObject() {
+    expect_type(reader.get(), BJSON_END);
+}
+
+void BinaryReader::beginList() {
+    expect_type(reader.get(), BJSON_TYPE_LIST);
+}
+
+void BinaryReader::endList() {
+    expect_type(reader.get(), BJSON_END);
+}
+
+std::string_view BinaryReader::readKey() {
+    const char* key = reinterpret_cast<const char*>(reader.pointer());
+    const void* end = std::memchr(key, 0, reader.remaining());
+    if (end == nullptr) {
+        throw std::runtime_error("Unterminated key");
+    }
+    size_t length = static_cast<const char*>(end) - key;
+    reader.skip(length + 1);
+    return std::string_view(key, length);
+}
 
-static dv::value value_from_binary(ByteReader& reader) {
+dv::integer_t BinaryReader::readInteger() {
     ubyte typecode = reader.get();
     switch (typecode) {
-        case BJSON_TYPE_DOCUMENT:
-            reader.getInt32();
-            return object_from_binary(reader);
-        case BJSON_TYPE_LIST:
-            return list_from_binary(reader);
         case BJSON_TYPE_BYTE:
             return reader.get();
         case BJSON_TYPE_INT16:
@@ -101,15 +206,81 @@ static dv::value value_from_binary(ByteReader& reader) {
         case BJSON_TYPE_INT64:
             return reader.getInt64();
         case BJSON_TYPE_NUMBER:
-            return reader.getFloat64();
+            return static_cast<dv::integer_t>(reader.getFloat64());
+    }
+    throw std::runtime_error(
+        "BJSON integer expected, got <" + std::to_string(typecode) + ">"
+    );
+}
+
+dv::number_t BinaryReader::readNumber() {
+    if (reader.peek() == BJSON_TYPE_NUMBER) {
+        reader.get();
+        return reader.getFloat64();
+    }
+    return static_cast<dv::number_t>(readInteger());
+}
+
+bool BinaryReader::readBoolean() {
+    ubyte typecode = reader.get();
+    if (typecode != BJSON_TYPE_FALSE && typecode != BJSON_TYPE_TRUE) {
+        throw std::runtime_error(
+            "BJSON boolean expected, got <" + std::to_string(typecode) + ">"
+        );
+    }
+    return typecode == BJSON_TYPE_TRUE;
+}
+
+std::string_view BinaryReader::readString() {
+    expect_type(reader.get(), BJSON_TYPE_STRING);
+    uint32_t length = static_cast<uint32_t>(reader.getInt32());
+    if (length > reader.remaining()) {
+        throw std::runtime_error("Buffer underflow");
+    }
+    auto chars = reinterpret_cast<const char*>(reader.pointer());
+    reader.skip(length);
+    return std::string_view(chars, length);
+}
+
+dv::value BinaryReader::readValue() {
+    ubyte typecode = reader.peek();
+    switch (typecode) {
+        case BJSON_TYPE_DOCUMENT: {
+            beginObject();
+            auto obj = dv::object();
+            while (hasNext()) {
+                auto key = readKey();
+                obj[key] = readValue();
+            }
+            endObject();
+            return obj;
+        }
+        case BJSON_TYPE_LIST: {
+            beginList();
+            auto list = dv::list();
+            while (hasNext()) {
+                list.add(readValue());
+            }
+            endList();
+            return list;
+        }
+        case BJSON_TYPE_BYTE:
+        case BJSON_TYPE_INT16:
+        case BJSON_TYPE_INT32:
+        case BJSON_TYPE_INT64:
+            return readInteger();
+        case BJSON_TYPE_NUMBER:
+            return readNumber();
         case BJSON_TYPE_FALSE:
         case BJSON_TYPE_TRUE:
-            return (typecode - BJSON_TYPE_FALSE) != 0;
+            return readBoolean();
         case BJSON_TYPE_STRING:
-            return reader.getString();
+            return std::string(readString());
         case BJSON_TYPE_NULL:
+            reader.get();
             return nullptr;
         case BJSON_TYPE_BYTES: {
+            reader.get();
             int32_t size = reader.getInt32();
             if (size < 0) {
                 throw std::runtime_error("Invalid byte-buffer size " + std::to_string(size));
@@ -125,35 +296,55 @@ static dv::value value_from_binary(ByteReader& reader) {
     throw std::runtime_error("Type support not implemented for <" + std::to_string(typecode) + ">");
 }
 
-static dv::value list_from_binary(ByteReader& reader) {
-    auto list = dv::list();
-    while (reader.peek() != BJSON_END) {
-        list.add(value_from_binary(reader));
-    }
-    reader.get();
-    return list;
-}
-
-static dv::value object_from_binary(ByteReader& reader) {
-    auto obj = dv::object();
-    while (reader.peek() != BJSON_END) {
-        const char* key = reader.getCString();
-        obj[key] = value_from_binary(reader);
+void BinaryReader::skipValue() {
+    size_t start = reader.position();
+    ubyte typecode = reader.get();
+    switch (typecode) {
+        case BJSON_TYPE_DOCUMENT: {
+            int32_t size = reader.getInt32();
+            if (size < 6) {
+                throw std::runtime_error("Invalid document size " + std::to_string(size));
+            }
+            reader.seek(start + size);
+            return;
+        }
+        case BJSON_TYPE_LIST:
+            while (hasNext()) {
+                skipValue();
+            }
+            reader.get();
+            return;
+        case BJSON_TYPE_BYTE:
+            reader.seek(start + 2);
+            return;
+        case BJSON_TYPE_INT16:
+            reader.seek(start + 3);
+            return;
+        case BJSON_TYPE_INT32:
+            reader.seek(start + 5);
+            return;
+        case BJSON_TYPE_INT64:
+        case BJSON_TYPE_NUMBER:
+            reader.seek(start + 9);
+            return;
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+        case BJSON_TYPE_NULL:
+            return;
+        case BJSON_TYPE_STRING:
+        case BJSON_TYPE_BYTES: {
+            uint32_t length = static_cast<uint32_t>(reader.getInt32());
+            reader.seek(reader.position() + length);
+            return;
+        }
     }
-    reader.get();
-    return obj;
+    throw std::runtime_error("Type support not implemented for <" + std::to_string(typecode) + ">");
 }
 
 dv::value json::from_binary(const ubyte* src, size_t size) {
     if (size < 2) {
         throw std::runtime_error("Bytes length is less than 2");
     }
-
-    if (src[0] == zip::MAGIC[0] && src[1] == zip::MAGIC[1]) {
-        auto data = zip::decompress(src, size);
-        return from_binary(data.data(), data.size());
-    } else {
-        ByteReader reader(src, size);
-        return value_from_binary(reader);
-    }
+    BinaryReader reader(src, size);
+    return reader.readValue();
 }
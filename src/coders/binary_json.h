@@ -2,7 +2,10 @@
 
 #include <vector>
 #include <memory>
+#include <string_view>
+#include <type_traits>
 
+#include <coders/byte_utils.h>
 #include <data/dv.h>
 #include <typedefs.h>
 
@@ -24,4 +27,148 @@ namespace json {
 
     std::vector<ubyte> to_binary(const dv::value& obj, bool compress = false);
     dv::value from_binary(const ubyte* src, size_t size);
+
+    /// @brief Потоковая запись BJSON в ByteBuilder без промежуточного
+    /// дерева dv::value.
+    ///
+    /// Размеры документов дописываются при их закрытии.
+    /// Пример:
+    /// @code
+    /// writer.beginObject();
+    /// writer.put("id", 1);
+    /// writer.beginList("slots");
+    /// writer.add(42);
+    /// writer.endList();
+    /// writer.endObject();
+    /// @endcode
+    class BinaryWriter {
+    public:
+        explicit BinaryWriter(ByteBuilder& builder);
+
+        /// @brief Открывает объект: корневой документ или элемент списка
+        void beginObject();
+        void beginObject(std::string_view key);
+        void endObject();
+
+        /// @brief Открывает список-элемент другого списка
+        void beginList();
+        void beginList(std::string_view key);
+        void endList();
+
+        /// @brief Записывает ключ поля текущего объекта. Значение
+        /// записывается следующим вызовом (например, beginObject())
+        void putKey(std::string_view key);
+
+        /// @brief Записывает поле текущего объекта
+        template<typename T>
+        void put(std::string_view key, const T& value) {
+            putKey(key);
+            add(value);
+        }
+
+        /// @brief Записывает элемент текущего списка
+        template<typename T>
+        void add(const T& value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                putBoolean(value);
+            } else if constexpr (std::is_integral_v<T>) {
+                putInteger(value);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                putNumber(value);
+            } else if constexpr (std::is_same_v<T, dv::value>) {
+                putValue(value);
+            } else {
+                putString(value);
+            }
+        }
+
+        /// @brief Записывает вектор или матрицу glm плоским списком чисел
+        template<typename T>
+        void addVec(const T& vec) {
+            using V = typename T::value_type;
+            const auto* values = reinterpret_cast<const V*>(&vec);
+            builder.put(BJSON_TYPE_LIST);
+            for (size_t i = 0; i < sizeof(T) / sizeof(V); ++i) {
+                putNumber(values[i]);
+            }
+            builder.put(BJSON_END);
+        }
+
+        template<typename T>
+        void putVec(std::string_view key, const T& vec) {
+            putKey(key);
+            addVec(vec);
+        }
+    private:
+        ByteBuilder& builder;
+        std::vector<size_t> documents;
+
+        void putInteger(dv::integer_t value);
+        void putNumber(dv::number_t value);
+        void putBoolean(bool value);
+        void putString(std::string_view value);
+        void putValue(const dv::value& value);
+    };
+
+    /// @brief Потоковое чтение BJSON без построения дерева dv::value.
+    ///
+    /// Сжатые данные распаковываются при создании. Строки и ключи
+    /// возвращаются как участки буфера и действительны, пока жив читатель
+    /// (или исходный буфер, если данные не были сжаты).
+    class BinaryReader {
+    public:
+        BinaryReader(const ubyte* src, size_t size);
+        BinaryReader(const BinaryReader&) = delete;
+
+        /// @return код типа следующего значения (BJSON_TYPE_*)
+        ubyte peekType();
+
+        /// @return true, если в текущем объекте или списке есть ещё элементы
+        bool hasNext();
+
+        void beginObject();
+        void endObject();
+        void beginList();
+        void endList();
+
+        /// @brief Читает ключ следующего поля объекта
+        std::string_view readKey();
+
+        dv::integer_t readInteger();
+        dv::number_t readNumber();
+        bool readBoolean();
+        std::string_view readString();
+        /// @brief Читает значение любого типа целиком
+        dv::value readValue();
+        /// @brief Пропускает значение; документы пропускаются по размеру
+        void skipValue();
+
+        /// @brief Читает список чисел в вектор или матрицу glm
+        template<typename T>
+        void readVec(T& vec) {
+            using V = typename T::value_type;
+            auto* values = reinterpret_cast<V*>(&vec);
+            size_t count = sizeof(T) / sizeof(V);
+            beginList();
+            for (size_t i = 0; hasNext(); ++i) {
+                if (i < count) {
+                    values[i] = readNumber();
+                } else {
+                    skipValue();
+                }
+            }
+            endList();
+        }
+
+        size_t position() const {
+            return reader.position();
+        }
+
+        void seek(size_t position) {
+            reader.seek(position);
+        }
+    private:
+        std::vector<ubyte> unpacked;
+        ByteReader reader;
+    };
 }
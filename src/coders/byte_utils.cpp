@@ -19,10 +19,12 @@ void ByteBuilder::put(ubyte b) {
 
 void ByteBuilder::putCStr(const char* str) {
     size_t size = std::strlen(str) + 1; // включаем завершающий нуль
-    buffer.reserve(buffer.size() + size);
-    for (size_t i = 0; i < size; ++i) {
-        buffer.push_back(str[i]);
-    }
+    buffer.insert(buffer.end(), str, str + size);
+}
+
+void ByteBuilder::putCStr(std::string_view str) {
+    buffer.insert(buffer.end(), str.begin(), str.end());
+    buffer.push_back(0);
 }
 
 void ByteBuilder::put(const std::string& s) {
@@ -33,10 +35,9 @@ void ByteBuilder::put(const std::string& s) {
 }
 
 void ByteBuilder::put(const ubyte* arr, size_t size) {
-    buffer.reserve(buffer.size() + size);
-    for (size_t i = 0; i < size; ++i) {
-        buffer.push_back(arr[i]);
-    }
+    // insert сохраняет геометрический рост ёмкости, в отличие от
+    // reserve под точный размер перед каждой записью
+    buffer.insert(buffer.end(), arr, arr + size);
 }
 
 void ByteBuilder::putInt16(int16_t val, bool bigEndian) {
@@ -95,6 +96,10 @@ std::vector<ubyte> ByteBuilder::build() {
     return buffer;
 }
 
+void ByteBuilder::clear() {
+    buffer.clear();
+}
+
 // ========== ByteReader ==========
 
 ByteReader::ByteReader(const ubyte* data, size_t size) : data(data), size(size), pos(0) {
@@ -219,3 +224,14 @@ const ubyte* ByteReader::pointer() const {
 void ByteReader::skip(size_t n) {
     pos += n;
 }
+
+size_t ByteReader::position() const {
+    return pos;
+}
+
+void ByteReader::seek(size_t position) {
+    if (position > size) {
+        throw std::runtime_error("Buffer underflow");
+    }
+    pos = position;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <typedefs.h>
@@ -30,6 +31,12 @@ public:
      */
     void putCStr(const char* str);
 
+    /**
+     * @brief Записывает строку как C-строку (с завершающим нулевым байтом).
+     * @param str Строка без нулевых байт.
+     */
+    void putCStr(std::string_view str);
+
     /**
      * @brief Записывает знаковое 16‑битное целое.
      * @param val Значение.
@@ -122,6 +129,12 @@ public:
      * @return Копия внутреннего буфера.
      */
     std::vector<ubyte> build();
+
+    /**
+     * @brief Очищает буфер, сохраняя выделенную память для повторного
+     * использования.
+     */
+    void clear();
 };
 
 /**
@@ -245,4 +258,16 @@ public:
      * @param n Число байт для пропуска.
      */
     void skip(size_t n);
+
+    /**
+     * @brief Возвращает текущую позицию чтения.
+     */
+    size_t position() const;
+
+    /**
+     * @brief Перемещает позицию чтения.
+     * @param position Новая позиция (не больше размера буфера).
+     * @throw std::runtime_error При выходе за границы буфера.
+     */
+    void seek(size_t position);
 };
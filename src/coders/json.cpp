@@ -6,6 +6,7 @@
 #include <memory>
 
 #include <coders/BasicParser.h>
+#include <coders/json_structural.h>
 #include <debug/Logger.h>
 #include <util/stringutil.h>
 
@@ -13,6 +14,9 @@ using namespace json;
 
 static debug::Logger logger("json");
 
+/// Индекс большего размера освобождается перед разбором следующего документа
+inline constexpr size_t MAX_RETAINED_POSITIONS = 1 << 20;
+
 namespace {
     class Parser : BasicParser<char> {
     public:
@@ -23,6 +27,42 @@ namespace {
         dv::value parseList();
         dv::value parseObject();
         dv::value parseValue();
+        std::string_view parseKey(std::string& buffer);
+    };
+
+    /// Документ не разбирается по структурному индексу; причина
+    /// (и сообщение об ошибке) определяется полным разбором Parser
+    struct fallback_required {};
+
+    /// @brief Вторая стадия разбора: построение dv::value по структурному
+    /// индексу. Числа сложнее целых и строки с экранированием
+    /// разбираются средствами BasicParser, поэтому результат совпадает
+    /// с результатом Parser
+    class IndexedParser : BasicParser<char> {
+    public:
+        IndexedParser(
+            std::string_view filename,
+            std::string_view source,
+            const std::vector<uint32_t>& positions
+        );
+
+        dv::value parse();
+    private:
+        const std::vector<uint32_t>& positions;
+        size_t current = 0;
+
+        /// Позиция следующего структурного символа
+        uint32_t take();
+        char peekStructural() const;
+        /// Конец токена, начинающегося в позиции текущего структурного
+        /// символа (без завершающих пробелов)
+        uint32_t tokenEnd(uint32_t start) const;
+
+        dv::value parseList();
+        dv::value parseObject();
+        dv::value parseValue();
+        dv::value parseScalar(uint32_t start);
+        std::string_view parseStringToken(uint32_t start, std::string& buffer);
     };
 }
 
@@ -184,13 +224,14 @@ dv::value Parser::parse() {
 dv::value Parser::parseObject() {
     expect('{');
     auto object = dv::object();
+    std::string keyBuffer;
     while (peek() != '}') {
         if (peek() == '#') {
             skipLine();
             continue;
         }
         expect('"');
-        std::string key = parseString('"');
+        auto key = parseKey(keyBuffer);
         char next = peek();
         if (next != ':') {
             logger.error() << "':' expected";
@@ -212,6 +253,19 @@ dv::value Parser::parseObject() {
     return object;
 }
 
+/// Ключ без экранирования возвращается как участок исходного текста,
+/// без промежуточной строки
+std::string_view Parser::parseKey(std::string& buffer) {
+    size_t end = source.find_first_of("\"\\", pos);
+    if (end != std::string_view::npos && source[end] == '"') {
+        auto key = source.substr(pos, end - pos);
+        pos = end + 1;
+        return key;
+    }
+    buffer = parseString('"');
+    return buffer;
+}
+
 dv::value Parser::parseList() {
     expect('[');
     auto list = dv::list();
@@ -275,9 +329,204 @@ dv::value Parser::parseValue() {
     throw error("Unexpected character '" + std::string({next}) + "'");
 }
 
+IndexedParser::IndexedParser(
+    std::string_view filename,
+    std::string_view source,
+    const std::vector<uint32_t>& positions
+) : BasicParser(filename, source), positions(positions) {}
+
+uint32_t IndexedParser::take() {
+    if (current >= positions.size()) {
+        throw fallback_required {};
+    }
+    return positions[current++];
+}
+
+char IndexedParser::peekStructural() const {
+    if (current >= positions.size()) {
+        throw fallback_required {};
+    }
+    return source[positions[current]];
+}
+
+uint32_t IndexedParser::tokenEnd(uint32_t start) const {
+    uint32_t end = current < positions.size() ? positions[current]
+                                              : source.size();
+    while (end > start && is_whitespace(source[end - 1])) {
+        end--;
+    }
+    return end;
+}
+
+dv::value IndexedParser::parse() {
+    char next = peekStructural();
+    if (next == '{') {
+        return parseObject();
+    } else if (next == '[') {
+        return parseList();
+    }
+    throw fallback_required {};
+}
+
+dv::value IndexedParser::parseObject() {
+    take();
+    auto object = dv::object();
+    if (peekStructural() == '}') {
+        current++;
+        return object;
+    }
+    std::string keyBuffer;
+    while (true) {
+        uint32_t start = take();
+        if (source[start] != '"') {
+            throw fallback_required {};
+        }
+        auto key = parseStringToken(start, keyBuffer);
+        if (source[take()] != ':') {
+            throw fallback_required {};
+        }
+        object[key] = parseValue();
+
+        char next = source[take()];
+        if (next == ',') {
+            if (peekStructural() == '}') {
+                current++;
+                break;
+            }
+        } else if (next == '}') {
+            break;
+        } else {
+            throw fallback_required {};
+        }
+    }
+    return object;
+}
+
+dv::value IndexedParser::parseList() {
+    take();
+    auto list = dv::list();
+    if (peekStructural() == ']') {
+        current++;
+        return list;
+    }
+    while (true) {
+        list.add(parseValue());
+
+        char next = source[take()];
+        if (next == ',') {
+            if (peekStructural() == ']') {
+                current++;
+                break;
+            }
+        } else if (next == ']') {
+            break;
+        } else {
+            throw fallback_required {};
+        }
+    }
+    return list;
+}
+
+dv::value IndexedParser::parseValue() {
+    char next = peekStructural();
+    if (next == '{') {
+        return parseObject();
+    }
+    if (next == '[') {
+        return parseList();
+    }
+    uint32_t start = take();
+    if (next == '"') {
+        std::string buffer;
+        auto string = parseStringToken(start, buffer);
+        if (string.data() == buffer.data()) {
+            return buffer;
+        }
+        return std::string(string);
+    }
+    return parseScalar(start);
+}
+
+dv::value IndexedParser::parseScalar(uint32_t start) {
+    uint32_t end = tokenEnd(start);
+    auto token = source.substr(start, end - start);
+    char first = token[0];
+    if (first == '-' || first == '+' || is_digit(first)) {
+        // Десятичные целые разбираются на месте
+        size_t digitsStart = first == '-' || first == '+';
+        size_t length = token.size() - digitsStart;
+        if (length > 0 && length <= 18) {
+            int64_t value = 0;
+            size_t i = digitsStart;
+            for (; i < token.size() && is_digit(token[i]); ++i) {
+                value = value * 10 + (token[i] - '0');
+            }
+            if (i == token.size()) {
+                return first == '-' ? -value : value;
+            }
+        }
+        pos = start;
+        auto numeric = parseNumber();
+        if (pos != end) {
+            throw fallback_required {};
+        }
+        if (numeric.isInteger()) {
+            return numeric.asInteger();
+        }
+        return numeric.asNumber();
+    }
+    if (token == "true") {
+        return true;
+    } else if (token == "false") {
+        return false;
+    } else if (token == "null") {
+        return nullptr;
+    } else if (token == "inf") {
+        return INFINITY;
+    } else if (token == "nan") {
+        return NAN;
+    }
+    throw fallback_required {};
+}
+
+/// Строка без экранирования возвращается как участок исходного текста
+std::string_view IndexedParser::parseStringToken(
+    uint32_t start, std::string& buffer
+) {
+    // После закрывающей кавычки до следующего структурного символа
+    // могут быть только пробелы
+    uint32_t end = tokenEnd(start);
+    if (end <= start + 1 || source[end - 1] != '"') {
+        throw fallback_required {};
+    }
+    auto content = source.substr(start + 1, end - start - 2);
+    if (content.find_first_of("\\\n") == std::string_view::npos) {
+        return content;
+    }
+    pos = start + 1;
+    buffer = parseString('"');
+    if (pos != end) {
+        throw fallback_required {};
+    }
+    return buffer;
+}
+
 dv::value json::parse(
     std::string_view filename, std::string_view source
 ) {
+    thread_local StructuralIndex index;
+    if (index.positions.capacity() > MAX_RETAINED_POSITIONS) {
+        index.positions = {};
+    }
+    build_structural_index(source, index);
+    if (!index.requiresFallback) {
+        try {
+            IndexedParser parser(filename, source, index.positions);
+            return parser.parse();
+        } catch (const fallback_required&) {
+        } catch (const parsing_error&) {
+        }
+    }
     Parser parser(filename, source);
     return parser.parse();
 }
@@ -0,0 +1,226 @@
+#include <coders/json_structural.h>
+
+#include <array>
+#include <limits>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define JSON_STRUCTURAL_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace json;
+
+inline constexpr size_t BLOCK_SIZE = 64;
+
+namespace {
+    /// Битовые маски классов символов блока (бит i - символ i)
+    struct BlockMasks {
+        uint64_t quote;
+        uint64_t backslash;
+        /// {}[]:,
+        uint64_t op;
+        uint64_t whitespace;
+        /// Символы расширений формата: '#' и '\''
+        uint64_t extension;
+    };
+
+    inline int trailing_zeros(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+#ifdef JSON_STRUCTURAL_SSE2
+    inline uint64_t movemask(const __m128i (&masks)[4]) {
+        return static_cast<uint64_t>(_mm_movemask_epi8(masks[0])) |
+               static_cast<uint64_t>(_mm_movemask_epi8(masks[1])) << 16 |
+               static_cast<uint64_t>(_mm_movemask_epi8(masks[2])) << 32 |
+               static_cast<uint64_t>(_mm_movemask_epi8(masks[3])) << 48;
+    }
+
+    void classify(const char* block, BlockMasks& masks) {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        // '[' и ']' отличаются от '{' и '}' только битом 0x20
+        const __m128i lowerBit = _mm_set1_epi8(0x20);
+        const __m128i openBrace = _mm_set1_epi8('{');
+        const __m128i closeBrace = _mm_set1_epi8('}');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        const __m128i formfeed = _mm_set1_epi8('\f');
+        const __m128i hash = _mm_set1_epi8('#');
+        const __m128i apostrophe = _mm_set1_epi8('\'');
+
+        __m128i quotes[4], backslashes[4], ops[4], spaces[4], extensions[4];
+        for (int i = 0; i < 4; ++i) {
+            __m128i chars = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(block + i * 16)
+            );
+            __m128i lowered = _mm_or_si128(chars, lowerBit);
+            quotes[i] = _mm_cmpeq_epi8(chars, quote);
+            backslashes[i] = _mm_cmpeq_epi8(chars, backslash);
+            ops[i] = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(lowered, openBrace),
+                    _mm_cmpeq_epi8(lowered, closeBrace)
+                ),
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(chars, colon), _mm_cmpeq_epi8(chars, comma)
+                )
+            );
+            spaces[i] = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)
+                ),
+                _mm_or_si128(
+                    _mm_or_si128(
+                        _mm_cmpeq_epi8(chars, newline),
+                        _mm_cmpeq_epi8(chars, carriage)
+                    ),
+                    _mm_cmpeq_epi8(chars, formfeed)
+                )
+            );
+            extensions[i] = _mm_or_si128(
+                _mm_cmpeq_epi8(chars, hash), _mm_cmpeq_epi8(chars, apostrophe)
+            );
+        }
+        masks.quote = movemask(quotes);
+        masks.backslash = movemask(backslashes);
+        masks.op = movemask(ops);
+        masks.whitespace = movemask(spaces);
+        masks.extension = movemask(extensions);
+    }
+#else
+    enum CharClass : ubyte {
+        CLASS_QUOTE = 1,
+        CLASS_BACKSLASH = 2,
+        CLASS_OP = 4,
+        CLASS_WHITESPACE = 8,
+        CLASS_EXTENSION = 16,
+    };
+
+    constexpr auto CHAR_CLASSES = []() {
+        std::array<ubyte, 256> table {};
+        table['"'] = CLASS_QUOTE;
+        table['\\'] = CLASS_BACKSLASH;
+        for (char c : {'{', '}', '[', ']', ':', ','}) {
+            table[static_cast<ubyte>(c)] = CLASS_OP;
+        }
+        for (char c : {' ', '\t', '\n', '\r', '\f'}) {
+            table[static_cast<ubyte>(c)] = CLASS_WHITESPACE;
+        }
+        table['#'] = CLASS_EXTENSION;
+        table['\''] = CLASS_EXTENSION;
+        return table;
+    }();
+
+    void classify(const char* block, BlockMasks& masks) {
+        masks = {};
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            ubyte cls = CHAR_CLASSES[static_cast<ubyte>(block[i])];
+            if (cls == 0) continue;
+            uint64_t bit = 1ULL << i;
+            if (cls & CLASS_QUOTE) masks.quote |= bit;
+            if (cls & CLASS_BACKSLASH) masks.backslash |= bit;
+            if (cls & CLASS_OP) masks.op |= bit;
+            if (cls & CLASS_WHITESPACE) masks.whitespace |= bit;
+            if (cls & CLASS_EXTENSION) masks.extension |= bit;
+        }
+    }
+#endif
+
+    /// Бит i результата - чётность числа установленных битов 0..i
+    inline uint64_t prefix_xor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /// @brief Находит экранированные символы (следующие за нечётной
+    /// последовательностью обратных слешей)
+    /// @param prevEscaped экранирован ли первый символ следующего блока
+    inline uint64_t find_escaped(uint64_t backslash, uint64_t& prevEscaped) {
+        constexpr uint64_t EVEN_BITS = 0x5555555555555555ULL;
+
+        backslash &= ~prevEscaped;
+        uint64_t followsEscape = backslash << 1 | prevEscaped;
+        uint64_t oddSequenceStarts = backslash & ~EVEN_BITS & ~followsEscape;
+        uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+        prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts;
+        uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+        return (EVEN_BITS ^ invertMask) & followsEscape;
+    }
+}
+
+void json::build_structural_index(
+    std::string_view source, StructuralIndex& index
+) {
+    auto& positions = index.positions;
+    positions.clear();
+    index.requiresFallback = false;
+    if (source.size() >= std::numeric_limits<uint32_t>::max()) {
+        index.requiresFallback = true;
+        return;
+    }
+    positions.reserve(source.size() / 4 + 1);
+
+    uint64_t prevEscaped = 0;
+    uint64_t prevInString = 0;
+    uint64_t prevScalar = 0;
+    char tail[BLOCK_SIZE];
+    for (size_t offset = 0; offset < source.size(); offset += BLOCK_SIZE) {
+        const char* block = source.data() + offset;
+        if (source.size() - offset < BLOCK_SIZE) {
+            std::memset(tail, ' ', BLOCK_SIZE);
+            std::memcpy(tail, block, source.size() - offset);
+            block = tail;
+        }
+        BlockMasks masks;
+        classify(block, masks);
+
+        uint64_t escaped = find_escaped(masks.backslash, prevEscaped);
+        uint64_t quote = masks.quote & ~escaped;
+        // Открывающая кавычка входит в строку, закрывающая - нет
+        uint64_t inString = prefix_xor(quote) ^ prevInString;
+        prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+        uint64_t outside = ~inString & ~quote;
+        if (masks.extension & outside) {
+            index.requiresFallback = true;
+            return;
+        }
+        uint64_t scalar = outside & ~masks.op & ~masks.whitespace;
+        uint64_t scalarStarts = scalar & ~(scalar << 1 | prevScalar);
+        prevScalar = scalar >> 63;
+
+        uint64_t structurals =
+            (masks.op & outside) | (quote & inString) | scalarStarts;
+        while (structurals) {
+            positions.push_back(
+                static_cast<uint32_t>(offset + trailing_zeros(structurals))
+            );
+            structurals &= structurals - 1;
+        }
+    }
+    if (prevInString) {
+        index.requiresFallback = true;
+    }
+}
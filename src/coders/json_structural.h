@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+
+#include <typedefs.h>
+
+namespace json {
+    /// @brief Результат первой стадии разбора JSON
+    struct StructuralIndex {
+        /// Позиции символов {}[]:, вне строк, открывающих кавычек строк
+        /// и первых символов скалярных значений (чисел, литералов)
+        std::vector<uint32_t> positions;
+        /// Документ нельзя разобрать по индексу: используются расширения
+        /// формата (комментарии '#', строки в одинарных кавычках),
+        /// есть незакрытая строка или документ слишком велик
+        bool requiresFallback = false;
+    };
+
+    /// @brief Строит структурный индекс документа, обрабатывая его блоками
+    /// по 64 байта (с SSE2 там, где он доступен)
+    void build_structural_index(std::string_view source, StructuralIndex& index);
+}
@@ -19,7 +19,8 @@ static debug::Logger logger("png-coder");
 
 std::unique_ptr<ImageData> png::loadImage(const ubyte* bytes, size_t size, bool flipVertically) {
     int width, height, channels;
-    stbi_set_flip_vertically_on_load(flipVertically);
+    // Флаг потоковый: изображения декодируются в нескольких потоках
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
     stbi_uc* data = stbi_load_from_memory(bytes, static_cast<int>(size), &width, &height, &channels, 4);
     if (!data) {
         const char* error_msg = stbi_failure_reason();
@@ -38,6 +38,10 @@ inline constexpr int CHUNK_HEIGHT = 256;
 inline constexpr int CHUNK_DEPTH = 16;
 /** Объём чанка (количество блоков). */
 inline constexpr int CHUNK_VOLUME = CHUNK_WIDTH * CHUNK_HEIGHT * CHUNK_DEPTH;
+/** Высота вертикальной секции чанка в блоках. */
+inline constexpr int CHUNK_SECTION_HEIGHT = 16;
+/** Количество вертикальных секций в чанке. */
+inline constexpr int CHUNK_SECTIONS = CHUNK_HEIGHT / CHUNK_SECTION_HEIGHT;
 
 inline constexpr float CHUNKS_MAP_MAX_LOAD_FACTOR = 0.1f;
 
@@ -73,8 +77,11 @@ inline constexpr int ITEM_ICON_SIZE = 48;
 
 // ========== --- ==========
 
-/** */
-inline constexpr int TRANSLUCENT_BLOCKS_SORT_INTERVAL = 8;
+/** Полупрозрачные грани чанка пересортировываются, когда камера смещается
+ * от точки прошлой сортировки дальше этой доли расстояния до чанка... */
+inline constexpr float TRANSLUCENT_RESORT_DISTANCE_FACTOR = 0.05f;
+/** ...но не меньше, чем на это расстояние (в блоках). */
+inline constexpr float TRANSLUCENT_RESORT_MIN_DISTANCE = 0.25f;
 
 inline constexpr int ATLAS_EXTRUSION = 2;
 
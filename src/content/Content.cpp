@@ -20,7 +20,27 @@ ContentIndices::ContentIndices(
     ContentUnitIndices<Entity, entitydefid_t> entities
 ) : blocks(std::move(blocks)),
     items(std::move(items)),
-    entities(std::move(entities)) {}
+    entities(std::move(entities)) {
+    size_t count = this->blocks.count();
+    blockProps.resize(count);
+    auto occludes = [](const Variant& variant) {
+        return variant.rt.solid && variant.drawGroup == 0;
+    };
+    for (size_t id = 0; id < count; ++id) {
+        const auto& def = this->blocks.require(id);
+        bool occluder = occludes(def.defaults);
+        if (def.variants) {
+            for (const auto& variant : def.variants->variants) {
+                occluder = occluder && occludes(variant);
+            }
+        }
+        blockProps[id] =
+            (def.lightPassing ? BLOCK_PROP_LIGHT_PASSING : 0) |
+            (def.skyLightPassing ? BLOCK_PROP_SKY_LIGHT_PASSING : 0) |
+            (def.rt.emissive ? BLOCK_PROP_EMISSIVE : 0) |
+            (occluder ? BLOCK_PROP_OCCLUDER : 0);
+    }
+}
 
 Content::Content(
     std::unique_ptr<ContentIndices> indices,
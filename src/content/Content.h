@@ -67,7 +67,19 @@ private:
     }
 };
 
+/// Биты таблицы свойств блоков ContentIndices::getBlockProps
+enum BlockPropBits : ubyte {
+    BLOCK_PROP_LIGHT_PASSING = 1,
+    BLOCK_PROP_SKY_LIGHT_PASSING = 2,
+    BLOCK_PROP_EMISSIVE = 4,
+    /// Все варианты блока сплошные и без группы отрисовки: грани куба с
+    /// отсечением по умолчанию рядом с ним не видны
+    BLOCK_PROP_OCCLUDER = 8,
+};
+
 class ContentIndices {
+    /// Свойства блоков по идентификатору, по байту на блок
+    std::vector<ubyte> blockProps;
 public:
     ContentUnitIndices<Block, blockid_t> blocks;
     ContentUnitIndices<Item, itemid_t> items;
@@ -78,6 +90,12 @@ public:
         ContentUnitIndices<Item, itemid_t> items,
         ContentUnitIndices<Entity, entitydefid_t> entities
     );
+
+    /// @brief Таблица BlockPropBits по идентификатору блока: плотные циклы
+    /// по вокселям читают байт вместо определения блока
+    const ubyte* getBlockProps() const {
+        return blockProps.data();
+    }
 };
 
 template<class T>
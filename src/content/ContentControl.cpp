@@ -6,6 +6,7 @@
 #include <content/ContentPack.h>
 #include <content/ContentBuilder.h>
 #include <content/ContentLoader.h>
+#include <content/loading/ContentDocuments.h>
 #include <content/PacksManager.h>
 #include <objects/rigging.h>
 #include <logic/scripting/scripting.h>
@@ -110,10 +111,14 @@ void ContentControl::loadContent() {
     }
     paths.resPaths = ResPaths(resRoots);
 
+    ContentDocuments documents;
+    documents.loadCache(EnginePaths::CONTENT_CACHE_FILE);
+    documents.preload(allPacks);
     for (auto& pack : allPacks) {
-        ContentLoader(&pack, contentBuilder, paths.resPaths).load();
+        ContentLoader(&pack, contentBuilder, paths.resPaths, documents).load();
         load_configs(input, pack.folder);
     }
+    documents.saveCache(EnginePaths::CONTENT_CACHE_FILE);
     content = contentBuilder.build();
     scripting::on_content_load(content.get());
 
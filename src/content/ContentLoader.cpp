@@ -15,10 +15,16 @@
 #include <util/stringutil.h>
 #include <engine/EnginePaths.h>
 #include <content/loading/ContentUnitLoader.h>
+#include <content/loading/ContentDocuments.h>
 
 static debug::Logger logger("content-loader");
 
-ContentLoader::ContentLoader(ContentPack* pack, ContentBuilder& builder, const ResPaths& paths) : pack(pack), builder(builder), paths(paths) {
+ContentLoader::ContentLoader(
+    ContentPack* pack,
+    ContentBuilder& builder,
+    const ResPaths& paths,
+    ContentDocuments& documents
+) : pack(pack), builder(builder), paths(paths), documents(documents) {
     auto runtime = std::make_unique<ContentPackRuntime>(
         *pack, scripting::create_pack_environment(*pack)
     );
@@ -31,7 +37,8 @@ ContentLoader::ContentLoader(ContentPack* pack, ContentBuilder& builder, const R
 static void detect_defs(
     const io::path& folder,
     const std::string& prefix,
-    std::vector<std::string>& detected
+    std::vector<std::string>& detected,
+    ContentDocuments* documents
 ) {
     if (!io::is_directory(folder)) return;
     for (const auto& file : io::directory_iterator(folder)) {
@@ -40,11 +47,16 @@ static void detect_defs(
             continue;
         }
         if (io::is_regular_file(file) && io::is_data_file(file)) {
-            auto map = io::read_object(file);
+            // Файл проверяется на корректность
+            if (documents) {
+                documents->read(file);
+            } else {
+                io::read_object(file);
+            }
             std::string id = prefix.empty() ? name : prefix + ":" + name;
             detected.emplace_back(id);
         } else if (io::is_directory(file) && file.extension() != ".files") {
-            detect_defs(file, name, detected);
+            detect_defs(file, name, detected, documents);
         }
     }
 }
@@ -87,10 +99,11 @@ std::vector<std::tuple<std::string, std::string>> ContentLoader::scanContent(
 bool ContentLoader::fixPackIndices(
     const io::path& folder,
     dv::value& indicesRoot,
-    const std::string& contentSection
+    const std::string& contentSection,
+    ContentDocuments* documents
 ) {
     std::vector<std::string> detected;
-    detect_defs(folder, "", detected);
+    detect_defs(folder, "", detected, documents);
 
     std::vector<std::string> indexed;
     bool modified = false;
@@ -132,9 +145,9 @@ void ContentLoader::fixPackIndices() {
     }
 
     bool modified = false;
-    modified |= fixPackIndices(blocksFolder, root, "blocks");
-    modified |= fixPackIndices(itemsFolder, root, "items");
-    modified |= fixPackIndices(entitiesFolder, root, "entities");
+    modified |= fixPackIndices(blocksFolder, root, "blocks", &documents);
+    modified |= fixPackIndices(itemsFolder, root, "items", &documents);
+    modified |= fixPackIndices(entitiesFolder, root, "entities", &documents);
 
     if (modified) io::write_json(contentFile, root);
 }
@@ -168,7 +181,7 @@ void ContentUnitLoader<DefT>::loadUnit(
 ) {
     auto folder = pack.folder;
     auto configFile = folder / (defsDir + "/" + name + ".json");
-    if (io::exists(configFile)) {
+    if (documents.exists(configFile)) {
         try {
             loadUnit(def, full, configFile);
         } catch (const std::runtime_error& err) {
@@ -183,7 +196,7 @@ void ContentUnitLoader<DefT>::loadUnit(
 void ContentLoader::loadBlockMaterial(
     BlockMaterial& def, const io::path& file
 ) {
-    def.deserialize(io::read_json(file));
+    def.deserialize(documents.read(file));
     if (def.hitSound.empty()) {
         def.hitSound = def.stepsSound;
     }
@@ -198,9 +211,8 @@ void ContentUnitLoader<DefT>::loadDefs(const dv::value& root) {
     auto getJsonParent = [this](const std::string& prefix, const std::string& name) {
         auto configFile = pack.folder / (prefix + "/" + name + ".json");
         std::string parent;
-        if (io::exists(configFile)) {
-            auto root = io::read_json(configFile);
-            root.at("parent").get(parent);
+        if (documents.exists(configFile)) {
+            documents.read(configFile).at("parent").get(parent);
         }
         return parent;
     };
@@ -257,7 +269,7 @@ void ContentLoader::loadContent(const dv::value& root) {
         builder.entities.defs.size(),
     };
 
-    ContentUnitLoader<Block>(*pack, builder.blocks, "blocks", 
+    ContentUnitLoader<Block>(*pack, documents, builder.blocks, "blocks",
         [this](Block& def) {
         if (!def.hidden) {
             bool created;
@@ -276,8 +288,9 @@ void ContentLoader::loadContent(const dv::value& root) {
         }
     }).loadDefs(root);
 
-    ContentUnitLoader(*pack, builder.items, "items").loadDefs(root);
-    ContentUnitLoader(*pack, builder.entities, "entities").loadDefs(root);
+    ContentUnitLoader(*pack, documents, builder.items, "items").loadDefs(root);
+    ContentUnitLoader(*pack, documents, builder.entities, "entities")
+        .loadDefs(root);
 
     stats->totalBlocks = builder.blocks.defs.size() - prevStats.totalBlocks;
     stats->totalItems = builder.items.defs.size() - prevStats.totalItems;
@@ -18,6 +18,7 @@ class ContentPackRuntime;
 struct Generator;
 class ResPaths;
 class Content;
+class ContentDocuments;
 
 class ContentLoader {
 private:
@@ -27,12 +28,11 @@ private:
     ContentBuilder& builder;
     ContentPackStats* stats;
     const ResPaths& paths;
+    ContentDocuments& documents;
 
     void loadGenerator(Generator& def, const std::string& full, const std::string& name);
 
-    static void loadBlockMaterial(
-        BlockMaterial& def, const io::path& file
-    );
+    void loadBlockMaterial(BlockMaterial& def, const io::path& file);
     void loadResources(ResourceType type, const dv::value& list);
     void loadResourceAliases(ResourceType type, const dv::value& aliases);
 
@@ -41,7 +41,8 @@ public:
     ContentLoader(
         ContentPack* pack,
         ContentBuilder& builder,
-        const ResPaths& paths
+        const ResPaths& paths,
+        ContentDocuments& documents
     );
 
     static std::vector<std::tuple<std::string, std::string>> scanContent(
@@ -51,7 +52,8 @@ public:
     static bool fixPackIndices(
         const io::path& folder,
         dv::value& indicesRoot,
-        const std::string& contentSection
+        const std::string& contentSection,
+        ContentDocuments* documents = nullptr
     );
     void fixPackIndices();
     void load();
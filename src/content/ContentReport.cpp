@@ -75,7 +75,7 @@ std::shared_ptr<ContentReport> ContentReport::create(
         return nullptr;
     }
 
-    auto root = io::read_json(filename);
+    const auto root = io::read_json(filename);
     uint regionsVersion = static_cast<uint>(root["region-version"].asInteger(REGION_FORMAT_VERSION));
     auto& blocklist = root["blocks"];
     auto& itemlist = root["items"];
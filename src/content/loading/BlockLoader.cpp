@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include <content/ContentBuilder.h>
+#include <content/loading/ContentDocuments.h>
 #include <coders/json.h>
 #include <core_content_defs.h>
 #include <data/dv.h>
@@ -84,7 +85,7 @@ static void load_variant(
 template<> void ContentUnitLoader<Block>::loadUnit(
     Block& def, const std::string& name, const io::path& file
 ) {
-    auto root = io::read_json(file);
+    const auto& root = documents.read(file);
 
     process_properties(def, name, root);
     process_tags(def, root);
@@ -0,0 +1,286 @@
+#include <content/loading/ContentDocuments.h>
+
+#include <stdexcept>
+#include <unordered_set>
+
+#include <content/ContentPack.h>
+#include <coders/binary_json.h>
+#include <coders/byte_utils.h>
+#include <debug/Logger.h>
+#include <util/ThreadPool.h>
+
+static debug::Logger logger("content-documents");
+
+/// Меньшее число файлов разбирается в вызывающем потоке
+inline constexpr size_t MIN_PARALLEL_FILES = 16;
+
+static const char MAGIC[] = "CFCD";
+/// Увеличивается при любом изменении формата файла кэша
+inline constexpr int FORMAT_VERSION = 2;
+
+inline constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+inline constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+static inline uint64_t fnv1a(uint64_t hash, std::string_view bytes) {
+    for (char c : bytes) {
+        hash = (hash ^ static_cast<ubyte>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/// Хэш содержимого файла вместе с расширением, определяющим формат разбора
+static uint64_t hash_document(const io::path& file, std::string_view text) {
+    return fnv1a(fnv1a(FNV_OFFSET, file.extension()), text);
+}
+
+struct DocumentJob {
+    const io::path* file;
+    ContentDocuments::Document* document;
+    const ContentDocuments* owner;
+};
+
+class DocumentWorker : public util::Worker<DocumentJob, int> {
+public:
+    int operator()(const DocumentJob& job) override {
+        auto& document = *job.document;
+        const auto& entries = job.owner->cacheEntries;
+        // Ошибка сохраняется в документе и выбрасывается при его чтении
+        try {
+            auto text = io::read_string(*job.file);
+            document.hash = hash_document(*job.file, text);
+            document.cacheable = true;
+            auto found = entries.find(document.hash);
+            if (found != entries.end()) {
+                const auto& entry = found->second;
+                document.inCache = true;
+                if (!entry.parseOnly) {
+                    try {
+                        document.value = json::from_binary(
+                            job.owner->cacheBytes.data() + entry.offset,
+                            entry.length
+                        );
+                        document.fromCache = true;
+                        return 0;
+                    } catch (const std::exception&) {
+                        // Повреждённая запись кэша - файл разбирается
+                        // заново, а запись перезаписывается
+                        document.inCache = false;
+                    }
+                }
+            }
+            document.value = io::parse_object(*job.file, text);
+        } catch (...) {
+            document.error = std::current_exception();
+        }
+        return 0;
+    }
+};
+
+static void detect_files(const io::path& folder, std::vector<io::path>& files) {
+    if (!io::is_directory(folder)) return;
+    for (const auto& file : io::directory_iterator(folder)) {
+        std::string name = file.stem();
+        if (name[0] == '_') {
+            continue;
+        }
+        if (io::is_regular_file(file) && io::is_data_file(file)) {
+            files.push_back(file);
+        } else if (io::is_directory(file) && file.extension() != ".files") {
+            detect_files(file, files);
+        }
+    }
+}
+
+void ContentDocuments::loadCache(const io::path& file) {
+    cacheEntries.clear();
+    cacheOrder.clear();
+    cacheBytes.clear();
+    if (!io::is_regular_file(file)) {
+        return;
+    }
+    try {
+        cacheBytes = io::read_bytes(file);
+        ByteReader reader(cacheBytes);
+        reader.checkMagic(MAGIC, 4);
+        if (reader.getInt32() != FORMAT_VERSION) {
+            cacheBytes.clear();
+            return;
+        }
+        int count = reader.getInt32();
+        for (int i = 0; i < count; ++i) {
+            auto hash = static_cast<uint64_t>(reader.getInt64());
+            CacheEntry entry {};
+            entry.parseOnly = reader.get() != 0;
+            entry.length = static_cast<uint32_t>(reader.getInt32());
+            entry.offset = reader.position();
+            if (entry.length > reader.remaining()) {
+                throw std::runtime_error("buffer underflow");
+            }
+            reader.skip(entry.length);
+            if (cacheEntries.emplace(hash, entry).second) {
+                cacheOrder.push_back(hash);
+            }
+        }
+    } catch (const std::exception& err) {
+        logger.warning() << "could not read " << file.string() << ": "
+                         << err.what();
+        cacheEntries.clear();
+        cacheOrder.clear();
+        cacheBytes.clear();
+    }
+}
+
+bool ContentDocuments::saveCache(const io::path& file) const {
+    if (!cacheDirty) {
+        return false;
+    }
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>(MAGIC), 4);
+    builder.putInt32(FORMAT_VERSION);
+
+    size_t countPosition = builder.size();
+    builder.putInt32(0);
+    int count = 0;
+    size_t totalSize = 0;
+    std::unordered_set<uint64_t> written;
+    auto put = [&](
+        uint64_t hash, bool parseOnly, const ubyte* data, size_t length
+    ) {
+        if (written.find(hash) != written.end() ||
+            totalSize + length > MAX_CACHE_SIZE) {
+            return;
+        }
+        written.insert(hash);
+        totalSize += length;
+        builder.putInt64(static_cast<int64_t>(hash));
+        builder.put(static_cast<ubyte>(parseOnly));
+        builder.putInt32(length);
+        if (length) {
+            builder.put(data, length);
+        }
+        count++;
+    };
+    auto put_entry = [&](uint64_t hash) {
+        const auto& entry = cacheEntries.at(hash);
+        put(hash,
+            entry.parseOnly,
+            cacheBytes.data() + entry.offset,
+            entry.length);
+    };
+    // Сначала содержимое этого запуска, затем прежние записи в порядке
+    // давности использования: в том числе файлы других паков и миров
+    for (const auto& [key, document] : documents) {
+        if (!document.cacheable || document.error) {
+            continue;
+        }
+        if (document.inCache) {
+            put_entry(document.hash);
+            continue;
+        }
+        try {
+            auto bytes = json::to_binary(document.value);
+            put(document.hash, false, bytes.data(), bytes.size());
+        } catch (const std::exception&) {
+            // Например, null в документе: BJSON его не представляет, и
+            // запись лишь отмечает, что файл нужно разбирать
+            put(document.hash, true, nullptr, 0);
+        }
+    }
+    for (auto hash : cacheOrder) {
+        put_entry(hash);
+    }
+    builder.setInt32(countPosition, count);
+    try {
+        if (!io::write_bytes(file, builder.data(), builder.size())) {
+            throw std::runtime_error("write failed");
+        }
+    } catch (const std::exception& err) {
+        logger.warning() << "could not write " << file.string() << ": "
+                         << err.what();
+        return false;
+    }
+    logger.info() << "cached " << count << " documents";
+    return true;
+}
+
+void ContentDocuments::preload(
+    const std::vector<ContentPack>& packs, int workers
+) {
+    std::vector<io::path> files;
+    for (const auto& pack : packs) {
+        detect_files(pack.folder / ContentPack::BLOCKS_FOLDER, files);
+        detect_files(pack.folder / ContentPack::ITEMS_FOLDER, files);
+        detect_files(pack.folder / ContentPack::ENTITIES_FOLDER, files);
+        detect_files(pack.folder / "block_materials", files);
+    }
+    std::vector<DocumentJob> jobs;
+    jobs.reserve(files.size());
+    for (const auto& file : files) {
+        auto& document = documents[file.normalized().string()];
+        jobs.push_back(DocumentJob {&file, &document, this});
+    }
+
+    if (workers == 1 || jobs.size() < MIN_PARALLEL_FILES) {
+        DocumentWorker worker;
+        for (const auto& job : jobs) {
+            worker(job);
+        }
+    } else {
+        // Каждое задание пишет только в свой документ, а кэш лишь читает
+        util::ThreadPool<DocumentJob, int> pool(
+            "content-documents",
+            []() { return std::make_unique<DocumentWorker>(); },
+            [](int&&) {},
+            workers
+        );
+        for (auto job : jobs) {
+            pool.enqueueJob(std::move(job));
+        }
+        size_t done = 0;
+        while (done < jobs.size()) {
+            if (!pool.isActive()) {
+                throw std::runtime_error("content documents pool stopped");
+            }
+            pool.waitForResults();
+            done += pool.pullResults();
+        }
+        logger.info() << "loaded " << jobs.size() << " files using "
+                      << pool.getWorkersCount() << " workers";
+    }
+
+    cacheHits = 0;
+    cacheDirty = false;
+    for (const auto& job : jobs) {
+        const auto& document = *job.document;
+        cacheHits += document.fromCache;
+        // Кэш перезаписывается, только если встретилось новое содержимое
+        cacheDirty |= document.cacheable && !document.error &&
+                      !document.inCache;
+    }
+    if (cacheHits) {
+        logger.info() << cacheHits << " documents taken from cache";
+    }
+}
+
+const dv::value& ContentDocuments::read(const io::path& file) {
+    auto key = file.normalized().string();
+    auto found = documents.find(key);
+    if (found == documents.end()) {
+        auto& document = documents[key];
+        try {
+            document.value = io::read_object(file);
+        } catch (...) {
+            document.error = std::current_exception();
+        }
+        found = documents.find(key);
+    }
+    if (found->second.error) {
+        std::rethrow_exception(found->second.error);
+    }
+    return found->second.value;
+}
+
+bool ContentDocuments::exists(const io::path& file) const {
+    return documents.find(file.normalized().string()) != documents.end() ||
+           io::exists(file);
+}
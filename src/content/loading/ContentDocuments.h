@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <exception>
+#include <unordered_map>
+
+#include <io/io.h>
+#include <data/dv.h>
+#include <typedefs.h>
+
+struct ContentPack;
+
+/// @brief Файлы определений контент-паков, прочитанные и разобранные
+/// заранее в пуле потоков. Определения по-прежнему регистрируются
+/// последовательно и в прежнем порядке, но берут документы отсюда
+/// вместо повторного чтения файлов.
+///
+/// Разобранные документы могут сохраняться в двоичный кэш (BJSON) по хэшу
+/// содержимого файла: файлы по-прежнему читаются при каждом запуске, но
+/// файлы с уже известным содержимым не разбираются заново. Записи файлов,
+/// не загруженных в этом запуске (например, паков других миров),
+/// сохраняются, пока кэш не превысит MAX_CACHE_SIZE. Кэшируется только
+/// разбор: определения строятся из документов при каждом запуске, и эта
+/// часть времени загрузки кэшем не сокращается
+class ContentDocuments {
+public:
+    /// Лимит суммарного размера записей кэша; давно не использованные
+    /// записи вытесняются первыми
+    static inline constexpr size_t MAX_CACHE_SIZE = 16 * 1024 * 1024;
+
+    /// @brief Загружает кэш документов. Отсутствующий, устаревший по
+    /// версии формата или повреждённый кэш игнорируется
+    void loadCache(const io::path& file);
+
+    /// @brief Перезаписывает кэш, если при предзагрузке встретилось
+    /// содержимое, которого в нём не было
+    /// @return true если кэш был записан
+    bool saveCache(const io::path& file) const;
+
+    /// @brief Находит файлы определений (блоков, предметов, сущностей,
+    /// материалов) всех паков, читает и разбирает их параллельно. Документы
+    /// файлов с известным кэшу содержимым берутся из кэша
+    /// @param workers число рабочих потоков (0 - по числу ядер,
+    /// 1 - разбор в вызывающем потоке)
+    void preload(const std::vector<ContentPack>& packs, int workers = 0);
+
+    /// @brief Документ файла определения. Файлы, не найденные при
+    /// предзагрузке, читаются и запоминаются здесь же. Ошибка чтения или
+    /// разбора выбрасывается при каждом обращении, как при прямом чтении
+    const dv::value& read(const io::path& file);
+
+    bool exists(const io::path& file) const;
+
+    size_t size() const {
+        return documents.size();
+    }
+
+    /// @brief Число документов последней предзагрузки, взятых из кэша
+    size_t getCacheHits() const {
+        return cacheHits;
+    }
+private:
+    friend struct DocumentJob;
+    friend class DocumentWorker;
+
+    struct Document {
+        dv::value value;
+        std::exception_ptr error;
+        /// Документ найден при предзагрузке и может попасть в кэш
+        bool cacheable = false;
+        /// Документ взят из кэша, а не разобран из файла
+        bool fromCache = false;
+        /// Для хэша содержимого уже есть запись в кэше
+        bool inCache = false;
+        /// Хэш содержимого и формата файла
+        uint64_t hash = 0;
+    };
+    /// Запись кэша: документ в BJSON внутри буфера cacheBytes
+    struct CacheEntry {
+        size_t offset;
+        size_t length;
+        /// Документ не представим в BJSON (например, содержит null) и
+        /// всегда разбирается из файла
+        bool parseOnly;
+    };
+    std::unordered_map<std::string, Document> documents;
+    /// Записи кэша по хэшу содержимого
+    std::unordered_map<uint64_t, CacheEntry> cacheEntries;
+    /// Хэши записей в порядке файла кэша: от недавно использованных
+    std::vector<uint64_t> cacheOrder;
+    /// Содержимое файла кэша, читаемого целиком одним вызовом
+    std::vector<ubyte> cacheBytes;
+    size_t cacheHits = 0;
+    bool cacheDirty = false;
+};
@@ -7,6 +7,7 @@
 #include <data/dv_fwd.h>
 
 struct ContentPack;
+class ContentDocuments;
 
 template<typename T> class ContentUnitBuilder;
 
@@ -15,10 +16,12 @@ class ContentUnitLoader {
 public:
     ContentUnitLoader(
         const ContentPack& pack,
+        ContentDocuments& documents,
         ContentUnitBuilder<DefT>& builder,
         const std::string& defsDir,
         std::function<void(DefT&)> postFunc = nullptr
     ) : pack(pack),
+        documents(documents),
         builder(builder),
         defsDir(defsDir),
         postFunc(std::move(postFunc)) {}
@@ -28,6 +31,7 @@ public:
     void loadDefs(const dv::value& root);
 private:
     const ContentPack& pack;
+    ContentDocuments& documents;
     ContentUnitBuilder<DefT>& builder;
     std::string defsDir;
     std::function<void(DefT&)> postFunc;
@@ -2,6 +2,7 @@
 #include <content/loading/ContentUnitLoader.h>
 
 #include <content/ContentBuilder.h>
+#include <content/loading/ContentDocuments.h>
 #include <coders/json.h>
 #include <core_content_defs.h>
 #include <data/dv.h>
@@ -15,7 +16,7 @@ static debug::Logger logger("entities-loader");
 template<> void ContentUnitLoader<Entity>::loadUnit(
     Entity& def, const std::string& name, const io::path& file
 ) {
-    auto root = io::read_json(file);
+    const auto& root = documents.read(file);
 
     if (root.has("parent")) {
         const auto& parentName = root["parent"].asString();
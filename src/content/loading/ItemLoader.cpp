@@ -3,6 +3,7 @@
 #include <content/loading/ContentLoadingCommons.h>
 
 #include <content/ContentBuilder.h>
+#include <content/loading/ContentDocuments.h>
 #include <coders/json.h>
 #include <core_content_defs.h>
 #include <data/dv.h>
@@ -16,7 +17,7 @@ static debug::Logger logger("items-loader");
 template<> void ContentUnitLoader<Item>::loadUnit(
     Item& def, const std::string& name, const io::path& file
 ) {
-    auto root = io::read_json(file);
+    const auto& root = documents.read(file);
 
     process_properties(def, name, root);
     process_tags(def, root);
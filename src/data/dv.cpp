@@ -1,5 +1,8 @@
 #include <data/dv.h>
 
+#include <mutex>
+#include <shared_mutex>
+
 #include <util/Buffer.h>
 #include <debug/Logger.h>
 #include <coders/json.h>
@@ -11,13 +14,168 @@ namespace dv {
         logger.error() << msg;
     }
 
-    value& value::operator[](const key_t& key) {
+    namespace keys {
+        struct KeysTable {
+            std::shared_mutex mutex;
+            std::unordered_map<std::string_view, std::unique_ptr<std::string>>
+                keys;
+        };
+
+        static KeysTable& get_table() {
+            static KeysTable table;
+            return table;
+        }
+
+        const std::string* intern(std::string_view key) {
+            if (key.size() > MAX_LENGTH) {
+                return nullptr;
+            }
+            auto& table = get_table();
+            {
+                std::shared_lock lock(table.mutex);
+                const auto& found = table.keys.find(key);
+                if (found != table.keys.end()) {
+                    return found->second.get();
+                }
+            }
+            std::unique_lock lock(table.mutex);
+            const auto& found = table.keys.find(key);
+            if (found != table.keys.end()) {
+                return found->second.get();
+            }
+            if (table.keys.size() >= MAX_COUNT) {
+                return nullptr;
+            }
+            auto string = std::make_unique<std::string>(key);
+            auto ptr = string.get();
+            table.keys[*ptr] = std::move(string);
+            return ptr;
+        }
+
+        size_t count() {
+            auto& table = get_table();
+            std::shared_lock lock(table.mutex);
+            return table.keys.size();
+        }
+    }
+
+    namespace objects {
+        Entry::Entry(std::string_view name, value val)
+            : key(keys::intern(name)), val(std::move(val)) {
+            if (key == nullptr) {
+                ownedKey = std::make_unique<std::string>(name);
+                key = ownedKey.get();
+            }
+        }
+
+        Entry::Entry(const Entry& other) : key(other.key), val(other.val) {
+            if (other.ownedKey) {
+                ownedKey = std::make_unique<std::string>(*other.ownedKey);
+                key = ownedKey.get();
+            }
+        }
+
+        Entry& Entry::operator=(const Entry& other) {
+            if (this != &other) {
+                *this = Entry(other);
+            }
+            return *this;
+        }
+
+        Object::Object(std::initializer_list<pair> pairs) {
+            entries.reserve(pairs.size());
+            for (const auto& [key, val] : pairs) {
+                (*this)[key] = val;
+            }
+        }
+
+        Object::Object(const Object& other) : entries(other.entries) {
+            if (other.index) {
+                buildIndex();
+            }
+        }
+
+        Object& Object::operator=(const Object& other) {
+            if (this != &other) {
+                entries = other.entries;
+                index.reset();
+                if (other.index) {
+                    buildIndex();
+                }
+            }
+            return *this;
+        }
+
+        value& Object::operator[](std::string_view key) {
+            auto found = find(key);
+            if (found != end()) {
+                return found->val;
+            }
+            auto& entry = entries.emplace_back(key, value());
+            if (index) {
+                index->emplace(entry.getKey(), entries.size() - 1);
+            } else if (entries.size() > LINEAR_SEARCH_LIMIT) {
+                buildIndex();
+            }
+            return entry.val;
+        }
+
+        Object::iterator Object::find(std::string_view key) {
+            const auto& constThis = *this;
+            return const_cast<iterator>(constThis.find(key));
+        }
+
+        Object::const_iterator Object::find(std::string_view key) const {
+            if (index) {
+                const auto& found = index->find(key);
+                if (found == index->end()) {
+                    return end();
+                }
+                return begin() + found->second;
+            }
+            for (const auto& entry : entries) {
+                if (entry.getKey() == key) {
+                    return &entry;
+                }
+            }
+            return end();
+        }
+
+        bool Object::erase(std::string_view key) {
+            auto found = find(key);
+            if (found == end()) {
+                return false;
+            }
+            entries.erase(found);
+            index.reset();
+            if (entries.size() > LINEAR_SEARCH_LIMIT) {
+                buildIndex();
+            }
+            return true;
+        }
+
+        void Object::buildIndex() {
+            index = std::make_unique<Index>();
+            index->reserve(entries.size());
+            for (size_t i = 0; i < entries.size(); ++i) {
+                index->emplace(entries[i].getKey(), i);
+            }
+        }
+    }
+
+    value& value::operator[](std::string_view key) {
         check_type(type, value_type::Object);
         return (*val.object)[key];
     }
-    const value& value::operator[](const key_t& key) const {
+    const value& value::operator[](std::string_view key) const {
+        static const value none;
         check_type(type, value_type::Object);
-        return (*val.object)[key];
+        const auto& object = *val.object;
+        auto found = object.find(key);
+        if (found == object.end()) {
+            return none;
+        }
+        return found->val;
     }
 
     static void apply_method(value& dst, value&& val, std::string_view method, bool deep) {
@@ -83,13 +241,13 @@ namespace dv {
         return val.list->push_back(std::move(v));
     }
 
-    value& value::object(const key_t& key) {
+    value& value::object(std::string_view key) {
         reference ref = this->operator[](key);
         ref = dv::object();
         return ref;
     }
 
-    value& value::list(const key_t& key) {
+    value& value::list(std::string_view key) {
         reference ref = this->operator[](key);
         ref = dv::list();
         return ref;
@@ -190,14 +348,15 @@ namespace dv {
         }
     }
 
-    bool value::has(const key_t& k) const {
+    bool value::has(std::string_view k) const {
         if (type == value_type::Object) {
-            return val.object->find(k) != val.object->end();
+            const auto& object = *val.object;
+            return object.find(k) != object.end();
         }
         return false;
     }
 
-    void value::erase(const key_t& key) {
+    void value::erase(std::string_view key) {
         check_type(type, value_type::Object);
         val.object->erase(key);
     }
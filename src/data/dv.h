@@ -6,9 +6,12 @@
 #include <vector>
 #include <cstring>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 #include <iosfwd>
 
+#include <util/small_vector.h>
+
 #ifdef CHROMA_ENABLE_REFLECTION
 #include <util/EnumMetadata.h>
 #endif
@@ -52,14 +55,13 @@ namespace dv {
     class value;
 
     using list_t = std::vector<value>;
-    using map_t = std::unordered_map<key_t, value>;
     using pair = std::pair<const key_t, value>;
 
     using reference = value&;
     using const_reference = const value&;
 
     namespace objects {
-        using Object = std::unordered_map<key_t, value>;
+        class Object;
         using List = std::vector<value>;
         using Bytes = util::Buffer<byte_t>;
     }
@@ -378,13 +380,14 @@ namespace dv {
             return add(value(v));
         }
 
-        void erase(const key_t& key);
+        void erase(std::string_view key);
 
         void erase(size_t index);
 
-        value& operator[](const key_t& key);
+        value& operator[](std::string_view key);
 
-        const value& operator[](const key_t& key) const;
+        /// @brief Отсутствующий ключ не добавляется: возвращается None
+        const value& operator[](std::string_view key) const;
 
         void merge(dv::value&& other, bool deep);
 
@@ -400,9 +403,9 @@ namespace dv {
             return type == value_type::None;
         }
 
-        value& object(const key_t& key);
+        value& object(std::string_view key);
 
-        value& list(const key_t& key);
+        value& list(std::string_view key);
 
         value& object();
 
@@ -474,14 +477,7 @@ namespace dv {
             }
         }
 
-        optionalvalue at(const key_t& k) const {
-            check_type(type, value_type::Object);
-            const auto& found = val.object->find(k);
-            if (found == val.object->end()) {
-                return optionalvalue(nullptr);
-            }
-            return optionalvalue(&found->second);
-        }
+        inline optionalvalue at(std::string_view k) const;
 
         optionalvalue at(size_t index) {
             check_type(type, value_type::List);
@@ -493,7 +489,7 @@ namespace dv {
             return optionalvalue(&val.list->at(index));
         }
 
-        bool has(const key_t& k) const;
+        bool has(std::string_view k) const;
 
         size_t size() const noexcept;
 
@@ -529,6 +525,166 @@ namespace dv {
     }
 }
 
+namespace dv {
+    /// @brief Общая таблица интернированных ключей объектов.
+    /// Строки таблицы не освобождаются до завершения программы
+    namespace keys {
+        /// @brief Максимальная длина интернируемого ключа
+        inline constexpr size_t MAX_LENGTH = 64;
+        /// @brief Максимальное число ключей в таблице
+        inline constexpr size_t MAX_COUNT = 1 << 16;
+
+        /// @return строка из таблицы или nullptr, если ключ слишком длинный
+        /// или таблица заполнена
+        const std::string* intern(std::string_view key);
+
+        /// @return число ключей в таблице
+        size_t count();
+    }
+
+    namespace objects {
+        /// @brief Поле объекта. Ключ либо хранится в общей таблице,
+        /// либо (если не был интернирован) принадлежит полю.
+        /// Поддерживает структурное связывание: auto& [key, value]
+        class Entry {
+            const std::string* key;
+            std::unique_ptr<std::string> ownedKey;
+        public:
+            value val;
+
+            Entry(std::string_view name, value val);
+            Entry(const Entry& other);
+            Entry(Entry&&) noexcept = default;
+
+            Entry& operator=(const Entry& other);
+            Entry& operator=(Entry&&) noexcept = default;
+
+            const std::string& getKey() const {
+                return *key;
+            }
+
+            template<size_t I>
+            decltype(auto) get() const {
+                if constexpr (I == 0) {
+                    return getKey();
+                } else {
+                    return static_cast<const value&>(val);
+                }
+            }
+
+            template<size_t I>
+            decltype(auto) get() {
+                if constexpr (I == 0) {
+                    return getKey();
+                } else {
+                    return static_cast<value&>(val);
+                }
+            }
+        };
+
+        /// @brief Объект с плоским хранением полей в порядке добавления.
+        ///
+        /// Несколько первых полей хранятся внутри самого объекта, поиск
+        /// по небольшим объектам линейный. Для объектов с числом полей
+        /// больше LINEAR_SEARCH_LIMIT строится хеш-индекс.
+        /// Добавление поля может переместить остальные поля, поэтому ссылки
+        /// на значения не должны удерживаться при добавлении новых ключей
+        class Object {
+        public:
+            static constexpr size_t INLINE_CAPACITY = 4;
+            static constexpr size_t LINEAR_SEARCH_LIMIT = 16;
+
+            using iterator = Entry*;
+            using const_iterator = const Entry*;
+
+            Object() = default;
+            Object(std::initializer_list<pair> pairs);
+            Object(const Object& other);
+            Object(Object&& other) noexcept = default;
+
+            Object& operator=(const Object& other);
+            Object& operator=(Object&& other) noexcept = default;
+
+            /// @brief Возвращает значение поля, добавляя его при отсутствии
+            value& operator[](std::string_view key);
+
+            iterator find(std::string_view key);
+            const_iterator find(std::string_view key) const;
+
+            /// @return true, если поле было удалено
+            bool erase(std::string_view key);
+
+            void reserve(size_t count) {
+                entries.reserve(count);
+            }
+
+            size_t size() const {
+                return entries.size();
+            }
+
+            bool empty() const {
+                return entries.empty();
+            }
+
+            iterator begin() {
+                return entries.begin();
+            }
+
+            iterator end() {
+                return entries.end();
+            }
+
+            const_iterator begin() const {
+                return entries.begin();
+            }
+
+            const_iterator end() const {
+                return entries.end();
+            }
+        private:
+            using Index = std::unordered_map<std::string_view, size_t>;
+
+            util::small_vector<Entry, INLINE_CAPACITY> entries;
+            std::unique_ptr<Index> index;
+
+            void buildIndex();
+        };
+    }
+
+    inline optionalvalue value::at(std::string_view k) const {
+        check_type(type, value_type::Object);
+        auto found = val.object->find(k);
+        if (found == val.object->end()) {
+            return optionalvalue(nullptr);
+        }
+        return optionalvalue(&found->val);
+    }
+}
+
+template<>
+struct std::tuple_size<dv::objects::Entry>
+    : std::integral_constant<size_t, 2> {};
+
+template<>
+struct std::tuple_element<0, dv::objects::Entry> {
+    using type = const std::string&;
+};
+
+template<>
+struct std::tuple_element<1, dv::objects::Entry> {
+    using type = dv::value&;
+};
+
+template<>
+struct std::tuple_element<0, const dv::objects::Entry> {
+    using type = const std::string&;
+};
+
+template<>
+struct std::tuple_element<1, const dv::objects::Entry> {
+    using type = const dv::value&;
+};
+
 namespace dv {
     inline const std::string& type_name(const value& value) {
         return type_name(value.getType());
@@ -542,6 +698,13 @@ namespace dv {
         return std::make_shared<objects::Object>(std::move(pairs));
     }
 
+    /// @brief Создаёт объект с местом под count полей
+    inline value object(size_t count) {
+        auto object = std::make_shared<objects::Object>();
+        object->reserve(count);
+        return object;
+    }
+
     inline value list() {
         return std::make_shared<objects::List>();
     }
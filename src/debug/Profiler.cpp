@@ -0,0 +1,348 @@
+#include <debug/Profiler.h>
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <io/io.h>
+#include <debug/Logger.h>
+#include <util/stringutil.h>
+
+using namespace debug;
+
+static debug::Logger logger("profiler");
+
+/// Ограничение буфера потока, из которого никто не забирает события
+inline constexpr size_t MAX_THREAD_EVENTS = 1 << 20;
+/// Ограничение длины записи трассы
+inline constexpr size_t MAX_CAPTURE_EVENTS = 1 << 21;
+
+namespace {
+    struct OpenZone {
+        const char* name;
+        uint64_t start;
+        bool script;
+    };
+
+    struct ThreadBuffer {
+        uint32_t id;
+        std::string name;
+        /// Открытые зоны; используется только своим потоком
+        std::vector<OpenZone> stack;
+        std::mutex mutex;
+        std::vector<ProfileEvent> events;
+        std::atomic<bool> alive {true};
+    };
+
+    struct LocalBuffer {
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~LocalBuffer() {
+            if (buffer) {
+                buffer->alive = false;
+            }
+        }
+    };
+
+    struct CapturedEvent {
+        ProfileEvent event;
+        uint32_t thread;
+    };
+
+    struct ProfilerState {
+        std::chrono::steady_clock::time_point epoch =
+            std::chrono::steady_clock::now();
+
+        std::mutex buffersMutex;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        uint32_t nextThreadId = 1;
+
+        std::mutex namesMutex;
+        std::unordered_set<std::string> names;
+
+        std::mutex frameMutex;
+        std::vector<ProfileNode> lastFrame;
+        uint64_t lastFrameTime = 0;
+        uint64_t frameStart = 0;
+
+        std::atomic<bool> capturing {false};
+        std::vector<CapturedEvent> captured;
+        std::unordered_map<uint32_t, std::string> threadNames;
+    };
+
+    ProfilerState& state() {
+        static ProfilerState instance;
+        return instance;
+    }
+
+    thread_local LocalBuffer localBuffer;
+
+    ThreadBuffer& local_buffer() {
+        if (localBuffer.buffer == nullptr) {
+            auto& profiler = state();
+            auto buffer = std::make_shared<ThreadBuffer>();
+            std::lock_guard lock(profiler.buffersMutex);
+            buffer->id = profiler.nextThreadId++;
+            buffer->name = "thread-" + std::to_string(buffer->id);
+            profiler.buffers.push_back(buffer);
+            localBuffer.buffer = std::move(buffer);
+        }
+        return *localBuffer.buffer;
+    }
+
+    uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - state().epoch
+        ).count();
+    }
+
+    /// @brief Строит дерево зон кадра; события сортируются по началу
+    std::vector<ProfileNode> aggregate(std::vector<ProfileEvent>& events) {
+        std::sort(events.begin(), events.end(), [](const auto& a, const auto& b) {
+            if (a.start != b.start) return a.start < b.start;
+            return a.depth < b.depth;
+        });
+        struct TreeNode {
+            ProfileNode node;
+            std::vector<size_t> children;
+        };
+        std::vector<TreeNode> tree;
+        std::vector<size_t> roots;
+        std::vector<size_t> path;
+        for (const auto& event : events) {
+            if (path.size() > event.depth) {
+                path.resize(event.depth);
+            }
+            auto& siblings = path.empty() ? roots : tree[path.back()].children;
+            size_t index = tree.size();
+            for (size_t sibling : siblings) {
+                if (tree[sibling].node.name == event.name) {
+                    index = sibling;
+                    break;
+                }
+            }
+            if (index == tree.size()) {
+                siblings.push_back(index);
+                tree.push_back(TreeNode {
+                    ProfileNode {
+                        event.name, static_cast<uint32_t>(path.size()), 0, 0},
+                    {}});
+            }
+            tree[index].node.calls++;
+            tree[index].node.time += event.end - event.start;
+            path.push_back(index);
+        }
+        std::vector<ProfileNode> nodes;
+        nodes.reserve(tree.size());
+        std::vector<size_t> stack(roots.rbegin(), roots.rend());
+        while (!stack.empty()) {
+            size_t index = stack.back();
+            stack.pop_back();
+            nodes.push_back(tree[index].node);
+            const auto& children = tree[index].children;
+            stack.insert(stack.end(), children.rbegin(), children.rend());
+        }
+        return nodes;
+    }
+}
+
+void Profiler::setEnabled(bool flag) {
+#ifdef CHROMA_ENABLE_PROFILER
+    enabled = flag;
+#endif
+}
+
+size_t Profiler::beginZone(const char* name, bool script) {
+    auto& buffer = local_buffer();
+    size_t depth = buffer.stack.size();
+    buffer.stack.push_back(OpenZone {name, now(), script});
+    return depth;
+}
+
+void Profiler::endZone(size_t depth) {
+    auto& buffer = local_buffer();
+    if (buffer.stack.size() <= depth) {
+        return;
+    }
+    uint64_t end = now();
+    std::lock_guard lock(buffer.mutex);
+    while (buffer.stack.size() > depth) {
+        const auto& zone = buffer.stack.back();
+        if (buffer.events.size() < MAX_THREAD_EVENTS) {
+            buffer.events.push_back(ProfileEvent {
+                zone.name,
+                zone.start,
+                end,
+                static_cast<uint32_t>(buffer.stack.size() - 1)});
+        }
+        buffer.stack.pop_back();
+    }
+}
+
+void Profiler::endScriptZone() {
+    auto& buffer = local_buffer();
+    if (!buffer.stack.empty() && buffer.stack.back().script) {
+        endZone(buffer.stack.size() - 1);
+    }
+}
+
+const char* Profiler::intern(const std::string& name) {
+    auto& profiler = state();
+    std::lock_guard lock(profiler.namesMutex);
+    return profiler.names.insert(name).first->c_str();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    auto& buffer = local_buffer();
+    std::lock_guard lock(buffer.mutex);
+    buffer.name = name;
+}
+
+/// @brief Забирает события из буферов всех потоков, сохраняя их в запись
+/// трассы, если она идёт. События потока self переносятся в selfEvents
+static void drain_buffers(
+    ThreadBuffer* self, std::vector<ProfileEvent>& selfEvents
+) {
+    auto& profiler = state();
+    bool capturing = profiler.capturing;
+    std::vector<ProfileEvent> events;
+
+    std::lock_guard buffersLock(profiler.buffersMutex);
+    auto& buffers = profiler.buffers;
+    for (const auto& buffer : buffers) {
+        {
+            // Буфер потока сохраняет выделенную память
+            std::lock_guard lock(buffer->mutex);
+            events.assign(buffer->events.begin(), buffer->events.end());
+            buffer->events.clear();
+            if (capturing) {
+                profiler.threadNames[buffer->id] = buffer->name;
+            }
+        }
+        if (capturing) {
+            for (const auto& event : events) {
+                if (profiler.captured.size() >= MAX_CAPTURE_EVENTS) {
+                    break;
+                }
+                profiler.captured.push_back({event, buffer->id});
+            }
+        }
+        if (buffer.get() == self) {
+            selfEvents.swap(events);
+        }
+        events.clear();
+    }
+    // Буферы завершившихся потоков удаляются после того, как опустели
+    buffers.erase(
+        std::remove_if(
+            buffers.begin(),
+            buffers.end(),
+            [](const auto& buffer) { return !buffer->alive; }
+        ),
+        buffers.end()
+    );
+}
+
+void Profiler::frame() {
+    auto& profiler = state();
+    uint64_t frameEnd = now();
+
+    std::vector<ProfileEvent> frameEvents;
+    drain_buffers(&local_buffer(), frameEvents);
+
+    auto nodes = aggregate(frameEvents);
+    std::lock_guard lock(profiler.frameMutex);
+    profiler.lastFrame = std::move(nodes);
+    profiler.lastFrameTime = frameEnd - profiler.frameStart;
+    profiler.frameStart = frameEnd;
+}
+
+std::vector<ProfileNode> Profiler::getLastFrame() {
+    auto& profiler = state();
+    std::lock_guard lock(profiler.frameMutex);
+    return profiler.lastFrame;
+}
+
+uint64_t Profiler::getLastFrameTime() {
+    auto& profiler = state();
+    std::lock_guard lock(profiler.frameMutex);
+    return profiler.lastFrameTime;
+}
+
+void Profiler::startCapture() {
+#ifdef CHROMA_ENABLE_PROFILER
+    auto& profiler = state();
+    {
+        std::lock_guard lock(profiler.buffersMutex);
+        profiler.captured.clear();
+        profiler.threadNames.clear();
+    }
+    profiler.capturing = true;
+    setEnabled(true);
+#else
+    logger.warning() << "built without profiler support";
+#endif
+}
+
+bool Profiler::isCapturing() {
+    return state().capturing;
+}
+
+size_t Profiler::stopCapture(std::ostream& out) {
+    auto& profiler = state();
+    // События текущего кадра тоже попадают в запись
+    std::vector<ProfileEvent> events;
+    drain_buffers(nullptr, events);
+
+    std::vector<CapturedEvent> captured;
+    std::unordered_map<uint32_t, std::string> threadNames;
+    {
+        std::lock_guard lock(profiler.buffersMutex);
+        profiler.capturing = false;
+        captured.swap(profiler.captured);
+        threadNames.swap(profiler.threadNames);
+    }
+    if (captured.size() >= MAX_CAPTURE_EVENTS) {
+        logger.warning() << "capture truncated to " << MAX_CAPTURE_EVENTS
+                         << " events";
+    }
+
+    std::unordered_map<const char*, std::string> escapedNames;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& [id, name] : threadNames) {
+        if (!first) out << ",";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+            << ",\"args\":{\"name\":" << util::escape(name) << "}}";
+    }
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (const auto& [event, thread] : captured) {
+        auto found = escapedNames.find(event.name);
+        if (found == escapedNames.end()) {
+            found = escapedNames.emplace(event.name, util::escape(event.name))
+                        .first;
+        }
+        if (!first) out << ",";
+        first = false;
+        out << "\n{\"name\":" << found->second
+            << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+            << ",\"ts\":" << event.start / 1000.0
+            << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+    }
+    out << "]}\n";
+    return captured.size();
+}
+
+size_t Profiler::stopCapture(const io::path& file) {
+    std::stringstream ss;
+    size_t count = stopCapture(ss);
+    io::write_string(file, ss.str());
+    logger.info() << "written " << count << " events to " << file.string();
+    return count;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <iosfwd>
+#include <vector>
+#include <cstdint>
+
+#include <io/fwd.h>
+
+namespace debug {
+    /// @brief Завершённая зона профилировщика
+    struct ProfileEvent {
+        /// Строковый литерал или строка, полученная из Profiler::intern
+        const char* name;
+        /// Наносекунды от запуска профилировщика
+        uint64_t start;
+        uint64_t end;
+        /// Глубина вложенности зоны в своём потоке
+        uint32_t depth;
+    };
+
+    /// @brief Суммарное время зоны за кадр (тик). Одноимённые зоны
+    /// с общим родителем объединяются
+    struct ProfileNode {
+        const char* name;
+        uint32_t depth;
+        uint32_t calls;
+        /// Наносекунды
+        uint64_t time;
+    };
+
+    /// @brief Иерархический профилировщик зон. Каждый поток пишет
+    /// завершённые зоны в собственный буфер; в конце кадра (тика) основной
+    /// поток забирает буферы всех потоков, строит сводку своего кадра и,
+    /// если идёт запись, сохраняет события для экспорта в Chrome trace.
+    ///
+    /// Пока профилировщик выключен, зона стоит одного чтения флага.
+    /// Без CHROMA_ENABLE_PROFILER макросы PROFILE_* не компилируются вовсе
+    class Profiler {
+        static inline std::atomic<bool> enabled {false};
+    public:
+        static bool isEnabled() {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        static void setEnabled(bool flag);
+
+        /// @brief Открывает зону в текущем потоке
+        /// @return глубина, которую нужно передать в endZone
+        static size_t beginZone(const char* name, bool script = false);
+
+        /// @brief Закрывает зону depth и все незакрытые вложенные в неё
+        static void endZone(size_t depth);
+
+        /// @brief Закрывает верхнюю зону, если она открыта скриптом.
+        /// Зоны скриптов, оставленные открытыми из-за ошибки, закрываются
+        /// вместе с объемлющей зоной движка
+        static void endScriptZone();
+
+        /// @brief Постоянная копия динамического имени зоны
+        static const char* intern(const std::string& name);
+
+        /// @brief Имя текущего потока в экспортируемой трассе
+        static void setThreadName(const std::string& name);
+
+        /// @brief Завершает кадр (тик) вызывающего потока
+        static void frame();
+
+        /// @brief Сводка последнего кадра в порядке обхода дерева зон
+        static std::vector<ProfileNode> getLastFrame();
+
+        /// @brief Длительность последнего кадра в наносекундах
+        static uint64_t getLastFrameTime();
+
+        /// @brief Начинает запись событий всех потоков для экспорта.
+        /// Включает профилировщик
+        static void startCapture();
+
+        static bool isCapturing();
+
+        /// @brief Останавливает запись и выводит её в формате Chrome
+        /// trace JSON (открывается в Perfetto и chrome://tracing)
+        /// @return число записанных событий
+        static size_t stopCapture(std::ostream& out);
+
+        static size_t stopCapture(const io::path& file);
+    };
+
+    /// @brief Зона, открытая на время жизни объекта
+    class ProfileZone {
+        size_t depth;
+        bool active;
+    public:
+        explicit ProfileZone(const char* name) : depth(0), active(Profiler::isEnabled()) {
+            if (active) {
+                depth = Profiler::beginZone(name);
+            }
+        }
+
+        ~ProfileZone() {
+            if (active) {
+                Profiler::endZone(depth);
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+    };
+}
+
+#ifdef CHROMA_ENABLE_PROFILER
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+/// Зона до конца текущей области видимости; name - строковый литерал
+#define PROFILE_ZONE(name) \
+    ::debug::ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_FRAME() ::debug::Profiler::frame()
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
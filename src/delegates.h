@@ -22,5 +22,9 @@ using wstringconsumer = std::function<void(const std::wstring&)>;
 using doubleconsumer = std::function<void(double)>;
 using boolconsumer = std::function<void(bool)>;
 using int_array_consumer = std::function<void(const int[], size_t)>;
+/// Вызывает func для индексов [0, count) параллельно и возвращается,
+/// когда выполнены все вызовы
+using parallel_runner =
+    std::function<void(size_t count, const consumer<size_t>& func)>;
 
 using wstringchecker = std::function<bool(const std::wstring&)>;
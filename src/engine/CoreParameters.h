@@ -13,10 +13,15 @@ struct CoreParameters {
     std::filesystem::path userFolder = ".";
     std::filesystem::path scriptFile;
     std::filesystem::path projectFolder;
+    /// Файл трассы профилировщика, записываемой весь сеанс
+    std::filesystem::path traceFile;
 
     std::string debugServerString;
 
     int sps = 20;
+    /// Радиус в чанках вокруг (0, 0), генерируемый заранее при открытии
+    /// мира; 0 - без предварительной генерации
+    int pregenRadius = 0;
 
     std::unordered_map<std::string, std::string> projectArgs;
 };
@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <assert.h>
+#include <fstream>
 #include <filesystem>
 #include <unordered_set>
 
@@ -13,6 +14,7 @@
 #include <assets/AssetsLoader.h>
 #include <core_content_defs.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 #include <graphics/ui/GUI.h>
 #include <graphics/core/ShaderProgram.h>
 #include <coders/GLSLExtension.h>
@@ -276,11 +278,21 @@ void Engine::renderFrame() {
 }
 
 void Engine::run() {
+    if (!params.traceFile.empty()) {
+        debug::Profiler::setThreadName("main");
+        debug::Profiler::startCapture();
+    }
     if (params.headless) {
         ServerMainloop(*this).run();
     } else {
         Mainloop(*this).run();
     }
+    if (debug::Profiler::isCapturing() && !params.traceFile.empty()) {
+        std::ofstream file(params.traceFile);
+        size_t count = debug::Profiler::stopCapture(file);
+        logger.info() << "written " << count << " profiler events to "
+                      << params.traceFile.string();
+    }
 }
 
 void Engine::postUpdate() {
@@ -76,6 +76,7 @@ public:
     static inline io::path CONFIG_DEFAULTS = "config/defaults.toml";
     static inline io::path CONTROLS_FILE = "user:controls.toml";
     static inline io::path SETTINGS_FILE = "user:settings.toml";
+    static inline io::path CONTENT_CACHE_FILE = "user:content_cache.bin";
 private:
     std::filesystem::path resourcesFolder;
     std::filesystem::path userFilesFolder;
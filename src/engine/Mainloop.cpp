@@ -4,6 +4,7 @@
 #include <window/Window.h>
 #include <frontend/screens/MenuScreen.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 #include <frontend/screens/LevelScreen.h>
 #include <world/Level.h>
 #include <devtools/Project.h>
@@ -43,12 +44,23 @@ void Mainloop::run() {
     logger.info() << "Main loop started";
     while (!window.isShouldClose()) {
         time.update(window.time());
-        engine.applicationSpark();
-        engine.updateFrontend();
+        {
+            PROFILE_ZONE("app.spark");
+            engine.applicationSpark();
+        }
+        {
+            PROFILE_ZONE("update");
+            engine.updateFrontend();
+        }
         if (!window.isIconified()) {
+            PROFILE_ZONE("render");
             engine.renderFrame();
         }
-        engine.postUpdate();
+        {
+            PROFILE_ZONE("post-update");
+            engine.postUpdate();
+        }
+        PROFILE_FRAME();
         engine.nextFrame(
             settings.display.adaptiveFpsInMenu.get() &&
             dynamic_cast<const MenuScreen*>(engine.getScreen().get()) != nullptr
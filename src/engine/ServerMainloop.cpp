@@ -1,14 +1,21 @@
 #include <engine/ServerMainloop.h>
 
 #include <chrono>
+#include <cmath>
+#include <stdexcept>
 
 #include <engine/Engine.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 #include <interfaces/Process.h>
 #include <devtools/Project.h>
 #include <logic/LevelController.h>
 #include <world/Level.h>
 #include <world/World.h>
+#include <objects/Player.h>
+#include <objects/Players.h>
+#include <math/voxmaths.h>
+#include <constants.h>
 #include <util/platform.h>
 #include <devtools/AppScriptsControl.h>
 
@@ -48,10 +55,19 @@ void ServerMainloop::run() {
             controller->getLevel()->getWorld().updateTimers(delta);
             controller->update(glm::min(delta, 0.2), false);
         }
-        engine.applicationSpark();
-        engine.postUpdate();
+        {
+            PROFILE_ZONE("app.spark");
+            engine.applicationSpark();
+        }
+        {
+            PROFILE_ZONE("post-update");
+            engine.postUpdate();
+        }
+        PROFILE_FRAME();
 
-        if (!coreParams.testMode) {
+        // Предварительная генерация занимает всё время между тиками
+        bool pregenerating = controller && controller->getPregenerator();
+        if (!coreParams.testMode && !pregenerating) {
             auto end = std::chrono::system_clock::now();
             int64_t millis = targetDelta * 1000 - std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count() / 1000;
             if (millis > 0) platform::sleep(millis);
@@ -61,6 +77,28 @@ void ServerMainloop::run() {
     logger.info() << "Script finished";
 }
 
+/// @brief Центр предварительной генерации в координатах чанков: точка
+/// появления игрока с наименьшим id, а если она ещё не выбрана - его позиция
+static glm::ivec2 get_pregen_center(const Level& level) {
+    const Player* first = nullptr;
+    for (const auto& [id, player] : *level.players) {
+        if (first == nullptr || player->getId() < first->getId()) {
+            first = player.get();
+        }
+    }
+    if (first == nullptr) {
+        return {};
+    }
+    glm::vec3 position = first->getSpawnPoint();
+    if (std::isnan(position.x) || std::isnan(position.z)) {
+        position = first->getPosition();
+    }
+    return {
+        floordiv<CHUNK_WIDTH>(static_cast<int>(glm::floor(position.x))),
+        floordiv<CHUNK_DEPTH>(static_cast<int>(glm::floor(position.z)))
+    };
+}
+
 void ServerMainloop::setLevel(std::unique_ptr<Level> level) {
     if (level == nullptr) {
         controller->onWorldQuit();
@@ -69,5 +107,16 @@ void ServerMainloop::setLevel(std::unique_ptr<Level> level) {
         controller = std::make_unique<LevelController>(
             engine, std::move(level), nullptr
         );
+        int pregenRadius = engine.getCoreParameters().pregenRadius;
+        if (pregenRadius > 0) {
+            try {
+                auto center = get_pregen_center(*controller->getLevel());
+                controller->pregenerate(
+                    PregenArea::circle(center.x, center.y, pregenRadius)
+                );
+            } catch (const std::runtime_error& err) {
+                logger.error() << "pre-generation failed: " << err.what();
+            }
+        }
     }
 }
@@ -35,6 +35,7 @@
 #include <network/Network.h>
 #include <objects/Entt_Entity.h>
 #include <graphics/ui/GUI.h>
+#include <debug/Profiler.h>
 
 static std::shared_ptr<gui::Label> create_label(gui::GUI& gui, wstringsupplier supplier) {
     auto label = std::make_shared<gui::Label>(gui, L"-");
@@ -46,6 +47,32 @@ static bool should_keep_previous(gui::GUI& gui) {
     return !gui.getInput().isCursorLocked();
 }
 
+/// Глубина и число зон профилировщика, выводимых в панели
+inline constexpr uint32_t PROFILER_MAX_DEPTH = 2;
+inline constexpr size_t PROFILER_MAX_LINES = 16;
+
+static std::wstring format_millis(uint64_t nanos) {
+    auto millis = std::to_wstring(nanos / 1000 / 1000.0);
+    return millis.substr(0, millis.find(L'.') + 3) + L" ms";
+}
+
+static std::wstring format_profiler_frame() {
+    std::wstring text = L"Frame: " +
+                        format_millis(debug::Profiler::getLastFrameTime());
+    size_t lines = 0;
+    for (const auto& node : debug::Profiler::getLastFrame()) {
+        if (node.depth > PROFILER_MAX_DEPTH) continue;
+        if (++lines > PROFILER_MAX_LINES) break;
+        text += L"\n" + std::wstring(node.depth * 2 + 2, L' ') +
+                util::str2wstr_utf8(node.name) + L": " +
+                format_millis(node.time);
+        if (node.calls > 1) {
+            text += L" x" + std::to_wstring(node.calls);
+        }
+    }
+    return text;
+}
+
 std::shared_ptr<gui::UINode> create_debug_panel(
     Engine& engine,
     Level& level,
@@ -150,8 +177,18 @@ std::shared_ptr<gui::UINode> create_debug_panel(
         return drawCallsMinMaxString;
     }));
     panel->add(std::shared_ptr<gui::Label>(create_label(gui, [&]() {
-        return L"Chunks: " + std::to_wstring(level.chunks->size()) + L" (visible: " + std::to_wstring(ChunksRenderer::visibleChunks) + L")";
+        return L"Chunks: " + std::to_wstring(level.chunks->size()) + L" (visible: " + std::to_wstring(ChunksRenderer::visibleChunks) + L", sections: " + std::to_wstring(ChunksRenderer::visibleSections) + L")";
     })));
+    panel->add(create_label(gui, []() {
+        const auto& stats = ChunksRenderer::meshBuffersStats;
+        return L"Mesh buffers: " + std::to_wstring(stats.usedBytes >> 10) +
+               L"/" + std::to_wstring(stats.allocatedBytes >> 10) + L"/" +
+               std::to_wstring(stats.limitBytes >> 10) + L" KiB, reused " +
+               std::to_wstring(stats.reused) + L"/" +
+               std::to_wstring(stats.acquired) + L", waits " +
+               std::to_wstring(stats.waits) + L", deferred " +
+               std::to_wstring(stats.failures);
+    }));
     panel->add(std::shared_ptr<gui::Label>(create_label(gui, [=]() {
         return L"Particles: " +
                 std::to_wstring(ParticlesRenderer::visibleParticles) +
@@ -329,6 +366,18 @@ std::shared_ptr<gui::UINode> create_debug_panel(
         });
         panel->add(checkbox);
     }
+    {
+        auto checkbox = std::make_shared<gui::FullCheckBox>(
+            gui, L"Occlusion-Culling", glm::vec2(400, 24)
+        );
+        checkbox->setSupplier([&engine]() {
+            return engine.getSettings().graphics.occlusionCulling.get();
+        });
+        checkbox->setConsumer([&engine](bool checked) {
+            engine.getSettings().graphics.occlusionCulling.set(checked);
+        });
+        panel->add(checkbox);
+    }
     {
         auto checkbox = std::make_shared<gui::FullCheckBox>(
             gui, L"Show Chunk Borders", glm::vec2(400, 24)
@@ -378,6 +427,30 @@ std::shared_ptr<gui::UINode> create_debug_panel(
         panel->add(checkbox);
     }
 
+    {
+        auto checkbox = std::make_shared<gui::FullCheckBox>(
+            gui, L"Profiler", glm::vec2(400, 24)
+        );
+        checkbox->setSupplier([=]() {
+            return debug::Profiler::isEnabled();
+        });
+        checkbox->setConsumer([=](bool checked) {
+            debug::Profiler::setEnabled(checked);
+        });
+        panel->add(checkbox);
+
+        static std::wstring profilerString;
+        panel->listenInterval(0.5f, []() {
+            profilerString = debug::Profiler::isEnabled()
+                                 ? format_profiler_frame()
+                                 : std::wstring();
+        });
+        auto label = create_label(gui, []() { return profilerString; });
+        label->setMultiline(true);
+        label->setAutoResize(true);
+        panel->add(label);
+    }
+
     panel->refresh();
     return panel;
 }
@@ -1,19 +1,26 @@
 #include <graphics/core/Atlas.h>
 
+#include <algorithm>
 #include <stdexcept>
 
-#include <math/LMPacker.h>
+#include <math/SkylinePacker.h>
 #include <graphics/core/Texture.h>
 #include <graphics/core/ImageData.h>
+#include <util/ThreadPool.h>
 #include <debug/Logger.h>
 
+/// Меньшее число изображений копируется в вызывающем потоке
+inline constexpr size_t MIN_PARALLEL_ENTRIES = 64;
+/// Число изображений в одном задании копирования
+inline constexpr size_t BLIT_RANGE_SIZE = 32;
+
 Atlas::Atlas(
     std::unique_ptr<ImageData> image,
     std::unordered_map<std::string, UVRegion> regions,
     bool prepare
 ) : texture(nullptr), 
     image(std::move(image)), 
-    regions(regions) 
+    regions(std::move(regions)) 
 {
     if (prepare) this->prepare();
 }
@@ -67,49 +74,138 @@ bool AtlasBuilder::has(const std::string& name) const {
     return names.find(name) != names.end();
 }
 
-std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint maxResolution) {
+static void blit_entry(
+    ImageData& canvas,
+    const ImageData& image,
+    const rectangle& rect,
+    uint extrusion
+) {
+    canvas.blit(image, rect.x, rect.y);
+    for (uint j = 0; j < extrusion; ++j) {
+        canvas.extrude(
+            rect.x - j, rect.y - j, rect.width + j * 2, rect.height + j * 2
+        );
+    }
+}
+
+/// @brief Рабочий пула копирования: вызывает функцию для индекса задания
+class AtlasBlitWorker : public util::Worker<size_t, int> {
+    const consumer<size_t>& func;
+public:
+    AtlasBlitWorker(const consumer<size_t>& func) : func(func) {
+    }
+
+    int operator()(const size_t& index) override {
+        func(index);
+        return 0;
+    }
+};
+
+std::unique_ptr<Atlas> AtlasBuilder::build(
+    uint extrusion, bool prepare, uint maxResolution, int workers
+) {
+    return build(
+        extrusion,
+        prepare,
+        maxResolution,
+        [workers](size_t count, const consumer<size_t>& func) {
+            if (workers == 1 || count == 1) {
+                for (size_t i = 0; i < count; ++i) {
+                    func(i);
+                }
+                return;
+            }
+            util::ThreadPool<size_t, int> pool(
+                "atlas-blit",
+                [&]() { return std::make_unique<AtlasBlitWorker>(func); },
+                [](int&&) {},
+                workers
+            );
+            for (size_t i = 0; i < count; ++i) {
+                pool.enqueueJob(size_t(i));
+            }
+            size_t done = 0;
+            while (done < count) {
+                if (!pool.isActive()) {
+                    throw std::runtime_error("atlas blit pool stopped");
+                }
+                pool.waitForResults();
+                done += pool.pullResults();
+            }
+        }
+    );
+}
+
+std::unique_ptr<Atlas> AtlasBuilder::build(
+    uint extrusion,
+    bool prepare,
+    uint maxResolution,
+    const parallel_runner& parallel
+) {
     if (maxResolution == 0) maxResolution = Texture::MAX_RESOLUTION;
 
     auto sizes = std::make_unique<uint[]>(entries.size() * 2);
 
     uint idx = 0;
-    for (auto entry : entries) {
-        auto image = entry.image;
+    size_t area = 0;
+    for (const auto& entry : entries) {
+        const auto& image = entry.image;
         sizes[idx++] = image->getWidth();
         sizes[idx++] = image->getHeight();
+        area += static_cast<size_t>(image->getWidth() + extrusion * 2) *
+                (image->getHeight() + extrusion * 2);
     }
-    LMPacker packer(sizes.get(), entries.size() * 2);
+    SkylinePacker packer(sizes.get(), entries.size() * 2);
     sizes.reset(nullptr);
 
     uint width = 32;
     uint height = 32;
-
-    while (!packer.buildCompact(width, height, extrusion)) {
+    // Размеры меньше суммарной площади заведомо не подходят
+    while (static_cast<size_t>(width) * height < area &&
+           width <= maxResolution && height <= maxResolution) {
         if (width > height) height *= 2;
         else width *= 2;
-
+    }
+    while (width > maxResolution || height > maxResolution ||
+           !packer.build(width, height, extrusion)) {
         if (width > maxResolution || height > maxResolution) {
             throw std::runtime_error("Max atlas resolution " + std::to_string(maxResolution) + " exceeded");
         }
+        if (width > height) height *= 2;
+        else width *= 2;
     }
 
     auto canvas = std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
+    const auto& rects = packer.getResult();
+    // Области изображений вместе с отступами под продление краёв не
+    // пересекаются, поэтому диапазоны копируются в холст без синхронизации
+    auto blitRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& rect = rects[i];
+            blit_entry(*canvas, *entries[rect.idx].image, rect, extrusion);
+        }
+    };
+    if (rects.size() < MIN_PARALLEL_ENTRIES) {
+        blitRange(0, rects.size());
+    } else {
+        size_t ranges = (rects.size() + BLIT_RANGE_SIZE - 1) / BLIT_RANGE_SIZE;
+        parallel(ranges, [&](size_t range) {
+            size_t begin = range * BLIT_RANGE_SIZE;
+            blitRange(begin, std::min(begin + BLIT_RANGE_SIZE, rects.size()));
+        });
+    }
+
     std::unordered_map<std::string, UVRegion> regions;
-    std::vector<rectangle> rects = packer.getResult();
-    for (uint i = 0; i < entries.size(); ++i) {
-        const rectangle& rect = rects[i];
-        const atlasentry& entry = entries[rect.idx];
+    regions.reserve(rects.size());
+    float unitX = 1.0f / width;
+    float unitY = 1.0f / height;
+    for (const auto& rect : rects) {
         uint x = rect.x;
         uint y = rect.y;
         uint w = rect.width;
         uint h = rect.height;
-        canvas->blit(*entry.image, rect.x, rect.y);
-        for (uint j = 0; j < extrusion; ++j) {
-            canvas->extrude(x - j, y - j, w + j * 2, h + j * 2);
-        }
-        float unitX = 1.0f / width;
-        float unitY = 1.0f / height;
-        regions[entry.name] = UVRegion(unitX * x, unitY * y, unitX * (x + w), unitY * (y + h));
+        regions[entries[rect.idx].name] =
+            UVRegion(unitX * x, unitY * y, unitX * (x + w), unitY * (y + h));
     }
-    return std::make_unique<Atlas>(std::move(canvas), regions, prepare);
+    return std::make_unique<Atlas>(std::move(canvas), std::move(regions), prepare);
 }
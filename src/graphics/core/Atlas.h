@@ -9,6 +9,7 @@
 
 #include <math/UVRegion.h>
 #include <typedefs.h>
+#include <delegates.h>
 
 class ImageData;
 class Texture;
@@ -54,5 +55,26 @@ public:
     bool has(const std::string& name) const;
     const std::set<std::string>& getNames() {return names;};
 
-    std::unique_ptr<Atlas> build(uint extrusion, bool prepare=true, uint maxResolution=0);
+    /// @brief Упаковывает изображения в атлас
+    /// @param extrusion ширина продления краёв изображений в пикселях
+    /// @param prepare создать текстуру сразу (требует GL-контекста)
+    /// @param maxResolution наибольший размер стороны (0 - ограничение
+    /// текстур)
+    /// @param workers число потоков копирования изображений в холст
+    /// (0 - по числу ядер, 1 - в вызывающем потоке)
+    std::unique_ptr<Atlas> build(
+        uint extrusion,
+        bool prepare = true,
+        uint maxResolution = 0,
+        int workers = 1
+    );
+
+    /// @brief Упаковывает изображения в атлас, копируя их в холст
+    /// через внешний исполнитель (например, общий пул загрузчика)
+    std::unique_ptr<Atlas> build(
+        uint extrusion,
+        bool prepare,
+        uint maxResolution,
+        const parallel_runner& parallel
+    );
 };
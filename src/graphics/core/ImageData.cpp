@@ -370,16 +370,18 @@ void ImageData::blitMatchingFormat(const ImageData& image, int x, int y) {
     const uint src_height = image.getHeight();
     ubyte* data = this->data.get();
 
+    int beginx = std::max(0, -x);
+    int endx = std::min<int>(src_width, static_cast<int>(width) - x);
+    if (endx <= beginx) {
+        return;
+    }
+    // Строки копируются целиком
+    size_t rowSize = (endx - beginx) * comps;
     for (uint srcy = std::max(0, -y); srcy < std::min(src_height, height - y); ++srcy) {
-        for (uint srcx = std::max(0, -x); srcx < std::min(src_width, width - x); ++srcx) {
-            uint dstx = srcx + x;
-            uint dsty = srcy + y;
-            uint dstidx = (dsty * width + dstx) * comps;
-            uint srcidx = (srcy * src_width + srcx) * comps;
-            for (uint c = 0; c < comps; ++c) {
-                data[dstidx + c] = source[srcidx + c];
-            }
-        }
+        uint dsty = srcy + y;
+        uint dstidx = (dsty * width + beginx + x) * comps;
+        uint srcidx = (srcy * src_width + beginx) * comps;
+        std::memcpy(data + dstidx, source + srcidx, rowSize);
     }
 }
 
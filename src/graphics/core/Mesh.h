@@ -55,6 +55,11 @@ public:
         reload(vertexBuffer, vertexCount, indices, streaming);
     }
 
+    /// @brief Заменяет содержимое индексного буфера, не трогая вершины
+    void reloadIndices(
+        const uint32_t* indices, size_t indexCount, int iboIndex = 0
+    );
+
     /**
      * @brief Отрисовывает меш с указанным типом примитива.
      * @param primitive Тип примитива OpenGL (например, GL_TRIANGLES, GL_LINES).
@@ -125,6 +125,27 @@ void Mesh<VertexStructure>::reload(
     }
 }
 
+template<typename VertexStructure>
+void Mesh<VertexStructure>::reloadIndices(
+    const uint32_t* indices, size_t indexCount, int iboIndex
+) {
+    auto& buffer = IBOs.at(iboIndex);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffer.ibo);
+    if (buffer.indexCount == indexCount) {
+        glBufferSubData(
+            GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(uint32_t) * indexCount, indices
+        );
+    } else {
+        buffer.indexCount = indexCount;
+        glBufferData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            sizeof(uint32_t) * indexCount,
+            indices,
+            GL_DYNAMIC_DRAW
+        );
+    }
+}
+
 template<typename VertexStructure>
 void Mesh<VertexStructure>::draw(unsigned int primitive, int iboIndex) const {
     MeshStats::drawCalls++;
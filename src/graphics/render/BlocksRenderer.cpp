@@ -1,5 +1,9 @@
 #include <graphics/render/BlocksRenderer.h>
 
+#include <array>
+#include <cstring>
+#include <vector>
+
 #include <graphics/core/Mesh.h>
 #include <math/UVRegion.h>
 #include <constants.h>
@@ -15,22 +19,109 @@
 inline constexpr glm::vec3 SUN_VECTOR = {0.528265, 0.833149, -0.163704};
 constexpr float DIRECTIONAL_LIGHT_FACTOR = 0.3f;
 
+// Начальная ёмкость буферов; растёт до максимальной при переполнении
+inline constexpr size_t INITIAL_CAPACITY = 16'384;
+
+/// Все грани куба закрыты соседями
+inline constexpr uint ALL_FACES_CLOSED = 0x3F;
+
+/// Единичные векторы направлений в порядке FACE_*
+static const glm::ivec3 FACE_DIRECTIONS[6] {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+static int direction_index(const glm::ivec3& v) {
+    if (v.x) return v.x > 0 ? FACE_PX : FACE_MX;
+    if (v.y) return v.y > 0 ? FACE_PY : FACE_MY;
+    return v.z > 0 ? FACE_PZ : FACE_MZ;
+}
+
+/// Наибольшая сумма четырёх значений канала освещения
+inline constexpr int LIGHT_SUM_MAX = 15 * 4;
+
+/// Яркость канала вершины по сумме четырёх значений канала с учётом
+/// затенения грани по направлению на солнце, для каждого направления FACE_*
+static const auto FACE_SHADES = [] {
+    std::array<std::array<uint8_t, LIGHT_SUM_MAX + 1>, 6> shades {};
+    for (int dir = 0; dir < 6; ++dir) {
+        float d = glm::dot(glm::vec3(FACE_DIRECTIONS[dir]), SUN_VECTOR);
+        d = (1.0f - DIRECTIONAL_LIGHT_FACTOR) + d * DIRECTIONAL_LIGHT_FACTOR;
+        for (int sum = 0; sum <= LIGHT_SUM_MAX; ++sum) {
+            shades[dir][sum] = static_cast<uint8_t>(sum / 15.0f * 0.25f * d * 255);
+        }
+    }
+    return shades;
+}();
+
+/// Раскладывает каналы освещения по байтам, чтобы складывать их одним
+/// целочисленным сложением
+static inline uint32_t spread_light(light_t light) {
+    return (light & 0xF) | ((light & 0xF0) << 4) | ((light & 0xF00) << 8) |
+           (static_cast<uint32_t>(light & 0xF000) << 12);
+}
+
+static inline std::array<uint8_t, 4> shade_light(
+    const uint8_t* shades, uint32_t sum
+) {
+    return {
+        shades[sum & 0xFF],
+        shades[(sum >> 8) & 0xFF],
+        shades[(sum >> 16) & 0xFF],
+        shades[sum >> 24]
+    };
+}
+
+struct BlocksRenderer::CubeFace {
+    glm::ivec3 axisX;
+    glm::ivec3 axisY;
+    /// Нормаль грани, направление на соседа
+    glm::ivec3 axisZ;
+    /// Направление нормали FACE_*
+    int direction;
+    /// Вершины относительно центра блока
+    glm::vec3 corners[4];
+    /// Смещения в VoxelsRenderVolume освещения 3x3 соседей перед гранью
+    int lightOffsets[9];
+    uint8_t normal[3];
+};
+
+/// Грани куба одной ориентации по индексам текстур FACE_*
+struct BlocksRenderer::CubeFaces {
+    CubeFace faces[6];
+};
+
 BlocksRenderer::BlocksRenderer(
     size_t capacity,
     const Block* const* blockDefs,
+    const ubyte* blockProps,
     const ContentGfxCache& cache,
     const EngineSettings& settings
-) : vertexBuffer(std::make_unique<ChunkVertex[]>(capacity)),
-    indexBuffer(std::make_unique<uint32_t[]>(capacity)),
-    denseIndexBuffer(std::make_unique<uint32_t[]>(capacity)),
-    vertexCount(0),
+) : vertexCount(0),
     vertexOffset(0),
     indexCount(0),
-    capacity(capacity),
+    capacity(0),
+    maxCapacity(capacity),
+    blockProps(blockProps),
     cache(cache),
     settings(settings) 
 {
     blockDefsCache = blockDefs;
+    reserve(std::min(capacity, INITIAL_CAPACITY));
+}
+
+void BlocksRenderer::reserve(size_t capacity) {
+    vertexBuffer = std::make_unique<ChunkVertex[]>(capacity);
+    indexBuffer = std::make_unique<uint32_t[]>(capacity);
+    denseIndexBuffer = std::make_unique<uint32_t[]>(capacity);
+    this->capacity = capacity;
+}
+
+bool BlocksRenderer::growOnOverflow() {
+    if (!overflow || capacity >= maxCapacity) {
+        return false;
+    }
+    reserve(std::min(capacity * 2, maxCapacity));
+    return true;
 }
 
 BlocksRenderer::~BlocksRenderer() = default;
@@ -384,65 +475,194 @@ void BlocksRenderer::blockCustomModel(
     }
 }
 
-/* Fastest solid shaded blocks render method */
+const BlocksRenderer::CubeFaces& BlocksRenderer::getCubeFaces(
+    const Block& block, uint8_t rotation
+) {
+    // Таблицы для всех ортогональных троек осей, по индексу
+    // (dirX * 6 + dirY) * 6 + dirZ
+    static const auto table = [] {
+        std::array<uint8_t, 6 * 6 * 6> indices {};
+        std::vector<CubeFaces> orientations;
+        constexpr int W = VoxelsRenderVolume::width;
+        constexpr int D = VoxelsRenderVolume::depth;
+        for (int key = 0; key < 6 * 6 * 6; ++key) {
+            const auto& X = FACE_DIRECTIONS[key / 36];
+            const auto& Y = FACE_DIRECTIONS[key / 6 % 6];
+            const auto& Z = FACE_DIRECTIONS[key % 6];
+            if (X * Y != glm::ivec3(0) || Y * Z != glm::ivec3(0) ||
+                X * Z != glm::ivec3(0)) {
+                continue;
+            }
+            const glm::ivec3 axes[6][3] {
+                {Z, Y, -X}, {-Z, Y, X}, {X, Z, -Y},
+                {X, -Z, Y}, {-X, Y, -Z}, {X, Y, Z},
+            };
+            CubeFaces cube {};
+            for (int side = 0; side < 6; ++side) {
+                auto& face = cube.faces[side];
+                face.axisX = axes[side][0];
+                face.axisY = axes[side][1];
+                face.axisZ = axes[side][2];
+                face.direction = direction_index(face.axisZ);
+
+                glm::vec3 fx(face.axisX);
+                glm::vec3 fy(face.axisY);
+                glm::vec3 fz(face.axisZ);
+                face.corners[0] = (-fx - fy + fz) * 0.5f;
+                face.corners[1] = ( fx - fy + fz) * 0.5f;
+                face.corners[2] = ( fx + fy + fz) * 0.5f;
+                face.corners[3] = (-fx + fy + fz) * 0.5f;
+
+                for (int b = -1; b <= 1; ++b) {
+                    for (int a = -1; a <= 1; ++a) {
+                        auto d = face.axisZ + face.axisX * a + face.axisY * b;
+                        face.lightOffsets[(b + 1) * 3 + a + 1] =
+                            (d.y * D + d.z) * W + d.x;
+                    }
+                }
+                for (int i = 0; i < 3; ++i) {
+                    face.normal[i] = static_cast<uint8_t>(face.axisZ[i] * 127 + 128);
+                }
+            }
+            indices[key] = orientations.size();
+            orientations.push_back(cube);
+        }
+        return std::make_pair(indices, std::move(orientations));
+    }();
+    // Без поворота - оси X, Y, Z
+    int key = (FACE_PX * 6 + FACE_PY) * 6 + FACE_PZ;
+    if (block.rotatable) {
+        const auto& axes = block.rotations.variants[rotation].axes;
+        key = (direction_index(axes[0]) * 6 + direction_index(axes[1])) * 6 +
+              direction_index(axes[2]);
+    }
+    return table.second[table.first[key]];
+}
+
+void BlocksRenderer::pickFaceLights(
+    const glm::ivec3& coord, const CubeFace& face, uint32_t (&dst)[9]
+) const {
+    constexpr int W = VoxelsRenderVolume::width;
+    constexpr int D = VoxelsRenderVolume::depth;
+    if (coord.y > 0 && coord.y + 1 < VoxelsRenderVolume::height) {
+        const light_t* lights = voxelsBuffer->getLights() + vox_index(
+            coord.x + VOXELS_BUFFER_PADDING,
+            coord.y,
+            coord.z + VOXELS_BUFFER_PADDING,
+            W, D
+        );
+        for (int i = 0; i < 9; ++i) {
+            dst[i] = spread_light(lights[face.lightOffsets[i]]);
+        }
+        return;
+    }
+    // У нижнего и верхнего слоёв соседи могут быть вне объёма
+    for (int b = -1; b <= 1; ++b) {
+        for (int a = -1; a <= 1; ++a) {
+            auto pos = coord + face.axisZ + face.axisX * a + face.axisY * b;
+            dst[(b + 1) * 3 + a + 1] = spread_light(voxelsBuffer->pickLight(
+                chunk->chunk_x * CHUNK_WIDTH + pos.x,
+                pos.y,
+                chunk->chunk_z * CHUNK_DEPTH + pos.z
+            ));
+        }
+    }
+}
+
+template <bool ao, bool lights>
+void BlocksRenderer::cubeFace(
+    const glm::ivec3& coord, const CubeFace& face, const UVRegion& region
+) {
+    if (vertexCount + 4 >= capacity || indexCount + 6 >= capacity) {
+        overflow = true;
+        return;
+    }
+    std::array<uint8_t, 4> colors[4];
+    if constexpr (lights) {
+        const uint8_t* shades = FACE_SHADES[face.direction].data();
+        if constexpr (ao) {
+            // Вершина усредняет четыре соседа из квадрата 3x3 у её угла
+            uint32_t l[9];
+            pickFaceLights(coord, face, l);
+            colors[0] = shade_light(shades, l[0] + l[1] + l[3] + l[4]);
+            colors[1] = shade_light(shades, l[1] + l[2] + l[4] + l[5]);
+            colors[2] = shade_light(shades, l[4] + l[5] + l[7] + l[8]);
+            colors[3] = shade_light(shades, l[3] + l[4] + l[6] + l[7]);
+        } else {
+            auto pos = coord + face.axisZ;
+            uint32_t light = spread_light(voxelsBuffer->pickLight(
+                chunk->chunk_x * CHUNK_WIDTH + pos.x,
+                pos.y,
+                chunk->chunk_z * CHUNK_DEPTH + pos.z
+            ));
+            colors[0] = colors[1] = colors[2] = colors[3] =
+                shade_light(shades, light * 4);
+        }
+    } else {
+        colors[0] = colors[1] = colors[2] = colors[3] =
+            {255, 255, 255, ao ? 255 : 0};
+    }
+    std::array<uint8_t, 4> normal {
+        face.normal[0], face.normal[1], face.normal[2], lights ? 0 : 255
+    };
+    glm::vec3 center(coord);
+    vertexBuffer[vertexCount++] = {
+        center + face.corners[0], {region.u1, region.v1}, colors[0], normal
+    };
+    vertexBuffer[vertexCount++] = {
+        center + face.corners[1], {region.u2, region.v1}, colors[1], normal
+    };
+    vertexBuffer[vertexCount++] = {
+        center + face.corners[2], {region.u2, region.v2}, colors[2], normal
+    };
+    vertexBuffer[vertexCount++] = {
+        center + face.corners[3], {region.u1, region.v2}, colors[3], normal
+    };
+    index(0, 1, 2, 0, 2, 3);
+}
+
+template <bool ao, bool lights>
 void BlocksRenderer::blockCube(
     const glm::ivec3& coord,
     const UVRegion(&texfaces)[6],
     const Block& block,
     blockstate states,
-    bool lights,
-    bool ao
+    uint closed
 ) {
     const auto& variant = block.getVariantByBits(states.userbits);
-    glm::ivec3 X(1, 0, 0);
-    glm::ivec3 Y(0, 1, 0);
-    glm::ivec3 Z(0, 0, 1);
-
-    if (block.rotatable) {
-        auto& rotations = block.rotations;
-        auto& orient = rotations.variants[states.rotation];
-        X = orient.axes[0];
-        Y = orient.axes[1];
-        Z = orient.axes[2];
+    const auto& cube = getCubeFaces(block, states.rotation);
+    for (int side = FACE_PZ; side >= FACE_MX; --side) {
+        const auto& face = cube.faces[side];
+        if ((closed >> face.direction) & 1) {
+            continue;
+        }
+        if (isOpen(coord + face.axisZ, block, variant)) {
+            cubeFace<ao, lights>(coord, face, texfaces[side]);
+        }
     }
+}
 
+/* Fastest solid shaded blocks render method */
+void BlocksRenderer::blockCube(
+    const glm::ivec3& coord,
+    const UVRegion(&texfaces)[6],
+    const Block& block,
+    blockstate states,
+    bool lights,
+    bool ao,
+    uint closed
+) {
     if (ao) {
-        if (isOpen(coord + Z, block, variant)) {
-            faceAO(coord, X, Y, Z, texfaces[5], lights);
-        }
-        if (isOpen(coord - Z, block, variant)) {
-            faceAO(coord, -X, Y, -Z, texfaces[4], lights);
-        }
-        if (isOpen(coord + Y, block, variant)) {
-            faceAO(coord, X, -Z, Y, texfaces[3], lights);
-        }
-        if (isOpen(coord - Y, block, variant)) {
-            faceAO(coord, X, Z, -Y, texfaces[2], lights);
-        }
-        if (isOpen(coord + X, block, variant)) {
-            faceAO(coord, -Z, Y, X, texfaces[1], lights);
-        }
-        if (isOpen(coord - X, block, variant)) {
-            faceAO(coord, Z, Y, -X, texfaces[0], lights);
+        if (lights) {
+            blockCube<true, true>(coord, texfaces, block, states, closed);
+        } else {
+            blockCube<true, false>(coord, texfaces, block, states, closed);
         }
     } else {
-        if (isOpen(coord + Z, block, variant)) {
-            face(coord, X, Y, Z, texfaces[5], lights ? pickLight(coord + Z) : glm::vec4(1, 1, 1, 0), lights);
-        }
-        if (isOpen(coord - Z, block, variant)) {
-            face(coord, -X, Y, -Z, texfaces[4], lights ? pickLight(coord - Z) : glm::vec4(1, 1, 1, 0), lights);
-        }
-        if (isOpen(coord + Y, block, variant)) {
-            face(coord, X, -Z, Y, texfaces[3], lights ? pickLight(coord + Y) : glm::vec4(1, 1, 1, 0), lights);
-        }
-        if (isOpen(coord - Y, block, variant)) {
-            face(coord, X, Z, -Y, texfaces[2], lights ? pickLight(coord - Y) : glm::vec4(1, 1, 1, 0), lights);
-        }
-        if (isOpen(coord + X, block, variant)) {
-            face(coord, -Z, Y, X, texfaces[1], lights ? pickLight(coord + X) : glm::vec4(1, 1, 1, 0), lights);
-        }
-        if (isOpen(coord - X, block, variant)) {
-            face(coord, Z, Y, -X, texfaces[0], lights ? pickLight(coord - X) : glm::vec4(1, 1, 1, 0), lights);
+        if (lights) {
+            blockCube<false, true>(coord, texfaces, block, states, closed);
+        } else {
+            blockCube<false, false>(coord, texfaces, block, states, closed);
         }
     }
 }
@@ -484,97 +704,160 @@ glm::vec4 BlocksRenderer::pickSoftLight(
     );
 }
 
+uint32_t BlocksRenderer::computeOccluders(int y, int z) const {
+    constexpr uint32_t ALL = (1U << (CHUNK_WIDTH + 2)) - 1;
+    if (y < 0 || y >= VoxelsRenderVolume::height) {
+        return ALL;
+    }
+    const voxel* row = voxelsBuffer->getVoxels() + vox_index(
+        VOXELS_BUFFER_PADDING - 1,
+        y,
+        z + VOXELS_BUFFER_PADDING,
+        VoxelsRenderVolume::width,
+        VoxelsRenderVolume::depth
+    );
+    uint32_t bits = 0;
+    for (int i = 0; i < CHUNK_WIDTH + 2; ++i) {
+        blockid_t id = row[i].id;
+        uint32_t occluder =
+            id == BLOCK_VOID || (blockProps[id] & BLOCK_PROP_OCCLUDER);
+        bits |= occluder << i;
+    }
+    return bits;
+}
+
+void BlocksRenderer::updateClosedFaces(int y, int z) {
+    if (occludersY != y) {
+        int first = 0;
+        if (occludersY == y - 1) {
+            // Слои сдвигаются вверх, вычисляется только y+1
+            std::memcpy(occluders[0], occluders[1], sizeof(occluders[0]));
+            std::memcpy(occluders[1], occluders[2], sizeof(occluders[1]));
+            first = 2;
+        }
+        for (int layer = first; layer < 3; ++layer) {
+            for (int rz = -1; rz <= CHUNK_DEPTH; ++rz) {
+                occluders[layer][rz + 1] = computeOccluders(y + layer - 1, rz);
+            }
+        }
+        occludersY = y;
+    }
+    // Сосед вокселя x по каждому направлению сдвигается в бит x
+    const uint32_t rows[6] {
+        occluders[1][z + 1],
+        occluders[1][z + 1] >> 2,
+        occluders[0][z + 1] >> 1,
+        occluders[2][z + 1] >> 1,
+        occluders[1][z] >> 1,
+        occluders[1][z + 2] >> 1,
+    };
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        uint8_t closed = 0;
+        for (int dir = 0; dir < 6; ++dir) {
+            closed |= ((rows[dir] >> x) & 1) << dir;
+        }
+        closedFaces[x] = closed;
+    }
+}
+
 void BlocksRenderer::render(
     const voxel* voxels, int totalBegin, int totalEnd
 ) {
     bool denseRender = this->denseRender;
     bool densePass = this->densePass;
     bool enableAO = settings.graphics.softLighting.get();
-    for (int i = totalBegin; i < totalEnd; ++i) {
-        const voxel& vox = voxels[i];
-        blockid_t id = vox.id;
-        blockstate state = vox.state;
-        const auto& def = *blockDefsCache[id];
-        uint8_t variantId = def.getVariantIndex(state.userbits);
-        const auto& variant = def.getVariant(variantId);
-        if (id == 0 || state.segment) continue;
-        if (denseRender != (variant.culling == CullingMode::Optional)) {
-            continue;
-        }
-        if (def.translucent) {
-            continue;
-        }
-        const UVRegion texfaces[6] {
-            cache.getRegion(id, variantId, 0, densePass),
-            cache.getRegion(id, variantId, 1, densePass),
-            cache.getRegion(id, variantId, 2, densePass),
-            cache.getRegion(id, variantId, 3, densePass),
-            cache.getRegion(id, variantId, 4, densePass),
-            cache.getRegion(id, variantId, 5, densePass)
-        };
-        int x = i % CHUNK_WIDTH;
-        int y = i / (CHUNK_DEPTH * CHUNK_WIDTH);
-        int z = (i / CHUNK_DEPTH) % CHUNK_WIDTH;
-        switch (def.getModel(state.userbits).type) {
-            case BlockModelType::Cube:
-                blockCube(
-                    {x, y, z},
-                    texfaces,
-                    def,
-                    vox.state,
-                    !def.shadeless,
-                    def.ambientOcclusion && enableAO
-                );
-                break;
-            case BlockModelType::X: {
-                if (!denseRender)
-                blockXSprite(
-                    x, y, z,
-                    glm::vec3(1.0f),
-                    texfaces[FACE_MX],
-                    texfaces[FACE_MZ],
-                    1.0f
-                );
-                break;
+    occludersY = std::numeric_limits<int>::min();
+    for (int row = totalBegin; row < totalEnd; row += CHUNK_WIDTH) {
+        int y = row / (CHUNK_DEPTH * CHUNK_WIDTH);
+        int z = (row / CHUNK_WIDTH) % CHUNK_DEPTH;
+        updateClosedFaces(y, z);
+        for (int x = 0; x < CHUNK_WIDTH; ++x) {
+            const voxel& vox = voxels[row + x];
+            blockid_t id = vox.id;
+            blockstate state = vox.state;
+            const auto& def = *blockDefsCache[id];
+            uint8_t variantId = def.getVariantIndex(state.userbits);
+            const auto& variant = def.getVariant(variantId);
+            if (id == 0 || state.segment) continue;
+            if (denseRender != (variant.culling == CullingMode::Optional)) {
+                continue;
             }
-            case BlockModelType::AABB: {
-                if (!denseRender)
-                blockAABB(
-                    {x, y, z},
-                    texfaces,
-                    &def,
-                    vox.state.rotation,
-                    !def.shadeless,
-                    def.ambientOcclusion && enableAO
-                );
-                break;
+            if (def.translucent) {
+                continue;
             }
-            case BlockModelType::Custom: {
-                blockCustomModel(
-                    {x, y, z},
-                    def,
-                    vox.state,
-                    !def.shadeless,
-                    def.ambientOcclusion && enableAO
-                );
-                break;
+            // Закрывающие соседи скрывают грани только при отсечении по умолчанию
+            uint closed = variant.culling == CullingMode::Default
+                ? closedFaces[x] : 0;
+            auto modelType = def.getModel(state.userbits).type;
+            if (closed == ALL_FACES_CLOSED &&
+                (modelType == BlockModelType::Cube ||
+                 (modelType == BlockModelType::Custom && !def.rt.extended))) {
+                continue;
             }
-            default:
-                break;
+            const UVRegion texfaces[6] {
+                cache.getRegion(id, variantId, 0, densePass),
+                cache.getRegion(id, variantId, 1, densePass),
+                cache.getRegion(id, variantId, 2, densePass),
+                cache.getRegion(id, variantId, 3, densePass),
+                cache.getRegion(id, variantId, 4, densePass),
+                cache.getRegion(id, variantId, 5, densePass)
+            };
+            switch (modelType) {
+                case BlockModelType::Cube:
+                    blockCube(
+                        {x, y, z},
+                        texfaces,
+                        def,
+                        vox.state,
+                        !def.shadeless,
+                        def.ambientOcclusion && enableAO,
+                        closed
+                    );
+                    break;
+                case BlockModelType::X: {
+                    if (!denseRender)
+                    blockXSprite(
+                        x, y, z,
+                        glm::vec3(1.0f),
+                        texfaces[FACE_MX],
+                        texfaces[FACE_MZ],
+                        1.0f
+                    );
+                    break;
+                }
+                case BlockModelType::AABB: {
+                    if (!denseRender)
+                    blockAABB(
+                        {x, y, z},
+                        texfaces,
+                        &def,
+                        vox.state.rotation,
+                        !def.shadeless,
+                        def.ambientOcclusion && enableAO
+                    );
+                    break;
+                }
+                case BlockModelType::Custom: {
+                    blockCustomModel(
+                        {x, y, z},
+                        def,
+                        vox.state,
+                        !def.shadeless,
+                        def.ambientOcclusion && enableAO
+                    );
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (overflow) return;
         }
-        if (overflow) return;
     }
 }
 
 SortingMeshData BlocksRenderer::renderTranslucent(
     const voxel* voxels, int totalBegin, int totalEnd
 ) {
-    SortingMeshData sortingMesh {{}};
-
-    AABB aabb {};
-    bool aabbInit = false;
-    size_t totalSize = 0;
-
     bool densePass = this->densePass;
     bool enableAO = settings.graphics.softLighting.get();
     for (int i = totalBegin; i < totalEnd; ++i) {
@@ -645,79 +928,64 @@ SortingMeshData BlocksRenderer::renderTranslucent(
             default:
                 break;
         }
-        if (vertexCount == 0) continue;
-
-        SortingMeshEntry entry {
-            glm::vec3(
-                x + chunk->chunk_x * CHUNK_WIDTH + 0.5f,
-                y + 0.5f,
-                z + chunk->chunk_z * CHUNK_DEPTH + 0.5f
-            ),
-            util::Buffer<ChunkVertex>(indexCount), 0};
-
-            totalSize += entry.vertexData.size();
-
-        for (int j = 0; j < indexCount; ++j) {
-            std::memcpy(
-                entry.vertexData.data() + j,
-                vertexBuffer.get() + indexBuffer[j],
-                sizeof(ChunkVertex)
-            );
-            ChunkVertex& vertex = entry.vertexData[j];
-            if (!aabbInit) {
-                aabbInit = true;
-                aabb.a = aabb.b = vertex.position;
-            } else {
-                aabb.addPoint(vertex.position);
-            }
-            vertex.position.x += chunk->chunk_x * CHUNK_WIDTH + 0.5f;
-            vertex.position.y += 0.5f;
-            vertex.position.z += chunk->chunk_z * CHUNK_DEPTH + 0.5f;
-        }
-        sortingMesh.entries.push_back(std::move(entry));
-        vertexCount = 0;
-        vertexOffset = indexCount = 0;
+        if (overflow) break;
     }
 
-    auto size = aabb.size();
-    if ((size.y < 0.01f || size.x < 0.01f || size.z < 0.01f) && sortingMesh.entries.size() > 1) {
-        SortingMeshEntry newEntry {
-            sortingMesh.entries[0].position,
-            util::Buffer<ChunkVertex>(totalSize),
-            0
-        };
-        size_t offset = 0;
-        for (const auto& entry : sortingMesh.entries) {
-            std::memcpy(
-                newEntry.vertexData.data() + offset,
-                entry.vertexData.data(),
-                entry.vertexData.size() * sizeof(ChunkVertex)
-            );
-            offset += entry.vertexData.size();
-        }
-        return SortingMeshData {{std::move(newEntry)}};
+    // Вершины переводятся в координаты мира, чтобы геометрию всех секций
+    // чанка можно было сортировать и рисовать как одно целое
+    SortingMeshData sortingMesh {
+        util::Buffer<ChunkVertex>(vertexBuffer.get(), vertexCount),
+        util::Buffer<uint32_t>(indexBuffer.get(), indexCount)
+    };
+    glm::vec3 offset(
+        chunk->chunk_x * CHUNK_WIDTH + 0.5f,
+        0.5f,
+        chunk->chunk_z * CHUNK_DEPTH + 0.5f
+    );
+    for (size_t i = 0; i < sortingMesh.vertices.size(); ++i) {
+        sortingMesh.vertices[i].position += offset;
     }
-
     return sortingMesh;
 }
 
 void BlocksRenderer::build(
-    const Chunk* chunk, const VoxelsRenderVolume& volume
+    const Chunk* chunk, const VoxelsRenderVolume& volume, int section
 ) {
-    meshAABB = AABB(glm::vec3(CHUNK_WIDTH, CHUNK_HEIGHT, CHUNK_DEPTH));
+    int sectionBegin = section * CHUNK_SECTION_HEIGHT;
+    int sectionEnd = sectionBegin + CHUNK_SECTION_HEIGHT;
+
+    this->section = section;
+    meshAABB = AABB(
+        glm::vec3(0, sectionBegin, 0),
+        glm::vec3(CHUNK_WIDTH, sectionEnd, CHUNK_DEPTH)
+    );
     this->chunk = chunk;
     this->voxelsBuffer = &volume;
 
+    cancelled = false;
+    overflow = false;
+    vertexCount = 0;
+    vertexOffset = indexCount = 0;
+    denseIndexCount = 0;
+    sortingMesh = {};
+    visibility = SectionVisibility::all();
+
+    int begin = std::max(chunk->bottom, sectionBegin);
+    int end = std::min(chunk->top, sectionEnd);
+    if (begin >= end) {
+        return;
+    }
     if (voxelsBuffer->pickBlockId(
-        chunk->chunk_x * CHUNK_WIDTH, 0, chunk->chunk_z * CHUNK_DEPTH
+        chunk->chunk_x * CHUNK_WIDTH, begin, chunk->chunk_z * CHUNK_DEPTH
     ) == BLOCK_VOID) {
         cancelled = true;
         return;
     }
     const voxel* voxels = chunk->voxels;
+    visibility = compute_section_visibility(voxels, blockDefsCache, section);
 
-    int totalBegin = chunk->bottom * (CHUNK_WIDTH * CHUNK_DEPTH);
-    int totalEnd = chunk->top * (CHUNK_WIDTH * CHUNK_DEPTH);
+    int totalBegin = begin * (CHUNK_WIDTH * CHUNK_DEPTH);
+    int totalEnd = end * (CHUNK_WIDTH * CHUNK_DEPTH);
 
     bool hasTranslucent = false;
 
@@ -730,19 +998,16 @@ void BlocksRenderer::build(
             break;
         }
     }
-    cancelled = false;
-
-    overflow = false;
-    vertexCount = 0;
-    vertexOffset = indexCount = 0;
 
     denseRender = false;
     densePass = false;
 
     if (hasTranslucent) {
         sortingMesh = renderTranslucent(voxels, totalBegin, totalEnd);
-    } else {
-        sortingMesh = {};
+        if (growOnOverflow()) {
+            build(chunk, volume, section);
+            return;
+        }
     }
 
     overflow = false;
@@ -769,41 +1034,304 @@ void BlocksRenderer::build(
     indexCount = endIndex;
     densePass = false;
     render(voxels, totalBegin, totalEnd);
+
+    if (growOnOverflow()) {
+        build(chunk, volume, section);
+    }
+}
+
+/// Оси граней в порядке -x, +x, -y, +y, -z, +z: {X, Y, нормаль}
+static const glm::ivec3 LOD_FACE_AXES[6][3] {
+    {{0, 0, 1}, {0, 1, 0}, {-1, 0, 0}},
+    {{0, 0, -1}, {0, 1, 0}, {1, 0, 0}},
+    {{1, 0, 0}, {0, 0, 1}, {0, -1, 0}},
+    {{1, 0, 0}, {0, 0, -1}, {0, 1, 0}},
+    {{-1, 0, 0}, {0, 1, 0}, {0, 0, -1}},
+    {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}},
+};
+
+static inline bool is_lod_filler(const Block& def, blockstate state) {
+    return def.rt.id != BLOCK_AIR && !def.translucent &&
+           def.getModel(state.userbits).type != BlockModelType::X;
+}
+
+static inline bool is_lod_translucent(const Block& def, blockstate state) {
+    return def.translucent &&
+           def.getModel(state.userbits).type != BlockModelType::X;
+}
+
+bool BlocksRenderer::isLodCellOpen(
+    const glm::ivec3& cell, int step, int face, blockid_t translucent
+) const {
+    const auto& normal = LOD_FACE_AXES[face][2];
+    auto next = cell + normal;
+    if (next.y < 0) {
+        return false;
+    } else if (next.y >= CHUNK_HEIGHT / step) {
+        return true;
+    }
+    int width = CHUNK_WIDTH / step;
+    int depth = CHUNK_DEPTH / step;
+    if (next.x >= 0 && next.z >= 0 && next.x < width && next.z < depth) {
+        size_t index = vox_index(next.x, next.y, next.z, width, depth);
+        if (lodCells[index] != BLOCK_AIR) {
+            return false;
+        }
+        return translucent == BLOCK_AIR ||
+               lodTranslucentCells[index] != translucent;
+    }
+    // Ячейки соседнего чанка недоступны: грань скрыта, только если
+    // прилегающий слой вокселей полностью заполнен (дыр не бывает)
+    const auto& axisX = LOD_FACE_AXES[face][0];
+    const auto& axisY = LOD_FACE_AXES[face][1];
+    glm::ivec3 origin = cell * step;
+    origin += glm::max(normal, glm::ivec3(0)) * (step - 1) + normal;
+    origin -= glm::min(axisX, glm::ivec3(0)) * (step - 1);
+    origin -= glm::min(axisY, glm::ivec3(0)) * (step - 1);
+    for (int v = 0; v < step; ++v) {
+        for (int u = 0; u < step; ++u) {
+            auto pos = origin + axisX * u + axisY * v;
+            const auto& vox = voxelsBuffer->pickBlock(
+                chunk->chunk_x * CHUNK_WIDTH + pos.x,
+                pos.y,
+                chunk->chunk_z * CHUNK_DEPTH + pos.z
+            );
+            if (vox.id == BLOCK_VOID) {
+                return false;
+            }
+            if (!is_lod_filler(*blockDefsCache[vox.id], vox.state) &&
+                (translucent == BLOCK_AIR || vox.id != translucent)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void BlocksRenderer::renderLod(
+    int step,
+    int cellsBegin,
+    int cellsEnd,
+    const std::vector<blockid_t>& cells,
+    bool translucent
+) {
+    int width = CHUNK_WIDTH / step;
+    int depth = CHUNK_DEPTH / step;
+    for (int cy = cellsBegin; cy < cellsEnd; ++cy) {
+        for (int cz = 0; cz < depth; ++cz) {
+            for (int cx = 0; cx < width; ++cx) {
+                glm::ivec3 cell(cx, cy, cz);
+                blockid_t id = cells[vox_index(cx, cy, cz, width, depth)];
+                if (id == BLOCK_AIR) continue;
+
+                const auto& def = *blockDefsCache[id];
+                bool lights = !def.shadeless;
+                glm::ivec3 base = cell * step;
+                glm::vec3 center = glm::vec3(base) + (step - 1) * 0.5f;
+                for (int side = 0; side < 6; ++side) {
+                    if (!isLodCellOpen(
+                            cell, step, side, translucent ? id : BLOCK_AIR
+                        )) {
+                        continue;
+                    }
+
+                    const auto& axes = LOD_FACE_AXES[side];
+                    glm::vec4 light(1, 1, 1, 0);
+                    if (lights) {
+                        // Максимум освещённости по прилегающему слою, так
+                        // как часть его может быть занята блоками ячейки
+                        glm::ivec3 sample = base + step / 2;
+                        int axis = axes[2].x ? 0 : (axes[2].y ? 1 : 2);
+                        sample[axis] = base[axis] +
+                            (axes[2][axis] > 0 ? step : -1);
+                        sample.y = std::min(sample.y, chunk->top);
+                        light = glm::vec4(0.0f);
+                        int half = step / 2;
+                        for (int v = -half; v < step - half; ++v) {
+                            for (int u = -half; u < step - half; ++u) {
+                                light = glm::max(light, pickLight(
+                                    sample + axes[0] * u + axes[1] * v
+                                ));
+                            }
+                        }
+                    }
+                    face(
+                        center + glm::vec3(axes[2]) * ((step - 1) * 0.5f),
+                        glm::vec3(axes[0]) * static_cast<float>(step),
+                        glm::vec3(axes[1]) * static_cast<float>(step),
+                        glm::vec3(axes[2]),
+                        cache.getRegion(id, 0, side, false),
+                        light,
+                        lights
+                    );
+                }
+                if (overflow) return;
+            }
+        }
+    }
+}
+
+void BlocksRenderer::buildLod(
+    const Chunk* chunk, const VoxelsRenderVolume& volume, int lod
+) {
+    const int step = 1 << lod;
+    this->section = 0;
+    this->chunk = chunk;
+    this->voxelsBuffer = &volume;
+    meshAABB = AABB(
+        glm::vec3(0, chunk->bottom, 0),
+        glm::vec3(CHUNK_WIDTH, chunk->top, CHUNK_DEPTH)
+    );
+
+    cancelled = false;
+    overflow = false;
+    vertexCount = 0;
+    vertexOffset = indexCount = 0;
+    denseIndexCount = 0;
+    sortingMesh = {};
+    visibility = SectionVisibility::all();
+
+    if (chunk->bottom >= chunk->top) {
+        return;
+    }
+    if (voxelsBuffer->pickBlockId(
+        chunk->chunk_x * CHUNK_WIDTH, chunk->bottom, chunk->chunk_z * CHUNK_DEPTH
+    ) == BLOCK_VOID) {
+        cancelled = true;
+        return;
+    }
+    const voxel* voxels = chunk->voxels;
+
+    int width = CHUNK_WIDTH / step;
+    int depth = CHUNK_DEPTH / step;
+    int cellsBegin = chunk->bottom / step;
+    int cellsEnd = (chunk->top + step - 1) / step;
+    size_t cellsCount = width * (CHUNK_HEIGHT / step) * depth;
+    lodCells.assign(cellsCount, BLOCK_AIR);
+    lodTranslucentCells.assign(cellsCount, BLOCK_AIR);
+
+    bool hasTranslucent = false;
+    for (int cy = cellsBegin; cy < cellsEnd; ++cy) {
+        for (int cz = 0; cz < depth; ++cz) {
+            for (int cx = 0; cx < width; ++cx) {
+                size_t index = vox_index(cx, cy, cz, width, depth);
+                auto& cell = lodCells[index];
+                auto& translucentCell = lodTranslucentCells[index];
+                // Верхний блок ячейки задаёт её текстуру
+                int top = std::min((cy + 1) * step, chunk->top);
+                for (int y = top - 1; y >= cy * step && !cell; --y) {
+                    for (int z = cz * step; z < (cz + 1) * step; ++z) {
+                        for (int x = cx * step; x < (cx + 1) * step; ++x) {
+                            const auto& vox = voxels[vox_index(x, y, z)];
+                            const auto& def = *blockDefsCache[vox.id];
+                            if (is_lod_filler(def, vox.state)) {
+                                cell = vox.id;
+                                break;
+                            }
+                            if (!translucentCell &&
+                                is_lod_translucent(def, vox.state)) {
+                                translucentCell = vox.id;
+                            }
+                        }
+                        if (cell) break;
+                    }
+                }
+                if (cell) {
+                    translucentCell = BLOCK_AIR;
+                } else if (translucentCell) {
+                    hasTranslucent = true;
+                }
+            }
+        }
+    }
+    if (hasTranslucent) {
+        renderLod(step, cellsBegin, cellsEnd, lodTranslucentCells, true);
+        if (growOnOverflow()) {
+            buildLod(chunk, volume, lod);
+            return;
+        }
+        // Как и в renderTranslucent: координаты мира для сортировки
+        sortingMesh = SortingMeshData {
+            util::Buffer<ChunkVertex>(vertexBuffer.get(), vertexCount),
+            util::Buffer<uint32_t>(indexBuffer.get(), indexCount)
+        };
+        glm::vec3 offset(
+            chunk->chunk_x * CHUNK_WIDTH + 0.5f,
+            0.5f,
+            chunk->chunk_z * CHUNK_DEPTH + 0.5f
+        );
+        for (size_t i = 0; i < sortingMesh.vertices.size(); ++i) {
+            sortingMesh.vertices[i].position += offset;
+        }
+        overflow = false;
+        vertexCount = 0;
+        vertexOffset = indexCount = 0;
+    }
+    renderLod(step, cellsBegin, cellsEnd, lodCells, false);
+
+    if (growOnOverflow()) {
+        buildLod(chunk, volume, lod);
+    }
+}
+
+template<typename T>
+static std::optional<MeshBuffer<T>> copy_to_pool(
+    MeshBuffersPool& pool, const T* src, size_t count, bool wait
+) {
+    auto buffer = pool.acquire<T>(count, wait);
+    if (buffer && count) {
+        std::memcpy(buffer->data(), src, count * sizeof(T));
+    }
+    return buffer;
 }
 
-ChunkMeshData BlocksRenderer::createMesh() {
+std::optional<ChunkMeshData> BlocksRenderer::createMesh(
+    MeshBuffersPool& pool, bool wait
+) {
+    auto vertices = copy_to_pool(pool, vertexBuffer.get(), vertexCount, wait);
+    if (!vertices) return std::nullopt;
+    auto indices = copy_to_pool(pool, indexBuffer.get(), indexCount, wait);
+    if (!indices) return std::nullopt;
+    auto denseIndices = copy_to_pool(
+        pool, denseIndexBuffer.get(), denseIndexCount, wait
+    );
+    if (!denseIndices) return std::nullopt;
     return ChunkMeshData {
-        MeshData(
-            util::Buffer(vertexBuffer.get(), vertexCount),
-            std::vector<util::Buffer<uint32_t>> {
-                util::Buffer(indexBuffer.get(), indexCount),
-                util::Buffer(denseIndexBuffer.get(), denseIndexCount),
-            },
-            util::Buffer(
-                ChunkVertex::ATTRIBUTES, sizeof(ChunkVertex::ATTRIBUTES) / sizeof(VertexAttribute)
-            )
-        ),
+        section,
+        std::move(*vertices),
+        std::move(*indices),
+        std::move(*denseIndices),
         std::move(sortingMesh),
-        std::move(meshAABB)
+        std::move(meshAABB),
+        visibility
     };
 }
 
-ChunkMesh BlocksRenderer::render(
-    const Chunk* chunk, const VoxelsRenderVolume& volume
+ChunkSectionMesh BlocksRenderer::render(
+    const Chunk* chunk, const VoxelsRenderVolume& volume, int section
 ) {
-    build(chunk, volume);
+    build(chunk, volume, section);
 
     assert(vertexCount <= capacity);
     assert(indexCount <= capacity);
     assert(denseIndexCount <= capacity);
 
-    return ChunkMesh{std::make_unique<Mesh<ChunkVertex>>(
-        vertexBuffer.get(), vertexCount, 
-        std::vector<IndexBufferData> {
-            IndexBufferData {indexBuffer.get(), indexCount},
-            IndexBufferData {denseIndexBuffer.get(), denseIndexCount},
-        }
-    ), std::move(sortingMesh), nullptr, std::move(meshAABB)};
+    std::unique_ptr<Mesh<ChunkVertex>> mesh;
+    if (vertexCount) {
+        mesh = std::make_unique<Mesh<ChunkVertex>>(
+            vertexBuffer.get(), vertexCount,
+            std::vector<IndexBufferData> {
+                IndexBufferData {indexBuffer.get(), indexCount},
+                IndexBufferData {denseIndexBuffer.get(), denseIndexCount},
+            }
+        );
+    }
+    return ChunkSectionMesh {
+        std::move(mesh),
+        std::move(sortingMesh),
+        std::move(meshAABB),
+        visibility
+    };
 }
 
 size_t BlocksRenderer::getMemoryConsumption() const {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <limits>
 #include <memory>
+#include <optional>
 
 #include <glm/glm.hpp>
 
@@ -26,24 +28,57 @@ struct UVRegion;
 /**
  * @brief Класс для рендеринга блоков (вокселей) в чанках.
  *
- * Строит меш для одного чанка, учитывая видимость граней, освещение,
- * модели блоков и их повороты.
+ * Строит меш для одной вертикальной секции чанка, учитывая видимость граней,
+ * освещение, модели блоков и их повороты.
  */
 class BlocksRenderer final {
+    /// Доступ тестов к построению отдельных блоков
+    friend struct BlocksRendererTester;
 public:
     BlocksRenderer(
         size_t capacity,
         const Block* const* blockDefs,
+        const ubyte* blockProps,
         const ContentGfxCache& cache,
         const EngineSettings& settings
     );
     ~BlocksRenderer();
 
-    void build(const Chunk* chunk, const VoxelsRenderVolume& volume);
-    ChunkMesh render(
-        const Chunk* chunk, const VoxelsRenderVolume& volume
+    /**
+     * @brief Строит меш секции чанка.
+     * @param volume Объём вокселей, содержащий уровни секции и по
+     * VOXELS_BUFFER_PADDING уровней над и под ней.
+     * @param section Индекс секции (0..CHUNK_SECTIONS-1).
+     */
+    void build(
+        const Chunk* chunk, const VoxelsRenderVolume& volume, int section
     );
-    ChunkMeshData createMesh();
+    ChunkSectionMesh render(
+        const Chunk* chunk, const VoxelsRenderVolume& volume, int section
+    );
+    /**
+     * @brief Строит упрощённый меш всего чанка для дальних дистанций.
+     *
+     * Воксели объединяются в ячейки со стороной 2^lod; ячейка заполнена,
+     * если в ней есть хотя бы один непрозрачный блок, и получает
+     * текстуру самого верхнего из них. Ячейки без непрозрачных блоков,
+     * но с полупрозрачными (вода, стекло), попадают в сортируемый меш.
+     *
+     * Меш строится из загруженного чанка: дальние чанки должны
+     * находиться в GlobalChunks.
+     * @param lod Уровень детализации (1..MAX_LOD).
+     */
+    void buildLod(
+        const Chunk* chunk, const VoxelsRenderVolume& volume, int lod
+    );
+    /**
+     * @brief Копирует построенный меш в буферы пула, округлённые
+     * до класса размера.
+     * @param wait Ждать (ограниченное время) освобождения памяти пула
+     * при превышении лимита.
+     * @return std::nullopt, если меш не уложился в лимит памяти пула
+     */
+    std::optional<ChunkMeshData> createMesh(MeshBuffersPool& pool, bool wait);
 
     size_t getMemoryConsumption() const;
 
@@ -51,6 +86,10 @@ public:
         return cancelled;
     }
 private:
+    /// Грань куба в заданной ориентации, см. BlocksRenderer.cpp
+    struct CubeFace;
+    struct CubeFaces;
+
     std::unique_ptr<ChunkVertex[]> vertexBuffer;
     std::unique_ptr<uint32_t[]> indexBuffer;
     std::unique_ptr<uint32_t[]> denseIndexBuffer;
@@ -59,18 +98,23 @@ private:
     size_t indexCount;
     size_t denseIndexCount;
     size_t capacity;
+    size_t maxCapacity;
 
     bool overflow = false; ///< Флаг переполнения буфера
     bool cancelled = false;
     bool densePass = false;
     bool denseRender = false;
 
+    int section = 0;
     AABB meshAABB {};
+    SectionVisibility visibility {};
 
     const Chunk* chunk = nullptr;
     const VoxelsRenderVolume* voxelsBuffer = nullptr;
 
     const Block* const* blockDefsCache;
+    /// Таблица BlockPropBits по идентификатору блока
+    const ubyte* blockProps;
     const ContentGfxCache& cache;
     const EngineSettings& settings;
 
@@ -78,6 +122,24 @@ private:
 
     SortingMeshData sortingMesh;
 
+    /// Биты закрывающих соседей (BLOCK_PROP_OCCLUDER или BLOCK_VOID) рядов
+    /// слоёв y-1, y, y+1; бит x+1 - воксель x, ряды от z=-1 до z=CHUNK_DEPTH
+    uint32_t occluders[3][CHUNK_DEPTH + 2] {};
+    /// Номер слоя occluders[1]; минимальное значение - слои не вычислены
+    int occludersY = std::numeric_limits<int>::min();
+    /// Биты граней FACE_*, закрытых соседями, у вокселей текущего ряда
+    uint8_t closedFaces[CHUNK_WIDTH] {};
+
+    /// Идентификаторы блоков ячеек при построении меша LOD
+    std::vector<blockid_t> lodCells;
+    /// Полупрозрачные блоки ячеек LOD, не занятых непрозрачными
+    std::vector<blockid_t> lodTranslucentCells;
+
+    void reserve(size_t capacity);
+
+    /// Увеличивает буферы после переполнения; true, если нужно перестроить
+    bool growOnOverflow();
+
     void vertex(
         const glm::vec3& coord,
         float u, float v,
@@ -153,6 +215,8 @@ private:
      * @param state Состояние блока.
      * @param lights Включить ли освещение.
      * @param ao
+     * @param closed Биты граней FACE_*, заведомо закрытых соседями
+     * (только для отсечения по умолчанию)
      */
     void blockCube(
         const glm::ivec3& coord, 
@@ -160,9 +224,42 @@ private:
         const Block& block, 
         blockstate state, 
         bool lights,
-        bool ao
+        bool ao,
+        uint closed = 0
     );
 
+    /// Вариант blockCube, специализированный по освещению и AO
+    template <bool ao, bool lights>
+    void blockCube(
+        const glm::ivec3& coord,
+        const UVRegion(&faces)[6],
+        const Block& block,
+        blockstate state,
+        uint closed
+    );
+
+    /// Грань куба по таблице ориентации: освещение вершин усредняется
+    /// целочисленно по упакованным каналам
+    template <bool ao, bool lights>
+    void cubeFace(
+        const glm::ivec3& coord, const CubeFace& face, const UVRegion& region
+    );
+
+    /// @brief Таблица граней куба для поворота блока
+    static const CubeFaces& getCubeFaces(const Block& block, uint8_t rotation);
+
+    /// @brief Упакованное освещение 3x3 соседей перед гранью (по байту на
+    /// канал), строки по оси Y грани
+    void pickFaceLights(
+        const glm::ivec3& coord, const CubeFace& face, uint32_t (&dst)[9]
+    ) const;
+
+    /// @brief Биты закрывающих соседей ряда (y, z), x от -1 до CHUNK_WIDTH
+    uint32_t computeOccluders(int y, int z) const;
+
+    /// @brief Обновляет closedFaces для ряда (y, z) секции
+    void updateClosedFaces(int y, int z);
+
     /**
      * @brief Рендерит блок, представленный AABB.
      * @param coord Координаты блока.
@@ -272,6 +369,19 @@ private:
     void render(
         const voxel* voxels, int totalBegin, int totalEnd
     );
+    void renderLod(
+        int step,
+        int cellsBegin,
+        int cellsEnd,
+        const std::vector<blockid_t>& cells,
+        bool translucent
+    );
+
+    /// Проверяет, видна ли грань ячейки LOD: соседняя ячейка пуста или,
+    /// для полупрозрачной ячейки, занята другим полупрозрачным блоком
+    bool isLodCellOpen(
+        const glm::ivec3& cell, int step, int face, blockid_t translucent
+    ) const;
     SortingMeshData renderTranslucent(
         const voxel* voxels, int totalBegin, int totalEnd
     );
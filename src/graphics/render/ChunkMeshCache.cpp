@@ -0,0 +1,347 @@
+#include <graphics/render/ChunkMeshCache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <voxels/Chunk.h>
+#include <voxels/Block.h>
+#include <voxels/VoxelsVolume.h>
+#include <content/Content.h>
+#include <frontend/ContentGfxCache.h>
+#include <math/UVRegion.h>
+#include <coders/byte_utils.h>
+#include <coders/zip.h>
+#include <debug/Logger.h>
+#include <settings.h>
+
+static debug::Logger logger("mesh-cache");
+
+inline constexpr char MAGIC[] = "CFMC";
+inline constexpr int32_t FORMAT_VERSION = 3;
+/// Обычные и плотные индексы
+inline constexpr int INDEX_BUFFERS = 2;
+
+inline constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+inline constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+static inline uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    auto bytes = static_cast<const ubyte*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+template<typename T>
+static inline uint64_t fnv1a(uint64_t hash, const T& value) {
+    return fnv1a(hash, &value, sizeof(T));
+}
+
+ChunkMeshCache::ChunkMeshCache(
+    io::path folder, uint64_t salt, size_t maxSize
+)
+    : folder(std::move(folder)), salt(salt), maxSize(maxSize) {
+    io::create_directories(this->folder);
+
+    // Порядок вытеснения между запусками восстанавливается по времени записи
+    std::vector<std::pair<io::file_time_type, io::path>> found;
+    for (const auto& file : io::directory_iterator(this->folder)) {
+        if (io::is_regular_file(file)) {
+            found.emplace_back(io::last_write_time(file), file);
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [_, file] : found) {
+        account(file.name(), io::file_size(file));
+    }
+    evict();
+}
+
+static inline uint64_t fnv1a(uint64_t hash, const std::string& string) {
+    hash = fnv1a(hash, string.size());
+    return fnv1a(hash, string.data(), string.size());
+}
+
+static uint64_t hash_variant(
+    uint64_t hash,
+    const Block& def,
+    const Variant& variant,
+    uint8_t index,
+    const ContentGfxCache& gfxCache
+) {
+    hash = fnv1a(hash, variant.model.type);
+    hash = fnv1a(hash, variant.model.name);
+    hash = fnv1a(hash, variant.culling);
+    hash = fnv1a(hash, variant.drawGroup);
+    hash = fnv1a(hash, variant.rt.solid);
+    for (int side = 0; side < 6; ++side) {
+        for (bool dense : {false, true}) {
+            hash = fnv1a(hash, gfxCache.getRegion(def.rt.id, index, side, dense));
+        }
+    }
+    if (variant.model.type == BlockModelType::Custom) {
+        // Геометрия модели берётся из ассетов и может меняться без
+        // изменения имени модели
+        const auto& model = gfxCache.getModel(def.rt.id, index);
+        for (const auto& mesh : model.meshes) {
+            hash = fnv1a(hash, mesh.texture);
+            hash = fnv1a(hash, mesh.shading);
+            hash = fnv1a(
+                hash,
+                mesh.vertices.data(),
+                mesh.vertices.size() * sizeof(model::Vertex)
+            );
+        }
+    }
+    return hash;
+}
+
+static uint64_t hash_block(
+    uint64_t hash, const Block& def, const ContentGfxCache& gfxCache
+) {
+    hash = fnv1a(hash, def.name);
+    hash = fnv1a(hash, def.rt.id);
+    hash = fnv1a(hash, def.rt.solid);
+    hash = fnv1a(hash, def.rt.extended);
+    hash = fnv1a(hash, def.emission);
+    hash = fnv1a(hash, def.size);
+    hash = fnv1a(hash, def.lightPassing);
+    hash = fnv1a(hash, def.skyLightPassing);
+    hash = fnv1a(hash, def.rotatable);
+    hash = fnv1a(hash, def.shadeless);
+    hash = fnv1a(hash, def.ambientOcclusion);
+    hash = fnv1a(hash, def.translucent);
+    for (const auto& hitbox : def.hitboxes) {
+        hash = fnv1a(hash, hitbox.a);
+        hash = fnv1a(hash, hitbox.b);
+    }
+    const auto& rotations = def.rotations;
+    hash = fnv1a(hash, rotations.name);
+    hash = fnv1a(hash, rotations.variantsCount);
+    for (int i = 0; i < rotations.variantsCount; ++i) {
+        hash = fnv1a(hash, rotations.variants[i].axes);
+        hash = fnv1a(hash, rotations.variants[i].fix);
+    }
+    hash = hash_variant(hash, def, def.defaults, 0, gfxCache);
+    if (def.variants) {
+        hash = fnv1a(hash, def.variants->offset);
+        hash = fnv1a(hash, def.variants->mask);
+        const auto& variants = def.variants->variants;
+        for (size_t i = 1; i < variants.size(); ++i) {
+            hash = hash_variant(hash, def, variants[i], i, gfxCache);
+        }
+    }
+    return hash;
+}
+
+uint64_t ChunkMeshCache::computeSalt(
+    const ContentIndices& indices,
+    const ContentGfxCache& gfxCache,
+    const EngineSettings& settings
+) {
+    uint64_t hash = fnv1a(FNV_OFFSET, FORMAT_VERSION);
+    hash = fnv1a(hash, sizeof(ChunkVertex));
+    hash = fnv1a(hash, settings.graphics.denseRender.get());
+    hash = fnv1a(hash, settings.graphics.softLighting.get());
+    hash = fnv1a(hash, settings.graphics.backlight.get());
+    for (const auto def : indices.blocks.getIterable()) {
+        hash = hash_block(hash, *def, gfxCache);
+    }
+    return hash;
+}
+
+uint64_t ChunkMeshCache::computeHash(
+    const Chunk& chunk, const VoxelsRenderVolume& volume, int section
+) const {
+    constexpr size_t layer =
+        VoxelsRenderVolume::width * VoxelsRenderVolume::depth;
+
+    // Строки выше chunk.top + 1 в объём не копируются
+    int begin = std::max(
+        0, section * CHUNK_SECTION_HEIGHT - VOXELS_BUFFER_PADDING
+    );
+    int end = std::min(
+        chunk.top + 1,
+        (section + 1) * CHUNK_SECTION_HEIGHT + VOXELS_BUFFER_PADDING
+    );
+    uint64_t hash = fnv1a(salt, section);
+    if (begin >= end) {
+        return hash;
+    }
+    hash = fnv1a(
+        hash,
+        volume.getVoxels() + begin * layer,
+        (end - begin) * layer * sizeof(voxel)
+    );
+    hash = fnv1a(
+        hash,
+        volume.getLights() + begin * layer,
+        (end - begin) * layer * sizeof(light_t)
+    );
+    return hash;
+}
+
+std::string ChunkMeshCache::getSectionFile(int x, int z, int section) {
+    return std::to_string(x) + "_" + std::to_string(z) + "_" +
+           std::to_string(section) + ".bin";
+}
+
+void ChunkMeshCache::touch(const std::string& name) {
+    const auto& found = files.find(name);
+    if (found != files.end()) {
+        order.splice(order.end(), order, found->second.position);
+    }
+}
+
+void ChunkMeshCache::account(const std::string& name, size_t size) {
+    const auto& found = files.find(name);
+    if (found != files.end()) {
+        totalSize -= found->second.size;
+        found->second.size = size;
+        order.splice(order.end(), order, found->second.position);
+    } else {
+        order.push_back(name);
+        files[name] = FileInfo {std::prev(order.end()), size};
+    }
+    totalSize += size;
+}
+
+void ChunkMeshCache::evict() {
+    while (totalSize > maxSize && !order.empty()) {
+        auto name = std::move(order.front());
+        order.pop_front();
+        const auto& found = files.find(name);
+        totalSize -= found->second.size;
+        files.erase(found);
+        io::remove(folder / name);
+    }
+}
+
+size_t ChunkMeshCache::getSize() const {
+    std::lock_guard lock(mutex);
+    return totalSize;
+}
+
+template<typename Buffer>
+static void put_buffer(ByteBuilder& builder, const Buffer& buffer) {
+    builder.putInt32(buffer.size());
+    builder.put(
+        reinterpret_cast<const ubyte*>(buffer.data()),
+        buffer.size() * sizeof(*buffer.data())
+    );
+}
+
+template<typename T, template<typename> class Buffer = util::Buffer>
+static Buffer<T> get_buffer(ByteReader& reader) {
+    size_t size = reader.getInt32();
+    if (size * sizeof(T) > reader.remaining()) {
+        throw std::runtime_error("unexpected end of data");
+    }
+    if (size == 0) {
+        return {};
+    }
+    Buffer<T> buffer(size);
+    reader.get(reinterpret_cast<char*>(buffer.data()), size * sizeof(T));
+    return buffer;
+}
+
+static void put_vec3(ByteBuilder& builder, const glm::vec3& vec) {
+    builder.putFloat32(vec.x);
+    builder.putFloat32(vec.y);
+    builder.putFloat32(vec.z);
+}
+
+static glm::vec3 get_vec3(ByteReader& reader) {
+    float x = reader.getFloat32();
+    float y = reader.getFloat32();
+    float z = reader.getFloat32();
+    return {x, y, z};
+}
+
+std::optional<ChunkMeshCache::Entry> ChunkMeshCache::load(
+    int x, int z, int section
+) {
+    auto name = getSectionFile(x, z, section);
+    auto file = folder / name;
+    if (!io::is_regular_file(file)) {
+        return std::nullopt;
+    }
+    try {
+        auto compressed = io::read_bytes(file);
+        auto bytes = zip::decompress(compressed.data(), compressed.size());
+        ByteReader reader(bytes);
+        reader.checkMagic(MAGIC, 4);
+        if (reader.getInt32() != FORMAT_VERSION ||
+            static_cast<uint64_t>(reader.getInt64()) != salt) {
+            return std::nullopt;
+        }
+        if (reader.get() != section) {
+            throw std::runtime_error("invalid section index");
+        }
+        Entry entry {};
+        entry.hash = reader.getInt64();
+
+        auto& data = entry.data;
+        data.section = section;
+        auto a = get_vec3(reader);
+        auto b = get_vec3(reader);
+        data.meshAABB = AABB(a, b);
+        data.visibility.bits = reader.getInt64();
+
+        data.vertices = get_buffer<ChunkVertex, MeshBuffer>(reader);
+        if (reader.get() != INDEX_BUFFERS) {
+            throw std::runtime_error("invalid index buffers count");
+        }
+        data.indices = get_buffer<uint32_t, MeshBuffer>(reader);
+        data.denseIndices = get_buffer<uint32_t, MeshBuffer>(reader);
+
+        data.sortingMesh.vertices = get_buffer<ChunkVertex>(reader);
+        data.sortingMesh.indices = get_buffer<uint32_t>(reader);
+
+        std::lock_guard lock(mutex);
+        touch(name);
+        return entry;
+    } catch (const std::exception& err) {
+        logger.warning() << "Could not read " << file.string() << ": "
+                         << err.what();
+        return std::nullopt;
+    }
+}
+
+void ChunkMeshCache::store(int x, int z, const Entry& entry) {
+    const auto& data = entry.data;
+
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>(MAGIC), 4);
+    builder.putInt32(FORMAT_VERSION);
+    builder.putInt64(salt);
+    builder.put(static_cast<ubyte>(data.section));
+    builder.putInt64(entry.hash);
+    put_vec3(builder, data.meshAABB.a);
+    put_vec3(builder, data.meshAABB.b);
+    builder.putInt64(data.visibility.bits);
+
+    put_buffer(builder, data.vertices);
+    builder.put(static_cast<ubyte>(INDEX_BUFFERS));
+    put_buffer(builder, data.indices);
+    put_buffer(builder, data.denseIndices);
+
+    put_buffer(builder, data.sortingMesh.vertices);
+    put_buffer(builder, data.sortingMesh.indices);
+
+    auto compressed = zip::compress(builder.data(), builder.size());
+    auto name = getSectionFile(x, z, data.section);
+    if (!io::write_bytes(
+            folder / name, compressed.data(), compressed.size()
+        )) {
+        logger.warning() << "Could not write mesh cache of chunk " << x
+                         << "_" << z;
+        return;
+    }
+    std::lock_guard lock(mutex);
+    account(name, compressed.size());
+    evict();
+}
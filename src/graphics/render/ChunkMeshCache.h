@@ -0,0 +1,91 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <io/io.h>
+#include <graphics/render/commons.h>
+
+class Chunk;
+class ContentIndices;
+class ContentGfxCache;
+struct EngineSettings;
+
+/**
+ * @brief Дисковый кэш мешей секций чанков.
+ *
+ * Меш каждой секции хранится вместе с хэшем входных данных мешинга:
+ * вокселей и освещения секции, соседних уровней и краёв соседних чанков.
+ * Если хэш совпадает, меш загружается вместо повторного построения.
+ * Кэш используется только при первом построении меша загруженного чанка:
+ * перемешинг изменённых секций его не читает и не пишет. Устаревшие записи
+ * отсеиваются по хэшу и перезаписываются при следующей загрузке чанка.
+ * Каждая секция хранится в отдельном файле.
+ *
+ * Общий размер кэша ограничен: при превышении лимита удаляются файлы,
+ * которые дольше всех не читались и не записывались.
+ */
+class ChunkMeshCache {
+public:
+    struct Entry {
+        uint64_t hash;
+        ChunkMeshData data;
+    };
+
+    static inline constexpr size_t DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+    /**
+     * @param folder Папка кэша.
+     * @param salt Хэш всего, что влияет на меш, кроме вокселей: индексов
+     * контента, текстурного атласа и настроек графики.
+     * @param maxSize Лимит суммарного размера файлов кэша в байтах.
+     */
+    ChunkMeshCache(
+        io::path folder, uint64_t salt, size_t maxSize = DEFAULT_MAX_SIZE
+    );
+
+    /// Вычисляет соль кэша для текущего контента и настроек
+    static uint64_t computeSalt(
+        const ContentIndices& indices,
+        const ContentGfxCache& gfxCache,
+        const EngineSettings& settings
+    );
+
+    /// Хэш входных данных мешинга секции
+    uint64_t computeHash(
+        const Chunk& chunk, const VoxelsRenderVolume& volume, int section
+    ) const;
+
+    /// Читает запись секции; при отсутствии или повреждении файла - пусто
+    std::optional<Entry> load(int x, int z, int section);
+
+    /// Записывает секцию entry.data.section и вытесняет старые файлы,
+    /// если кэш превысил лимит
+    void store(int x, int z, const Entry& entry);
+
+    /// Суммарный размер файлов кэша в байтах
+    size_t getSize() const;
+private:
+    struct FileInfo {
+        std::list<std::string>::iterator position;
+        size_t size;
+    };
+    io::path folder;
+    uint64_t salt;
+    size_t maxSize;
+
+    mutable std::mutex mutex;
+    /// Имена файлов от давно использованных к недавно использованным
+    std::list<std::string> order;
+    std::unordered_map<std::string, FileInfo> files;
+    size_t totalSize = 0;
+
+    static std::string getSectionFile(int x, int z, int section);
+
+    void touch(const std::string& name);
+    void account(const std::string& name, size_t size);
+    void evict();
+};
@@ -4,6 +4,7 @@
 
 #include <graphics/core/Mesh.h>
 #include <graphics/render/BlocksRenderer.h>
+#include <graphics/render/ChunkMeshCache.h>
 #include <voxels/Chunk.h>
 #include <world/Level.h>
 #include <debug/Logger.h>
@@ -22,43 +23,171 @@
 static debug::Logger logger("chunks-renderer");
 
 size_t ChunksRenderer::visibleChunks = 0;
+size_t ChunksRenderer::visibleSections = 0;
+MeshBuffersPool::Stats ChunksRenderer::meshBuffersStats {};
 
 static constexpr inline size_t MAX_CHUNKS_ENQUEUED_IN_FRAME = 4;
 
+static inline const io::path MESH_CACHE_FOLDER = "world:client/meshes";
+
+struct MeshCacheStoreJob {
+    glm::ivec2 key;
+    ChunkMeshCache::Entry entry;
+};
+
+class MeshCacheWriter : public util::Worker<MeshCacheStoreJob, int> {
+    ChunkMeshCache& cache;
+public:
+    MeshCacheWriter(ChunkMeshCache& cache) : cache(cache) {}
+
+    int operator()(const MeshCacheStoreJob& job) override {
+        cache.store(job.key.x, job.key.y, job.entry);
+        return 0;
+    }
+};
+
 class RendererWorker : public util::Worker<RendererJob, RendererResult> {
     BlocksRenderer renderer;
+    MeshBuffersPool& buffersPool;
+    ChunkMeshCache* meshCache;
+
+    /// Копирует построенный меш в буферы пула
+    bool pushMesh(RendererResult& result) {
+        auto mesh = renderer.createMesh(buffersPool, true);
+        if (!mesh) {
+            result.deferred = true;
+            result.meshData.clear();
+            result.cacheMisses.clear();
+            return false;
+        }
+        result.meshData.push_back(std::move(*mesh));
+        return true;
+    }
+
+    /// Строит секции нового чанка, загружая неизменённые из кэша мешей;
+    /// построенные заново секции отмечаются в result.cacheMisses
+    void buildCached(const RendererJob& job, RendererResult& result) {
+        const auto& chunk = *job.chunk;
+        for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+            if ((job.sections & (1U << section)) == 0) continue;
+
+            auto hash = meshCache->computeHash(chunk, *job.volume, section);
+            auto entry = meshCache->load(chunk.chunk_x, chunk.chunk_z, section);
+            if (entry.has_value() && entry->hash == hash) {
+                result.meshData.push_back(std::move(entry->data));
+                continue;
+            }
+            renderer.build(&chunk, *job.volume, section);
+            if (renderer.isCancelled()) {
+                result.cancelled = true;
+                result.meshData.clear();
+                result.cacheMisses.clear();
+                return;
+            }
+            if (!pushMesh(result)) {
+                return;
+            }
+            result.cacheMisses.emplace_back(result.meshData.size() - 1, hash);
+        }
+    }
 public:
     RendererWorker(
         const Level& level,
         const ContentGfxCache& cache,
-        const EngineSettings& settings
+        const EngineSettings& settings,
+        MeshBuffersPool& buffersPool,
+        ChunkMeshCache* meshCache
     ) : renderer(
             settings.graphics.denseRender.get()
                 ? settings.graphics.chunkMaxVerticesDense.get()
                 : settings.graphics.chunkMaxVertices.get(),
             level.content.getIndices()->blocks.getDefs(),
+            level.content.getIndices()->getBlockProps(),
             cache,
             settings
-        ) {}
+        ),
+        buffersPool(buffersPool),
+        meshCache(meshCache) {}
 
     RendererResult operator()(const RendererJob& job) override {
         auto chunk = job.chunk;
         auto volume = job.volume;
-        renderer.build(chunk.get(), *volume);
-        if (renderer.isCancelled()) {
-            return RendererResult {
-                glm::ivec2(chunk->chunk_x, chunk->chunk_z), true, ChunkMeshData {}
-            };
-        }
-        auto meshData = renderer.createMesh();
-        return RendererResult {
-            glm::ivec2(chunk->chunk_x, chunk->chunk_z), false, std::move(meshData)
+        RendererResult result {
+            glm::ivec2(chunk->chunk_x, chunk->chunk_z),
+            false,
+            job.sections,
+            job.lod,
+            {}
         };
+        if (job.lod) {
+            renderer.buildLod(chunk.get(), *volume, job.lod);
+            if (renderer.isCancelled()) {
+                result.cancelled = true;
+            } else {
+                pushMesh(result);
+            }
+            return result;
+        }
+        if (meshCache && job.fresh) {
+            buildCached(job, result);
+            return result;
+        }
+        for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+            if ((job.sections & (1U << section)) == 0) continue;
+
+            renderer.build(chunk.get(), *volume, section);
+            if (renderer.isCancelled()) {
+                result.cancelled = true;
+                result.meshData.clear();
+                break;
+            }
+            if (!pushMesh(result)) {
+                break;
+            }
+        }
+        return result;
+    }
+};
+
+class TranslucentSortWorker
+    : public util::Worker<TranslucentSortJob, TranslucentSortResult> {
+    TranslucentSorter sorter;
+public:
+    TranslucentSortResult operator()(const TranslucentSortJob& job) override {
+        TranslucentSortResult result {job.key, job.geometry, job.origin, {}};
+        sorter.sort(*job.geometry, job.origin, result.indices);
+        return result;
     }
 };
 
 static util::ObjectsPool<VoxelsRenderVolume> voxelsVolumesPool {};
 
+/// Загружает данные меша на GPU напрямую из буферов пула
+static std::unique_ptr<Mesh<ChunkVertex>> create_mesh(
+    const ChunkMeshData& data
+) {
+    if (data.vertices.size() == 0) {
+        return nullptr;
+    }
+    return std::make_unique<Mesh<ChunkVertex>>(
+        data.vertices.data(),
+        data.vertices.size(),
+        std::vector<IndexBufferData> {
+            IndexBufferData {data.indices.data(), data.indices.size()},
+            IndexBufferData {
+                data.denseIndices.data(), data.denseIndices.size()
+            },
+        }
+    );
+}
+
+static SortingMeshData clone_sorting_mesh(const SortingMeshData& data) {
+    if (data.vertices.size() == 0) {
+        return {};
+    }
+    return {data.vertices.clone(), data.indices.clone()};
+}
+
 ChunksRenderer::ChunksRenderer(
     const Level& level,
     const Chunks& chunks,
@@ -70,33 +199,121 @@ ChunksRenderer::ChunksRenderer(
     assets(assets),
     frustum(frustum),
     settings(settings),
+    meshCache(
+        settings.graphics.meshCache.get() && io::get_device("world")
+            ? std::make_unique<ChunkMeshCache>(
+                MESH_CACHE_FOLDER,
+                ChunkMeshCache::computeSalt(
+                    *level.content.getIndices(), cache, settings
+                )
+            )
+            : nullptr
+    ),
+    meshBuffersPool(
+        static_cast<size_t>(settings.graphics.meshBuffersLimit.get()) << 20
+    ),
     threadPool(
         "chunks-render-pool",
         [&]() {
             return std::make_unique<RendererWorker>(
-                level, cache, settings
+                level, cache, settings, meshBuffersPool, meshCache.get()
             );
         }, 
         [&](RendererResult&& result) {
-            if (!result.cancelled) {
-                auto meshData = std::move(result.meshData);
-                auto chunk = std::make_unique<Mesh<ChunkVertex>>(meshData.mesh);
-                meshes[result.key] = ChunkMesh {
-                    std::move(chunk),
-                    std::move(meshData.sortingMesh),
-                    nullptr,
-                    std::move(meshData.meshAABB)
-                };
-            }
             inwork.erase(result.key);
+            if (result.cancelled) return;
+            if (result.deferred) {
+                // Секции будут перестроены, когда буферы освободятся
+                auto key = result.key;
+                if (auto chunk = this->chunks.getChunk(key.x, key.y)) {
+                    chunk->dirtySections |= result.sections;
+                    chunk->flags.modified = true;
+                }
+                return;
+            }
+
+            auto found = meshes.find(result.key);
+            if (result.lod) {
+                auto& chunkMesh = meshes[result.key];
+                chunkMesh = ChunkMesh {};
+                auto& meshData = result.meshData.at(0);
+                chunkMesh.lodMesh = create_mesh(meshData);
+                chunkMesh.lod = result.lod;
+                // Полупрозрачная поверхность LOD сортируется как секция
+                chunkMesh.sections[0].sortingMeshData =
+                    std::move(meshData.sortingMesh);
+                return;
+            }
+            if (found == meshes.end() || found->second.lod) {
+                // Частичный результат имеет смысл только поверх
+                // существующего полного меша (чанк мог быть выгружен)
+                if (result.sections != Chunk::ALL_SECTIONS) return;
+                found = meshes.emplace(result.key, ChunkMesh {}).first;
+            }
+            auto& chunkMesh = found->second;
+            chunkMesh.lodMesh = nullptr;
+            chunkMesh.lod = 0;
+            // Данные записываемых в кэш секций остаются в результате
+            bool storing = !result.cacheMisses.empty();
+            for (auto& meshData : result.meshData) {
+                auto& section = chunkMesh.sections[meshData.section];
+                section.mesh = create_mesh(meshData);
+                if (storing) {
+                    section.sortingMeshData =
+                        clone_sorting_mesh(meshData.sortingMesh);
+                } else {
+                    section.sortingMeshData = std::move(meshData.sortingMesh);
+                }
+                section.meshAABB = meshData.meshAABB;
+                section.visibility = meshData.visibility;
+            }
+            chunkMesh.translucent = nullptr;
+            for (auto& [index, hash] : result.cacheMisses) {
+                storePool->enqueueJob(MeshCacheStoreJob {
+                    result.key,
+                    ChunkMeshCache::Entry {
+                        hash, std::move(result.meshData.at(index))
+                    }
+                });
+            }
         },
         settings.graphics.chunkMaxRenderers.get()
+    ),
+    sortPool(
+        "translucent-sort-pool",
+        []() { return std::make_unique<TranslucentSortWorker>(); },
+        [&](TranslucentSortResult&& result) {
+            auto found = meshes.find(result.key);
+            if (found == meshes.end()) return;
+            auto& translucent = found->second.translucent;
+            // Меш мог быть перестроен, пока шла сортировка
+            if (translucent == nullptr ||
+                translucent->geometry != result.geometry) {
+                return;
+            }
+            translucent->mesh->reloadIndices(
+                result.indices.data(), result.indices.size()
+            );
+            translucent->sortOrigin = result.origin;
+            translucent->sorting = false;
+        },
+        1
     )
 {
     threadPool.setStopOnFail(false);
+    if (meshCache) {
+        storePool = std::make_unique<util::ThreadPool<MeshCacheStoreJob, int>>(
+            "mesh-cache-writer",
+            [this]() { return std::make_unique<MeshCacheWriter>(*meshCache); },
+            [](int&&) {},
+            1
+        );
+        storePool->setStopOnFail(false);
+    }
     renderer = std::make_unique<BlocksRenderer>(
         settings.graphics.chunkMaxVertices.get(),
         level.content.getIndices()->blocks.getDefs(),
+        level.content.getIndices()->getBlockProps(),
         cache,
         settings
     );
@@ -116,15 +333,28 @@ ChunksRenderer::ChunksRenderer(
 ChunksRenderer::~ChunksRenderer() = default;
 
 std::shared_ptr<VoxelsRenderVolume> ChunksRenderer::prepareVoxelsVolume(
-    const Chunk& chunk
+    const Chunk& chunk, uint32_t sections
 ) {
     auto voxelsBuffer = voxelsVolumesPool.create();
     voxelsBuffer->setPosition(
         chunk.chunk_x * CHUNK_WIDTH - VOXELS_BUFFER_PADDING, 0,
         chunk.chunk_z * CHUNK_DEPTH - VOXELS_BUFFER_PADDING
     );
+    // Копируются только уровни перестраиваемых секций с отступом
+    int first = 0;
+    while ((sections & (1U << first)) == 0) ++first;
+    int last = CHUNK_SECTIONS - 1;
+    while ((sections & (1U << last)) == 0) --last;
+
+    int bottom = std::max(
+        0, first * CHUNK_SECTION_HEIGHT - VOXELS_BUFFER_PADDING
+    );
+    int top = std::min(
+        chunk.top + 1,
+        (last + 1) * CHUNK_SECTION_HEIGHT + VOXELS_BUFFER_PADDING
+    );
     chunks.getVoxels(
-        *voxelsBuffer, settings.graphics.backlight.get(), chunk.top + 1
+        *voxelsBuffer, settings.graphics.backlight.get(), top, bottom
     );
     return voxelsBuffer;
 }
@@ -132,18 +362,42 @@ std::shared_ptr<VoxelsRenderVolume> ChunksRenderer::prepareVoxelsVolume(
 const ChunkMesh* ChunksRenderer::render(
     const std::shared_ptr<Chunk>& chunk,
     bool important,
-    bool lowPriority
+    bool lowPriority,
+    int lod
 ) {
     glm::ivec2 key(chunk->chunk_x, chunk->chunk_z);
 
-    if (important) {
-        ChunkMesh mesh {};
-        auto voxelsBuffer = prepareVoxelsVolume(*chunk);
+    const auto& found = meshes.find(key);
+    uint32_t sections = found == meshes.end() || found->second.lod != lod
+        ? Chunk::ALL_SECTIONS
+        : chunk->dirtySections;
+    bool fresh = lod == 0 && (found == meshes.end() || found->second.lod);
+    if (sections == 0) {
+        chunk->flags.modified = false;
+        return &found->second;
+    }
+    if (lod) {
+        // Меш LOD строится только целиком
+        sections = Chunk::ALL_SECTIONS;
+    }
+
+    if (important && lod == 0) {
+        auto voxelsBuffer = prepareVoxelsVolume(*chunk, sections);
 
-        mesh = renderer->render(chunk.get(), *voxelsBuffer);
-        meshes[key] = std::move(mesh);
+        auto& mesh = meshes[key];
+        for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+            if (sections & (1U << section)) {
+                mesh.sections[section] = renderer->render(
+                    chunk.get(), *voxelsBuffer, section
+                );
+            }
+        }
+        mesh.translucent = nullptr;
+        mesh.lodMesh = nullptr;
+        mesh.lod = 0;
         chunk->flags.modified = false;
-        return &meshes[key];
+        chunk->dirtySections = 0;
+        return &mesh;
     }
 
     if (
@@ -156,10 +410,13 @@ const ChunkMesh* ChunksRenderer::render(
         )
     ) return nullptr;
     chunk->flags.modified = false;
+    chunk->dirtySections = 0;
     enqueuedInFrame++;
-    auto voxelsBuffer = prepareVoxelsVolume(*chunk);
+    auto voxelsBuffer = prepareVoxelsVolume(*chunk, sections);
 
-    threadPool.enqueueJob({chunk, std::move(voxelsBuffer)});
+    threadPool.enqueueJob(
+        {chunk, std::move(voxelsBuffer), sections, lod, fresh}
+    );
     inwork[key] = true;
     return nullptr;
 }
@@ -173,20 +430,24 @@ void ChunksRenderer::clear() {
     meshes.clear();
     inwork.clear();
     threadPool.clearQueue();
+    sortPool.clearQueue();
 }
 
 const ChunkMesh* ChunksRenderer::getOrRender(
     const std::shared_ptr<Chunk>& chunk,
     bool important,
-    bool lowPriority
+    bool lowPriority,
+    int lod
 ) {
     auto found = meshes.find(glm::ivec2(chunk->chunk_x, chunk->chunk_z));
     if (found == meshes.end()) {
-        return render(chunk, important, lowPriority);
+        return render(chunk, important, lowPriority, lod);
     }
 
-    if (chunk->flags.modified && chunk->flags.lighted) {
-        render(chunk, important, lowPriority);
+    // Пока строится меш нового уровня детализации, рисуется прежний
+    if ((chunk->flags.modified && chunk->flags.lighted) ||
+        found->second.lod != lod) {
+        render(chunk, important, lowPriority, lod);
     }
 
     return &found->second;
@@ -194,11 +455,16 @@ const ChunkMesh* ChunksRenderer::getOrRender(
 
 void ChunksRenderer::update() {
     threadPool.pullResults();
+    sortPool.pullResults();
+    if (storePool) {
+        storePool->pullResults();
+    }
     enqueuedInFrame = 0;
+    meshBuffersStats = meshBuffersPool.getStats();
 }
 
-const Mesh<ChunkVertex>* ChunksRenderer::retrieveChunk(
-    size_t index, const Camera& camera, bool culling
+const ChunkMesh* ChunksRenderer::retrieveChunk(
+    size_t index, const Camera& camera
 ) {
     auto chunk = chunks.getChunks()[index];
     if (chunk == nullptr) return nullptr;
@@ -207,7 +473,7 @@ const Mesh<ChunkVertex>* ChunksRenderer::retrieveChunk(
         if (found == meshes.end()) {
             return nullptr;
         } else {
-            return found->second.mesh.get();
+            return &found->second;
         }
     }
 
@@ -219,32 +485,47 @@ const Mesh<ChunkVertex>* ChunksRenderer::retrieveChunk(
             (chunk->chunk_z + 0.5f) * CHUNK_DEPTH
         )
     );
+    int lod = getLodLevel(distance / CHUNK_WIDTH);
     auto mesh = getOrRender(
         chunk,
         distance < CHUNK_WIDTH * 1.5f,
-        distance > CHUNK_WIDTH * settings.chunks.loadDistance.get() * 0.5
+        distance > CHUNK_WIDTH * settings.chunks.loadDistance.get() * 0.5,
+        lod
     );
     if (mesh == nullptr) return nullptr;
     if (chunk->flags.dirtyHeights) chunk->updateHeights();
+    return mesh;
+}
 
-    if (culling) {
-        const auto& meshAABB = mesh->meshAABB;
-        auto aabbMin = meshAABB.min();
-        auto aabbMax = meshAABB.max();
-        glm::vec3 min(
-            chunk->chunk_x * CHUNK_WIDTH + std::min(0.0f, aabbMin.x),
-            chunk->bottom,
-            chunk->chunk_z * CHUNK_DEPTH + std::min(0.0f, aabbMin.z)
-        );
-        glm::vec3 max(
-            chunk->chunk_x * CHUNK_WIDTH + aabbMax.x,
-            chunk->top,
-            chunk->chunk_z * CHUNK_DEPTH + aabbMax.z
-        );
-
-        if (!frustum.isBoxVisible(min, max)) return nullptr;
+int ChunksRenderer::getLodLevel(float distance) const {
+    int lodDistance = settings.graphics.lodDistance.get();
+    if (lodDistance == 0 || distance < lodDistance) {
+        return 0;
+    }
+    // Каждое следующее кольцо вдвое дальше предыдущего
+    int lod = 1;
+    while (lod < MAX_LOD && distance >= lodDistance << lod) {
+        lod++;
     }
-    return mesh->mesh.get();
+    return lod;
+}
+
+static inline bool is_section_visible(
+    const Frustum& frustum, const Chunk& chunk, const ChunkSectionMesh& section
+) {
+    auto aabbMin = section.meshAABB.min();
+    auto aabbMax = section.meshAABB.max();
+    glm::vec3 min(
+        chunk.chunk_x * CHUNK_WIDTH + std::min(0.0f, aabbMin.x),
+        aabbMin.y,
+        chunk.chunk_z * CHUNK_DEPTH + std::min(0.0f, aabbMin.z)
+    );
+    glm::vec3 max(
+        chunk.chunk_x * CHUNK_WIDTH + aabbMax.x,
+        aabbMax.y,
+        chunk.chunk_z * CHUNK_DEPTH + aabbMax.z
+    );
+    return frustum.isBoxVisible(min, max);
 }
 
 void ChunksRenderer::drawShadowsPass(
@@ -285,16 +566,51 @@ void ChunksRenderer::drawShadowsPass(
 
         glm::mat4 model = glm::translate(glm::mat4(1.0f), coord);
         shader.uniformMatrix("u_model", model);
-        found->second.mesh->draw(
-            GL_TRIANGLES, 
-            glm::distance2(
-                playerCamera.position * glm::vec3(1, 0, 1), 
-                (min + max) * 0.5f * glm::vec3(1, 0, 1)
-            ) < denseDistance2
-        );
+        bool dense = glm::distance2(
+            playerCamera.position * glm::vec3(1, 0, 1),
+            (min + max) * 0.5f * glm::vec3(1, 0, 1)
+        ) < denseDistance2;
+        const auto& chunkMesh = found->second;
+        if (chunkMesh.lod) {
+            if (chunkMesh.lodMesh) {
+                chunkMesh.lodMesh->draw();
+            }
+            continue;
+        }
+        for (const auto& section : chunkMesh.sections) {
+            if (section.mesh) {
+                section.mesh->draw(GL_TRIANGLES, dense);
+            }
+        }
     }
 }
 
+bool ChunksRenderer::computeOcclusion(const Camera& camera, bool culling) {
+    int chunksWidth = chunks.getWidth();
+    int chunksOffsetX = chunks.getOffsetX();
+    int chunksOffsetZ = chunks.getOffsetZ();
+
+    occlusionMasks.assign(chunks.getVolume(), 0);
+    return occlusion.collect(
+        camera.position,
+        {chunksOffsetX, chunksOffsetZ},
+        {chunksWidth, chunks.getDepth()},
+        culling ? &frustum : nullptr,
+        [this](int x, int section, int z) {
+            const auto& found = meshes.find({x, z});
+            if (found == meshes.end()) {
+                // Секции без меша не должны скрывать то, что за ними
+                return SectionVisibility::all();
+            }
+            return found->second.sections[section].visibility;
+        },
+        [&](int x, int section, int z) {
+            int index = (z - chunksOffsetZ) * chunksWidth + x - chunksOffsetX;
+            occlusionMasks[index] |= 1U << section;
+        }
+    );
+}
+
 void ChunksRenderer::drawChunks(
     const Camera& camera, ShaderProgram& shader
 ) {
@@ -322,8 +638,11 @@ void ChunksRenderer::drawChunks(
     util::insertion_sort(indices.begin(), indices.end());
 
     bool culling = settings.graphics.frustumCulling.get();
+    bool occlusionCulling = settings.graphics.occlusionCulling.get() &&
+                            computeOcclusion(camera, culling);
 
     visibleChunks = 0;
+    visibleSections = 0;
     shader.uniform1i("u_alphaClip", true);
 
     auto denseDistance = settings.graphics.denseRenderDistance.get();
@@ -332,7 +651,7 @@ void ChunksRenderer::drawChunks(
     // TODO: minimize the number of draw calls
     for (int i = indices.size() - 1; i >= 0; --i) {
         auto& chunk = chunks.getChunks()[indices[i].index];
-        auto mesh = retrieveChunk(indices[i].index, camera, culling);
+        auto mesh = retrieveChunk(indices[i].index, camera);
 
         if (mesh == nullptr) continue;
 
@@ -341,42 +660,118 @@ void ChunksRenderer::drawChunks(
             0.5f,
             chunk->chunk_z * CHUNK_DEPTH + 0.5f
         );
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), coord);
-        shader.uniformMatrix("u_model", model);
-        mesh->draw(
-            GL_TRIANGLES,
-            glm::distance2(
-                camera.position * glm::vec3(1, 0, 1), 
-                (coord + glm::vec3(
-                    CHUNK_WIDTH * 0.5f,
-                    0.0f,
-                    CHUNK_DEPTH * 0.5f
-                ))
-            ) < denseDistance2
-        );
-        visibleChunks++;
+        bool dense = glm::distance2(
+            camera.position * glm::vec3(1, 0, 1),
+            (coord + glm::vec3(
+                CHUNK_WIDTH * 0.5f,
+                0.0f,
+                CHUNK_DEPTH * 0.5f
+            ))
+        ) < denseDistance2;
+
+        uint32_t sectionsMask = occlusionCulling
+            ? occlusionMasks[indices[i].index]
+            : Chunk::ALL_SECTIONS;
+
+        if (mesh->lod) {
+            if (mesh->lodMesh == nullptr || sectionsMask == 0) continue;
+            if (culling) {
+                glm::vec3 min(
+                    chunk->chunk_x * CHUNK_WIDTH,
+                    chunk->bottom,
+                    chunk->chunk_z * CHUNK_DEPTH
+                );
+                glm::vec3 max(
+                    chunk->chunk_x * CHUNK_WIDTH + CHUNK_WIDTH,
+                    chunk->top,
+                    chunk->chunk_z * CHUNK_DEPTH + CHUNK_DEPTH
+                );
+                if (!frustum.isBoxVisible(min, max)) continue;
+            }
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), coord);
+            shader.uniformMatrix("u_model", model);
+            mesh->lodMesh->draw();
+            visibleChunks++;
+            continue;
+        }
+
+        bool visible = false;
+        for (int index = 0; index < CHUNK_SECTIONS; ++index) {
+            const auto& section = mesh->sections[index];
+            if (section.mesh == nullptr) continue;
+            if ((sectionsMask & (1U << index)) == 0) continue;
+            if (culling && !is_section_visible(frustum, *chunk, section)) {
+                continue;
+            }
+            if (!visible) {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), coord);
+                shader.uniformMatrix("u_model", model);
+                visible = true;
+            }
+            section.mesh->draw(GL_TRIANGLES, dense);
+            visibleSections++;
+        }
+        if (visible) visibleChunks++;
     }
 }
 
-static inline void write_sorting_mesh_entries(
-    ChunkVertex* buffer, const std::vector<SortingMeshEntry>& chunkEntries
+/// Собирает полупрозрачную геометрию секций в один меш, отсортированный
+/// для положения камеры origin
+static std::unique_ptr<TranslucentMesh> create_translucent_mesh(
+    const ChunkMesh& chunkMesh,
+    TranslucentSorter& sorter,
+    const glm::vec3& origin
 ) {
-    for (const auto& entry : chunkEntries) {
-        const auto& vertexData = entry.vertexData;
-        std::memcpy(
-            buffer,
-            vertexData.data(),
-            vertexData.size() * sizeof(ChunkVertex)
-        );
-        buffer += vertexData.size();
+    auto translucent = std::make_unique<TranslucentMesh>();
+    translucent->sortOrigin = origin;
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (const auto& section : chunkMesh.sections) {
+        vertexCount += section.sortingMeshData.vertices.size();
+        indexCount += section.sortingMeshData.indices.size();
+    }
+    if (indexCount == 0) {
+        return translucent;
+    }
+    static util::Buffer<ChunkVertex> vertices;
+    if (vertices.size() < vertexCount) {
+        vertices = util::Buffer<ChunkVertex>(vertexCount);
+    }
+    auto geometry = std::make_shared<TranslucentGeometry>();
+    geometry->indices.reserve(indexCount);
+    geometry->centroids.reserve(indexCount / 3);
+
+    uint32_t offset = 0;
+    for (const auto& section : chunkMesh.sections) {
+        const auto& data = section.sortingMeshData;
+        std::copy(data.vertices.begin(), data.vertices.end(), vertices.data() + offset);
+        for (size_t i = 0; i + 2 < data.indices.size(); i += 3) {
+            glm::vec3 centroid {};
+            for (size_t j = 0; j < 3; ++j) {
+                uint32_t index = data.indices[i + j];
+                centroid += data.vertices[index].position;
+                geometry->indices.push_back(offset + index);
+            }
+            geometry->centroids.push_back(centroid / 3.0f);
+        }
+        offset += data.vertices.size();
     }
+
+    static std::vector<uint32_t> indices;
+    sorter.sort(*geometry, origin, indices);
+    translucent->mesh = std::make_unique<Mesh<ChunkVertex>>(
+        vertices.data(),
+        vertexCount,
+        std::vector<IndexBufferData> {
+            IndexBufferData {indices.data(), indices.size()}
+        }
+    );
+    translucent->geometry = std::move(geometry);
+    return translucent;
 }
 
 void ChunksRenderer::drawSortedMeshes(const Camera& camera, ShaderProgram& shader) {
-    const int sortInterval = TRANSLUCENT_BLOCKS_SORT_INTERVAL;
-    static int frameid = 0;
-    frameid++;
-
     bool culling = settings.graphics.frustumCulling.get();
     const auto& chunks = this->chunks.getChunks();
     const auto& cameraPos = camera.position;
@@ -392,8 +787,10 @@ void ChunksRenderer::drawSortedMeshes(const Camera& camera, ShaderProgram& shade
         const auto& chunk = chunks[index.index];
         if (chunk == nullptr || !chunk->flags.lighted) continue;
 
-        const auto& found = meshes.find(glm::ivec2(chunk->chunk_x, chunk->chunk_z));
-        if (found == meshes.end() || found->second.sortingMeshData.entries.empty()) continue;
+        glm::ivec2 key(chunk->chunk_x, chunk->chunk_z);
+        const auto& found = meshes.find(key);
+        if (found == meshes.end()) continue;
+        auto& chunkMesh = found->second;
 
         if (culling) {
             glm::vec3 min(
@@ -410,41 +807,32 @@ void ChunksRenderer::drawSortedMeshes(const Camera& camera, ShaderProgram& shade
             if (!frustum.isBoxVisible(min, max)) continue;
         }
 
-        auto& chunkEntries = found->second.sortingMeshData.entries;
-
-        if (chunkEntries.size() == 1) {
-            auto& entry = chunkEntries.at(0);
-            if (found->second.sortedMesh == nullptr) {
-                found->second.sortedMesh = std::make_unique<Mesh<ChunkVertex>>(
-                    entry.vertexData.data(),
-                    entry.vertexData.size()
-                );
-            }
-            found->second.sortedMesh->draw();
-            continue;
+        if (chunkMesh.translucent == nullptr) {
+            chunkMesh.translucent =
+                create_translucent_mesh(chunkMesh, sorter, cameraPos);
         }
-
-        for (auto& entry : chunkEntries) {
-            entry.distance = static_cast<long long>(
-                glm::distance2(entry.position, cameraPos)
+        auto& translucent = *chunkMesh.translucent;
+        if (translucent.mesh == nullptr) continue;
+
+        // Порядок дальних чанков меняется медленнее: порог смещения камеры
+        // растёт с расстоянием
+        if (!translucent.sorting) {
+            glm::vec3 center(
+                (chunk->chunk_x + 0.5f) * CHUNK_WIDTH,
+                cameraPos.y,
+                (chunk->chunk_z + 0.5f) * CHUNK_DEPTH
             );
-        }
-
-        if (found->second.sortedMesh == nullptr || (frameid + chunk->chunk_x) % sortInterval == 0) {
-            std::sort(chunkEntries.begin(), chunkEntries.end());
-            size_t size = 0;
-            for (const auto& entry : chunkEntries) {
-                size += entry.vertexData.size();
-            }
-            static util::Buffer<ChunkVertex> buffer;
-            if (buffer.size() < size) {
-                buffer = util::Buffer<ChunkVertex>(size);
-            }
-            write_sorting_mesh_entries(buffer.data(), chunkEntries);
-            found->second.sortedMesh = std::make_unique<Mesh<ChunkVertex>>(
-                buffer.data(), size
+            float threshold = std::max(
+                TRANSLUCENT_RESORT_MIN_DISTANCE,
+                glm::distance(center, cameraPos) *
+                    TRANSLUCENT_RESORT_DISTANCE_FACTOR
             );
+            if (glm::distance2(translucent.sortOrigin, cameraPos) >
+                threshold * threshold) {
+                sortPool.enqueueJob({key, translucent.geometry, cameraPos});
+                translucent.sorting = true;
+            }
         }
-        found->second.sortedMesh->draw();
+        translucent.mesh->draw();
     }
 }
@@ -10,6 +10,8 @@
 
 #include <util/ThreadPool.h>
 #include <graphics/render/commons.h>
+#include <graphics/render/SectionsOcclusion.h>
+#include <graphics/render/TranslucentSorter.h>
 
 template<typename VertexStructure> class Mesh;
 class Chunk;
@@ -19,6 +21,7 @@ class ShaderProgram;
 class Assets;
 class Frustum;
 class BlocksRenderer;
+class ChunkMeshCache;
 class ContentGfxCache;
 struct EngineSettings;
 class Chunks;
@@ -35,12 +38,41 @@ struct ChunksSortEntry {
 struct RendererResult {
     glm::ivec2 key;
     bool cancelled;
-    ChunkMeshData meshData;
+    uint32_t sections; ///< Маска перестроенных секций
+    int lod; ///< Уровень детализации; при lod > 0 meshData - меш всего чанка
+    std::vector<ChunkMeshData> meshData;
+    /// Меш не уложился в лимит памяти пула; секции перестраиваются позже
+    bool deferred = false;
+    /// Секции, не найденные в кэше мешей: индекс в meshData и хэш входных
+    /// данных; записываются в кэш после загрузки на GPU
+    std::vector<std::pair<size_t, uint64_t>> cacheMisses {};
 };
 
 struct RendererJob {
     std::shared_ptr<Chunk> chunk;
     std::shared_ptr<VoxelsRenderVolume> volume;
+    uint32_t sections; ///< Маска секций, требующих перестроения
+    int lod;
+    /// У чанка ещё нет полного меша: секции можно взять из кэша мешей
+    bool fresh;
+};
+
+/// Запись секции в кэш мешей
+struct MeshCacheStoreJob;
+
+/// Пересортировка полупрозрачной геометрии чанка для нового положения камеры
+struct TranslucentSortJob {
+    glm::ivec2 key;
+    std::shared_ptr<const TranslucentGeometry> geometry;
+    glm::vec3 origin;
+};
+
+struct TranslucentSortResult {
+    glm::ivec2 key;
+    /// Применяется, только если геометрия чанка не сменилась
+    std::shared_ptr<const TranslucentGeometry> geometry;
+    glm::vec3 origin;
+    std::vector<uint32_t> indices;
 };
 
 class ChunksRenderer {
@@ -52,15 +84,30 @@ class ChunksRenderer {
     std::unordered_map<glm::ivec2, ChunkMesh> meshes;
     std::unordered_map<glm::ivec2, bool> inwork;
     std::vector<ChunksSortEntry> indices;
+    /// Первая сортировка полупрозрачной геометрии выполняется сразу
+    TranslucentSorter sorter;
+    SectionsOcclusion occlusion;
+    /// Маски секций, прошедших отсечение перекрытых, по индексу чанка
+    std::vector<uint32_t> occlusionMasks;
+    /// nullptr, если кэш мешей отключён
+    std::unique_ptr<ChunkMeshCache> meshCache;
+    /// Буферы мешей, передаваемые от рабочих потоков; объявлен до пулов
+    /// потоков, чтобы пережить их результаты
+    MeshBuffersPool meshBuffersPool;
 
     util::ThreadPool<RendererJob, RendererResult> threadPool;
+    util::ThreadPool<TranslucentSortJob, TranslucentSortResult> sortPool;
+    /// Пишет кэш мешей вне потоков мешинга; nullptr, если кэш отключён
+    std::unique_ptr<util::ThreadPool<MeshCacheStoreJob, int>> storePool;
 
-    const Mesh<ChunkVertex>* retrieveChunk(
-        size_t index, const Camera& camera, bool culling
-    );
+    const ChunkMesh* retrieveChunk(size_t index, const Camera& camera);
+    /// Уровень детализации чанка на заданном расстоянии (в чанках)
+    int getLodLevel(float distance) const;
     std::shared_ptr<VoxelsRenderVolume> prepareVoxelsVolume(
-        const Chunk& chunk
+        const Chunk& chunk, uint32_t sections
     );
+    /// Заполняет occlusionMasks; false, если отсечение не выполнено
+    bool computeOcclusion(const Camera& camera, bool culling);
     size_t enqueuedInFrame = 0;
 public:
     ChunksRenderer(
@@ -76,7 +123,8 @@ public:
     const ChunkMesh* render(
         const std::shared_ptr<Chunk>& chunk,
         bool important,
-        bool lowPriority
+        bool lowPriority,
+        int lod = 0
     );
     void unload(const Chunk* chunk);
     void clear();
@@ -84,7 +132,8 @@ public:
     const ChunkMesh* getOrRender(
         const std::shared_ptr<Chunk>& chunk,
         bool important,
-        bool lowPriority
+        bool lowPriority,
+        int lod = 0
     );
 
     void drawShadowsPass(
@@ -96,5 +145,9 @@ public:
 
     void update();
 
+    /// Статистика пула буферов мешей на момент последнего update()
+    static MeshBuffersPool::Stats meshBuffersStats;
+
     static size_t visibleChunks;
+    static size_t visibleSections;
 };
@@ -0,0 +1,103 @@
+#include <graphics/render/MeshBuffersPool.h>
+
+#include <chrono>
+
+inline constexpr size_t MIN_CLASS_SIZE = 4096;
+
+/// Ожидание ограничено: потоки, удерживающие часть буферов меша,
+/// иначе могли бы ждать друг друга
+inline constexpr auto MAX_WAIT_TIME = std::chrono::milliseconds(50);
+
+MeshBuffersPool::MeshBuffersPool(size_t limitBytes) {
+    stats.limitBytes = limitBytes;
+}
+
+size_t MeshBuffersPool::classSize(size_t bytes) {
+    if (bytes <= MIN_CLASS_SIZE) {
+        return MIN_CLASS_SIZE;
+    }
+    size_t base = MIN_CLASS_SIZE;
+    while (base * 2 <= bytes) {
+        base *= 2;
+    }
+    size_t step = base / 4;
+    return base + (bytes - base + step - 1) / step * step;
+}
+
+std::shared_ptr<ubyte[]> MeshBuffersPool::acquireBytes(
+    size_t bytes, bool wait
+) {
+    size_t size = classSize(bytes);
+    std::unique_ptr<ubyte[]> buffer;
+    {
+        std::unique_lock lock(mutex);
+        auto fits = [this, size]() {
+            return stats.usedBytes == 0 ||
+                   stats.usedBytes + size <= stats.limitBytes;
+        };
+        if (!fits()) {
+            if (wait) {
+                stats.waits++;
+                freed.wait_for(lock, MAX_WAIT_TIME, fits);
+            }
+            if (!fits()) {
+                stats.failures++;
+                return nullptr;
+            }
+        }
+        stats.acquired++;
+        stats.usedBytes += size;
+
+        auto found = freeBuffers.find(size);
+        if (found != freeBuffers.end() && !found->second.empty()) {
+            buffer = std::move(found->second.back());
+            found->second.pop_back();
+            stats.reused++;
+        } else {
+            stats.allocatedBytes += size;
+        }
+    }
+    if (buffer == nullptr) {
+        buffer = std::make_unique<ubyte[]>(size);
+    }
+    return std::shared_ptr<ubyte[]>(buffer.release(), [this, size](ubyte* ptr) {
+        release(ptr, size);
+    });
+}
+
+void MeshBuffersPool::release(ubyte* ptr, size_t size) {
+    {
+        std::lock_guard lock(mutex);
+        stats.usedBytes -= size;
+        if (stats.allocatedBytes > stats.limitBytes) {
+            stats.allocatedBytes -= size;
+            delete[] ptr;
+        } else {
+            freeBuffers[size].emplace_back(ptr);
+        }
+    }
+    freed.notify_all();
+}
+
+void MeshBuffersPool::setLimit(size_t limitBytes) {
+    {
+        std::lock_guard lock(mutex);
+        stats.limitBytes = limitBytes;
+    }
+    trim();
+}
+
+void MeshBuffersPool::trim() {
+    std::lock_guard lock(mutex);
+    for (auto& [size, buffers] : freeBuffers) {
+        while (!buffers.empty() && stats.allocatedBytes > stats.limitBytes) {
+            buffers.pop_back();
+            stats.allocatedBytes -= size;
+        }
+    }
+}
+
+MeshBuffersPool::Stats MeshBuffersPool::getStats() {
+    std::lock_guard lock(mutex);
+    return stats;
+}
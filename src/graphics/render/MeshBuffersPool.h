@@ -0,0 +1,115 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <condition_variable>
+
+#include <typedefs.h>
+
+/**
+ * @brief Буфер данных меша с разделяемым владением.
+ *
+ * Память может принадлежать пулу MeshBuffersPool: тогда она возвращается
+ * в пул при уничтожении последней ссылки, а не освобождается.
+ */
+template<typename T>
+class MeshBuffer {
+    std::shared_ptr<T[]> ptr;
+    size_t length = 0;
+public:
+    MeshBuffer() = default;
+
+    MeshBuffer(std::shared_ptr<T[]> ptr, size_t length)
+        : ptr(std::move(ptr)), length(length) {}
+
+    /// Буфер в обычной куче, вне пула
+    explicit MeshBuffer(size_t length)
+        : ptr(new T[length]), length(length) {}
+
+    T* data() {
+        return ptr.get();
+    }
+
+    const T* data() const {
+        return ptr.get();
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    T& operator[](size_t index) {
+        return ptr[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return ptr[index];
+    }
+};
+
+/**
+ * @brief Потокобезопасный пул буферов для выходных данных мешинга.
+ *
+ * Размеры буферов округляются вверх до классов (четыре класса на каждую
+ * степень двойки, потери не более 25%). Освобождённые буферы
+ * переиспользуются, свободные сверх лимита освобождаются.
+ *
+ * Объём выданных буферов не превышает лимит: запрос сверх него ждёт
+ * освобождения памяти ограниченное время и завершается неудачей.
+ * Исключение - запрос при пустом пуле, иначе буфер больше лимита
+ * нельзя было бы получить никогда.
+ */
+class MeshBuffersPool {
+public:
+    struct Stats {
+        size_t usedBytes; ///< Занято выданными буферами
+        size_t allocatedBytes; ///< Всего выделено, включая свободные
+        size_t limitBytes;
+        size_t acquired; ///< Всего выдано буферов
+        size_t reused; ///< Из них переиспользовано
+        size_t waits; ///< Число ожиданий из-за превышения лимита
+        size_t failures; ///< Запросов, не уложившихся в лимит
+    };
+
+    explicit MeshBuffersPool(size_t limitBytes);
+
+    /**
+     * @brief Выдаёт буфер на count элементов.
+     * @param wait Ждать освобождения памяти при превышении лимита.
+     * Главный поток ждать не должен: буферы освобождает он сам.
+     * @return std::nullopt, если буфер не уложился в лимит
+     */
+    template<typename T>
+    std::optional<MeshBuffer<T>> acquire(size_t count, bool wait) {
+        if (count == 0) {
+            return MeshBuffer<T>();
+        }
+        auto bytes = acquireBytes(count * sizeof(T), wait);
+        if (bytes == nullptr) {
+            return std::nullopt;
+        }
+        T* data = reinterpret_cast<T*>(bytes.get());
+        return MeshBuffer<T>(std::shared_ptr<T[]>(std::move(bytes), data), count);
+    }
+
+    void setLimit(size_t limitBytes);
+
+    /// Освобождает свободные буферы сверх лимита
+    void trim();
+
+    Stats getStats();
+
+    /// Размер класса, в который попадает запрос указанного размера
+    static size_t classSize(size_t bytes);
+private:
+    std::mutex mutex;
+    std::condition_variable freed;
+    std::map<size_t, std::vector<std::unique_ptr<ubyte[]>>> freeBuffers;
+    Stats stats {};
+
+    std::shared_ptr<ubyte[]> acquireBytes(size_t bytes, bool wait);
+    void release(ubyte* ptr, size_t size);
+};
@@ -0,0 +1,191 @@
+#include <graphics/render/SectionsOcclusion.h>
+
+#include <bitset>
+
+#include <voxels/Block.h>
+#include <math/voxmaths.h>
+#include <math/FrustumCulling.h>
+
+static_assert(CHUNK_WIDTH == CHUNK_SECTION_HEIGHT);
+static_assert(CHUNK_DEPTH == CHUNK_SECTION_HEIGHT);
+
+inline constexpr int SECTION_VOLUME =
+    CHUNK_WIDTH * CHUNK_SECTION_HEIGHT * CHUNK_DEPTH;
+
+inline constexpr uint8_t NO_FACE = 0xFF;
+
+static constexpr glm::ivec3 FACE_OFFSETS[SectionVisibility::FACES] {
+    {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+};
+
+void SectionVisibility::connectAll(uint8_t facesMask) {
+    for (int a = 0; a < FACES; ++a) {
+        if ((facesMask & (1 << a)) == 0) continue;
+        for (int b = a; b < FACES; ++b) {
+            if (facesMask & (1 << b)) {
+                connect(a, b);
+            }
+        }
+    }
+}
+
+static inline bool is_occluder(const Block& def, blockstate state) {
+    if (def.lightPassing || def.translucent) {
+        return false;
+    }
+    const auto& variant = def.getVariantByBits(state.userbits);
+    return variant.rt.solid &&
+           variant.model.type == BlockModelType::Cube &&
+           variant.culling == CullingMode::Default &&
+           variant.drawGroup == 0;
+}
+
+static inline uint8_t boundary_faces(int x, int y, int z) {
+    uint8_t faces = 0;
+    faces |= (x == 0) << 0;
+    faces |= (x == CHUNK_WIDTH - 1) << 1;
+    faces |= (y == 0) << 2;
+    faces |= (y == CHUNK_SECTION_HEIGHT - 1) << 3;
+    faces |= (z == 0) << 4;
+    faces |= (z == CHUNK_DEPTH - 1) << 5;
+    return faces;
+}
+
+SectionVisibility compute_section_visibility(
+    const voxel* voxels, const Block* const* blockDefs, int section
+) {
+    const voxel* sectionVoxels =
+        voxels + section * SECTION_VOLUME;
+
+    // Перекрывающие и уже посещённые воксели
+    std::bitset<SECTION_VOLUME> closed;
+    int openCount = 0;
+    for (int i = 0; i < SECTION_VOLUME; ++i) {
+        const auto& vox = sectionVoxels[i];
+        if (is_occluder(*blockDefs[vox.id], vox.state)) {
+            closed.set(i);
+        } else {
+            openCount++;
+        }
+    }
+    if (openCount == 0) {
+        return SectionVisibility {};
+    } else if (openCount == SECTION_VOLUME) {
+        return SectionVisibility::all();
+    }
+
+    SectionVisibility visibility {};
+    uint16_t stack[SECTION_VOLUME];
+    for (int start = 0; start < SECTION_VOLUME; ++start) {
+        if (closed.test(start)) continue;
+
+        uint8_t faces = 0;
+        int top = 0;
+        stack[top++] = start;
+        closed.set(start);
+        while (top) {
+            int index = stack[--top];
+            int x = index % CHUNK_WIDTH;
+            int z = (index / CHUNK_WIDTH) % CHUNK_DEPTH;
+            int y = index / (CHUNK_WIDTH * CHUNK_DEPTH);
+            faces |= boundary_faces(x, y, z);
+
+            for (const auto& offset : FACE_OFFSETS) {
+                int nx = x + offset.x;
+                int ny = y + offset.y;
+                int nz = z + offset.z;
+                if (static_cast<uint>(nx) >= CHUNK_WIDTH ||
+                    static_cast<uint>(ny) >= CHUNK_SECTION_HEIGHT ||
+                    static_cast<uint>(nz) >= CHUNK_DEPTH) {
+                    continue;
+                }
+                int neighbour = vox_index(nx, ny, nz);
+                if (!closed.test(neighbour)) {
+                    closed.set(neighbour);
+                    stack[top++] = neighbour;
+                }
+            }
+        }
+        visibility.connectAll(faces);
+        if (visibility.bits == SectionVisibility::ALL_BITS) break;
+    }
+    return visibility;
+}
+
+bool SectionsOcclusion::collect(
+    const glm::vec3& cameraPos,
+    const glm::ivec2& areaOffset,
+    const glm::ivec2& areaSize,
+    const Frustum* frustum,
+    const VisibilitySupplier& supplier,
+    const SectionConsumer& consumer
+) {
+    glm::ivec3 origin(
+        floordiv<CHUNK_WIDTH>(static_cast<int>(std::floor(cameraPos.x))),
+        glm::clamp(
+            static_cast<int>(std::floor(cameraPos.y)) / CHUNK_SECTION_HEIGHT,
+            0,
+            CHUNK_SECTIONS - 1
+        ),
+        floordiv<CHUNK_DEPTH>(static_cast<int>(std::floor(cameraPos.z)))
+    );
+    auto indexOf = [&areaOffset, &areaSize](const glm::ivec3& pos) -> int {
+        int lx = pos.x - areaOffset.x;
+        int lz = pos.z - areaOffset.y;
+        if (lx < 0 || lz < 0 || lx >= areaSize.x || lz >= areaSize.y ||
+            pos.y < 0 || pos.y >= CHUNK_SECTIONS) {
+            return -1;
+        }
+        return (lz * areaSize.x + lx) * CHUNK_SECTIONS + pos.y;
+    };
+    int originIndex = indexOf(origin);
+    if (originIndex == -1) {
+        return false;
+    }
+
+    visited.assign(areaSize.x * areaSize.y * CHUNK_SECTIONS, false);
+    queue.clear();
+
+    visited[originIndex] = true;
+    queue.push_back(Entry {origin, NO_FACE, 0});
+
+    for (size_t i = 0; i < queue.size(); ++i) {
+        Entry entry = queue[i];
+        const auto& pos = entry.pos;
+        consumer(pos.x, pos.y, pos.z);
+
+        auto visibility = entry.entryFace == NO_FACE
+            ? SectionVisibility::all()
+            : supplier(pos.x, pos.y, pos.z);
+        for (int face = 0; face < SectionVisibility::FACES; ++face) {
+            // Не возвращаемся в сторону камеры
+            if (entry.directions & (1 << (face ^ 1))) continue;
+            if (entry.entryFace != NO_FACE &&
+                !visibility.isConnected(entry.entryFace, face)) {
+                continue;
+            }
+            auto next = pos + FACE_OFFSETS[face];
+            int index = indexOf(next);
+            if (index == -1 || visited[index]) continue;
+            visited[index] = true;
+
+            if (frustum) {
+                glm::vec3 min(
+                    next.x * CHUNK_WIDTH,
+                    next.y * CHUNK_SECTION_HEIGHT,
+                    next.z * CHUNK_DEPTH
+                );
+                glm::vec3 max = min + glm::vec3(
+                    CHUNK_WIDTH, CHUNK_SECTION_HEIGHT, CHUNK_DEPTH
+                );
+                if (!frustum->isBoxVisible(min, max)) continue;
+            }
+            queue.push_back(Entry {
+                next,
+                static_cast<uint8_t>(face ^ 1),
+                static_cast<uint8_t>(entry.directions | (1 << face))
+            });
+        }
+    }
+    return true;
+}
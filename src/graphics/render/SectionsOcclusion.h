@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include <glm/glm.hpp>
+
+#include <typedefs.h>
+#include <constants.h>
+#include <voxels/voxel.h>
+
+class Block;
+class Frustum;
+
+/**
+ * @brief Связность граней вертикальной секции чанка.
+ *
+ * Грань a связана с гранью b, если из a в b можно пройти через
+ * не перекрывающие обзор воксели секции.
+ * Порядок граней: -x, +x, -y, +y, -z, +z.
+ */
+struct SectionVisibility {
+    static constexpr int FACES = 6;
+    static constexpr uint64_t ALL_BITS = (1ULL << (FACES * FACES)) - 1;
+
+    uint64_t bits = 0;
+
+    static constexpr SectionVisibility all() {
+        return SectionVisibility {ALL_BITS};
+    }
+
+    bool isConnected(int a, int b) const {
+        return (bits >> (a * FACES + b)) & 1;
+    }
+
+    void connect(int a, int b) {
+        bits |= (1ULL << (a * FACES + b)) | (1ULL << (b * FACES + a));
+    }
+
+    /// Связывает попарно все грани из маски
+    void connectAll(uint8_t facesMask);
+};
+
+/**
+ * @brief Строит граф связности граней секции заливкой по вокселям,
+ * не перекрывающим обзор.
+ * @param voxels Воксели чанка.
+ * @param blockDefs Кэш определений блоков по идентификатору.
+ * @param section Индекс секции.
+ */
+SectionVisibility compute_section_visibility(
+    const voxel* voxels, const Block* const* blockDefs, int section
+);
+
+/**
+ * @brief Отсечение невидимых секций обходом графа видимости.
+ *
+ * Обход в ширину начинается с секции камеры. В соседнюю секцию можно
+ * перейти, только если грань, через которую в текущую секцию вошли,
+ * связана с гранью выхода, а направление перехода не обращено к камере.
+ */
+class SectionsOcclusion {
+public:
+    /// Возвращает связность секции; для отсутствующих секций - all()
+    using VisibilitySupplier = std::function<SectionVisibility(int, int, int)>;
+    /// Принимает координаты видимой секции (x чанка, индекс секции, z чанка)
+    using SectionConsumer = std::function<void(int, int, int)>;
+
+    /**
+     * @brief Собирает видимые секции.
+     * @param cameraPos Позиция камеры.
+     * @param areaOffset Координаты первого чанка области обхода.
+     * @param areaSize Размер области обхода в чанках.
+     * @param frustum Пирамида видимости (nullptr - без отсечения).
+     * @return false, если камера вне области и обход не выполнялся.
+     */
+    bool collect(
+        const glm::vec3& cameraPos,
+        const glm::ivec2& areaOffset,
+        const glm::ivec2& areaSize,
+        const Frustum* frustum,
+        const VisibilitySupplier& supplier,
+        const SectionConsumer& consumer
+    );
+private:
+    struct Entry {
+        glm::ivec3 pos;
+        uint8_t entryFace;
+        uint8_t directions;
+    };
+    std::vector<Entry> queue;
+    std::vector<bool> visited;
+};
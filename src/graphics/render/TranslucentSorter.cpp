@@ -0,0 +1,42 @@
+#include <graphics/render/TranslucentSorter.h>
+
+#include <cstring>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+
+#include <util/listutil.h>
+
+/// Неотрицательные float упорядочены так же, как их биты; инверсия
+/// даёт порядок по убыванию расстояния
+static inline uint32_t far_to_near_key(float distance2) {
+    uint32_t bits;
+    std::memcpy(&bits, &distance2, sizeof(bits));
+    return ~bits;
+}
+
+void TranslucentSorter::sort(
+    const TranslucentGeometry& geometry,
+    const glm::vec3& origin,
+    std::vector<uint32_t>& dst
+) {
+    const auto& centroids = geometry.centroids;
+    items.resize(centroids.size());
+    for (uint32_t i = 0; i < centroids.size(); ++i) {
+        uint64_t key = far_to_near_key(glm::distance2(centroids[i], origin));
+        items[i] = (key << 32) | i;
+    }
+    util::radix_sort_keys(items, buffer);
+
+    const auto& indices = geometry.indices;
+    dst.resize(items.size() * 3);
+    uint32_t* out = dst.data();
+    for (uint64_t item : items) {
+        const uint32_t* triangle = indices.data() + (item & 0xFFFFFFFF) * 3;
+        out[0] = triangle[0];
+        out[1] = triangle[1];
+        out[2] = triangle[2];
+        out += 3;
+    }
+}
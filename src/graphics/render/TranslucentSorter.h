@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/vec3.hpp>
+
+/// @brief Полупрозрачная геометрия чанка, подготовленная к сортировке.
+/// Не изменяется после создания и разделяется с рабочими потоками
+struct TranslucentGeometry {
+    /// Центры треугольников в координатах мира
+    std::vector<glm::vec3> centroids;
+    /// По три индекса вершин на треугольник в порядке построения
+    std::vector<uint32_t> indices;
+};
+
+/// @brief Упорядочивает треугольники от дальних к ближним поразрядной
+/// сортировкой по квадрату расстояния до их центров. Результат - новый
+/// индексный буфер; буферы сортировки переиспользуются между вызовами
+class TranslucentSorter {
+    std::vector<uint64_t> items;
+    std::vector<uint64_t> buffer;
+public:
+    /// @param origin положение камеры
+    /// @param dst индексы треугольников в порядке отрисовки
+    void sort(
+        const TranslucentGeometry& geometry,
+        const glm::vec3& origin,
+        std::vector<uint32_t>& dst
+    );
+};
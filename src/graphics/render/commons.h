@@ -11,6 +11,8 @@
 #include <util/Buffer.h>
 #include <constants.h>
 #include <math/AABB.h>
+#include <graphics/render/SectionsOcclusion.h>
+#include <graphics/render/MeshBuffersPool.h>
 
 struct ChunkVertex {
     glm::vec3 position;
@@ -30,33 +32,60 @@ struct ChunkVertex {
 template<typename VertexStructure>
 class Mesh;
 
-struct SortingMeshEntry {
-    glm::vec3 position;
-    util::Buffer<ChunkVertex> vertexData;
-    long long distance;
-
-    inline bool operator<(const SortingMeshEntry &o) const noexcept {
-        return distance > o.distance;
-    }
-};
-
+/// Полупрозрачная геометрия секции в координатах мира. Треугольники
+/// сортируются перестановкой индексов, вершины не меняются
 struct SortingMeshData {
-    std::vector<SortingMeshEntry> entries;
+    util::Buffer<ChunkVertex> vertices;
+    /// По три индекса на треугольник в порядке построения
+    util::Buffer<uint32_t> indices;
 };
 
+/// Данные меша одной вертикальной секции чанка, построенные рабочим потоком
 struct ChunkMeshData {
-    MeshData<ChunkVertex> mesh;
+    int section;
+    /// Буферы из пула (память округлена до класса размера);
+    /// передаются главному потоку без копирования
+    MeshBuffer<ChunkVertex> vertices;
+    MeshBuffer<uint32_t> indices;
+    MeshBuffer<uint32_t> denseIndices;
     SortingMeshData sortingMesh;
     AABB meshAABB;
+    SectionVisibility visibility;
 };
 
-struct ChunkMesh {
-    std::unique_ptr<Mesh<ChunkVertex>> mesh;
+struct ChunkSectionMesh {
+    std::unique_ptr<Mesh<ChunkVertex>> mesh; ///< nullptr, если секция пуста
     SortingMeshData sortingMeshData;
-    std::unique_ptr<Mesh<ChunkVertex>> sortedMesh;
     AABB meshAABB;
+    /// Связность граней секции для отсечения перекрытых секций
+    SectionVisibility visibility = SectionVisibility::all();
+};
+
+struct TranslucentGeometry;
+
+/// Полупрозрачная геометрия всех секций чанка. Вершины загружаются один
+/// раз, пересортировка в рабочем потоке заменяет только индексный буфер
+struct TranslucentMesh {
+    std::unique_ptr<Mesh<ChunkVertex>> mesh; ///< nullptr, если геометрии нет
+    std::shared_ptr<const TranslucentGeometry> geometry;
+    /// Положение камеры, для которого выполнена последняя сортировка
+    glm::vec3 sortOrigin {};
+    /// Сортировка поставлена в очередь и ещё не применена
+    bool sorting = false;
+};
+
+struct ChunkMesh {
+    std::array<ChunkSectionMesh, CHUNK_SECTIONS> sections;
+    /// nullptr, пока не собрана из секций
+    std::unique_ptr<TranslucentMesh> translucent;
+    /// Упрощённый меш всего чанка; используется вместо секций при lod > 0
+    std::unique_ptr<Mesh<ChunkVertex>> lodMesh;
+    int lod = 0;
 };
 
+/// Максимальный уровень детализации (ячейки 2^MAX_LOD вокселей)
+inline constexpr int MAX_LOD = 3;
+
 inline constexpr int VOXELS_BUFFER_PADDING = 2;
 
 template<int, int, int> class StaticVoxelsVolume;
@@ -207,11 +207,13 @@ std::unique_ptr<std::istream> ZipFileDevice::read(std::string_view path) {
     if (entry.isDirectory) {
         throw std::runtime_error("zip://" + std::string(path) + " is directory");
     }
+    std::unique_lock lock(fileMutex);
     if (entry.blobOffset == 0) {
         findBlob(entry);
     }
     std::unique_ptr<std::istream> src_stream;
     if (separateFunc) {
+        lock.unlock();
         src_stream = separateFunc();
         src_stream->seekg(entry.blobOffset);
     } else {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <unordered_map>
 #include <functional>
 
@@ -48,6 +49,8 @@ namespace io {
         std::unique_ptr<PathsGenerator> list(std::string_view path) override;
     private:
         std::unique_ptr<std::istream> file;
+        /// Чтение из общего потока file (допускает чтение из нескольких потоков)
+        std::mutex fileMutex;
         FileSeparateFunc separateFunc;
         std::unordered_map<std::string, Entry> entries;
 
@@ -330,11 +330,17 @@ bool io::is_data_interchange_format(const std::string& ext) {
 }
 
 dv::value io::read_object(const path& file) {
+    if (!is_data_file(file)) {
+		throw std::runtime_error("Unknown file format " + file.extension());
+    }
+    return parse_object(file, read_string(file));
+}
+
+dv::value io::parse_object(const path& file, std::string_view text) {
     const auto& found = data_decoders.find(file.extension());
     if (found == data_decoders.end()) {
 		throw std::runtime_error("Unknown file format " + file.extension());
     }
-    auto text = read_string(file);
     try {
         return found->second(file.string(), text);
     } catch (const parsing_error& err) {
@@ -154,4 +154,6 @@ namespace io {
     bool is_data_file(const io::path& file);
     bool is_data_interchange_format(const std::string& ext);
     dv::value read_object(const path& file);
+    /// Разбирает уже прочитанный текст файла по его расширению
+    dv::value parse_object(const path& file, std::string_view text);
 }
@@ -42,6 +42,7 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("volume-music", &settings.audio.volumeMusic);
     builder.add("input-device", &settings.audio.inputDevice);
     builder.add("acoustic-effects", &settings.audio.acousticEffects);
+    builder.add("pcm-cache-limit", &settings.audio.pcmCacheLimit);
 
     builder.addSection("display");
     builder.add("width", &settings.display.width);
@@ -63,6 +64,8 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("load-distance", &settings.chunks.loadDistance);
     builder.add("load-speed", &settings.chunks.loadSpeed);
     builder.add("padding", &settings.chunks.padding);
+    builder.add("generator-workers", &settings.chunks.generatorWorkers);
+    builder.add("pregen-speed", &settings.chunks.pregenSpeed);
 
     builder.addSection("graphics");
     builder.add("fog-curve", &settings.graphics.fogCurve);
@@ -70,6 +73,7 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("dense-render", &settings.graphics.denseRender);
     builder.add("gamma", &settings.graphics.gamma);
     builder.add("frustum-culling", &settings.graphics.frustumCulling);
+    builder.add("occlusion-culling", &settings.graphics.occlusionCulling);
     builder.add("skybox-resolution", &settings.graphics.skyboxResolution);
     builder.add("chunk-max-vertices", &settings.graphics.chunkMaxVertices);
     builder.add("chunk-max-vertices-dense", &settings.graphics.chunkMaxVerticesDense);
@@ -79,6 +83,9 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("ssao", &settings.graphics.ssao);
     builder.add("shadows-quality", &settings.graphics.shadowsQuality);
     builder.add("dense-render-distance", &settings.graphics.denseRenderDistance);
+    builder.add("lod-distance", &settings.graphics.lodDistance);
+    builder.add("mesh-cache", &settings.graphics.meshCache);
+    builder.add("mesh-buffers-limit", &settings.graphics.meshBuffersLimit);
     builder.add("soft-lighting", &settings.graphics.softLighting);
     builder.add("clouds-quality", &settings.graphics.cloudsQuality);
 
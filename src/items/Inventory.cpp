@@ -1,5 +1,6 @@
 #include <items/Inventory.h>
 
+#include <coders/binary_json.h>
 #include <content/ContentReport.h>
 #include <debug/Logger.h>
 
@@ -99,6 +100,72 @@ dv::value Inventory::serialize() const {
     return map;
 }
 
+static ItemStack read_slot(json::BinaryReader& reader) {
+    itemid_t id = 0;
+    itemcount_t count = 0;
+    dv::value fields = nullptr;
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "id") {
+            id = reader.readInteger();
+        } else if (key == "count") {
+            count = reader.readInteger();
+        } else if (key == "fields") {
+            fields = reader.readValue();
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+    return ItemStack(id, count, std::move(fields));
+}
+
+void Inventory::deserialize(json::BinaryReader& reader) {
+    id = 1;
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "id") {
+            id = reader.readInteger();
+        } else if (key == "slots") {
+            reader.beginList();
+            for (size_t i = 0; reader.hasNext(); ++i) {
+                if (i == slots.size()) {
+                    slots.emplace_back(ItemStack());
+                }
+                slots[i].set(read_slot(reader));
+            }
+            reader.endList();
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+}
+
+void Inventory::serialize(json::BinaryWriter& writer) const {
+    writer.beginObject();
+    writer.put("id", id);
+    writer.beginList("slots");
+    for (const auto& item : slots) {
+        itemcount_t count = item.getCount();
+
+        writer.beginObject();
+        writer.put("id", item.getItemId());
+        if (count) {
+            writer.put("count", count);
+        }
+        const auto& fields = item.getFields();
+        if (fields != nullptr) {
+            writer.put("fields", fields);
+        }
+        writer.endObject();
+    }
+    writer.endList();
+    writer.endObject();
+}
+
 void Inventory::check(const ContentIndices& indices) {
     for (size_t i = 0; i < slots.size(); ++i) {
         auto& slot = slots[i];
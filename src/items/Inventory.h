@@ -10,6 +10,11 @@
 class ContentIndices;
 class ContentReport;
 
+namespace json {
+    class BinaryWriter;
+    class BinaryReader;
+}
+
 class Inventory : Serializable {
     int64_t id;
     std::vector<ItemStack> slots;
@@ -36,6 +41,11 @@ public:
     void deserialize(const dv::value& src) override;
     dv::value serialize() const override;
 
+    /// @brief Читает инвентарь из BJSON без построения дерева dv
+    void deserialize(json::BinaryReader& reader);
+    /// @brief Записывает инвентарь в BJSON без построения дерева dv
+    void serialize(json::BinaryWriter& writer) const;
+
     void check(const ContentIndices& indices);
     void convert(const ContentReport* report);
     static void convert(dv::value& data, const ContentReport* report);
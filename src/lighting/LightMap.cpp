@@ -1,32 +1,246 @@
 #include <lighting/Lightmap.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 #include <util/data_io.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTMAP_SSE2
+#endif
+
 static_assert(sizeof(light_t) == 2, "Replace the dataio calls with the new light_t value");
+static_assert(
+    LIGHTMAP_SECTION_VOLUME * CHUNK_SECTIONS == CHUNK_VOLUME,
+    "Lightmap sections must cover the chunk"
+);
+
+/// Байт упакованного канала неба на два блока
+inline constexpr int SECTION_PACKED_LEN = LIGHTMAP_SECTION_VOLUME / 2;
+
+/// @brief Заменяет канал неба значений [from, to) на sky
+static void store_sky(light_t* data, uint from, uint to, light_t sky) {
+    uint i = from;
+#ifdef LIGHTMAP_SSE2
+    const __m128i keep = _mm_set1_epi16(0x0FFF);
+    const __m128i skyv = _mm_set1_epi16(static_cast<short>(sky));
+    for (; i + 8 <= to; i += 8) {
+        auto ptr = reinterpret_cast<__m128i*>(data + i);
+        __m128i value = _mm_loadu_si128(ptr);
+        _mm_storeu_si128(ptr, _mm_or_si128(_mm_and_si128(value, keep), skyv));
+    }
+#endif
+    for (; i < to; ++i) {
+        data[i] = (data[i] & 0x0FFF) | sky;
+    }
+}
+
+light_t* Lightmap::materialize(int section) {
+    auto& data = sections[section];
+    if (data == nullptr) {
+        data = std::make_unique<light_t[]>(LIGHTMAP_SECTION_VOLUME);
+        std::fill_n(data.get(), LIGHTMAP_SECTION_VOLUME, uniform[section]);
+    }
+    return data.get();
+}
 
 void Lightmap::set(const Lightmap* lightmap) {
-    set(lightmap->map);
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        uniform[i] = lightmap->uniform[i];
+        if (auto src = lightmap->sections[i].get()) {
+            std::memcpy(
+                materialize(i), src, sizeof(light_t) * LIGHTMAP_SECTION_VOLUME
+            );
+        } else {
+            sections[i].reset();
+        }
+    }
+    highestPoint = lightmap->highestPoint;
 }
 
 void Lightmap::set(const light_t* map) {
-    std::memcpy(this->map, map, sizeof(light_t) * CHUNK_VOLUME);
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        const light_t* src = map + i * LIGHTMAP_SECTION_VOLUME;
+        const light_t* end = src + LIGHTMAP_SECTION_VOLUME;
+        if (std::all_of(src, end, [v = *src](light_t l) { return l == v; })) {
+            sections[i].reset();
+            uniform[i] = *src;
+        } else {
+            std::copy(src, end, materialize(i));
+        }
+    }
+}
+
+void Lightmap::clear() {
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        sections[i].reset();
+        uniform[i] = 0;
+    }
+}
+
+void Lightmap::compact() {
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        const light_t* data = sections[i].get();
+        if (data == nullptr) {
+            continue;
+        }
+        light_t first = data[0];
+        const light_t* end = data + LIGHTMAP_SECTION_VOLUME;
+        if (std::all_of(data, end, [first](light_t l) { return l == first; })) {
+            sections[i].reset();
+            uniform[i] = first;
+        }
+    }
 }
 
-std::unique_ptr<ubyte[]> Lightmap::encode() const {
-    auto buffer = std::make_unique<ubyte[]>(LIGHTMAP_DATA_LEN);
-    for (uint i = 0; i < CHUNK_VOLUME; i += 2) {
-        buffer[i / 2] = ((map[i] >> 12) & 0xF) | ((map[i + 1] >> 8) & 0xF0);
+void Lightmap::fillS(int y0, int y1, int value) {
+    y0 = std::max(y0, 0);
+    y1 = std::min(y1, CHUNK_HEIGHT);
+    const light_t sky = value << 12;
+    while (y0 < y1) {
+        int section = y0 / CHUNK_SECTION_HEIGHT;
+        int sectionTop = (section + 1) * CHUNK_SECTION_HEIGHT;
+        int top = std::min(y1, sectionTop);
+        light_t* data = sections[section].get();
+        if (data == nullptr && y0 == section * CHUNK_SECTION_HEIGHT &&
+            top == sectionTop) {
+            // Однородная секция целиком остаётся однородной
+            uniform[section] = (uniform[section] & 0x0FFF) | sky;
+        } else {
+            if (data == nullptr) {
+                if ((uniform[section] & 0xF000) == sky) {
+                    y0 = top;
+                    continue;
+                }
+                data = materialize(section);
+            }
+            uint from = index(0, y0, 0) % LIGHTMAP_SECTION_VOLUME;
+            uint to = from + (top - y0) * CHUNK_WIDTH * CHUNK_DEPTH;
+            store_sky(data, from, to, sky);
+        }
+        y0 = top;
+    }
+}
+
+void Lightmap::setRowS(int y, int z, uint32_t mask, int value) {
+    constexpr uint32_t FULL_ROW = (1U << CHUNK_WIDTH) - 1;
+    mask &= FULL_ROW;
+    if (mask == 0) {
+        return;
+    }
+    const light_t sky = value << 12;
+    uint rowIndex = index(0, y, z);
+    int section = rowIndex / LIGHTMAP_SECTION_VOLUME;
+    light_t* data = sections[section].get();
+    if (data == nullptr) {
+        if ((uniform[section] & 0xF000) == sky) {
+            return;
+        }
+        data = materialize(section);
+    }
+    light_t* row = data + rowIndex % LIGHTMAP_SECTION_VOLUME;
+    if (mask == FULL_ROW) {
+        store_sky(row, 0, CHUNK_WIDTH, sky);
+        return;
+    }
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        if (mask & (1U << x)) {
+            row[x] = (row[x] & 0x0FFF) | sky;
+        }
+    }
+}
+
+int Lightmap::countMaterialized() const {
+    int count = 0;
+    for (const auto& section : sections) {
+        count += section != nullptr;
+    }
+    return count;
+}
+
+std::unique_ptr<ubyte[]> Lightmap::encode(uint32_t& size) const {
+    ubyte header[CHUNK_SECTIONS];
+    int packed = 0;
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        const light_t* data = sections[i].get();
+        header[i] = extract(uniform[i], 3);
+        if (data == nullptr) {
+            continue;
+        }
+        // Секция может различаться только светом блоков
+        light_t sky = data[0] & 0xF000;
+        if (!std::all_of(data, data + LIGHTMAP_SECTION_VOLUME, [sky](light_t l) {
+                return (l & 0xF000) == sky;
+            })) {
+            header[i] = LIGHTMAP_SECTION_PACKED;
+            packed++;
+        } else {
+            header[i] = sky >> 12;
+        }
+    }
+    size = CHUNK_SECTIONS + packed * SECTION_PACKED_LEN;
+    auto buffer = std::make_unique<ubyte[]>(size);
+    std::memcpy(buffer.get(), header, CHUNK_SECTIONS);
+    ubyte* dst = buffer.get() + CHUNK_SECTIONS;
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        if (header[i] != LIGHTMAP_SECTION_PACKED) {
+            continue;
+        }
+        const light_t* data = sections[i].get();
+        for (int j = 0; j < LIGHTMAP_SECTION_VOLUME; j += 2) {
+            *dst++ = ((data[j] >> 12) & 0xF) | ((data[j + 1] >> 8) & 0xF0);
+        }
     }
     return buffer;
 }
 
-void Lightmap::decode(const ubyte* src) {
-    for (uint i = 0; i < CHUNK_VOLUME; i += 2) {
-        ubyte b = src[i/2];
-        map[i] = ((b & 0xF) << 12);
-        map[i + 1] = ((b & 0xF0) << 8);
+/// @brief Распаковывает канал неба секции; однородная секция не выделяется
+static bool decode_section(const ubyte* src, light_t* dst) {
+    for (int j = 0; j < SECTION_PACKED_LEN; ++j) {
+        ubyte b = src[j];
+        dst[j * 2] = ((b & 0xF) << 12);
+        dst[j * 2 + 1] = ((b & 0xF0) << 8);
+    }
+    light_t first = dst[0];
+    return std::all_of(dst, dst + LIGHTMAP_SECTION_VOLUME, [first](light_t l) {
+        return l == first;
+    });
+}
+
+bool Lightmap::decode(const ubyte* src, size_t size) {
+    bool flat = size == LIGHTMAP_DATA_LEN;
+    if (!flat) {
+        if (size < CHUNK_SECTIONS) {
+            return false;
+        }
+        size_t packedCount = 0;
+        for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+            if (src[i] == LIGHTMAP_SECTION_PACKED) {
+                packedCount++;
+            } else if (src[i] > 0xF) {
+                return false;
+            }
+        }
+        if (size != CHUNK_SECTIONS + packedCount * SECTION_PACKED_LEN) {
+            return false;
+        }
+    }
+    const ubyte* packed = flat ? src : src + CHUNK_SECTIONS;
+    for (int i = 0; i < CHUNK_SECTIONS; ++i) {
+        if (!flat && src[i] != LIGHTMAP_SECTION_PACKED) {
+            sections[i].reset();
+            uniform[i] = src[i] << 12;
+            continue;
+        }
+        light_t* data = materialize(i);
+        if (decode_section(packed, data)) {
+            uniform[i] = data[0];
+            sections[i].reset();
+        }
+        packed += SECTION_PACKED_LEN;
     }
+    return true;
 }
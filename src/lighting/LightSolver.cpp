@@ -14,6 +14,7 @@ LightSolver::LightSolver(
     Chunks& chunks,
     int channel
 ) : blockDefs(contentIds.blocks.getDefs()),
+    blockProps(contentIds.getBlockProps()),
     chunks(chunks),
     channel(channel) {}
 
@@ -36,7 +37,7 @@ void LightSolver::add(int x, int y, int z, int bright) {
 
     add_queue.push(lightentry{x, y, z, (ubyte)bright});
 
-    chunk->flags.modified = true;
+    chunk->setModified(y);
     lightmap.set(
         x - chunk->chunk_x * CHUNK_WIDTH,
         y,
@@ -105,7 +106,7 @@ void LightSolver::solve(Chunk* prevailingChunk) {
 
             int lx = x - chunk->chunk_x * CHUNK_WIDTH;
             int lz = z - chunk->chunk_z * CHUNK_DEPTH;
-            chunk->flags.modified = true;
+            chunk->setModified(y);
 
             assert(chunk->lightmap != nullptr);
             auto& lightmap = *chunk->lightmap;
@@ -154,11 +155,11 @@ void LightSolver::solve(Chunk* prevailingChunk) {
             int local_x = x - chunk->chunk_x * CHUNK_WIDTH;
             int local_z = z - chunk->chunk_z * CHUNK_DEPTH;
 
-            chunk->flags.modified = true;
+            chunk->setModified(y);
             ubyte light = lightmap.get(local_x, y, local_z, channel);
-            voxel& vox = chunk->voxels[vox_index(local_x, y, local_z)];
-            const Block* block = blockDefs[vox.id];
-            if (block->lightPassing && light + 2 <= entry.light){
+            const voxel& vox = chunk->voxels[vox_index(local_x, y, local_z)];
+            if ((blockProps[vox.id] & BLOCK_PROP_LIGHT_PASSING) &&
+                light + 2 <= entry.light) {
                 lightmap.set(local_x, y, local_z, channel, entry.light - 1);
                 add_queue.push(lightentry{x, y, z, ubyte(entry.light - 1)});
             }
@@ -19,6 +19,8 @@ class LightSolver {
     util::array_queue<lightentry> add_queue;
     util::array_queue<lightentry> rem_queue;
     const Block* const* blockDefs;
+    /// Таблица свойств блоков ContentIndices::getBlockProps
+    const ubyte* blockProps;
     Chunks& chunks;
     int channel;
 public:
@@ -1,6 +1,7 @@
 #include <lighting/Lighting.h>
 
 #include <memory>
+#include <algorithm>
 #include <string>
 
 #include <lighting/LightSolver.h>
@@ -8,12 +9,14 @@
 #include <voxels/Chunks.h>
 #include <voxels/Chunk.h>
 #include <voxels/voxel.h>
+#include <voxels/voxel_scan.h>
 #include <voxels/Block.h>
 #include <core_content_defs.h>
 #include <typedefs.h>
 #include <constants.h>
 #include <content/Content.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("lighting");
 
@@ -39,7 +42,7 @@ void Lighting::clear() {
         auto& lightmap = chunk->lightmap;
         if (lightmap == nullptr) continue;
 
-        std::memset(lightmap->map, 0, sizeof(Lightmap::map));
+        lightmap->clear();
     }
 }
 
@@ -49,28 +52,57 @@ void Lighting::preBuildSkyLight(
     assert(chunk.lightmap != nullptr);
     auto& lightmap = *chunk.lightmap;
 
-    const auto* blockDefs = indices.blocks.getDefs();
+    constexpr int LAYER_VOLUME = CHUNK_WIDTH * CHUNK_DEPTH;
+    const ubyte* props = indices.getBlockProps();
     int highestPoint = 0;
-    for (int z = 0; z < CHUNK_DEPTH; ++z) {
-        for (int x = 0; x < CHUNK_WIDTH; ++x) {
-            for (int y = CHUNK_HEIGHT - 1; y >= 0; --y) {
-                int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-                voxel& vox = chunk.voxels[index];
-                const Block* block = blockDefs[vox.id];
-                if (!block->skyLightPassing) {
-                    if (highestPoint < y) highestPoint = y;
-                    break;
+
+    // Слои выше верхнего непустого вокселя - воздух
+    int y = CHUNK_HEIGHT - 1;
+    if (props[0] & BLOCK_PROP_SKY_LIGHT_PASSING) {
+        int last = voxel_scan::find_last_nonzero(chunk.voxels, CHUNK_VOLUME);
+        y = last < 0 ? -1 : last / LAYER_VOLUME;
+    }
+    // Столбцы (бит x в ряду z), до которых ещё доходит свет неба
+    uint32_t open[CHUNK_DEPTH];
+    std::fill_n(open, CHUNK_DEPTH, (1U << CHUNK_WIDTH) - 1);
+    int openRows = CHUNK_DEPTH;
+    // Слои от fullFrom и выше освещены небом во всех столбцах
+    int fullFrom = y + 1;
+    bool full = true;
+    for (; y >= 0 && openRows > 0; --y) {
+        const voxel* layer = chunk.voxels + y * LAYER_VOLUME;
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            if (open[z] == 0) {
+                continue;
+            }
+            uint32_t passing = voxel_scan::props_mask(
+                layer + z * CHUNK_WIDTH, props, BLOCK_PROP_SKY_LIGHT_PASSING
+            );
+            if (open[z] & ~passing) {
+                if (highestPoint < y) highestPoint = y;
+                full = false;
+                open[z] &= passing;
+                if (open[z] == 0) {
+                    openRows--;
                 }
-                lightmap.setS(x, y, z, 15);
             }
         }
+        if (full) {
+            fullFrom = y;
+            continue;
+        }
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            lightmap.setRowS(y, z, open[z], 15);
+        }
     }
+    // Целые слои записываются разом, однородные секции не выделяются
+    lightmap.fillS(fullFrom, CHUNK_HEIGHT, 15);
     if (highestPoint < CHUNK_HEIGHT - 1) highestPoint++;
     lightmap.highestPoint = highestPoint;
 }
 
 void Lighting::buildSkyLight(int cx, int cz) {
-    const auto blockDefs = indices.blocks.getDefs();
+    const ubyte* props = indices.getBlockProps();
 
     Chunk* chunk = chunks.getChunk(cx, cz);
     if (chunk == nullptr) {
@@ -86,7 +118,8 @@ void Lighting::buildSkyLight(int cx, int cz) {
         for (int x = 0; x < CHUNK_WIDTH; ++x) {
             int gx = x + cx * CHUNK_WIDTH;
             for (int y = lightmap.highestPoint; y >= 0; --y){
-                while (y > 0 && !blockDefs[chunk->voxels[vox_index(x, y, z)].id]->lightPassing) {
+                while (y > 0 && !(props[chunk->voxels[vox_index(x, y, z)].id] &
+                                  BLOCK_PROP_LIGHT_PASSING)) {
                     --y;
                 }
                 if (lightmap.getS(x, y, z) != 15) {
@@ -105,6 +138,7 @@ void Lighting::buildSkyLight(int cx, int cz) {
 }
 
 void Lighting::onChunkLoaded(int chunk_x, int chunk_z, bool expand) {
+    PROFILE_ZONE("lighting.chunk");
     auto& solverR = *this->solverR;
     auto& solverG = *this->solverG;
     auto& solverB = *this->solverB;
@@ -120,18 +154,24 @@ void Lighting::onChunkLoaded(int chunk_x, int chunk_z, bool expand) {
     assert(chunk->lightmap != nullptr);
     auto& lightmap = *chunk->lightmap;
 
-    for (uint y = 0; y < CHUNK_HEIGHT; ++y) {
-        for (uint z = 0; z < CHUNK_DEPTH; ++z) {
-            for (uint x = 0; x < CHUNK_WIDTH; ++x) {
-                const voxel& vox = chunk->voxels[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x];
-                const Block* block = blockDefs[vox.id];
+    // Источники света ищутся рядами: определение блока читается только
+    // для светящихся
+    const ubyte* props = indices.getBlockProps();
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            const voxel* row = chunk->voxels + vox_index(0, y, z);
+            uint32_t emissive =
+                voxel_scan::props_mask(row, props, BLOCK_PROP_EMISSIVE);
+            for (int x = 0; emissive; ++x, emissive >>= 1) {
+                if ((emissive & 1) == 0) {
+                    continue;
+                }
+                const Block* block = blockDefs[row[x].id];
                 int gx = x + chunk_x * CHUNK_WIDTH;
                 int gz = z + chunk_z * CHUNK_DEPTH;
-                if (block->rt.emissive){
-                    solverR.add(gx, y, gz, block->emission[0]);
-                    solverG.add(gx, y, gz, block->emission[1]);
-                    solverB.add(gx, y, gz, block->emission[2]);
-                }
+                solverR.add(gx, y, gz, block->emission[0]);
+                solverG.add(gx, y, gz, block->emission[1]);
+                solverB.add(gx, y, gz, block->emission[2]);
             }
         }
     }
@@ -175,6 +215,9 @@ void Lighting::onChunkLoaded(int chunk_x, int chunk_z, bool expand) {
     solverG.solve(chunk);
     solverB.solve(chunk);
     solverS.solve(chunk);
+    // Решатели материализуют затронутые секции; однородные возвращаются
+    // к одному значению
+    chunk->lightmap->compact();
 }
 
 void Lighting::onBlockSet(int x, int y, int z, blockid_t id) {
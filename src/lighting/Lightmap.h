@@ -8,86 +8,147 @@
 #include <typedefs.h>
 #include <constants.h>
 
+/// Размер освещения чанка в прежнем плоском формате: по 4 бита неба на блок
 inline constexpr int LIGHTMAP_DATA_LEN = CHUNK_VOLUME / 2;
-
+/// Число значений освещения в вертикальной секции чанка
+inline constexpr int LIGHTMAP_SECTION_VOLUME =
+    CHUNK_WIDTH * CHUNK_DEPTH * CHUNK_SECTION_HEIGHT;
+/// Наибольший размер освещения чанка в секционном формате
+inline constexpr int LIGHTMAP_MAX_ENCODED_LEN = CHUNK_SECTIONS + LIGHTMAP_DATA_LEN;
+/// Отметка неоднородной секции в заголовке закодированного освещения
+inline constexpr ubyte LIGHTMAP_SECTION_PACKED = 0xFF;
+
+/// @brief Карта освещения чанка по вертикальным секциям.
+///
+/// Однородная секция (например, полный свет неба над рельефом или ноль
+/// под землёй) хранится одним значением, массив выделяется только секции
+/// с разными значениями. Индекс в чанке (vox_index) делится на индекс
+/// секции и смещение в ней без учёта координат
 class Lightmap {
+    /// Массивы неоднородных секций; nullptr - секция однородна
+    std::unique_ptr<light_t[]> sections[CHUNK_SECTIONS];
+    /// Значения однородных секций
+    light_t uniform[CHUNK_SECTIONS] {};
+
+    light_t* materialize(int section);
+
+    inline void write(uint index, light_t value) {
+        uint section = index / LIGHTMAP_SECTION_VOLUME;
+        if (auto data = sections[section].get()) {
+            data[index % LIGHTMAP_SECTION_VOLUME] = value;
+        } else if (uniform[section] != value) {
+            materialize(section)[index % LIGHTMAP_SECTION_VOLUME] = value;
+        }
+    }
+
+    static inline uint index(int x, int y, int z) {
+        return (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
+    }
 public:
-	light_t map[CHUNK_VOLUME] {};
     int highestPoint = 0;
 
     void set(const Lightmap* lightmap);
-	void set(const light_t* map);
-
-	void clear() {
-        std::memset(map, 0, sizeof(map));
+    /// @brief Копирует освещение из плоского массива CHUNK_VOLUME значений
+    void set(const light_t* map);
+
+    void clear();
+
+    /// @brief Заменяет неоднородные секции с одинаковыми значениями одним
+    /// значением, освобождая их массивы
+    void compact();
+
+    /// @brief Задаёт канал неба в слоях [y0, y1); целые однородные секции
+    /// остаются однородными
+    void fillS(int y0, int y1, int value);
+
+    /// @brief Задаёт канал неба вокселям ряда z слоя y, отмеченным в mask
+    /// (бит x)
+    void setRowS(int y, int z, uint32_t mask, int value);
+
+    /// @return значение по индексу в чанке (vox_index)
+    inline light_t get(uint index) const {
+        uint section = index / LIGHTMAP_SECTION_VOLUME;
+        if (auto data = sections[section].get()) {
+            return data[index % LIGHTMAP_SECTION_VOLUME];
+        }
+        return uniform[section];
     }
 
     inline ushort get(int x, int y, int z) const {
-		return (map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x]);
-	}
-
-	inline ubyte get(int x, int y, int z, int channel) const {
-		return (map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x] >> (channel << 2)) & 0xF;
-	}
-
-	inline ubyte getR(int x, int y, int z) const {
-		return map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x] & 0xF;
-	}
-
-	inline ubyte getG(int x, int y, int z) const {
-		return (map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x] >> 4) & 0xF;
-	}
-
-	inline ubyte getB(int x, int y, int z) const {
-		return (map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x] >> 8) & 0xF;
-	}
-
-	inline ubyte getS(int x, int y, int z) const {
-		return (map[(y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x] >> 12) & 0xF;
-	}
-
-	inline void setR(int x, int y, int z, int value){
-		const int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-		map[index] = (map[index] & 0xFFF0) | value;
-	}
-
-	inline void setG(int x, int y, int z, int value){
-		const int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-		map[index] = (map[index] & 0xFF0F) | (value << 4);
-	}
-
-	inline void setB(int x, int y, int z, int value){
-		const int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-		map[index] = (map[index] & 0xF0FF) | (value << 8);
-	}
-
-	inline void setS(int x, int y, int z, int value){
-		const int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-		map[index] = (map[index] & 0x0FFF) | (value << 12);
-	}
-
-	inline void set(int x, int y, int z, int channel, int value){
-		const int index = (y * CHUNK_DEPTH + z) * CHUNK_WIDTH + x;
-		map[index] = (map[index] & (0xFFFF & (~(0xF << (channel*4))))) | (value << (channel << 2));
-	}
-
-    inline const light_t* getLights() const {
-		return map;
-	}
-
-	inline light_t* getLightsWriteable() {
-		return map;
-	}
-
-	static inline constexpr light_t extract(light_t light, ubyte channel) {
-		return (light >> (channel << 2)) & 0xF;
-	}
-
-	static inline constexpr light_t combine(int r, int g, int b, int s) {
-		return r | (g << 4) | (b << 8) | (s << 12);
-	}
-
-	static glm::vec4 extractNormalized(light_t light) {
+        return get(index(x, y, z));
+    }
+
+    inline ubyte get(int x, int y, int z, int channel) const {
+        return extract(get(index(x, y, z)), channel);
+    }
+
+    inline ubyte getR(int x, int y, int z) const {
+        return get(index(x, y, z)) & 0xF;
+    }
+
+    inline ubyte getG(int x, int y, int z) const {
+        return (get(index(x, y, z)) >> 4) & 0xF;
+    }
+
+    inline ubyte getB(int x, int y, int z) const {
+        return (get(index(x, y, z)) >> 8) & 0xF;
+    }
+
+    inline ubyte getS(int x, int y, int z) const {
+        return (get(index(x, y, z)) >> 12) & 0xF;
+    }
+
+    inline void setR(int x, int y, int z, int value) {
+        const uint i = index(x, y, z);
+        write(i, (get(i) & 0xFFF0) | value);
+    }
+
+    inline void setG(int x, int y, int z, int value) {
+        const uint i = index(x, y, z);
+        write(i, (get(i) & 0xFF0F) | (value << 4));
+    }
+
+    inline void setB(int x, int y, int z, int value) {
+        const uint i = index(x, y, z);
+        write(i, (get(i) & 0xF0FF) | (value << 8));
+    }
+
+    inline void setS(int x, int y, int z, int value) {
+        const uint i = index(x, y, z);
+        write(i, (get(i) & 0x0FFF) | (value << 12));
+    }
+
+    inline void set(int x, int y, int z, int channel, int value) {
+        const uint i = index(x, y, z);
+        write(
+            i,
+            (get(i) & (0xFFFF & (~(0xF << (channel * 4))))) |
+                (value << (channel << 2))
+        );
+    }
+
+    /// @return массив неоднородной секции или nullptr
+    inline const light_t* getSection(int section) const {
+        return sections[section].get();
+    }
+
+    /// @return значение однородной секции
+    inline light_t getUniform(int section) const {
+        return uniform[section];
+    }
+
+    /// @return число секций, для которых выделены массивы
+    int countMaterialized() const;
+
+    static inline constexpr light_t extract(light_t light, ubyte channel) {
+        return (light >> (channel << 2)) & 0xF;
+    }
+
+    static inline constexpr light_t combine(int r, int g, int b, int s) {
+        return r | (g << 4) | (b << 8) | (s << 12);
+    }
+
+    static glm::vec4 extractNormalized(light_t light) {
         return glm::vec4(
             extract(light, 0) / 15.0f,
             extract(light, 1) / 15.0f,
@@ -96,8 +157,16 @@ public:
         );
     }
 
-	std::unique_ptr<ubyte[]> encode() const;
-    void decode(const ubyte* src);
-
-	static inline light_t SUN_LIGHT_ONLY = combine(0U, 0U, 0U, 15U);
+    /// @brief Кодирует канал неба по секциям: заголовок из CHUNK_SECTIONS
+    /// байт (значение однородной секции или LIGHTMAP_SECTION_PACKED), затем
+    /// по 4 бита на блок для каждой неоднородной секции
+    /// @param size размер результата
+    std::unique_ptr<ubyte[]> encode(uint32_t& size) const;
+    /// @brief Декодирует канал неба; данные размера LIGHTMAP_DATA_LEN
+    /// читаются в прежнем плоском формате
+    /// @return false, если размер или заголовок повреждены; карта при этом
+    /// не изменяется
+    [[nodiscard]] bool decode(const ubyte* src, size_t size);
+
+    static inline light_t SUN_LIGHT_ONLY = combine(0U, 0U, 0U, 15U);
 };
@@ -19,8 +19,14 @@
 #include <objects/Player.h>
 #include <objects/Players.h>
 #include <math/rand.h>
+#include <debug/Profiler.h>
+#include <logic/ChunksInterest.h>
+#include <voxels/GlobalChunks.h>
 
 static inline constexpr int CHUNK_RANDOM_TICK_SEGMENTS = 4;
+/// Шаг строки при распределении чанков по частям тика, взаимно простой
+/// с обычным числом частей, чтобы соседние строки не совпадали
+static inline constexpr int RANDOM_SPARK_STRIDE = 7;
 
 BlocksController::BlocksController(
     const Level& level,
@@ -123,13 +129,14 @@ void BlocksController::updateBlock(int x, int y, int z) {
     if (def.rt.funcsset.update) scripting::update_block(def, glm::ivec3(x, y, z));
 }
 
-void BlocksController::update(float delta, uint padding) {
+void BlocksController::update(float delta, const ChunksInterest& interest) {
+    PROFILE_ZONE("blocks.update");
     if (int parts = randSparkClock.update(delta)) {
         for (int i = 0; i < parts; ++i) {
             randomSpark(
                 randSparkClock.convertPart(i),
                 randSparkClock.getParts(),
-                padding
+                interest
             );
         }
     }
@@ -203,27 +210,21 @@ void BlocksController::randomSpark(
     }
 }
 
-void BlocksController::randomSpark(int sparkId, int parts, uint padding) {
+void BlocksController::randomSpark(
+    int sparkId, int parts, const ChunksInterest& interest
+) {
+    PROFILE_ZONE("blocks.random-spark");
     auto indices = level.content.getIndices();
-
-    for (const auto& [pid, player] : *level.players) {
-        const auto& chunks = *player->chunks;
-        int width = chunks.getWidth();
-        int depth = chunks.getDepth();
-
-        for (uint z = padding; z < depth - padding; ++z) {
-            for (uint x = padding; x < width - padding; ++x) {
-                int index = z * width + x;
-                if ((index + sparkId) % parts != 0) continue;
-                auto& chunk = chunks.getChunks()[index];
-                if (chunk == nullptr || !chunk->flags.ready) continue;
-                if (chunk->lastRandomSparkId == randomSparkId) {
-                    continue;
-                }
-                chunk->lastRandomSparkId = randomSparkId;
-                randomSpark(*chunk, indices);
-            }
-        }
+    // Каждый нужный чанк встречается один раз, сколько бы игроков его
+    // ни держали; часть тика выбирается по позиции чанка, а не по индексу,
+    // который меняется при удалениях
+    for (const auto& pos : interest.getPositions()) {
+        int slot = (pos.x + pos.y * RANDOM_SPARK_STRIDE) % parts;
+        if (slot < 0) slot += parts;
+        if ((slot + sparkId) % parts != 0) continue;
+        auto chunk = chunks.getChunk(pos.x, pos.y);
+        if (chunk == nullptr || !chunk->flags.ready) continue;
+        randomSpark(*chunk, indices);
     }
     randomSparkId++;
 }
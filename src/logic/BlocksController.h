@@ -16,6 +16,7 @@ class Lighting;
 class Chunk;
 class ContentIndices;
 class GlobalChunks;
+class ChunksInterest;
 
 enum class BlockInteraction {
     Step,
@@ -56,12 +57,13 @@ public:
         int x, int y, int z
     );
 
-    void update(float delta, uint padding);
+    void update(float delta, const ChunksInterest& interest);
     void randomSpark(
         const Chunk& chunk,
         const ContentIndices* indices
     );
-    void randomSpark(int sparkId, int parts, uint padding);
+    /// @brief Случайные тики части нужных игрокам чанков, по разу на чанк
+    void randomSpark(int sparkId, int parts, const ChunksInterest& interest);
     void onBlocksSpark(int sparkId, int parts);
 
     int64_t createBlockInventory(int x, int y, int z);
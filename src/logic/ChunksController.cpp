@@ -1,5 +1,6 @@
 #include <logic/ChunksController.h>
 
+#include <cmath>
 #include <limits.h>
 #include <memory>
 
@@ -21,18 +22,37 @@
 #include <util/timeutil.h>
 #include <content/Content.h>
 #include <objects/Player.h>
+#include <objects/Players.h>
+#include <physics/Hitbox.h>
 #include <world/LevelEvents.h>
+#include <debug/Profiler.h>
 
 inline constexpr int MAX_WORK_PER_FRAME = 128;
 inline constexpr int MIN_SURROUNDING = 9;
+/// Чанки, выбираемые из очереди загрузки за один раз
+inline constexpr size_t LOAD_BATCH_SIZE = 16;
+
+static ChunksLoadFocus get_load_focus(const Player& player) {
+    ChunksLoadFocus focus;
+    const auto& position = player.getPosition();
+    focus.position = {position.x / CHUNK_WIDTH, position.z / CHUNK_DEPTH};
+    float yaw = glm::radians(player.getRotation().x);
+    focus.view = {-std::sin(yaw), -std::cos(yaw)};
+    if (auto hitbox = player.getHitbox()) {
+        focus.velocity = {
+            hitbox->velocity.x / CHUNK_WIDTH, hitbox->velocity.z / CHUNK_DEPTH};
+    }
+    return focus;
+}
 
 ChunksController::ChunksController(
-    Level& level
+    Level& level, int generatorWorkers
 ) : level(level), 
     generator(std::make_unique<WorldGenerator>(
         level.content.generators.require(level.environment.generator),
         level.content,
-        level.getWorld().getSeed()
+        level.getWorld().getSeed(),
+        generatorWorkers
     )) {}
 
 ChunksController::~ChunksController() = default;
@@ -43,7 +63,8 @@ void ChunksController::update(
     uint padding,
     Player& player,
     bool isLocalPlayer
-) const {
+) {
+    PROFILE_ZONE("chunks.update");
     const auto& position = player.getPosition();
     int centerX = floordiv<CHUNK_WIDTH>(glm::floor(position.x));
     int centerY = floordiv<CHUNK_DEPTH>(glm::floor(position.z));
@@ -53,17 +74,59 @@ void ChunksController::update(
     } else {
         return;
     }
-    int64_t mcstotal = 0;
-    for (uint i = 0; i < MAX_WORK_PER_FRAME; ++i) {
-        timeutil::Timer timer;
-        if (loadVisible(player, padding, isLocalPlayer)) {
-            int64_t mcs = timer.stop();
-            if (mcstotal + mcs < maxDuration * 1000) {
-                mcstotal += mcs;
+    auto& chunks = *player.chunks;
+    auto& queue = queues[player.getId()];
+    if (queue.update(chunks.getAreaMap(), padding)) {
+        removeFarChunks(chunks);
+        queue.acceptRemovals(chunks.getAreaMap());
+    }
+
+    timeutil::Timer timer;
+    int work = 0;
+    // Первая единица работы выполняется всегда, как и прежде
+    auto isOverBudget = [&]() {
+        return ++work >= MAX_WORK_PER_FRAME ||
+               timer.stop() >= maxDuration * 1000;
+    };
+    auto focus = get_load_focus(player);
+    while (true) {
+        auto& candidates = queue.getLightCandidates();
+        if (!isLocalPlayer) {
+            candidates.clear();
+        }
+        while (!candidates.empty()) {
+            auto pos = candidates.back();
+            candidates.pop_back();
+            if (!queue.isInLoadingZone(pos.x, pos.y)) {
+                continue;
+            }
+            auto chunk = chunks.getChunk(pos.x, pos.y);
+            if (chunk == nullptr || !chunk->flags.loaded ||
+                chunk->flags.lighted || !buildLights(player, *chunk)) {
                 continue;
             }
+            if (isOverBudget()) return;
+        }
+
+        queue.select(chunks.getAreaMap(), focus, LOAD_BATCH_SIZE, batch);
+        if (batch.empty()) {
+            return;
+        }
+        for (const auto& pos : batch) {
+            createChunk(player, pos.x, pos.y);
+            queue.onLoaded(pos.x, pos.y);
+            if (isOverBudget()) return;
+        }
+    }
+}
+
+void ChunksController::removeAbsentPlayers(const Players& players) {
+    for (auto it = queues.begin(); it != queues.end();) {
+        if (players.getPlayer(it->first)) {
+            ++it;
+            continue;
         }
-        break;
+        it = queues.erase(it);
     }
 }
 
@@ -83,88 +146,43 @@ bool ChunksController::isInLoadingZone(
     return distance < minDistance;
 }
 
-bool ChunksController::loadVisible(
-    const Player& player, uint padding, bool isLocalPlayer
-) const {
-    auto& chunks = *player.chunks;
+void ChunksController::removeFarChunks(Chunks& chunks) const {
     int sizeX = chunks.getWidth();
     int sizeY = chunks.getDepth();
-
-    int nearX = 0;
-    int nearZ = 0;
-    bool assigned = false;
-    int minDistance = ((sizeX - padding * 2) / 2) * ((sizeY - padding * 2) / 2);
-
     int maxDistance = ((sizeX) / 2) * ((sizeY) / 2);
-    for (uint z = 0; z < sizeY; ++z) {
-        for (uint x = 0; x < sizeX; ++x) {
-            int index = z * sizeX + x;
+    for (int z = 0; z < sizeY; ++z) {
+        for (int x = 0; x < sizeX; ++x) {
             int lx = x - sizeX / 2;
             int lz = z - sizeY / 2;
             int distance = (lx * lx + lz * lz);
-            auto& chunk = chunks.getChunks()[index];
-            if (chunk != nullptr) {
-                if (distance >= maxDistance) {
-                    chunks.remove(
-                        x + chunks.getOffsetX(), z + chunks.getOffsetZ()
-                    );
-                }
-                continue;
+            if (distance >= maxDistance &&
+                chunks.getChunks()[z * sizeX + x] != nullptr) {
+                chunks.remove(
+                    x + chunks.getOffsetX(), z + chunks.getOffsetZ()
+                );
             }
         }
     }
-
-    for (uint z = padding; z < sizeY - padding; ++z){
-        for (uint x = padding; x < sizeX - padding; ++x){
-            int index = z * sizeX + x;
-            int lx = x - sizeX / 2;
-            int lz = z - sizeY / 2;
-            int distance = (lx * lx + lz * lz);
-            auto& chunk = chunks.getChunks()[index];
-            if (chunk != nullptr) {
-                if (chunk->flags.loaded && !chunk->flags.lighted) {
-                    if (isLocalPlayer && buildLights(player, chunk)) return true;
-                }
-                continue;
-            }
-
-            if (distance < minDistance){
-                minDistance = distance;
-                nearX = x;
-                nearZ = z;
-                assigned = true;
-            }
-        }
-    }
-
-    const auto& chunk = chunks.getChunks()[nearZ * sizeX + nearX];
-    if (chunk != nullptr || !assigned || !player.isLoadingChunks()) {
-        return false;
-    }
-
-    int offsetX = chunks.getOffsetX();
-    int offsetZ = chunks.getOffsetZ();
-    createChunk(player, nearX + offsetX, nearZ + offsetZ);
-    return true;
 }
 
-bool ChunksController::buildLights(const Player& player, const std::shared_ptr<Chunk>& chunk) const {
+bool ChunksController::buildLights(const Player& player, Chunk& chunk) const {
+    PROFILE_ZONE("chunks.lighting");
     int surrounding = 0;
     for (int dz = -1; dz <= 1; ++dz) {
         for (int dx = -1; dx <= 1; ++dx) {
-            if (player.chunks->getChunk(chunk->chunk_x + dx, chunk->chunk_z + dz)) surrounding++;
+            if (player.chunks->getChunk(chunk.chunk_x + dx, chunk.chunk_z + dz)) surrounding++;
         }
     }
 
     if (surrounding == MIN_SURROUNDING) {
-        if (lighting && chunk->lightmap) {
-            bool lightsCache = chunk->flags.loadedLights;
+        if (lighting && chunk.lightmap) {
+            bool lightsCache = chunk.flags.loadedLights;
             if (!lightsCache) {
-                lighting->buildSkyLight(chunk->chunk_x, chunk->chunk_z);
+                lighting->buildSkyLight(chunk.chunk_x, chunk.chunk_z);
             }
-            lighting->onChunkLoaded(chunk->chunk_x, chunk->chunk_z, !lightsCache);
+            lighting->onChunkLoaded(chunk.chunk_x, chunk.chunk_z, !lightsCache);
         }
-        chunk->flags.lighted = true;
+        chunk.flags.lighted = true;
         return true;
     }
     return false;
@@ -180,6 +198,11 @@ void ChunksController::createChunk(const Player& player, int x, int z) const {
     auto chunk = level.chunks->create(x, z, lighting != nullptr);
     player.chunks->putChunk(chunk);
     auto& chunkFlags = chunk->flags;
+    // Чанк уже подготовлен для другого игрока: повторные генерация,
+    // CHUNK_PRESENT и сброс освещения не нужны
+    if (chunkFlags.ready) {
+        return;
+    }
 
     if (!chunkFlags.loaded) {
         generator->generate(chunk->voxels, x, z);
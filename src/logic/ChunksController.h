@@ -1,8 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <unordered_map>
 
 #include <typedefs.h>
+#include <logic/ChunksLoadQueue.h>
 
 class Level;
 class Chunks;
@@ -13,19 +16,25 @@ class ChunksLoader;
 class WorldGenerator;
 class Chunk;
 class Player;
+class Players;
 
 class ChunksController {
 private:
     Level& level;
     std::unique_ptr<WorldGenerator> generator;
-
-    bool loadVisible(const Player& player, uint padding, bool isLocalPlayer) const;
-    bool buildLights(const Player& player, const std::shared_ptr<Chunk>& chunk) const;
+    /// Очереди загрузки чанков по идентификаторам игроков
+    std::unordered_map<int64_t, ChunksLoadQueue> queues;
+    /// Пакет чанков, выбранный из очереди
+    std::vector<glm::ivec2> batch;
+
+    /// @brief Удаляет чанки в углах окна, вне радиуса загрузки
+    void removeFarChunks(Chunks& chunks) const;
+    bool buildLights(const Player& player, Chunk& chunk) const;
     void createChunk(const Player& player, int x, int y) const;
 public:
     std::unique_ptr<Lighting> lighting;
 
-    ChunksController(Level& level);
+    ChunksController(Level& level, int generatorWorkers = 1);
     ~ChunksController();
 
     void update(
@@ -34,7 +43,10 @@ public:
         uint padding,
         Player& player,
         bool isLocalPlayer
-    ) const;
+    );
+
+    /// @brief Удаляет очереди загрузки игроков, которых больше нет
+    void removeAbsentPlayers(const Players& players);
 
     bool isInLoadingZone(
         const Player& player,
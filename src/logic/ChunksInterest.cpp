@@ -0,0 +1,115 @@
+#include <logic/ChunksInterest.h>
+
+#include <algorithm>
+
+template <typename Func>
+void ChunksInterest::forEachExcept(
+    const Area& area, const Area& other, Func func
+) {
+    if (area.empty()) {
+        return;
+    }
+    for (int z = area.min.y; z <= area.max.y; ++z) {
+        if (other.empty() || z < other.min.y || z > other.max.y) {
+            for (int x = area.min.x; x <= area.max.x; ++x) {
+                func(x, z);
+            }
+            continue;
+        }
+        // Строка пересекается с other: остаются отрезки слева и справа
+        int leftEnd = std::min(area.max.x, other.min.x - 1);
+        for (int x = area.min.x; x <= leftEnd; ++x) {
+            func(x, z);
+        }
+        int rightBegin = std::max(area.min.x, other.max.x + 1);
+        for (int x = rightBegin; x <= area.max.x; ++x) {
+            func(x, z);
+        }
+    }
+}
+
+void ChunksInterest::incref(int x, int z) {
+    glm::ivec2 pos(x, z);
+    auto [found, inserted] = indices.try_emplace(pos, positions.size());
+    if (inserted) {
+        positions.push_back(pos);
+        refs.push_back(1);
+    } else {
+        refs[found->second]++;
+    }
+}
+
+void ChunksInterest::decref(int x, int z) {
+    const auto& found = indices.find(glm::ivec2(x, z));
+    if (found == indices.end()) {
+        return;
+    }
+    size_t index = found->second;
+    if (--refs[index] > 0) {
+        return;
+    }
+    indices.erase(found);
+    // Последняя позиция переносится на место удалённой
+    size_t last = positions.size() - 1;
+    if (index != last) {
+        positions[index] = positions[last];
+        refs[index] = refs[last];
+        indices[positions[index]] = index;
+    }
+    positions.pop_back();
+    refs.pop_back();
+}
+
+void ChunksInterest::assign(
+    Area& area, const glm::ivec2& min, const glm::ivec2& max
+) {
+    if (area.min == min && area.max == max) {
+        return;
+    }
+    Area next = area;
+    next.min = min;
+    next.max = max;
+    forEachExcept(next, area, [this](int x, int z) { incref(x, z); });
+    forEachExcept(area, next, [this](int x, int z) { decref(x, z); });
+    area = next;
+}
+
+void ChunksInterest::beginUpdate() {
+    updateId++;
+}
+
+void ChunksInterest::endUpdate() {
+    for (auto it = areas.begin(); it != areas.end();) {
+        if (it->second.updateId == updateId) {
+            ++it;
+            continue;
+        }
+        assign(it->second, {0, 0}, {-1, -1});
+        it = areas.erase(it);
+    }
+}
+
+void ChunksInterest::setArea(
+    int64_t owner, const glm::ivec2& min, const glm::ivec2& max
+) {
+    auto& area = areas[owner];
+    area.updateId = updateId;
+    assign(area, min, max);
+}
+
+void ChunksInterest::removeOwner(int64_t owner) {
+    const auto& found = areas.find(owner);
+    if (found == areas.end()) {
+        return;
+    }
+    assign(found->second, {0, 0}, {-1, -1});
+    areas.erase(found);
+}
+
+uint32_t ChunksInterest::getRefs(int x, int z) const {
+    const auto& found = indices.find(glm::ivec2(x, z));
+    if (found == indices.end()) {
+        return 0;
+    }
+    return refs[found->second];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+/// @brief Общее для всех игроков множество нужных чанков.
+///
+/// Каждый владелец (игрок) задаёт прямоугольник нужных ему чанков, у каждой
+/// позиции хранится число владельцев, которым она нужна. Пересекающиеся
+/// области дают одну позицию, поэтому обработка множества (случайные тики)
+/// выполняется по разу на чанк, сколько бы игроков ни было рядом.
+///
+/// Область обновляется по разности прямоугольников: при сдвиге на один чанк
+/// затрагиваются только вошедшие и покинувшие область строки и столбцы
+class ChunksInterest {
+    struct Area {
+        /// Границы включительно; пустая область, если min > max
+        glm::ivec2 min {0, 0};
+        glm::ivec2 max {-1, -1};
+        /// Номер обновления, в котором область была задана
+        uint64_t updateId = 0;
+
+        bool contains(int x, int z) const {
+            return x >= min.x && z >= min.y && x <= max.x && z <= max.y;
+        }
+        bool empty() const {
+            return min.x > max.x || min.y > max.y;
+        }
+    };
+
+    std::unordered_map<int64_t, Area> areas;
+    /// Нужные позиции подряд, для обхода без пустот
+    std::vector<glm::ivec2> positions;
+    /// Число владельцев позиции, параллельно positions
+    std::vector<uint32_t> refs;
+    /// Индекс позиции в positions
+    std::unordered_map<glm::ivec2, size_t> indices;
+    uint64_t updateId = 0;
+
+    void incref(int x, int z);
+    void decref(int x, int z);
+
+    /// @brief Вызывает func для позиций area, не входящих в other
+    template <typename Func>
+    static void forEachExcept(const Area& area, const Area& other, Func func);
+
+    void assign(Area& area, const glm::ivec2& min, const glm::ivec2& max);
+public:
+    /// @brief Начинает обход владельцев: области, не заданные до endUpdate,
+    /// будут удалены
+    void beginUpdate();
+    /// @brief Удаляет области владельцев, не заданные с начала обновления
+    void endUpdate();
+
+    /// @brief Задаёт прямоугольник нужных владельцу чанков (включительно)
+    void setArea(int64_t owner, const glm::ivec2& min, const glm::ivec2& max);
+    void removeOwner(int64_t owner);
+
+    /// @return число владельцев, которым нужен чанк
+    uint32_t getRefs(int x, int z) const;
+
+    bool isRequired(int x, int z) const {
+        return getRefs(x, z) > 0;
+    }
+
+    /// @brief Нужные чанки без повторов; порядок меняется при удалениях
+    const std::vector<glm::ivec2>& getPositions() const {
+        return positions;
+    }
+
+    size_t size() const {
+        return positions.size();
+    }
+};
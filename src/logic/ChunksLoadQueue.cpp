@@ -0,0 +1,196 @@
+#include <logic/ChunksLoadQueue.h>
+
+#include <cmath>
+#include <algorithm>
+
+#include <voxels/Chunk.h>
+
+/// Доля расстояния, на которую приближаются чанки прямо по взгляду
+inline constexpr float VIEW_WEIGHT = 0.35f;
+/// Доля расстояния, на которую приближаются чанки по направлению движения
+inline constexpr float MOTION_WEIGHT = 0.35f;
+/// Скорость (чанков в секунду), с которой вес движения максимален
+inline constexpr float MOTION_SATURATION = 2.0f;
+
+float ChunksLoadFocus::priority(int x, int z) const {
+    glm::vec2 delta = glm::vec2(x, z) + 0.5f - position;
+    float distance = glm::length(delta);
+    // Чанк под игроком и соседние загружаются первыми независимо от взгляда
+    if (distance < 1.5f) {
+        return distance;
+    }
+    glm::vec2 dir = delta / distance;
+    float ahead = std::max(0.0f, glm::dot(dir, view));
+    float motion = 0.0f;
+    float speed = glm::length(velocity);
+    if (speed > 0.0f) {
+        motion = std::max(0.0f, glm::dot(dir, velocity / speed)) *
+                 std::min(speed / MOTION_SATURATION, 1.0f);
+    }
+    return distance * (1.0f - VIEW_WEIGHT * ahead - MOTION_WEIGHT * motion);
+}
+
+ChunksLoadQueue::ZoneRow ChunksLoadQueue::zoneRow(int32_t z) const {
+    if (z < padding || z >= depth - padding) {
+        return {0, -1};
+    }
+    int32_t lz = z - depth / 2;
+    int32_t minDistance =
+        ((width - padding * 2) / 2) * ((depth - padding * 2) / 2);
+    int32_t rest = minDistance - lz * lz;
+    if (rest <= 0) {
+        return {0, -1};
+    }
+    // Наибольшее k, при котором k * k < rest
+    auto k = static_cast<int32_t>(std::sqrt(static_cast<float>(rest)));
+    while (k > 0 && k * k >= rest) {
+        k--;
+    }
+    while ((k + 1) * (k + 1) < rest) {
+        k++;
+    }
+    return {
+        std::max<int32_t>(padding, width / 2 - k),
+        std::min<int32_t>(width - padding - 1, width / 2 + k)};
+}
+
+bool ChunksLoadQueue::isInZone(int32_t x, int32_t z) const {
+    if (z < 0 || z >= depth) {
+        return false;
+    }
+    auto row = zoneRow(z);
+    return x >= row.from && x <= row.to;
+}
+
+void ChunksLoadQueue::rescan(const AreaMap& area) {
+    width = area.getWidth();
+    depth = area.getDepth();
+    offsetX = area.getOffsetX();
+    offsetZ = area.getOffsetZ();
+    removedCount = area.getRemovedCount();
+
+    missing.clear();
+    lightCandidates.clear();
+    const auto& buffer = area.getBuffer();
+    for (int32_t z = 0; z < depth; ++z) {
+        auto row = zoneRow(z);
+        for (int32_t x = row.from; x <= row.to; ++x) {
+            const auto& chunk = buffer[z * width + x];
+            if (chunk == nullptr) {
+                missing.emplace_back(x + offsetX, z + offsetZ);
+            } else if (!chunk->flags.lighted) {
+                lightCandidates.emplace_back(x + offsetX, z + offsetZ);
+            }
+        }
+    }
+}
+
+void ChunksLoadQueue::shift(const AreaMap& area, int32_t dx, int32_t dz) {
+    offsetX += dx;
+    offsetZ += dz;
+
+    // Чанки, покинувшие зону или уже загруженные, удаляются из очереди
+    for (size_t i = 0; i < missing.size();) {
+        const auto& pos = missing[i];
+        if (isInLoadingZone(pos.x, pos.y) &&
+            *area.getIf(pos.x, pos.y) == nullptr) {
+            ++i;
+            continue;
+        }
+        missing[i] = missing.back();
+        missing.pop_back();
+    }
+
+    // Добавляются позиции, вошедшие в зону: в каждой строке окна это
+    // не более двух отрезков вне прежней зоны
+    const auto& buffer = area.getBuffer();
+    for (int32_t z = 0; z < depth; ++z) {
+        auto row = zoneRow(z);
+        if (row.from > row.to) {
+            continue;
+        }
+        ZoneRow prev {0, -1};
+        int32_t prevZ = z + dz;
+        if (prevZ >= 0 && prevZ < depth) {
+            prev = zoneRow(prevZ);
+            // В координатах нового окна
+            prev.from -= dx;
+            prev.to -= dx;
+        }
+        for (int32_t x = row.from; x <= row.to; ++x) {
+            if (x >= prev.from && x <= prev.to) {
+                x = prev.to;
+                continue;
+            }
+            const auto& chunk = buffer[z * width + x];
+            if (chunk == nullptr) {
+                missing.emplace_back(x + offsetX, z + offsetZ);
+            } else if (!chunk->flags.lighted) {
+                lightCandidates.emplace_back(x + offsetX, z + offsetZ);
+            }
+        }
+    }
+}
+
+bool ChunksLoadQueue::update(const AreaMap& area, int padding) {
+    if (area.getWidth() != width || area.getDepth() != depth ||
+        padding != this->padding ||
+        area.getRemovedCount() != removedCount) {
+        this->padding = padding;
+        rescan(area);
+        return true;
+    }
+    int32_t dx = area.getOffsetX() - offsetX;
+    int32_t dz = area.getOffsetZ() - offsetZ;
+    if (dx == 0 && dz == 0) {
+        return false;
+    }
+    if (std::abs(dx) >= width || std::abs(dz) >= depth) {
+        rescan(area);
+    } else {
+        shift(area, dx, dz);
+    }
+    return true;
+}
+
+void ChunksLoadQueue::acceptRemovals(const AreaMap& area) {
+    removedCount = area.getRemovedCount();
+}
+
+void ChunksLoadQueue::select(
+    const AreaMap& area,
+    const ChunksLoadFocus& focus,
+    size_t count,
+    std::vector<glm::ivec2>& dst
+) {
+    dst.clear();
+    ranked.clear();
+    for (size_t i = 0; i < missing.size();) {
+        const auto& pos = missing[i];
+        if (*area.getIf(pos.x, pos.y) != nullptr) {
+            missing[i] = missing.back();
+            missing.pop_back();
+            continue;
+        }
+        ranked.emplace_back(focus.priority(pos.x, pos.y), i);
+        ++i;
+    }
+    count = std::min(count, ranked.size());
+    if (count == 0) {
+        return;
+    }
+    auto middle = ranked.begin() + count;
+    std::nth_element(ranked.begin(), middle - 1, ranked.end());
+    std::sort(ranked.begin(), middle);
+    for (auto it = ranked.begin(); it != middle; ++it) {
+        dst.push_back(missing[it->second]);
+    }
+}
+
+void ChunksLoadQueue::onLoaded(int x, int z) {
+    for (int dz = -1; dz <= 1; ++dz) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            lightCandidates.emplace_back(x + dx, z + dz);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include <util/AreaMap2D.h>
+
+class Chunk;
+
+/// @brief Положение и движение игрока для приоритетов загрузки, в чанках
+struct ChunksLoadFocus {
+    glm::vec2 position {};
+    /// Единичное направление взгляда в плоскости XZ или ноль
+    glm::vec2 view {};
+    /// Скорость в чанках в секунду
+    glm::vec2 velocity {};
+
+    /// @return приоритет чанка: чем меньше, тем раньше загрузка.
+    /// Расстояние до чанка уменьшается для чанков впереди по взгляду
+    /// и по направлению движения
+    float priority(int x, int z) const;
+};
+
+/// @brief Отсутствующие чанки зоны загрузки окна игрока (ChunksController).
+///
+/// Очередь поддерживается по мере сдвига окна: при сдвиге просматриваются
+/// только позиции, вошедшие в зону загрузки. Окно просматривается целиком
+/// лишь при изменении его размера или удалении чанков в обход очереди.
+/// Каждый вызов select обходит только отсутствующие чанки, а не всё окно
+class ChunksLoadQueue {
+public:
+    using AreaMap = util::AreaMap2D<std::shared_ptr<Chunk>, int32_t>;
+private:
+    /// Отсутствующие чанки зоны загрузки (мировые координаты чанков)
+    std::vector<glm::ivec2> missing;
+    /// Загруженные чанки, которым, возможно, пора строить освещение
+    std::vector<glm::ivec2> lightCandidates;
+
+    int32_t offsetX = 0;
+    int32_t offsetZ = 0;
+    int32_t width = 0;
+    int32_t depth = 0;
+    int padding = -1;
+    size_t removedCount = 0;
+    /// Буфер select: приоритет и индекс в missing
+    std::vector<std::pair<float, size_t>> ranked;
+
+    struct ZoneRow {
+        int32_t from;
+        int32_t to;
+    };
+
+    /// @brief Позиции зоны загрузки в строке z окна (включительно)
+    ZoneRow zoneRow(int32_t z) const;
+    bool isInZone(int32_t x, int32_t z) const;
+
+    void rescan(const AreaMap& area);
+    void shift(const AreaMap& area, int32_t dx, int32_t dz);
+public:
+    /// @brief Синхронизирует очередь с окном
+    /// @param padding ширина кольца окна, в котором чанки не загружаются
+    /// @return true, если окно сдвинулось или было просмотрено заново
+    bool update(const AreaMap& area, int padding);
+
+    /// @brief Учитывает удаления чанков из окна, сделанные владельцем
+    /// очереди вне зоны загрузки, чтобы они не вызвали полный просмотр
+    void acceptRemovals(const AreaMap& area);
+
+    /// @brief Выбирает до count отсутствующих чанков в порядке приоритета
+    void select(
+        const AreaMap& area,
+        const ChunksLoadFocus& focus,
+        size_t count,
+        std::vector<glm::ivec2>& dst
+    );
+
+    /// @brief Отмечает загруженный чанк: ему и соседям может быть пора
+    /// строить освещение
+    void onLoaded(int x, int z);
+
+    /// @brief Чанки для проверки освещения; проверенные позиции удаляет
+    /// вызывающий, позиции могут повторяться
+    std::vector<glm::ivec2>& getLightCandidates() {
+        return lightCandidates;
+    }
+
+    size_t size() const {
+        return missing.size();
+    }
+
+    /// @return true, если чанк входит в зону загрузки текущего окна
+    bool isInLoadingZone(int x, int z) const {
+        return isInZone(x - offsetX, z - offsetZ);
+    }
+};
@@ -1,6 +1,7 @@
 #include <logic/LevelController.h>
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <world/Level.h>
 #include <physics/Hitbox.h>
@@ -20,6 +21,7 @@
 #include <voxels/Pathfinding.h>
 #include <engine/EnginePaths.h>
 #include <content/Content.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("level-controller");
 
@@ -30,7 +32,9 @@ LevelController::LevelController(
 ) : engine(engine),
     settings(engine.getSettings()),
     level(std::move(levelPtr)),
-    chunks(std::make_unique<ChunksController>(*level)),
+    chunks(std::make_unique<ChunksController>(
+        *level, settings.chunks.generatorWorkers.get()
+    )),
     playerSparkClock(20, 3),
     clientPlayer(clientPlayer)
 {
@@ -76,6 +80,7 @@ LevelController::LevelController(
 }
 
 void LevelController::update(float delta, bool pause) {
+    PROFILE_ZONE("level.update");
     level->pathfinding->performAllAsync(
         settings.pathfinding.stepsPerAsyncAgent.get()
     );
@@ -97,8 +102,14 @@ void LevelController::update(float delta, bool pause) {
         );
         player->updateEntity();
     }
+    chunks->removeAbsentPlayers(*level->players);
+    updateInterest();
+    if (pregenerator &&
+        pregenerator->update(settings.chunks.pregenSpeed.get() * 1000)) {
+        pregenerator.reset();
+    }
     if (!pause) {
-        blocks->update(delta, settings.chunks.padding.get());
+        blocks->update(delta, interest);
         level->entities->update(delta);
 
         for (const auto& [_, player] : *level->players) {
@@ -122,8 +133,23 @@ void LevelController::update(float delta, bool pause) {
     level->entities->clean();
 }
 
+void LevelController::updateInterest() {
+    PROFILE_ZONE("chunks.interest");
+    int padding = settings.chunks.padding.get();
+    interest.beginUpdate();
+    for (const auto& [id, player] : *level->players) {
+        if (player->chunks == nullptr) continue;
+        const auto& chunks = *player->chunks;
+        glm::ivec2 offset(chunks.getOffsetX(), chunks.getOffsetZ());
+        glm::ivec2 size(chunks.getWidth(), chunks.getDepth());
+        interest.setArea(id, offset + padding, offset + size - padding - 1);
+    }
+    interest.endUpdate();
+}
+
 void LevelController::processBeforeQuit() {
     preQuitCallbacks.notify();
+    pregenerator.reset();
     for (auto player : level->players->getAll()) {
         if (player->chunks) {
             player->chunks->saveAndClear();
@@ -133,6 +159,7 @@ void LevelController::processBeforeQuit() {
 }
 
 void LevelController::saveWorld() {
+    PROFILE_ZONE("world.save");
     auto& world = level->getWorld();
     if (world.isNameless()) {
         logger.warning() << "Nameless world will not be saved";
@@ -162,3 +189,22 @@ BlocksController* LevelController::getBlocksController() {
 ChunksController* LevelController::getChunksController() {
     return chunks.get();
 }
+
+void LevelController::pregenerate(const PregenArea& area) {
+    if (level->getWorld().isNameless()) {
+        throw std::runtime_error("nameless world can not be pre-generated");
+    }
+    pregenerator.reset();
+    pregenerator = std::make_unique<WorldPregenerator>(*level, area);
+}
+
+void LevelController::stopPregeneration() {
+    if (pregenerator) {
+        logger.info() << "pre-generation stopped";
+        pregenerator.reset();
+    }
+}
+
+WorldPregenerator* LevelController::getPregenerator() {
+    return pregenerator.get();
+}
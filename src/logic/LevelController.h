@@ -4,6 +4,8 @@
 
 #include <logic/BlocksController.h>
 #include <logic/ChunksController.h>
+#include <logic/ChunksInterest.h>
+#include <logic/WorldPregenerator.h>
 #include <util/Clock.h>
 #include <util/CallbacksSet.h>
 
@@ -19,10 +21,16 @@ class LevelController {
 
     std::unique_ptr<BlocksController> blocks;
     std::unique_ptr<ChunksController> chunks;
+    std::unique_ptr<WorldPregenerator> pregenerator;
+    /// Чанки, нужные всем игрокам вместе
+    ChunksInterest interest;
 
     util::Clock playerSparkClock;
 
     Player* clientPlayer;
+
+    /// @brief Обновляет общее множество нужных чанков по окнам игроков
+    void updateInterest();
 public:
     CallbacksSet<> preQuitCallbacks;
 
@@ -42,4 +50,15 @@ public:
 
     ChunksController* getChunksController();
     BlocksController* getBlocksController();
+
+    const ChunksInterest& getChunksInterest() const {
+        return interest;
+    }
+
+    /// @brief Запускает предварительную генерацию области вместо текущей.
+    /// Генерация продолжается в update, пока не будет завершена
+    void pregenerate(const PregenArea& area);
+    void stopPregeneration();
+    /// @return nullptr, если предварительная генерация не идёт
+    WorldPregenerator* getPregenerator();
 };
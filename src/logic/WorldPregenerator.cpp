@@ -0,0 +1,319 @@
+#include <logic/WorldPregenerator.h>
+
+#include <algorithm>
+
+#include <constants.h>
+#include <content/Content.h>
+#include <debug/Logger.h>
+#include <debug/Profiler.h>
+#include <lighting/Lighting.h>
+#include <math/voxmaths.h>
+#include <util/timeutil.h>
+#include <voxels/Chunk.h>
+#include <voxels/Chunks.h>
+#include <voxels/GlobalChunks.h>
+#include <world/Level.h>
+#include <world/LevelEvents.h>
+#include <world/World.h>
+#include <world/files/WorldFiles.h>
+#include <world/generator/WorldGenerator.h>
+
+static debug::Logger logger("pregenerator");
+
+PregenArea PregenArea::rect(int x1, int z1, int x2, int z2) {
+    PregenArea area;
+    area.min = {std::min(x1, x2), std::min(z1, z2)};
+    area.max = {std::max(x1, x2), std::max(z1, z2)};
+    return area;
+}
+
+PregenArea PregenArea::circle(int centerX, int centerZ, int radius) {
+    radius = std::max(radius, 0);
+    PregenArea area;
+    area.min = {centerX - radius, centerZ - radius};
+    area.max = {centerX + radius, centerZ + radius};
+    area.radius = radius;
+    area.center = {centerX, centerZ};
+    return area;
+}
+
+bool PregenArea::contains(int x, int z) const {
+    if (x < min.x || z < min.y || x > max.x || z > max.y) {
+        return false;
+    }
+    if (radius == 0) {
+        return true;
+    }
+    int dx = x - center.x;
+    int dz = z - center.y;
+    return dx * dx + dz * dz <= radius * radius;
+}
+
+size_t PregenArea::count() const {
+    if (radius == 0) {
+        return static_cast<size_t>(max.x - min.x + 1) * (max.y - min.y + 1);
+    }
+    size_t count = 0;
+    for (int z = min.y; z <= max.y; ++z) {
+        for (int x = min.x; x <= max.x; ++x) {
+            count += contains(x, z);
+        }
+    }
+    return count;
+}
+
+PregenWork PregenWork::of(const Chunk& chunk) {
+    const auto& flags = chunk.flags;
+    return PregenWork {
+        !flags.loaded,
+        chunk.lightmap != nullptr && !flags.lighted && !flags.loadedLights
+    };
+}
+
+/// @brief Есть ли в прямоугольнике чанки области
+static bool intersects(
+    const PregenArea& area, const glm::ivec2& min, const glm::ivec2& max
+) {
+    auto from = glm::max(min, area.min);
+    auto to = glm::min(max, area.max);
+    if (from.x > to.x || from.y > to.y) {
+        return false;
+    }
+    if (area.radius == 0) {
+        return true;
+    }
+    // Ближайшая к центру круга точка прямоугольника
+    auto nearest = glm::clamp(area.center, from, to);
+    return area.contains(nearest.x, nearest.y);
+}
+
+WorldPregenerator::WorldPregenerator(
+    Level& level, const PregenArea& area, int workers
+) : level(level),
+    area(area),
+    generator(std::make_unique<WorldGenerator>(
+        level.content.generators.require(level.environment.generator),
+        level.content,
+        level.getWorld().getSeed(),
+        workers
+    )),
+    total(area.count()),
+    startTime(std::chrono::steady_clock::now())
+{
+    constexpr int size = RegionConsts::SIZE;
+    int minX = floordiv(area.min.x, size);
+    int minZ = floordiv(area.min.y, size);
+    int maxX = floordiv(area.max.x, size);
+    int maxZ = floordiv(area.max.y, size);
+    for (int z = minZ; z <= maxZ; ++z) {
+        for (int x = minX; x <= maxX; ++x) {
+            glm::ivec2 region(x, z);
+            if (intersects(area, region * size, region * size + size - 1)) {
+                regions.push_back(region);
+            }
+        }
+    }
+    // Регионы ближе к центру области (обычно к точке появления) - первыми
+    glm::ivec2 center = (area.min + area.max) / 2;
+    auto distance = [center](const glm::ivec2& region) {
+        auto delta = region * size + size / 2 - center;
+        return delta.x * delta.x + delta.y * delta.y;
+    };
+    std::stable_sort(
+        regions.begin(), regions.end(), [&](const auto& a, const auto& b) {
+            return distance(a) < distance(b);
+        }
+    );
+    logger.info() << "pre-generation of " << total << " chunks in "
+                  << regions.size() << " regions started";
+}
+
+WorldPregenerator::~WorldPregenerator() {
+    if (chunks) {
+        // Прерванный регион сохраняется, чтобы не терять сделанное
+        lighting.reset();
+        chunks->saveAndClear();
+    }
+}
+
+void WorldPregenerator::beginRegion(const glm::ivec2& region) {
+    PROFILE_ZONE("pregen.begin-region");
+    constexpr int size = RegionConsts::SIZE;
+    auto min = glm::max(region * size, area.min);
+    auto max = glm::min(region * size + size - 1, area.max);
+
+    lightQueue.clear();
+    for (int z = min.y; z <= max.y; ++z) {
+        for (int x = min.x; x <= max.x; ++x) {
+            if (area.contains(x, z)) {
+                lightQueue.emplace_back(x, z);
+            }
+        }
+    }
+    // Освещению чанка нужны все восемь соседей
+    auto windowMin = min - 1;
+    auto windowMax = max + 1;
+    loadQueue.clear();
+    for (int z = windowMin.y; z <= windowMax.y; ++z) {
+        for (int x = windowMin.x; x <= windowMax.x; ++x) {
+            bool needed = false;
+            for (int dz = -1; dz <= 1 && !needed; ++dz) {
+                for (int dx = -1; dx <= 1 && !needed; ++dx) {
+                    int nx = x + dx;
+                    int nz = z + dz;
+                    needed = nx >= min.x && nz >= min.y && nx <= max.x &&
+                             nz <= max.y && area.contains(nx, nz);
+                }
+            }
+            if (needed) {
+                loadQueue.emplace_back(x, z);
+            }
+        }
+    }
+    queueIndex = 0;
+    prepared = false;
+
+    int width = windowMax.x - windowMin.x + 1;
+    int depth = windowMax.y - windowMin.y + 1;
+    const auto& indices = *level.content.getIndices();
+    chunks = std::make_unique<Chunks>(
+        width, depth, 0, 0, level.events.get(), indices
+    );
+    chunks->setCenter(
+        (windowMin.x + width / 2) * CHUNK_WIDTH,
+        (windowMin.y + depth / 2) * CHUNK_DEPTH
+    );
+    lighting = std::make_unique<Lighting>(indices, *chunks);
+    generator->update(
+        windowMin.x + width / 2,
+        windowMin.y + depth / 2,
+        std::max(width, depth) / 2 + 1
+    );
+    windowFrom = windowMin;
+    windowTo = windowMax;
+}
+
+void WorldPregenerator::endRegion(const glm::ivec2& region) {
+    PROFILE_ZONE("pregen.end-region");
+    lighting.reset();
+    // Чанки, на которые больше никто не ссылается, сохраняются и выгружаются
+    chunks->saveAndClear();
+    chunks.reset();
+    level.getWorld().wfile->getRegions().flushRegion(region.x, region.y);
+
+    auto progress = getProgress();
+    logger.info() << "region " << region.x << ", " << region.y << ": "
+                  << progress.done << "/" << progress.total << " chunks ("
+                  << progress.done * 100 / std::max<size_t>(progress.total, 1)
+                  << "%), " << static_cast<int>(progress.speed)
+                  << " chunks/s";
+}
+
+void WorldPregenerator::loadChunk(int x, int z) {
+    PROFILE_ZONE("pregen.load");
+    auto chunk = level.chunks->create(x, z, true);
+    chunks->putChunk(chunk);
+    auto& flags = chunk->flags;
+    if (flags.ready) {
+        return;
+    }
+    if (PregenWork::of(*chunk).generate) {
+        if (!prepared) {
+            // Прототипы окна готовятся крупными пакетами только тогда,
+            // когда в регионе есть что генерировать
+            generator->prepare(windowFrom.x, windowFrom.y, windowTo.x, windowTo.y);
+            prepared = true;
+        }
+        generator->generate(chunk->voxels, x, z);
+        flags.unsaved = true;
+        if (area.contains(x, z)) {
+            generated++;
+        }
+    }
+    chunk->updateHeights();
+
+    level.events->trigger(LevelEventType::CHUNK_PRESENT, chunk.get());
+    if (!flags.loadedLights && chunk->lightmap) {
+        Lighting::preBuildSkyLight(*chunk, *level.content.getIndices());
+    }
+    flags.loaded = true;
+    flags.ready = true;
+}
+
+void WorldPregenerator::lightChunk(int x, int z) {
+    PROFILE_ZONE("pregen.lighting");
+    done++;
+    auto chunk = chunks->getChunk(x, z);
+    // Освещение уже построено загрузчиком игрока или сохранено ранее
+    if (!PregenWork::of(*chunk).light) {
+        skipped++;
+        return;
+    }
+    lighting->buildSkyLight(x, z);
+    lighting->onChunkLoaded(x, z, true);
+    chunk->flags.lighted = true;
+}
+
+bool WorldPregenerator::step() {
+    if (isFinished()) {
+        return false;
+    }
+    const auto& region = regions[regionIndex];
+    if (chunks == nullptr) {
+        beginRegion(region);
+        return true;
+    }
+    if (queueIndex < loadQueue.size()) {
+        const auto& pos = loadQueue[queueIndex++];
+        loadChunk(pos.x, pos.y);
+        return true;
+    }
+    size_t lightIndex = queueIndex - loadQueue.size();
+    if (lightIndex < lightQueue.size()) {
+        queueIndex++;
+        const auto& pos = lightQueue[lightIndex];
+        lightChunk(pos.x, pos.y);
+        return true;
+    }
+    endRegion(region);
+    regionIndex++;
+    if (isFinished()) {
+        // Рамка вокруг области записана в регионы за её пределами
+        level.getWorld().wfile->getRegions().writeAll();
+        auto progress = getProgress();
+        logger.info() << "pre-generation finished: " << progress.generated
+                      << " chunks generated, " << progress.skipped
+                      << " already saved, " << static_cast<int>(progress.speed)
+                      << " chunks/s";
+        return false;
+    }
+    return true;
+}
+
+bool WorldPregenerator::update(int64_t maxDuration) {
+    PROFILE_ZONE("pregen.update");
+    timeutil::Timer timer;
+    while (step()) {
+        if (timer.stop() >= maxDuration) {
+            break;
+        }
+    }
+    return isFinished();
+}
+
+bool WorldPregenerator::isFinished() const {
+    return regionIndex >= regions.size();
+}
+
+PregenProgress WorldPregenerator::getProgress() const {
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime
+    ).count();
+    return PregenProgress {
+        total,
+        done,
+        generated,
+        skipped,
+        seconds > 0.0 ? done / seconds : 0.0
+    };
+}
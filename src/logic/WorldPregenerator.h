@@ -0,0 +1,117 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Level;
+class Chunk;
+class Chunks;
+class Lighting;
+class WorldGenerator;
+
+/// @brief Область предварительной генерации в координатах чанков
+struct PregenArea {
+    /// Границы прямоугольника включительно
+    glm::ivec2 min {};
+    glm::ivec2 max {};
+    /// Радиус круга с центром center; 0 - весь прямоугольник
+    int radius = 0;
+    glm::ivec2 center {};
+
+    static PregenArea rect(int x1, int z1, int x2, int z2);
+    static PregenArea circle(int centerX, int centerZ, int radius);
+
+    bool contains(int x, int z) const;
+
+    /// @brief Число чанков области
+    size_t count() const;
+};
+
+struct PregenProgress {
+    /// Чанков в области
+    size_t total;
+    /// Обработано чанков области
+    size_t done;
+    /// Из них сгенерировано заново
+    size_t generated;
+    /// Из них уже были сохранены вместе с освещением
+    size_t skipped;
+    /// Обработано чанков в секунду с начала генерации
+    double speed;
+};
+
+/// @brief Работа, которая осталась чанку после загрузки из регионов
+struct PregenWork {
+    /// Чанк не сохранён и должен быть сгенерирован
+    bool generate;
+    /// Освещение чанка не сохранено и не построено
+    bool light;
+
+    /// @brief Чанк сохранён вместе с освещением - продолженная
+    /// генерация его пропускает
+    bool done() const {
+        return !generate && !light;
+    }
+
+    static PregenWork of(const Chunk& chunk);
+};
+
+/// @brief Предварительная генерация области мира. Область обходится
+/// по регионам WorldRegions от центра: чанки региона с рамкой в один чанк
+/// генерируются (этапы прототипов - на всех ядрах), освещаются, сохраняются,
+/// после чего регион записывается на диск и выгружается из памяти.
+///
+/// Уже сохранённые с освещением чанки пропускаются, поэтому прерванная
+/// генерация продолжается с места остановки. Работа дробится по чанкам
+/// и ограничивается бюджетом времени на тик, как в ChunksController
+class WorldPregenerator {
+    Level& level;
+    PregenArea area;
+    std::unique_ptr<WorldGenerator> generator;
+
+    /// Регионы области в порядке обработки
+    std::vector<glm::ivec2> regions;
+    size_t regionIndex = 0;
+
+    /// Матрица чанков текущего региона с рамкой
+    std::unique_ptr<Chunks> chunks;
+    std::unique_ptr<Lighting> lighting;
+    /// Чанки региона и рамки, которые нужно загрузить или сгенерировать
+    std::vector<glm::ivec2> loadQueue;
+    /// Чанки региона внутри области, которые нужно осветить
+    std::vector<glm::ivec2> lightQueue;
+    size_t queueIndex = 0;
+    /// Окно региона с рамкой включительно
+    glm::ivec2 windowFrom {};
+    glm::ivec2 windowTo {};
+    /// Прототипы окна подготовлены
+    bool prepared = false;
+
+    size_t total;
+    size_t done = 0;
+    size_t generated = 0;
+    size_t skipped = 0;
+    std::chrono::steady_clock::time_point startTime;
+
+    void beginRegion(const glm::ivec2& region);
+    void endRegion(const glm::ivec2& region);
+    void loadChunk(int x, int z);
+    void lightChunk(int x, int z);
+    /// @return false, если обработана вся область
+    bool step();
+public:
+    /// @param workers рабочие потоки генератора (0 и меньше - по числу ядер)
+    WorldPregenerator(Level& level, const PregenArea& area, int workers = 0);
+    ~WorldPregenerator();
+
+    /// @brief Продолжает генерацию не дольше maxDuration микросекунд
+    /// (обработка одного чанка не прерывается)
+    /// @return true, если вся область сгенерирована
+    bool update(int64_t maxDuration);
+
+    bool isFinished() const;
+
+    PregenProgress getProgress() const;
+};
@@ -46,6 +46,7 @@ extern const luaL_Reg randomlib[];
 extern const luaL_Reg compressionlib[];
 extern const luaL_Reg testlib[];
 extern const luaL_Reg xmllib[];
+extern const luaL_Reg profilerlib[];
 
 extern const luaL_Reg skeletonlib [];
 extern const luaL_Reg rigidbodylib [];
@@ -228,7 +228,7 @@ static int l_set_states(lua::State* L) {
     int lx = x - cx * CHUNK_WIDTH;
     int lz = z - cz * CHUNK_DEPTH;
     chunk->voxels[vox_index(lx, y, lz)].state = int2blockstate(states);
-    chunk->setModifiedAndUnsaved();
+    chunk->setModifiedAndUnsaved(y);
     return 0;
 }
 
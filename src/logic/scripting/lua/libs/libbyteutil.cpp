@@ -1,9 +1,11 @@
 #include <logic/scripting/lua/libs/api_lua.h>
 
 #include <string>
+#include <cstring>
 
 #include <coders/byte_utils.h>
 #include <util/data_io.h>
+#include <logic/scripting/lua/usertypes/lua_type_bytes.h>
 
 static size_t calc_size(const char* format) {
     size_t outSize = 0;
@@ -35,12 +37,11 @@ static size_t calc_size(const char* format) {
     return outSize;
 }
 
-static int pack(lua::State* L, const char* format, bool usetable) {
-    size_t outSize = calc_size(format);
+/// Упаковывает значения, начиная с аргумента index
+static void pack_values(
+    lua::State* L, const char* format, int index, ByteBuilder& builder
+) {
     bool bigEndian = false;
-
-    ByteBuilder builder(outSize);
-    int index = 2;
     for (int i = 0; format[i]; ++i) {
         switch (format[i]) {
             case 'b':
@@ -90,6 +91,12 @@ static int pack(lua::State* L, const char* format, bool usetable) {
         }
         index++;
     }
+}
+
+static int pack(lua::State* L, const char* format, bool usetable) {
+    size_t outSize = calc_size(format);
+    ByteBuilder builder(outSize);
+    pack_values(L, format, 2, builder);
     if (usetable) {
         lua::createtable(L, outSize, 0);
         const ubyte* data = builder.data();
@@ -197,6 +204,24 @@ static int l_tpack(lua::State* L) {
     return pack(L, format, true);
 }
 
+static int l_pack_into(lua::State* L) {
+    auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    auto pos = lua::tointeger(L, 2);
+    const char* format = lua::require_string(L, 3);
+    size_t size = calc_size(format);
+    if (pos < 1 || pos - 1 + size > bytes.size()) {
+        throw std::out_of_range(
+            "could not pack " + std::to_string(size) + " byte(s) at " +
+            std::to_string(pos) + " into Bytes[" +
+            std::to_string(bytes.size()) + "]"
+        );
+    }
+    ByteBuilder builder(size);
+    pack_values(L, format, 4, builder);
+    std::memcpy(bytes.data() + pos - 1, builder.data(), size);
+    return lua::pushinteger(L, pos + size);
+}
+
 static int l_get_size(lua::State* L) {
     return lua::pushinteger(
         L, static_cast<int>(calc_size(lua::require_string(L, 1)))
@@ -206,6 +231,7 @@ static int l_get_size(lua::State* L) {
 const luaL_Reg byteutillib[] = {
     {"pack", lua::wrap<l_pack>},
     {"tpack", lua::wrap<l_tpack>},
+    {"pack_into", lua::wrap<l_pack_into>},
     {"unpack", lua::wrap<l_unpack>},
     {"get_size", lua::wrap<l_get_size>},
     {nullptr, nullptr}
@@ -2,11 +2,13 @@
 
 #include <variant>
 #include <utility>
+#include <cstring>
 
 #include <engine/Engine.h>
 #include <network/Network.h>
 #include <coders/json.h>
 #include <devtools/Project.h>
+#include <logic/scripting/lua/usertypes/lua_type_bytes.h>
 
 enum NetworkEventType {
     CLIENT_CONNECTED = 1,
@@ -40,7 +42,9 @@ struct NetworkDatagramEventDto {
     uint64_t client;
     std::string addr;
     int port;
-    std::vector<char> buffer;
+    /// Разделяется с Bytes, передаваемым в скрипт
+    std::shared_ptr<ubyte[]> buffer;
+    size_t size;
 };
 
 struct NetworkEvent {
@@ -182,6 +186,7 @@ static int l_send(lua::State* L, network::Network& network) {
         connection->getState() == network::ConnectionState::Closed) {
         return 0;
     }
+    int sent;
     if (lua::istable(L, 2)) {
         lua::pushvalue(L, 2);
         size_t size = lua::objlen(L, 2);
@@ -192,16 +197,16 @@ static int l_send(lua::State* L, network::Network& network) {
             lua::pop(L);
         }
         lua::pop(L);
-        connection->send(buffer.data(), size);
+        sent = connection->send(buffer.data(), size);
     } else if (lua::isstring(L, 2)) {
         auto string = lua::tolstring(L, 2);
-        connection->send(string.data(), string.length());
+        sent = connection->send(string.data(), string.length());
     } else {
         auto string = lua::bytearray_as_string(L, 2);
-        connection->send(string.data(), string.length());
+        sent = connection->send(string.data(), string.length());
         lua::pop(L);
     }
-    return 0;
+    return lua::pushinteger(L, sent);
 }
 
 static int l_udp_server_send_to(lua::State* L, network::Network& network) {
@@ -252,7 +257,8 @@ static int l_recv(lua::State* L, network::Network& network) {
 
     auto tcpConnection = dynamic_cast<network::TcpConnection*>(connection);
 
-    length = glm::min(length, tcpConnection->available());
+    // Отрицательная длина читает ноль байт
+    length = glm::clamp(length, 0, tcpConnection->available());
     util::Buffer<char> buffer(length);
 
     int size = tcpConnection->recv(buffer.data(), length);
@@ -271,6 +277,37 @@ static int l_recv(lua::State* L, network::Network& network) {
     }
 }
 
+static int l_recv_bytes(lua::State* L, network::Network& network) {
+    uint64_t id = lua::tointeger(L, 1);
+    int length = lua::tointeger(L, 2);
+
+    auto connection = network.getConnection(id, false);
+
+    if (connection == nullptr || connection->getTransportType() != network::TransportType::TCP) {
+        return 0;
+    }
+
+    auto tcpConnection = dynamic_cast<network::TcpConnection*>(connection);
+
+    // Отрицательная длина читает ноль байт
+    length = glm::clamp(length, 0, tcpConnection->available());
+    std::shared_ptr<ubyte[]> memory(new ubyte[length]);
+
+    int size = tcpConnection->recv(reinterpret_cast<char*>(memory.get()), length);
+    if (size == -1) {
+        return 0;
+    }
+    return lua::newuserdata<lua::LuaBytes>(L, std::move(memory), 0, size);
+}
+
+static std::shared_ptr<ubyte[]> copy_datagram(
+    const char* buffer, size_t length
+) {
+    std::shared_ptr<ubyte[]> memory(new ubyte[length]);
+    std::memcpy(memory.get(), buffer, length);
+    return memory;
+}
+
 static int l_available(lua::State* L, network::Network& network) {
     uint64_t id = lua::tointeger(L, 1);
 
@@ -326,7 +363,7 @@ static int l_connect_udp(lua::State* L, network::Network& network) {
             DATAGRAM,
             NetworkDatagramEventDto {
                 ON_CLIENT, 0, cid,
-                address, port, std::vector<char>(buffer, buffer + length)
+                address, port, copy_datagram(buffer, length), length
             }
         ));
     });
@@ -346,7 +383,7 @@ static int l_open_udp(lua::State* L, network::Network& network) {
                 DATAGRAM,
                 NetworkDatagramEventDto {
                     ON_SERVER, sid, 0,
-                    addr, port, std::vector<char>(buffer, buffer + length)
+                    addr, port, copy_datagram(buffer, length), length
                 }
             )
         );
@@ -492,7 +529,7 @@ static int l_pull_events(lua::State* L) {
                 lua::pushinteger(L, dto.side);
                 lua::rawseti(L, 6);
 
-                lua::create_bytearray(L, dto.buffer.data(), dto.buffer.size());
+                lua::newuserdata<lua::LuaBytes>(L, dto.buffer, 0, dto.size);
                 lua::rawseti(L, 7);
                 break;
             }
@@ -565,6 +602,7 @@ const luaL_Reg networklib[] = {
     {"__close", network_wrap<l_close>},
     {"__send", network_wrap<l_send>},
     {"__recv", network_wrap<l_recv>},
+    {"__recv_bytes", network_wrap<l_recv_bytes>},
     {"__available", network_wrap<l_available>},
     {"__is_alive", network_wrap<l_is_alive>},
     {"__is_connected", network_wrap<l_is_connected>},
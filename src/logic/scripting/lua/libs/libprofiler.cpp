@@ -0,0 +1,81 @@
+#include <logic/scripting/lua/libs/api_lua.h>
+
+#include <debug/Profiler.h>
+#include <io/io.h>
+
+using debug::Profiler;
+
+static int l_begin_zone(lua::State* L) {
+    if (Profiler::isEnabled()) {
+        Profiler::beginZone(Profiler::intern(lua::require_string(L, 1)), true);
+    }
+    return 0;
+}
+
+static int l_end_zone(lua::State* L) {
+    Profiler::endScriptZone();
+    return 0;
+}
+
+static int l_set_enabled(lua::State* L) {
+    Profiler::setEnabled(lua::toboolean(L, 1));
+    return 0;
+}
+
+static int l_is_enabled(lua::State* L) {
+    return lua::pushboolean(L, Profiler::isEnabled());
+}
+
+static int l_start_capture(lua::State* L) {
+    Profiler::startCapture();
+    return 0;
+}
+
+static int l_is_capturing(lua::State* L) {
+    return lua::pushboolean(L, Profiler::isCapturing());
+}
+
+static int l_stop_capture(lua::State* L) {
+    if (!Profiler::isCapturing()) {
+        throw std::runtime_error("profiler capture is not started");
+    }
+    io::path file = lua::require_string(L, 1);
+    return lua::pushinteger(L, Profiler::stopCapture(file));
+}
+
+/// Сводка последнего кадра: {name, depth, calls, time (мс)}
+static int l_get_frame(lua::State* L) {
+    auto nodes = Profiler::getLastFrame();
+    lua::createtable(L, nodes.size(), 0);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const auto& node = nodes[i];
+        lua::createtable(L, 0, 4);
+        lua::pushstring(L, node.name);
+        lua::setfield(L, "name");
+        lua::pushinteger(L, node.depth);
+        lua::setfield(L, "depth");
+        lua::pushinteger(L, node.calls);
+        lua::setfield(L, "calls");
+        lua::pushnumber(L, node.time / 1e6);
+        lua::setfield(L, "time");
+        lua::rawseti(L, i + 1);
+    }
+    return 1;
+}
+
+static int l_get_frame_time(lua::State* L) {
+    return lua::pushnumber(L, Profiler::getLastFrameTime() / 1e6);
+}
+
+const luaL_Reg profilerlib[] = {
+    {"begin_zone", lua::wrap<l_begin_zone>},
+    {"end_zone", lua::wrap<l_end_zone>},
+    {"set_enabled", lua::wrap<l_set_enabled>},
+    {"is_enabled", lua::wrap<l_is_enabled>},
+    {"start_capture", lua::wrap<l_start_capture>},
+    {"is_capturing", lua::wrap<l_is_capturing>},
+    {"stop_capture", lua::wrap<l_stop_capture>},
+    {"get_frame", lua::wrap<l_get_frame>},
+    {"get_frame_time", lua::wrap<l_get_frame_time>},
+    {nullptr, nullptr}
+};
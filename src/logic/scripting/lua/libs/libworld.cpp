@@ -35,6 +35,13 @@ static WorldInfo& require_world_info() {
     return require_level().getWorld().getInfo();
 }
 
+static LevelController& require_controller() {
+    if (scripting::controller == nullptr) {
+        throw std::runtime_error("World is not open");
+    }
+    return *scripting::controller;
+}
+
 static int l_get_list(lua::State* L) {
     const auto& paths = scripting::engine->getPaths();
     auto worlds = paths.scanForWorlds();
@@ -167,7 +174,7 @@ static void integrate_chunk_client(Chunk& chunk) {
                 continue;
             }
             if (auto other = scripting::level->chunks->getChunk(x + lx, z + lz)) {
-                other->flags.modified = true;
+                other->setModified();
             }
         }
     }
@@ -224,6 +231,48 @@ static int l_count_chunks(lua::State* L) {
     return lua::pushinteger(L, scripting::level->chunks->size());
 }
 
+static int l_pregenerate(lua::State* L) {
+    int x1 = static_cast<int>(lua::tointeger(L, 1));
+    int z1 = static_cast<int>(lua::tointeger(L, 2));
+    int x2 = static_cast<int>(lua::tointeger(L, 3));
+    int z2 = static_cast<int>(lua::tointeger(L, 4));
+    require_controller().pregenerate(PregenArea::rect(x1, z1, x2, z2));
+    return 0;
+}
+
+static int l_pregenerate_radius(lua::State* L) {
+    int x = static_cast<int>(lua::tointeger(L, 1));
+    int z = static_cast<int>(lua::tointeger(L, 2));
+    int radius = static_cast<int>(lua::tointeger(L, 3));
+    require_controller().pregenerate(PregenArea::circle(x, z, radius));
+    return 0;
+}
+
+static int l_stop_pregen(lua::State* L) {
+    require_controller().stopPregeneration();
+    return 0;
+}
+
+static int l_get_pregen_progress(lua::State* L) {
+    auto pregenerator = require_controller().getPregenerator();
+    if (pregenerator == nullptr) {
+        return 0;
+    }
+    auto progress = pregenerator->getProgress();
+    lua::createtable(L, 0, 5);
+    lua::pushinteger(L, progress.total);
+    lua::setfield(L, "total");
+    lua::pushinteger(L, progress.done);
+    lua::setfield(L, "done");
+    lua::pushinteger(L, progress.generated);
+    lua::setfield(L, "generated");
+    lua::pushinteger(L, progress.skipped);
+    lua::setfield(L, "skipped");
+    lua::pushnumber(L, progress.speed);
+    lua::setfield(L, "speed");
+    return 1;
+}
+
 static int l_reload_script(lua::State* L) {
     auto packid = lua::require_string(L, 1);
     if (scripting::content == nullptr) {
@@ -252,6 +301,10 @@ const luaL_Reg worldlib [] = {
     {"set_chunk_data", lua::wrap<l_set_chunk_data>},
     {"save_chunk_data", lua::wrap<l_save_chunk_data>},
     {"count_chunks", lua::wrap<l_count_chunks>},
+    {"pregenerate", lua::wrap<l_pregenerate>},
+    {"pregenerate_radius", lua::wrap<l_pregenerate_radius>},
+    {"stop_pregen", lua::wrap<l_stop_pregen>},
+    {"get_pregen_progress", lua::wrap<l_get_pregen_progress>},
     {"reload_script", lua::wrap<l_reload_script>},
     {nullptr, nullptr}
 };
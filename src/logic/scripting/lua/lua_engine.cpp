@@ -10,6 +10,7 @@
 #include <logic/scripting/lua/usertypes/lua_type_random.h>
 #include <logic/scripting/lua/usertypes/lua_type_voxelfragment.h>
 #include <logic/scripting/lua/usertypes/lua_type_pcmstream.h>
+#include <logic/scripting/lua/usertypes/lua_type_bytes.h>
 #include <debug/Logger.h>
 #include <util/stringutil.h>
 #include <io/io.h>
@@ -68,6 +69,7 @@ static void create_libs(State* L, StateType stateType) {
     openlib(L, "byteutil", byteutillib);
     openlib(L, "xml", xmllib);
     openlib(L, "yaml", yamllib);
+    openlib(L, "profiler", profilerlib);
 
     openlib(L, "__chroma_app", applib);
     lua::getglobal(L, "__chroma_app");
@@ -160,6 +162,10 @@ void lua::init_state(State* L, StateType stateType) {
     newusertype<LuaHeightmap>(L);
     newusertype<LuaVoxelFragment>(L);
     newusertype<LuaCanvas>(L);
+    newusertype<LuaBytes>(L);
+    if (getglobal(L, LuaBytes::TYPENAME)) {
+        setglobal(L, "Bytes");
+    }
 
     pushboolean(L, headless_mode);
     setglobal(L, "__CHROMA_HEADLESS");
@@ -5,6 +5,7 @@
 
 #include <util/stringutil.h>
 #include <logic/scripting/lua/lua_engine.h>
+#include <logic/scripting/lua/usertypes/lua_type_bytes.h>
 #include <engine/Engine.h>
 #include <debug/Logger.h>
 
@@ -377,6 +378,8 @@ std::string_view lua::bytearray_as_string(lua::State* L, int idx) {
         return tolstring(L, idx);
     } else if (luaType == LUA_TTABLE) {
         return bytearray_as_string_indirect(L, idx);
+    } else if (auto bytes = touserdata_of<LuaBytes>(L, idx)) {
+        return bytes->view();
     }
     pushvalue(L, idx);
 
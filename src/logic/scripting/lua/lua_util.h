@@ -353,6 +353,18 @@ namespace lua {
         throw std::runtime_error("Invalid 'self' value");
     }
 
+    /// @brief Userdata указанного типа или nullptr (с проверкой типа)
+    template <class T>
+    inline T* touserdata_of(lua::State* L, int idx) {
+        if (lua_type(L, idx) != LUA_TUSERDATA) {
+            return nullptr;
+        }
+        if (auto userdata = static_cast<Userdata*>(lua_touserdata(L, idx))) {
+            return dynamic_cast<T*>(userdata);
+        }
+        return nullptr;
+    }
+
     template<class T, typename... Args>
     inline int newuserdata(lua::State* L, Args&&... args) {
         const auto& found = usertypeNames.find(typeid(T));
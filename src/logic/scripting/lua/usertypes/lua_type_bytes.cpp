@@ -0,0 +1,148 @@
+#include <logic/scripting/lua/usertypes/lua_type_bytes.h>
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+
+#include <logic/scripting/lua/lua_util.h>
+
+lua::LuaBytes::LuaBytes(
+    std::shared_ptr<ubyte[]> memory, size_t offset, size_t length
+) : memory(std::move(memory)), offset(offset), length(length) {}
+
+lua::LuaBytes::LuaBytes(size_t length)
+    : memory(new ubyte[length]()), offset(0), length(length) {}
+
+lua::LuaBytes::~LuaBytes() = default;
+
+lua::LuaBytes lua::LuaBytes::slice(size_t first, size_t count) const {
+    return LuaBytes(memory, offset + first, count);
+}
+
+/// Индекс в стиле string.sub: отрицательные отсчитываются с конца
+static long long normalize_index(long long index, size_t length) {
+    return index < 0 ? static_cast<long long>(length) + index + 1 : index;
+}
+
+static int l_slice(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    long long length = bytes.size();
+    long long first = normalize_index(
+        lua::isnoneornil(L, 2) ? 1 : lua::tointeger(L, 2), length
+    );
+    long long last = normalize_index(
+        lua::isnoneornil(L, 3) ? -1 : lua::tointeger(L, 3), length
+    );
+    first = std::max(first, 1LL);
+    last = std::min(last, length);
+    size_t count = last >= first ? last - first + 1 : 0;
+    return lua::newuserdata<lua::LuaBytes>(
+        L, bytes.slice(count ? first - 1 : 0, count)
+    );
+}
+
+static int l_string(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    return lua::pushlstring(L, bytes.view());
+}
+
+static int l_bytearray(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    return lua::create_bytearray(L, bytes.data(), bytes.size());
+}
+
+static std::unordered_map<std::string, lua_CFunction> methods {
+    {"slice", lua::wrap<l_slice>},
+    {"string", lua::wrap<l_string>},
+    {"bytearray", lua::wrap<l_bytearray>},
+};
+
+static int l_meta_meta_call(lua::State* L) {
+    if (lua::isnoneornil(L, 2)) {
+        return lua::newuserdata<lua::LuaBytes>(L, 0);
+    }
+    if (lua::isnumber(L, 2)) {
+        auto length = lua::tointeger(L, 2);
+        if (length < 0 ||
+            static_cast<uint64_t>(length) > lua::LuaBytes::MAX_LENGTH) {
+            throw std::runtime_error(
+                "invalid Bytes length " + std::to_string(length) +
+                " (expected 0.." + std::to_string(lua::LuaBytes::MAX_LENGTH) +
+                ")"
+            );
+        }
+        return lua::newuserdata<lua::LuaBytes>(L, length);
+    }
+    if (lua::istable(L, 2)) {
+        std::vector<ubyte> values;
+        lua::read_bytes_from_table(L, 2, values);
+        lua::newuserdata<lua::LuaBytes>(L, values.size());
+        auto& bytes = lua::require_userdata<lua::LuaBytes>(L, -1);
+        std::memcpy(bytes.data(), values.data(), values.size());
+        return 1;
+    }
+    auto source = lua::bytearray_as_string(L, 2);
+    lua::newuserdata<lua::LuaBytes>(L, source.size());
+    auto& bytes = lua::require_userdata<lua::LuaBytes>(L, -1);
+    std::memcpy(bytes.data(), source.data(), source.size());
+    return 1;
+}
+
+static int l_meta_tostring(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    return lua::pushstring(L, "Bytes[" + std::to_string(bytes.size()) + "]");
+}
+
+static int l_meta_len(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    return lua::pushinteger(L, bytes.size());
+}
+
+static int l_meta_index(lua::State* L) {
+    const auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    if (lua::isnumber(L, 2)) {
+        auto index = lua::tointeger(L, 2);
+        if (index < 1 || index > bytes.size()) {
+            return 0;
+        }
+        return lua::pushinteger(L, bytes.data()[index - 1]);
+    }
+    if (lua::isstring(L, 2)) {
+        auto found = methods.find(lua::tostring(L, 2));
+        if (found != methods.end()) {
+            return lua::pushcfunction(L, found->second);
+        }
+    }
+    return 0;
+}
+
+static int l_meta_newindex(lua::State* L) {
+    auto& bytes = lua::require_userdata<lua::LuaBytes>(L, 1);
+    auto index = lua::tointeger(L, 2);
+    if (index < 1 || index > bytes.size()) {
+        throw std::out_of_range(
+            "index " + std::to_string(index) + " is out of range [1, " +
+            std::to_string(bytes.size()) + "]"
+        );
+    }
+    bytes.data()[index - 1] = lua::tointeger(L, 3) & 0xFF;
+    return 0;
+}
+
+int lua::LuaBytes::createMetatable(lua::State* L) {
+    createtable(L, 0, 5);
+    pushcfunction(L, lua::wrap<l_meta_tostring>);
+    setfield(L, "__tostring");
+    pushcfunction(L, lua::wrap<l_meta_len>);
+    setfield(L, "__len");
+    pushcfunction(L, lua::wrap<l_meta_index>);
+    setfield(L, "__index");
+    pushcfunction(L, lua::wrap<l_meta_newindex>);
+    setfield(L, "__newindex");
+
+    createtable(L, 0, 1);
+    pushcfunction(L, lua::wrap<l_meta_meta_call>);
+    setfield(L, "__call");
+    setmetatable(L);
+    return 1;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include <typedefs.h>
+#include <logic/scripting/lua/lua_commons.h>
+
+namespace lua {
+    /// @brief Срез байтового буфера с разделяемой памятью.
+    /// Срезы ссылаются на ту же память, что и исходный буфер, поэтому
+    /// данные сети и скриптов передаются без копирования
+    class LuaBytes : public Userdata {
+    public:
+        /// Наибольший размер буфера, создаваемого из скрипта (256 МиБ)
+        static constexpr size_t MAX_LENGTH = 256 * 1024 * 1024;
+
+        LuaBytes(std::shared_ptr<ubyte[]> memory, size_t offset, size_t length);
+        /// Буфер заданного размера, заполненный нулями
+        explicit LuaBytes(size_t length);
+        virtual ~LuaBytes() override;
+
+        ubyte* data() {
+            return memory.get() + offset;
+        }
+
+        const ubyte* data() const {
+            return memory.get() + offset;
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        std::string_view view() const {
+            return {reinterpret_cast<const char*>(data()), length};
+        }
+
+        /// Срез [first, first + count), разделяющий память
+        LuaBytes slice(size_t first, size_t count) const;
+
+        const std::string& getTypeName() const override {
+            return TYPENAME;
+        }
+        static int createMetatable(lua::State*);
+        inline static std::string TYPENAME = "__chroma_Bytes";
+    private:
+        std::shared_ptr<ubyte[]> memory;
+        size_t offset;
+        size_t length;
+    };
+    static_assert(!std::is_abstract<LuaBytes>());
+}
@@ -6,25 +6,25 @@
 #include <filesystem>
 
 #include <logic/scripting/lua/lua_util.h>
-#define FNL_IMPL
 #include <math/FastNoiseLite.h>
 #include <coders/imageio.h>
 #include <graphics/core/ImageData.h>
 #include <util/functional_util.h>
 #include <io/util.h>
 #include <math/Heightmap.h>
+#include <math/LazyHeightmap.h>
 #include <engine/Engine.h>
 #include <engine/EnginePaths.h>
 
 using namespace lua;
 
-LuaHeightmap::LuaHeightmap(const std::shared_ptr<Heightmap>& map) : map(map), noise(std::make_unique<fnl_state>(fnlCreateState())) {
+LuaHeightmap::LuaHeightmap(const std::shared_ptr<Heightmap>& map)
+    : map(std::make_shared<LazyHeightmap>(map)),
+      noise(std::make_unique<fnl_state>(fnlCreateState())) {
 }
 
-LuaHeightmap::LuaHeightmap(
-    uint width, uint height
-) : map(std::make_shared<Heightmap>(width, height)),
-    noise(std::make_unique<fnl_state>(fnlCreateState())) {}
+LuaHeightmap::LuaHeightmap(uint width, uint height)
+    : LuaHeightmap(std::make_shared<Heightmap>(width, height)) {}
 
 LuaHeightmap::~LuaHeightmap() {}
 
@@ -44,8 +44,15 @@ float* LuaHeightmap::getValues() {
     return map->getValues();
 }
 
-const float* LuaHeightmap::getValues() const {
-    return map->getValues();
+const std::shared_ptr<Heightmap>& LuaHeightmap::getHeightmap() const {
+    return map->getHeightmap();
+}
+
+static std::shared_ptr<LazyHeightmap> require_operand(lua::State* L, int idx) {
+    if (auto operand = touserdata<LuaHeightmap>(L, idx)) {
+        return operand->getLazyHeightmap();
+    }
+    throw std::runtime_error("number or Heightmap expected");
 }
 
 static int l_dump(lua::State* L) {
@@ -83,139 +90,73 @@ static int l_at(lua::State* L) {
 template<fnl_noise_type noise_type>
 static int l_noise(lua::State* L) {
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
-        auto noise = heightmap->getNoise();
-
-        auto offset = tovec<2>(L, 2);
-
-        float s = tonumber(L, 3);
-        int octaves = 1;
-        float multiplier = 1.0f;
+        auto noise = std::make_shared<HeightmapNoise>();
+        noise->state = std::make_shared<fnl_state>(*heightmap->getNoise());
+        noise->state->noise_type = noise_type;
+        noise->offset = tovec<2>(L, 2);
+        noise->scale = tonumber(L, 3);
+        noise->octaves = 1;
+        noise->multiplier = 1.0f;
         if (gettop(L) > 3) {
-            octaves = tointeger(L, 4);
+            noise->octaves = tointeger(L, 4);
         }
         if (gettop(L) > 4) {
-            multiplier = tonumber(L, 5);
+            noise->multiplier = tonumber(L, 5);
         }
-        const LuaHeightmap* shiftMapX = nullptr;
-        const LuaHeightmap* shiftMapY = nullptr;
-        if (gettop(L) > 5) {
-            shiftMapX = touserdata<LuaHeightmap>(L, 6);
-        }
-        if (gettop(L) > 6) {
-            shiftMapY = touserdata<LuaHeightmap>(L, 7);
-        }
-        noise->noise_type = noise_type;
-        for (uint y = 0; y < h; ++y) {
-            for (uint x = 0; x < w; ++x) {
-                uint i = y * w + x;
-                for (uint c = 0; c < octaves; ++c) {
-                    float m = s * (1 << c);
-                    float value = heights[i];
-                    float u = (x + offset.x) * m;
-                    float v = (y + offset.y) * m;
-                    if (shiftMapX) {
-                        u += shiftMapX->getValues()[i];
-                    }
-                    if (shiftMapY) {
-                        v += shiftMapY->getValues()[i];
-                    }
-
-                    value += fnlGetNoise2D(noise, u, v) / static_cast<float>(1 << c) * multiplier;
-                    heights[i] = value;
+        HeightmapOp op {HeightmapOp::Type::Noise};
+        for (int i = 0; i < 2; ++i) {
+            if (gettop(L) > 5 + i) {
+                if (auto shiftMap = touserdata<LuaHeightmap>(L, 6 + i)) {
+                    op.maps[i] = shiftMap->getLazyHeightmap();
                 }
             }
         }
+        op.noise = std::move(noise);
+        heightmap->getLazyHeightmap()->apply(std::move(op));
     }
     return 0;
 }
 
-template<template<class> class Op>
+template<HeightmapOp::Type type>
 static int l_binop_func(lua::State* L) {
-    Op<float> op;
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
-
+        HeightmapOp op {type};
         if (isnumber(L, 2)) {
-            float scalar = tonumber(L, 2);
-            for (uint y = 0; y < h; ++y) {
-                for (uint x = 0; x < w; ++x) {
-                    uint i = y * w + x;
-                    heights[i] = op(heights[i], scalar);
-                }
-            }
+            op.values[0] = tonumber(L, 2);
         } else {
-            auto map = touserdata<LuaHeightmap>(L, 2);
-            for (uint y = 0; y < h; ++y) {
-                for (uint x = 0; x < w; ++x) {
-                    uint i = y * w + x;
-                    heights[i] = op(heights[i], map->getValues()[i]);
-                }
-            }
+            op.maps[0] = require_operand(L, 2);
         }
+        heightmap->getLazyHeightmap()->apply(std::move(op));
     }
     return 0;
 }
 
 static int l_mixin(lua::State* L) {
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
-
-        if (isnumber(L, 2)) {
-            float scalar = tonumber(L, 2);
-            if (isnumber(L, 3)) {
-                float t = tonumber(L, 3);
-                for (uint i = 0; i < w * h; ++i) {
-                    heights[i] = heights[i] * (1.0f - t) + scalar * t;
-                }
-            } else {
-                auto tmap = touserdata<LuaHeightmap>(L, 3);
-                auto tmapvalues = tmap->getValues();
-                for (uint i = 0; i < w * h; ++i) {
-                    float t = tmapvalues[i];
-                    heights[i] = heights[i] * (1.0f - t) + scalar * t;
-                }
-            }
-        } else {
-            auto map = touserdata<LuaHeightmap>(L, 2);
-            auto mapvalues = map->getValues();
-            if (isnumber(L, 3)) {
-                float t = tonumber(L, 3);
-                for (uint i = 0; i < w * h; ++i) {
-                    heights[i] = heights[i] * (1.0f - t) + mapvalues[i] * t;
-                }
+        HeightmapOp op {HeightmapOp::Type::Mix};
+        for (int i = 0; i < 2; ++i) {
+            if (isnumber(L, 2 + i)) {
+                op.values[i] = tonumber(L, 2 + i);
             } else {
-                auto tmap = touserdata<LuaHeightmap>(L, 3);
-                auto tmapvalues = tmap->getValues();
-                for (uint i = 0; i < w * h; ++i) {
-                    float t = tmapvalues[i];
-                    heights[i] = heights[i] * (1.0f - t) + mapvalues[i] * t;
-                }
+                op.maps[i] = require_operand(L, 2 + i);
             }
         }
+        heightmap->getLazyHeightmap()->apply(std::move(op));
     }
     return 0;
 }
 
-template<template<class> class Op>
+template<HeightmapOp::Type type>
 static int l_unaryop_func(lua::State* L) {
-    Op<float> op;
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
-        for (uint y = 0; y < h; ++y) {
-            for (uint x = 0; x < w; ++x) {
-                uint i = y * w + x;
-                heights[i] = op(heights[i]);
-            }
-        }
+        heightmap->getLazyHeightmap()->apply(HeightmapOp {type});
+    }
+    return 0;
+}
+
+static int l_evaluate(lua::State* L) {
+    if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
+        heightmap->getLazyHeightmap()->evaluate();
     }
     return 0;
 }
@@ -253,17 +194,18 @@ static std::unordered_map<std::string, lua_CFunction> methods {
     {"dump", lua::wrap<l_dump>},
     {"noise", lua::wrap<l_noise<FNL_NOISE_OPENSIMPLEX2>>},
     {"cellnoise", lua::wrap<l_noise<FNL_NOISE_CELLULAR>>},
-    {"pow", lua::wrap<l_binop_func<util::pow>>},
-    {"sub", lua::wrap<l_binop_func<std::minus>>},
-    {"add", lua::wrap<l_binop_func<std::plus>>},
-    {"mul", lua::wrap<l_binop_func<std::multiplies>>},
-    {"min", lua::wrap<l_binop_func<util::min>>},
-    {"max", lua::wrap<l_binop_func<util::max>>},
-    {"abs", lua::wrap<l_unaryop_func<util::abs>>},
+    {"pow", lua::wrap<l_binop_func<HeightmapOp::Type::Pow>>},
+    {"sub", lua::wrap<l_binop_func<HeightmapOp::Type::Sub>>},
+    {"add", lua::wrap<l_binop_func<HeightmapOp::Type::Add>>},
+    {"mul", lua::wrap<l_binop_func<HeightmapOp::Type::Mul>>},
+    {"min", lua::wrap<l_binop_func<HeightmapOp::Type::Min>>},
+    {"max", lua::wrap<l_binop_func<HeightmapOp::Type::Max>>},
+    {"abs", lua::wrap<l_unaryop_func<HeightmapOp::Type::Abs>>},
     {"resize", lua::wrap<l_resize>},
     {"crop", lua::wrap<l_crop>},
     {"at", lua::wrap<l_at>},
-    {"mixin", lua::wrap<l_mixin>}
+    {"mixin", lua::wrap<l_mixin>},
+    {"evaluate", lua::wrap<l_evaluate>}
 };
 
 static int l_meta_meta_call(lua::State* L) {
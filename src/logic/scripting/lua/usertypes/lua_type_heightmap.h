@@ -4,10 +4,13 @@
 
 struct fnl_state;
 class Heightmap;
+class LazyHeightmap;
 
 namespace lua {
+    /// @brief Карта высот для скриптов. Операции выполняются отложенно,
+    /// одним проходом при обращении к значениям (см. LazyHeightmap)
     class LuaHeightmap : public Userdata {
-        std::shared_ptr<Heightmap> map;
+        std::shared_ptr<LazyHeightmap> map;
         std::unique_ptr<fnl_state> noise;
     public:
         LuaHeightmap(const std::shared_ptr<Heightmap>& map);
@@ -19,15 +22,17 @@ namespace lua {
 
         uint getHeight() const;
 
+        /// Значения после выполнения отложенных операций
         float* getValues();
 
-        const float* getValues() const;
-
         const std::string& getTypeName() const override {
             return TYPENAME;
         }
 
-        const std::shared_ptr<Heightmap>& getHeightmap() const {
+        /// Карта после выполнения отложенных операций
+        const std::shared_ptr<Heightmap>& getHeightmap() const;
+
+        const std::shared_ptr<LazyHeightmap>& getLazyHeightmap() const {
             return map;
         }
 
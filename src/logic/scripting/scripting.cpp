@@ -27,6 +27,7 @@
 #include <content/ContentControl.h>
 #include <world/World.h>
 #include <voxels/blocks_agent.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("scripting");
 
@@ -237,6 +238,7 @@ scriptenv scripting::create_doc_environment(const scriptenv& parent, const std::
 }
 
 void scripting::process_post_runnables() {
+    PROFILE_ZONE("lua.post_runnables");
     auto L = lua::get_main_state();
     if (lua::getglobal(L, "__chroma__process_post_runnables")) {
         lua::call_nothrow(L, 0, 0);
@@ -311,6 +313,7 @@ void scripting::on_world_load(LevelController* controller) {
 }
 
 void scripting::on_world_spark(int sps) {
+    PROFILE_ZONE("lua.world_spark");
     auto L = lua::get_main_state();
     if (lua::getglobal(L, "__chroma_on_world_spark")) {
         lua::pushinteger(L, sps);
@@ -375,6 +378,7 @@ void scripting::cleanup(const std::vector<std::string>& nonReset) {
 }
 
 void scripting::on_blocks_spark(const Block& block, int sps) {
+    PROFILE_ZONE("lua.blocks_spark");
     std::string name = block.name + ".blocksspark";
     lua::emit_event(lua::get_main_state(), name, [sps] (auto L) {
         return lua::pushinteger(L, sps);
@@ -533,6 +537,7 @@ void scripting::on_inventory_closed(const Player* player, const Inventory& inven
 }
 
 void scripting::on_player_spark(Player* player, int sps) {
+    PROFILE_ZONE("lua.player_spark");
     auto args = [=](lua::State* L) {
         lua::pushinteger(L, player ? player->getId() : -1);
         lua::pushinteger(L, sps);
@@ -9,6 +9,7 @@
 #include <content/Content.h>
 #include <content/ContentPack.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("scripting-entities");
 
@@ -324,6 +325,7 @@ void scripting::on_entity_used(const Entt_Entity& entity, Player* player) {
 }
 
 void scripting::on_entities_update(int sps, int parts, int part) {
+    PROFILE_ZONE("lua.entities_update");
     auto L = lua::get_main_state();
     lua::get_from(L, STDCOMP, "update", true);
     lua::pushinteger(L, sps);
@@ -334,6 +336,7 @@ void scripting::on_entities_update(int sps, int parts, int part) {
 }
 
 void scripting::on_entities_physics_update(float delta) {
+    PROFILE_ZONE("lua.entities_physics");
     auto L = lua::get_main_state();
     lua::get_from(L, STDCOMP, "physics_update", true);
     lua::pushnumber(L, delta);
@@ -11,6 +11,7 @@
 #include <frontend/UIDocument.h>
 #include <assets/Assets.h>
 #include <content/ContentControl.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("scripting-hud");
 
@@ -75,6 +76,7 @@ void scripting::on_frontend_close() {
 }
 
 void scripting::on_frontend_render() {
+    PROFILE_ZONE("lua.frontend_render");
     for (auto& pack : scripting::content_control->getAllContentPacks()) {
         lua::emit_event(lua::get_main_state(), pack.id + ":.hudrender", 
         [] (lua::State* L) {
@@ -41,6 +41,10 @@ public:
         }
     }
 
+    std::unique_ptr<GeneratorScript> copy() const override {
+        return scripting::load_generator(def, file, dirPath);
+    }
+
     void initialize(uint64_t seed) override {
         env = lua::create_environment(L);
         lua::stackguard _(L);
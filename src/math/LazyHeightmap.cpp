@@ -0,0 +1,208 @@
+#include <math/LazyHeightmap.h>
+
+#include <stdexcept>
+
+#define FNL_IMPL
+#include <math/FastNoiseLite.h>
+#include <math/Heightmap.h>
+#include <util/functional_util.h>
+
+/// Размер блока в значениях: блок и операнды остаются в L1-кэше
+inline constexpr size_t BLOCK_SIZE = 1024;
+
+/// Типичная длина цепочки операций в скриптах генераторов
+inline constexpr size_t INITIAL_OPS_CAPACITY = 32;
+
+template<template<class> class Op>
+static void apply_binary(
+    float* dst, const float* src, float scalar, size_t count
+) {
+    Op<float> op;
+    if (src) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = op(dst[i], src[i]);
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = op(dst[i], scalar);
+        }
+    }
+}
+
+static void apply_abs(float* dst, size_t count) {
+    util::abs<float> op;
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = op(dst[i]);
+    }
+}
+
+static void apply_mix(
+    float* dst,
+    const float* src, float scalar,
+    const float* tsrc, float t,
+    size_t count
+) {
+    for (size_t i = 0; i < count; ++i) {
+        float x = src ? src[i] : scalar;
+        float k = tsrc ? tsrc[i] : t;
+        dst[i] = dst[i] * (1.0f - k) + x * k;
+    }
+}
+
+static void apply_noise(
+    float* dst,
+    const HeightmapNoise& noise,
+    const float* shiftX,
+    const float* shiftY,
+    size_t begin,
+    size_t count,
+    uint width
+) {
+    auto state = noise.state.get();
+    uint x = begin % width;
+    uint y = begin / width;
+    for (size_t i = 0; i < count; ++i) {
+        for (uint c = 0; c < noise.octaves; ++c) {
+            float m = noise.scale * (1 << c);
+            float u = (x + noise.offset.x) * m;
+            float v = (y + noise.offset.y) * m;
+            if (shiftX) {
+                u += shiftX[i];
+            }
+            if (shiftY) {
+                v += shiftY[i];
+            }
+            dst[i] += fnlGetNoise2D(state, u, v) /
+                      static_cast<float>(1 << c) * noise.multiplier;
+        }
+        if (++x == width) {
+            x = 0;
+            y++;
+        }
+    }
+}
+
+static inline const float* operand_values(
+    const std::shared_ptr<LazyHeightmap>& map, size_t begin
+) {
+    return map ? map->getRawValues() + begin : nullptr;
+}
+
+static void apply_op(
+    const HeightmapOp& op, float* dst, size_t begin, size_t count, uint width
+) {
+    const float* src = operand_values(op.maps[0], begin);
+    float scalar = op.values[0];
+    using Type = HeightmapOp::Type;
+    switch (op.type) {
+        case Type::Add: apply_binary<std::plus>(dst, src, scalar, count); break;
+        case Type::Sub: apply_binary<std::minus>(dst, src, scalar, count); break;
+        case Type::Mul: apply_binary<std::multiplies>(dst, src, scalar, count); break;
+        case Type::Pow: apply_binary<util::pow>(dst, src, scalar, count); break;
+        case Type::Min: apply_binary<util::min>(dst, src, scalar, count); break;
+        case Type::Max: apply_binary<util::max>(dst, src, scalar, count); break;
+        case Type::Abs: apply_abs(dst, count); break;
+        case Type::Mix:
+            apply_mix(
+                dst,
+                src, scalar,
+                operand_values(op.maps[1], begin), op.values[1],
+                count
+            );
+            break;
+        case Type::Noise:
+            apply_noise(
+                dst,
+                *op.noise,
+                src,
+                operand_values(op.maps[1], begin),
+                begin,
+                count,
+                width
+            );
+            break;
+    }
+}
+
+LazyHeightmap::LazyHeightmap(std::shared_ptr<Heightmap> map)
+    : map(std::move(map)) {}
+
+LazyHeightmap::~LazyHeightmap() = default;
+
+void LazyHeightmap::evaluateDependents() {
+    auto list = std::move(dependents);
+    dependents.clear();
+    for (const auto& weak : list) {
+        if (auto dependent = weak.lock()) {
+            dependent->evaluate();
+        }
+    }
+}
+
+void LazyHeightmap::apply(HeightmapOp op) {
+    // Зависимые карты должны увидеть значения до этой операции
+    evaluateDependents();
+
+    size_t size = map->getWidth() * map->getHeight();
+    for (const auto& operand : op.maps) {
+        if (operand == nullptr) {
+            continue;
+        }
+        if (operand->getWidth() * operand->getHeight() < size) {
+            throw std::runtime_error("heightmap operand is smaller than target");
+        }
+        if (operand.get() != this) {
+            operand->evaluate();
+            if (operand->dependents.empty() ||
+                operand->dependents.back().lock().get() != this) {
+                operand->dependents.push_back(weak_from_this());
+            }
+        } else {
+            evaluate();
+        }
+    }
+    if (ops.capacity() == 0) {
+        ops.reserve(INITIAL_OPS_CAPACITY);
+    }
+    ops.push_back(std::move(op));
+}
+
+void LazyHeightmap::evaluate() {
+    if (ops.empty()) {
+        return;
+    }
+    evaluateDependents();
+
+    uint width = map->getWidth();
+    size_t size = width * map->getHeight();
+    float* values = map->getValues();
+    for (size_t begin = 0; begin < size; begin += BLOCK_SIZE) {
+        size_t count = std::min(BLOCK_SIZE, size - begin);
+        for (const auto& op : ops) {
+            apply_op(op, values + begin, begin, count, width);
+        }
+    }
+    ops.clear();
+}
+
+float* LazyHeightmap::getValues() {
+    return getHeightmap()->getValues();
+}
+
+const std::shared_ptr<Heightmap>& LazyHeightmap::getHeightmap() {
+    evaluate();
+    evaluateDependents();
+    return map;
+}
+
+const float* LazyHeightmap::getRawValues() const {
+    return map->getValues();
+}
+
+uint LazyHeightmap::getWidth() const {
+    return map->getWidth();
+}
+
+uint LazyHeightmap::getHeight() const {
+    return map->getHeight();
+}
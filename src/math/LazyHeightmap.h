@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <typedefs.h>
+
+struct fnl_state;
+class Heightmap;
+class LazyHeightmap;
+
+/// Параметры шума для операции Noise
+struct HeightmapNoise {
+    /// Копия состояния на момент записи операции
+    std::shared_ptr<fnl_state> state;
+    glm::vec2 offset;
+    float scale;
+    int octaves;
+    float multiplier;
+};
+
+/// @brief Отложенная поэлементная операция над картой высот
+struct HeightmapOp {
+    enum class Type : uint8_t {
+        Add, Sub, Mul, Pow, Min, Max,
+        Abs,
+        /// h * (1 - t) + x * t, где x = операнд 0, t = операнд 1
+        Mix,
+        /// Добавление шума, операнды-карты - сдвиги по x и y
+        Noise
+    };
+    Type type;
+    /// Скалярные операнды
+    float values[2] {};
+    /// Операнды-карты, используются вместо скаляров при наличии
+    std::shared_ptr<LazyHeightmap> maps[2];
+    std::shared_ptr<HeightmapNoise> noise;
+
+    explicit HeightmapOp(Type type) : type(type) {}
+};
+
+/**
+ * @brief Карта высот с отложенным выполнением операций.
+ *
+ * Операции записываются в цепочку и выполняются одним проходом по
+ * блокам, помещающимся в кэш, при первом обращении к значениям.
+ * Промежуточные карты не создаются.
+ *
+ * Карта-операнд вычисляется в момент записи операции и запоминает
+ * зависимую карту: перед изменением операнда зависимые карты
+ * вычисляются, поэтому результат совпадает с немедленным выполнением.
+ */
+class LazyHeightmap : public std::enable_shared_from_this<LazyHeightmap> {
+    std::shared_ptr<Heightmap> map;
+    std::vector<HeightmapOp> ops;
+    std::vector<std::weak_ptr<LazyHeightmap>> dependents;
+
+    void evaluateDependents();
+public:
+    explicit LazyHeightmap(std::shared_ptr<Heightmap> map);
+    ~LazyHeightmap();
+
+    /// @brief Записывает операцию для отложенного выполнения
+    void apply(HeightmapOp op);
+
+    /// @brief Выполняет отложенные операции
+    void evaluate();
+
+    /// @brief Значения после выполнения отложенных операций.
+    /// Указатель допускает запись
+    float* getValues();
+
+    /// @brief Карта после выполнения отложенных операций.
+    /// Карта может изменяться вызывающим кодом
+    const std::shared_ptr<Heightmap>& getHeightmap();
+
+    /// @brief Значения без выполнения отложенных операций
+    const float* getRawValues() const;
+
+    uint getWidth() const;
+
+    uint getHeight() const;
+
+    size_t getPendingOps() const {
+        return ops.size();
+    }
+};
@@ -0,0 +1,103 @@
+#include <math/SkylinePacker.h>
+
+#include <limits>
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(const uint32_t sizes[], size_t length) {
+    for (uint i = 0; i < length / 2; ++i) {
+        rects.emplace_back(i, 0, 0, (int)sizes[i * 2], (int)sizes[i * 2 + 1]);
+    }
+    // Высокие прямоугольники первыми: линия горизонта остаётся ровнее
+    std::stable_sort(
+        rects.begin(), rects.end(), [](const auto& a, const auto& b) {
+            if (a.height != b.height) return a.height > b.height;
+            return a.width > b.width;
+        }
+    );
+}
+
+int SkylinePacker::fit(size_t index, int w, int h) const {
+    int x = skyline[index].x;
+    if (x + w > width) {
+        return -1;
+    }
+    int y = 0;
+    int left = w;
+    for (size_t i = index; left > 0; ++i) {
+        y = std::max(y, skyline[i].y);
+        if (y + h > height) {
+            return -1;
+        }
+        left -= skyline[i].width;
+    }
+    return y;
+}
+
+void SkylinePacker::place(size_t index, int x, int y, int w, int h) {
+    skyline.insert(skyline.begin() + index, Node {x, y + h, w});
+
+    // Отрезки под новым прямоугольником укорачиваются или удаляются
+    for (size_t i = index + 1; i < skyline.size();) {
+        const auto& prev = skyline[i - 1];
+        auto& node = skyline[i];
+        int overlap = prev.x + prev.width - node.x;
+        if (overlap <= 0) {
+            break;
+        }
+        node.x += overlap;
+        node.width -= overlap;
+        if (node.width > 0) {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool SkylinePacker::build(
+    uint32_t width, uint32_t height, uint16_t extension
+) {
+    this->width = width;
+    this->height = height;
+    skyline.clear();
+    skyline.push_back(Node {0, 0, static_cast<int>(width)});
+
+    for (auto& rect : rects) {
+        int w = rect.width + extension * 2;
+        int h = rect.height + extension * 2;
+
+        // Наименьшая верхняя граница, при равенстве - самый узкий отрезок
+        size_t bestIndex = skyline.size();
+        int bestTop = std::numeric_limits<int>::max();
+        int bestWidth = std::numeric_limits<int>::max();
+        int bestY = 0;
+        for (size_t i = 0; i < skyline.size(); ++i) {
+            int y = fit(i, w, h);
+            if (y < 0) {
+                continue;
+            }
+            if (y + h < bestTop ||
+                (y + h == bestTop && skyline[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = y + h;
+                bestWidth = skyline[i].width;
+                bestY = y;
+            }
+        }
+        if (bestIndex == skyline.size()) {
+            return false;
+        }
+        int x = skyline[bestIndex].x;
+        place(bestIndex, x, bestY, w, h);
+        rect.x = x + extension;
+        rect.y = bestY + extension;
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <typedefs.h>
+
+struct rectangle {
+    uint idx;
+    int x;
+    int y;
+    int width;
+    int height;
+
+    rectangle(uint idx, int x, int y, int width, int height)
+        : idx(idx), x(x), y(y), width(width), height(height) {
+    }
+};
+
+/// @brief Упаковщик прямоугольников по линии горизонта (skyline,
+/// bottom-left). Вместо матрицы занятых клеток хранит только верхнюю
+/// границу уже размещённых прямоугольников, поэтому поиск места занимает
+/// O(число отрезков границы) вместо перебора пикселей
+class SkylinePacker {
+    /// Горизонтальный отрезок линии горизонта
+    struct Node {
+        int x;
+        int y;
+        int width;
+    };
+    std::vector<rectangle> rects;
+    std::vector<Node> skyline;
+    int width = 0;
+    int height = 0;
+
+    /// @return верхняя граница под прямоугольником, начинающимся на
+    /// отрезке index, или -1, если он там не помещается
+    int fit(size_t index, int w, int h) const;
+    void place(size_t index, int x, int y, int w, int h);
+public:
+    /// @param sizes пары ширина, высота
+    /// @param length длина массива sizes (удвоенное число прямоугольников)
+    SkylinePacker(const uint32_t sizes[], size_t length);
+
+    /// @brief Размещает все прямоугольники с отступом extension с каждой
+    /// стороны. Координаты результата указывают на сам прямоугольник
+    /// без отступа
+    /// @return false если прямоугольники не помещаются в width x height
+    bool build(uint32_t width, uint32_t height, uint16_t extension);
+
+    /// @brief Прямоугольники в порядке размещения; idx - исходный индекс
+    const std::vector<rectangle>& getResult() const {
+        return rects;
+    }
+};
@@ -7,8 +7,10 @@
 #endif
 #include <stdexcept>
 #include <limits>
-#include <queue>
-#include <thread>
+#include <deque>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
 
 #ifdef _WIN32
 #include <curl/curl.h>
@@ -16,6 +18,7 @@
 #else
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
@@ -28,6 +31,8 @@ using SOCKET = int;
 #endif // _WIN32
 
 #include <network/Network.h>
+#include <network/SocketsReactor.h>
+#include <util/RingBuffer.h>
 #include <util/stringutil.h>
 #include <debug/Logger.h>
 
@@ -71,24 +76,141 @@ static inline std::runtime_error handle_socket_error(const std::string& message)
 }
 #endif
 
+/// Порция чтения из сокета за один вызов
+inline constexpr size_t READ_CHUNK_SIZE = 16'384;
+/// Объём непрочитанных данных, после которого приём приостанавливается
+inline constexpr size_t MAX_READ_BUFFERED = 16 * 1024 * 1024;
+/// Небольшие отправки дописываются в последний блок очереди
+inline constexpr size_t SEND_CHUNK_SIZE = 16'384;
+/// Максимум блоков очереди отправки за один системный вызов
+inline constexpr size_t MAX_SEND_BUFFERS = 64;
+/// Предел неотправленных данных: сверх него send принимает только часть
+inline constexpr size_t MAX_SEND_QUEUED = 16 * 1024 * 1024;
+/// Сколько закрытое соединение дописывает очередь отправки
+inline constexpr auto CLOSE_LINGER_TIMEOUT = std::chrono::seconds(10);
+
+#ifdef MSG_NOSIGNAL
+inline constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+inline constexpr int SEND_FLAGS = 0;
+#endif
+
+using SendQueue = std::deque<std::vector<char>>;
+
 static inline int connectsocket(
     int descriptor, const sockaddr* addr, socklen_t len
 ) noexcept {
     return connect(descriptor, addr, len);
 }
 
-static inline int recvsocket(
-    int descriptor, char* buf, size_t len
-) noexcept {
-    return recv(descriptor, buf, len, 0);
-}
-
 static inline int sendsocket(
     int descriptor, const char* buf, size_t len, int flags
 ) noexcept {
     return send(descriptor, buf, len, flags);
 }
 
+static void set_nonblocking(SOCKET descriptor) {
+#ifdef _WIN32
+    u_long mode = 1;
+    bool failed = ioctlsocket(descriptor, FIONBIO, &mode) != 0;
+#else
+    int flags = fcntl(descriptor, F_GETFL);
+    bool failed =
+        flags == -1 || fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == -1;
+#endif
+    if (failed) {
+        throw handle_socket_error("Could not make socket non-blocking");
+    }
+}
+
+/// Последняя операция не выполнена, так как сокет не готов
+static inline bool would_block() {
+#ifdef _WIN32
+    int err = WSAGetLastError();
+    return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS;
+#endif
+}
+
+/// Забирает отложенную ошибку сокета (например, неблокирующего connect)
+/// и делает её последней ошибкой для handle_socket_error
+static int take_pending_error(SOCKET descriptor) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(
+            descriptor, SOL_SOCKET, SO_ERROR, (char*)&err, &len
+        ) < 0) {
+        return -1;
+    }
+#ifdef _WIN32
+    WSASetLastError(err);
+#else
+    errno = err;
+#endif
+    return err;
+}
+
+/// Читает доступные данные прямо в свободные участки кольцевого буфера
+static int recv_into(SOCKET descriptor, util::RingBuffer<char>& buffer) {
+    buffer.reserve(READ_CHUNK_SIZE);
+    auto spans = buffer.writable();
+    int count = spans[1].size ? 2 : 1;
+#ifdef _WIN32
+    WSABUF buffers[2] {
+        {static_cast<ULONG>(spans[0].size), spans[0].data},
+        {static_cast<ULONG>(spans[1].size), spans[1].data},
+    };
+    DWORD received = 0;
+    DWORD flags = 0;
+    if (WSARecv(
+            descriptor, buffers, count, &received, &flags, nullptr, nullptr
+        )) {
+        return -1;
+    }
+    int size = received;
+#else
+    iovec buffers[2] {
+        {spans[0].data, spans[0].size},
+        {spans[1].data, spans[1].size},
+    };
+    int size = readv(descriptor, buffers, count);
+#endif
+    if (size > 0) {
+        buffer.commit(size);
+    }
+    return size;
+}
+
+/// Отправляет начало очереди одним вызовом (scatter/gather)
+static int send_queued(SOCKET descriptor, const SendQueue& queue, size_t offset) {
+    size_t count = std::min(queue.size(), MAX_SEND_BUFFERS);
+#ifdef _WIN32
+    WSABUF buffers[MAX_SEND_BUFFERS];
+    for (size_t i = 0; i < count; ++i) {
+        size_t skip = i == 0 ? offset : 0;
+        buffers[i].buf = const_cast<char*>(queue[i].data()) + skip;
+        buffers[i].len = static_cast<ULONG>(queue[i].size() - skip);
+    }
+    DWORD sent = 0;
+    if (WSASend(descriptor, buffers, count, &sent, 0, nullptr, nullptr)) {
+        return -1;
+    }
+    return sent;
+#else
+    iovec buffers[MAX_SEND_BUFFERS];
+    for (size_t i = 0; i < count; ++i) {
+        size_t skip = i == 0 ? offset : 0;
+        buffers[i].iov_base = const_cast<char*>(queue[i].data()) + skip;
+        buffers[i].iov_len = queue[i].size() - skip;
+    }
+    msghdr message {};
+    message.msg_iov = buffers;
+    message.msg_iovlen = count;
+    return sendmsg(descriptor, &message, SEND_FLAGS);
+#endif
+}
+
 static std::string to_string(const sockaddr_in& addr, bool port=true) {
     char ip[INET_ADDRSTRLEN];
     if (inet_ntop(AF_INET, &(addr.sin_addr), ip, INET_ADDRSTRLEN)) {
@@ -97,44 +219,130 @@ static std::string to_string(const sockaddr_in& addr, bool port=true) {
     return "";
 }
 
-class SocketTcpConnection : public TcpConnection {
+/// TCP-соединение, обслуживаемое общим SocketsReactor.
+/// Принятые данные копятся в кольцевом буфере, неотправленные - в очереди
+class SocketTcpConnection : public TcpConnection,
+                            public SocketsReactor::Handler,
+                            public std::enable_shared_from_this<SocketTcpConnection> {
     SOCKET descriptor;
     sockaddr_in addr;
     size_t totalUpload = 0;
     size_t totalDownload = 0;
-    ConnectionState state = ConnectionState::Initial;
-    std::unique_ptr<std::thread> thread = nullptr;
-    std::vector<char> readBatch;
-    util::Buffer<char> buffer;
+    std::atomic<ConnectionState> state = ConnectionState::Initial;
+    uint64_t reactorId = 0;
+    int interest = 0;
+    util::RingBuffer<char> readBuffer;
+    SendQueue sendQueue;
+    /// Отправленная часть первого блока очереди
+    size_t sendOffset = 0;
+    /// Неотправленные байты очереди
+    size_t queuedBytes = 0;
+    /// Соединение закрыто, но ещё дописывает очередь отправки
+    std::atomic<bool> closing = false;
+    /// Удерживает закрываемое соединение, пока очередь не отправлена
+    std::shared_ptr<SocketTcpConnection> lingering;
     std::mutex mutex;
-    std::string errorMessage;
+    runnable connectCallback;
+    stringconsumer errorCallback;
 
-    void connectSocket() {
-        state = ConnectionState::Connecting;
-        logger.info() << "Connecting to " << to_string(addr);
-        int res = connectsocket(descriptor, (const sockaddr*)&addr, sizeof(sockaddr_in));
-        if (res < 0) {
-            auto error = handle_socket_error("Connect failed");
-            closesocket(descriptor);
-            state = ConnectionState::Closed;
-            errorMessage = error.what();
-            logger.error() << errorMessage;
+    // Методы ниже вызываются под mutex
+
+    void closeSocket() {
+        if (state == ConnectionState::Closed) {
             return;
         }
-        logger.info() << "Connected to " << to_string(addr);
-        state = ConnectionState::Connected;
+        if (reactorId) {
+            SocketsReactor::get().remove(reactorId);
+            reactorId = 0;
+        }
+        shutdown(descriptor, SHUT_RDWR);
+        closesocket(descriptor);
+        sendQueue.clear();
+        sendOffset = 0;
+        queuedBytes = 0;
+        state = ConnectionState::Closed;
+    }
+
+    void updateInterest() {
+        if (reactorId == 0 || state == ConnectionState::Closed) {
+            return;
+        }
+        int newInterest = 0;
+        if (state == ConnectionState::Connecting || !sendQueue.empty()) {
+            newInterest |= SocketsReactor::WRITE;
+        }
+        if (state == ConnectionState::Connected && !closing &&
+            readBuffer.size() < MAX_READ_BUFFERED) {
+            newInterest |= SocketsReactor::READ;
+        }
+        if (newInterest != interest) {
+            interest = newInterest;
+            SocketsReactor::get().modify(reactorId, interest);
+        }
+    }
+
+    void receive() {
+        while (readBuffer.size() < MAX_READ_BUFFERED) {
+            int size = recv_into(descriptor, readBuffer);
+            if (size > 0) {
+                totalDownload += size;
+                continue;
+            }
+            if (size == 0) {
+                logger.info() << "Closed connection with " << to_string(addr);
+                closeSocket();
+            } else if (!would_block()) {
+                logger.warning() << "An error ocurred while receiving from " << to_string(addr);
+                handle_socket_error("recv(...) error");
+                closeSocket();
+            }
+            break;
+        }
+    }
+
+    void flush() {
+        while (!sendQueue.empty()) {
+            int size = send_queued(descriptor, sendQueue, sendOffset);
+            if (size < 0) {
+                if (!would_block()) {
+                    handle_socket_error("send(...) error");
+                    closeSocket();
+                }
+                return;
+            }
+            totalUpload += size;
+            queuedBytes -= size;
+            size_t remaining = size;
+            while (remaining) {
+                size_t chunkSize = sendQueue.front().size() - sendOffset;
+                if (remaining < chunkSize) {
+                    sendOffset += remaining;
+                    break;
+                }
+                remaining -= chunkSize;
+                sendQueue.pop_front();
+                sendOffset = 0;
+            }
+        }
+    }
+
+    void enqueue(const char* buffer, size_t length) {
+        queuedBytes += length;
+        if (!sendQueue.empty() &&
+            sendQueue.back().size() + length <= SEND_CHUNK_SIZE) {
+            auto& chunk = sendQueue.back();
+            chunk.insert(chunk.end(), buffer, buffer + length);
+        } else {
+            sendQueue.emplace_back(buffer, buffer + length);
+        }
     }
 public:
     SocketTcpConnection(SOCKET descriptor, sockaddr_in addr)
-        : descriptor(descriptor), addr(std::move(addr)), buffer(16'384) {}
+        : descriptor(descriptor), addr(std::move(addr)) {}
 
     ~SocketTcpConnection() {
-        if (state != ConnectionState::Closed) {
-            shutdown(descriptor, 2);
-        }
-        if (thread) {
-            thread->join();
-        }
+        std::lock_guard lock(mutex);
+        closeSocket();
     }
 
     void setNoDelay(bool noDelay) override {
@@ -153,105 +361,174 @@ public:
         return opt != 0;
     }
 
-    void startListen() {
-        while (state == ConnectionState::Connected) {
-            int size = recvsocket(descriptor, buffer.data(), buffer.size());
-            if (size == 0) {
-                logger.info() << "Closed connection with " << to_string(addr);
-                closesocket(descriptor);
-                state = ConnectionState::Closed;
-                break;
-            } else if (size < 0) {
-                logger.warning() << "An error ocurred while receiving from " << to_string(addr);
-                auto error = handle_socket_error("recv(...) error");
-                closesocket(descriptor);
-                state = ConnectionState::Closed;
-                logger.error() << error.what();
-                break;
-            }
-            {
-                std::lock_guard lock(mutex);
-                for (size_t i = 0; i < size; ++i) {
-                    readBatch.emplace_back(buffer[i]);
+    void onSocketEvents(bool readable, bool writable) override {
+        runnable onConnected;
+        stringconsumer onError;
+        std::string errorMessage;
+        // Освобождается после снятия блокировки
+        std::shared_ptr<SocketTcpConnection> self;
+        {
+            std::lock_guard lock(mutex);
+            if (state == ConnectionState::Connecting) {
+                if (!writable) return;
+                if (take_pending_error(descriptor)) {
+                    errorMessage = handle_socket_error("Connect failed").what();
+                    closeSocket();
+                    onError = std::move(errorCallback);
+                } else {
+                    logger.info() << "Connected to " << to_string(addr);
+                    state = ConnectionState::Connected;
+                    onConnected = std::move(connectCallback);
+                    flush();
                 }
-                totalDownload += size;
+            } else if (state == ConnectionState::Connected) {
+                if (readable && !closing) {
+                    receive();
+                }
+                if (writable && state == ConnectionState::Connected) {
+                    flush();
+                }
+                if (closing && sendQueue.empty()) {
+                    closeSocket();
+                }
+            }
+            updateInterest();
+            if (state == ConnectionState::Closed) {
+                self = std::move(lingering);
             }
         }
+        // Обработчики могут обращаться к соединению, поэтому вне блокировки
+        if (onConnected) {
+            onConnected();
+        }
+        if (onError) {
+            onError(errorMessage);
+        }
+    }
+
+    void onDeadline() override {
+        std::shared_ptr<SocketTcpConnection> self;
+        std::lock_guard lock(mutex);
+        if (!closing || state == ConnectionState::Closed) {
+            return;
+        }
+        logger.warning() << "Dropped " << queuedBytes
+                         << " unsent bytes on close of " << to_string(addr);
+        closeSocket();
+        self = std::move(lingering);
     }
 
     void startClient() {
+        std::lock_guard lock(mutex);
+        set_nonblocking(descriptor);
         state = ConnectionState::Connected;
-        thread = std::make_unique<std::thread>([this]() { startListen();});
+        interest = SocketsReactor::READ;
+        reactorId = SocketsReactor::get().add(
+            descriptor, weak_from_this(), interest
+        );
     }
 
     void connect(runnable callback, stringconsumer errorCallback) override {
-        thread = std::make_unique<std::thread>([this, callback, errorCallback]() {
-            connectSocket();
-            if (state == ConnectionState::Connected) {
-                callback();
-                startListen();
-            } else {
+        std::unique_lock lock(mutex);
+        state = ConnectionState::Connecting;
+        logger.info() << "Connecting to " << to_string(addr);
+        set_nonblocking(descriptor);
+        int res = connectsocket(descriptor, (const sockaddr*)&addr, sizeof(sockaddr_in));
+        if (res < 0 && !would_block()) {
+            std::string errorMessage = handle_socket_error("Connect failed").what();
+            closeSocket();
+            lock.unlock();
+            if (errorCallback) {
                 errorCallback(errorMessage);
             }
-        });
+            return;
+        }
+        connectCallback = std::move(callback);
+        this->errorCallback = std::move(errorCallback);
+        // Завершение подключения, даже мгновенного, обрабатывает реактор
+        interest = SocketsReactor::WRITE;
+        reactorId = SocketsReactor::get().add(
+            descriptor, weak_from_this(), interest
+        );
     }
 
     int recv(char* buffer, size_t length) override {
         std::lock_guard lock(mutex);
 
-        if (state != ConnectionState::Connected && readBatch.empty()) {
+        if (state != ConnectionState::Connected && readBuffer.empty()) {
             return -1;
         }
-        int size = std::min(readBatch.size(), length);
-        std::memcpy(buffer, readBatch.data(), size);
-        readBatch.erase(readBatch.begin(), readBatch.begin() + size);
+        int size = readBuffer.read(buffer, length);
+        // Возобновляет приём, приостановленный переполнением буфера
+        updateInterest();
         return size;
     }
 
     int send(const char* buffer, size_t length) override {
-        if (state == ConnectionState::Closed) {
+        std::lock_guard lock(mutex);
+
+        if (state == ConnectionState::Closed || closing) {
             return 0;
         }
-        int len = sendsocket(descriptor, buffer, length, 0);
-        if (len == -1) {
-            int err = errno;
-            close();
-            throw std::runtime_error(
-                "Send failed [errno=" + std::to_string(err) + "]: " + std::string(strerror(err))
-            );
+        size_t sent = 0;
+        if (sendQueue.empty() && state == ConnectionState::Connected) {
+            // Без очереди данные отправляются напрямую, без копирования
+            int len = sendsocket(descriptor, buffer, length, SEND_FLAGS);
+            if (len < 0 && !would_block()) {
+                auto error = handle_socket_error("Send failed");
+                closeSocket();
+                throw error;
+            }
+            sent = std::max(len, 0);
+            totalUpload += sent;
         }
-        totalUpload += len;
-        return len;
+        if (sent < length && queuedBytes < MAX_SEND_QUEUED) {
+            // Медленный получатель не должен раздувать очередь без предела
+            size_t accepted = std::min(length - sent, MAX_SEND_QUEUED - queuedBytes);
+            enqueue(buffer + sent, accepted);
+            updateInterest();
+            sent += accepted;
+        }
+        return sent;
     }
 
     int available() override {
         std::lock_guard lock(mutex);
-        return readBatch.size();
+        return readBuffer.size();
     }
 
     void close(bool discardAll=false) override {
-        {
-            std::lock_guard lock(mutex);
-            readBatch.clear();
-
-            if (state != ConnectionState::Closed) {
-                shutdown(descriptor, SHUT_RDWR);
-                closesocket(descriptor);
+        std::shared_ptr<SocketTcpConnection> self;
+        std::lock_guard lock(mutex);
+        readBuffer.clear();
+        if (!discardAll && state == ConnectionState::Connected && !closing) {
+            flush();
+            if (state == ConnectionState::Connected && !sendQueue.empty()) {
+                // Остаток очереди дописывает реактор; до отправки или
+                // истечения срока соединение удерживает себя само
+                closing = true;
+                lingering = shared_from_this();
+                updateInterest();
+                SocketsReactor::get().setDeadline(
+                    reactorId,
+                    SocketsReactor::clock::now() + CLOSE_LINGER_TIMEOUT
+                );
+                return;
             }
         }
-        if (thread) {
-            thread->join();
-            thread = nullptr;
-        }
+        closeSocket();
+        self = std::move(lingering);
     }
 
     size_t pullUpload() override {
+        std::lock_guard lock(mutex);
         size_t size = totalUpload;
         totalUpload = 0;
         return size;
     }
 
     size_t pullDownload() override {
+        std::lock_guard lock(mutex);
         size_t size = totalDownload;
         totalDownload = 0;
         return size;
@@ -306,25 +583,55 @@ public:
     }
 
     ConnectionState getState() const override {
-        return state;
+        return closing ? ConnectionState::Closed : state.load();
     }
 };
 
-class SocketTcpServer : public TcpServer {
+class SocketTcpServer : public TcpServer,
+                        public SocketsReactor::Handler,
+                        public std::enable_shared_from_this<SocketTcpServer> {
     uint64_t id;
     Network* network;
     SOCKET descriptor;
     std::vector<uint64_t> clients;
     std::mutex clientsMutex;
-    bool open = true;
-    std::unique_ptr<std::thread> thread = nullptr;
+    /// Не даёт закрыть сервер во время приёма клиентов
+    std::mutex mutex;
+    std::atomic<bool> open = true;
+    uint64_t reactorId = 0;
+    ConnectCallback handler;
     int port;
     int maxConnected = -1;
+
+    /// Вызывается под mutex
+    void closeSocket() {
+        if (!open) return;
+
+        logger.info() << "Closing server";
+        open = false;
+
+        {
+            std::lock_guard lock(clientsMutex);
+            for (uint64_t clientid : clients) {
+                if (auto client = network->getConnection(clientid, true)) {
+                    client->close();
+                }
+            }
+            clients.clear();
+        }
+        if (reactorId) {
+            SocketsReactor::get().remove(reactorId);
+            reactorId = 0;
+        }
+        shutdown(descriptor, 2);
+        closesocket(descriptor);
+    }
 public:
     SocketTcpServer(uint64_t id, Network* network, SOCKET descriptor, int port)
     : id(id), network(network), descriptor(descriptor), port(port) {}
 
     ~SocketTcpServer() {
+        std::lock_guard lock(mutex);
         closeSocket();
     }
 
@@ -333,6 +640,7 @@ public:
     }
 
     void update() override {
+        std::lock_guard lock(clientsMutex);
         std::vector<uint64_t> clients;
         for (uint64_t cid : this->clients) {
             if (auto client = network->getConnection(cid, true)) {
@@ -345,63 +653,59 @@ public:
     }
 
     void startListen(ConnectCallback handler) override {
-        thread = std::make_unique<std::thread>([this, handler]() {
-            while (open) {
-                logger.info() << "Listening for connections";
-                if (listen(descriptor, 2) < 0) {
-                    close();
-                    break;
-                }
-                socklen_t addrlen = sizeof(sockaddr_in);
-                SOCKET clientDescriptor;
-                sockaddr_in address;
-                logger.info() << "Accepting clients";
-                if ((clientDescriptor = accept(descriptor, (sockaddr*)&address, &addrlen)) == -1) {
-                    close();
-                    break;
-                }
-                if (maxConnected >= 0 && clients.size() >= maxConnected) {
-                    logger.info() << "Refused connection attemp from " << to_string(address);
-                    closesocket(clientDescriptor);
-                    continue;
-                }
-                logger.info() << "Client connected: " << to_string(address);
-                auto socket = std::make_shared<SocketTcpConnection>(
-                    clientDescriptor, address
-                );
-                socket->startClient();
-                uint64_t id = network->addConnection(socket);
-                {
-                    std::lock_guard lock(clientsMutex);
-                    clients.push_back(id);
-                }
-                handler(this->id, id);
-            }
-        });
+        std::lock_guard lock(mutex);
+        this->handler = std::move(handler);
+        logger.info() << "Listening for connections";
+        if (listen(descriptor, SOMAXCONN) < 0) {
+            auto error = handle_socket_error("listen(...) failed");
+            closeSocket();
+            throw error;
+        }
+        set_nonblocking(descriptor);
+        reactorId = SocketsReactor::get().add(
+            descriptor, weak_from_this(), SocketsReactor::READ
+        );
     }
 
-    void closeSocket() {
-        if (!open) return;
-
-        logger.info() << "Closing server";
-        open = false;
-
-        {
-            std::lock_guard lock(clientsMutex);
-            for (uint64_t clientid : clients) {
-                if (auto client = network->getConnection(clientid, true)) {
-                    client->close();
+    void onSocketEvents(bool, bool) override {
+        std::lock_guard lock(mutex);
+        while (open) {
+            socklen_t addrlen = sizeof(sockaddr_in);
+            SOCKET clientDescriptor;
+            sockaddr_in address;
+            if ((clientDescriptor = accept(descriptor, (sockaddr*)&address, &addrlen)) == -1) {
+                if (!would_block()) {
+                    handle_socket_error("accept(...) failed");
+                    closeSocket();
                 }
+                break;
+            }
+            size_t connected;
+            {
+                std::lock_guard lock(clientsMutex);
+                connected = clients.size();
+            }
+            if (maxConnected >= 0 && connected >= maxConnected) {
+                logger.info() << "Refused connection attemp from " << to_string(address);
+                closesocket(clientDescriptor);
+                continue;
+            }
+            logger.info() << "Client connected: " << to_string(address);
+            auto socket = std::make_shared<SocketTcpConnection>(
+                clientDescriptor, address
+            );
+            socket->startClient();
+            uint64_t id = network->addConnection(socket);
+            {
+                std::lock_guard lock(clientsMutex);
+                clients.push_back(id);
             }
+            handler(this->id, id);
         }
-        clients.clear();
-
-        shutdown(descriptor, 2);
-        closesocket(descriptor);
-        thread->join();
     }
 
     void close() override {
+        std::lock_guard lock(mutex);
         closeSocket();
     }
 
@@ -467,21 +771,39 @@ static sockaddr_in resolve_address_dgram(const std::string& address, int port) {
     return serverAddr;
 }
 
-class SocketUdpConnection : public UdpConnection {
+class SocketUdpConnection : public UdpConnection,
+                            public SocketsReactor::Handler,
+                            public std::enable_shared_from_this<SocketUdpConnection> {
     uint64_t id;
     SOCKET descriptor;
     sockaddr_in addr{};
-    bool open = true;
-    std::unique_ptr<std::thread> thread;
+    std::atomic<bool> open = true;
+    uint64_t reactorId = 0;
+    /// Рекурсивный: обработчик датаграмм может закрыть соединение
+    std::recursive_mutex mutex;
+    util::Buffer<char> buffer;
     ClientDatagramCallback callback;
 
-    size_t totalUpload = 0;
-    size_t totalDownload = 0;
-    ConnectionState state = ConnectionState::Initial;
+    std::atomic<size_t> totalUpload = 0;
+    std::atomic<size_t> totalDownload = 0;
+    std::atomic<ConnectionState> state = ConnectionState::Initial;
 
+    /// Вызывается под mutex
+    void closeSocket() {
+        if (state == ConnectionState::Closed) {
+            return;
+        }
+        if (reactorId) {
+            SocketsReactor::get().remove(reactorId);
+            reactorId = 0;
+        }
+        shutdown(descriptor, 2);
+        closesocket(descriptor);
+        state = ConnectionState::Closed;
+    }
 public:
     SocketUdpConnection(uint64_t id, SOCKET descriptor, sockaddr_in addr)
-        : id(id), descriptor(descriptor), addr(std::move(addr)) {}
+        : id(id), descriptor(descriptor), addr(std::move(addr)), buffer(16'384) {}
 
     ~SocketUdpConnection() override {
         SocketUdpConnection::close();
@@ -516,34 +838,43 @@ public:
     }
 
     void connect(ClientDatagramCallback handler) override {
+        std::lock_guard lock(mutex);
         callback = std::move(handler);
         state = ConnectionState::Connected;
+        set_nonblocking(descriptor);
+        reactorId = SocketsReactor::get().add(
+            descriptor, weak_from_this(), SocketsReactor::READ
+        );
+    }
 
-        thread = std::make_unique<std::thread>([this]() {
-            util::Buffer<char> buffer(16'384);
-            while (open) {
-                int size = recv(descriptor, buffer.data(), buffer.size(), 0);
-                if (size <= 0) {
+    void onSocketEvents(bool, bool) override {
+        std::lock_guard lock(mutex);
+        while (open && state == ConnectionState::Connected) {
+            int size = ::recv(descriptor, buffer.data(), buffer.size(), 0);
+            if (size < 0) {
+                if (!would_block()) {
                     logger.error() << "UDP connection " << id << ": " << handle_socket_error(" recv error").what();
-                    if (!open) break;
-                    closesocket(descriptor);
-                    state = ConnectionState::Closed;
-                    break;
-                }
-                totalDownload += size;
-                if (callback) {
-                    callback(id, buffer.data(), size);
+                    closeSocket();
                 }
+                break;
+            }
+            totalDownload += size;
+            if (callback) {
+                callback(id, buffer.data(), size);
             }
-        });
+        }
     }
 
     int send(const char* buffer, size_t length) override {
-        int len = ::send(descriptor, buffer, length, 0);
+        int len = ::send(descriptor, buffer, length, SEND_FLAGS);
         if (len < 0) {
+            // Переполненный буфер отправки: датаграмма отбрасывается
+            if (would_block()) {
+                return 0;
+            }
             auto err = handle_socket_error(" send failed");
-            closesocket(descriptor);
-            state = ConnectionState::Closed;
+            std::lock_guard lock(mutex);
+            closeSocket();
             logger.error() << "UDP connection " << id << ": " << err.what();
         } else totalUpload += len;
 
@@ -555,28 +886,16 @@ public:
         open = false;
         logger.info() << "Closing UDP connection " << id;
 
-        if (state != ConnectionState::Closed) {
-            shutdown(descriptor, 2);
-            closesocket(descriptor);
-        }
-
-        if (thread) {
-            thread->join();
-            thread.reset();
-        }
-        state = ConnectionState::Closed;
+        std::lock_guard lock(mutex);
+        closeSocket();
     }
 
     size_t pullUpload() override {
-        size_t s = totalUpload;
-        totalUpload = 0;
-        return s;
+        return totalUpload.exchange(0);
     }
 
     size_t pullDownload() override {
-        size_t s = totalDownload;
-        totalDownload = 0;
-        return s;
+        return totalDownload.exchange(0);
     }
 
     [[nodiscard]] int getPort() const override {
@@ -592,16 +911,21 @@ public:
     }
 };
 
-class SocketUdpServer : public UdpServer {
+class SocketUdpServer : public UdpServer,
+                        public SocketsReactor::Handler,
+                        public std::enable_shared_from_this<SocketUdpServer> {
     uint64_t id;
     SOCKET descriptor;
-    bool open = true;
-    std::unique_ptr<std::thread> thread = nullptr;
+    std::atomic<bool> open = true;
+    uint64_t reactorId = 0;
+    /// Рекурсивный: обработчик датаграмм может закрыть сервер
+    std::recursive_mutex mutex;
+    util::Buffer<char> buffer;
     int port;
     ServerDatagramCallback callback;
 public:
     SocketUdpServer(uint64_t id, Network* network, SOCKET descriptor, int port)
-        : id(id), descriptor(descriptor), port(port) {}
+        : id(id), descriptor(descriptor), buffer(16'384), port(port) {}
 
     ~SocketUdpServer() override {
         SocketUdpServer::close();
@@ -610,44 +934,51 @@ public:
     void update() override {}
 
     void startListen(ServerDatagramCallback handler) override {
+        std::lock_guard lock(mutex);
         callback = std::move(handler);
+        set_nonblocking(descriptor);
+        reactorId = SocketsReactor::get().add(
+            descriptor, weak_from_this(), SocketsReactor::READ
+        );
+    }
 
-        thread = std::make_unique<std::thread>([this]() {
-            util::Buffer<char> buffer(16384);
-            sockaddr_in clientAddr{};
+    void onSocketEvents(bool, bool) override {
+        std::lock_guard lock(mutex);
+        sockaddr_in clientAddr{};
+        while (open) {
             socklen_t addrlen = sizeof(clientAddr);
+            int size = recvfrom(descriptor, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&clientAddr), &addrlen);
+            if (size < 0) {
+                break;
+            }
 
-            while (open) {
-                int size = recvfrom(descriptor, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&clientAddr), &addrlen);
-                if (size <= 0) {
-                    if (!open) break;
-                    continue;
-                }
-
-                std::string addrStr = to_string(clientAddr, false);
-                int port = ntohs(clientAddr.sin_port);
+            std::string addrStr = to_string(clientAddr, false);
+            int port = ntohs(clientAddr.sin_port);
 
-                callback(id, addrStr, port, buffer.data(), size);
-            }
-        });
+            callback(id, addrStr, port, buffer.data(), size);
+        }
     }
 
     void sendTo(const std::string& addr, int port, const char* buffer, size_t length) override {
         sockaddr_in client = resolve_address_dgram(addr, port);
-        if (sendto(descriptor, buffer, length, 0, reinterpret_cast<sockaddr*>(&client), sizeof(client)) < 0) {
-            handle_socket_error("sendto");
+        if (sendto(descriptor, buffer, length, SEND_FLAGS, reinterpret_cast<sockaddr*>(&client), sizeof(client)) < 0) {
+            if (!would_block()) {
+                handle_socket_error("sendto");
+            }
         }
     }
 
     void close() override {
         if (!open) return;
         open = false;
+
+        std::lock_guard lock(mutex);
+        if (reactorId) {
+            SocketsReactor::get().remove(reactorId);
+            reactorId = 0;
+        }
         shutdown(descriptor, 2);
         closesocket(descriptor);
-        if (thread) {
-            thread->join();
-            thread = nullptr;
-        }
     }
 
     bool isOpen() override { return open; }
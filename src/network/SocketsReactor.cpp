@@ -0,0 +1,362 @@
+#include <network/SocketsReactor.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#define USE_EPOLL
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+#include <debug/Logger.h>
+
+static debug::Logger logger("sockets-reactor");
+
+using namespace network;
+
+/// Максимум событий, выбираемых за одно ожидание
+inline constexpr int MAX_EVENTS = 256;
+
+/// Идентификатор пробуждающего дескриптора
+inline constexpr uint64_t WAKE_ID = 0;
+
+#ifdef USE_EPOLL
+
+static uint32_t to_epoll_events(int interest) {
+    uint32_t events = 0;
+    if (interest & SocketsReactor::READ) events |= EPOLLIN | EPOLLRDHUP;
+    if (interest & SocketsReactor::WRITE) events |= EPOLLOUT;
+    return events;
+}
+
+SocketsReactor::SocketsReactor() {
+    pollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (pollDescriptor == -1) {
+        throw std::runtime_error("epoll_create1 failed");
+    }
+    wakeDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeDescriptor == -1) {
+        close(pollDescriptor);
+        throw std::runtime_error("eventfd failed");
+    }
+    epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_ID;
+    epoll_ctl(pollDescriptor, EPOLL_CTL_ADD, wakeDescriptor, &event);
+    thread = std::thread([this]() { run(); });
+}
+
+SocketsReactor::~SocketsReactor() {
+    running = false;
+    wake();
+    thread.join();
+    close(wakeDescriptor);
+    close(pollDescriptor);
+}
+
+void SocketsReactor::wake() {
+    uint64_t value = 1;
+    [[maybe_unused]] auto res = write(wakeDescriptor, &value, sizeof(value));
+}
+
+uint64_t SocketsReactor::add(
+    socket_t descriptor, std::weak_ptr<Handler> handler, int interest
+) {
+    std::lock_guard lock(mutex);
+    uint64_t id = nextId++;
+    epoll_event event {};
+    event.events = to_epoll_events(interest);
+    event.data.u64 = id;
+    if (epoll_ctl(pollDescriptor, EPOLL_CTL_ADD, descriptor, &event)) {
+        throw std::runtime_error(
+            "epoll_ctl(ADD) failed [errno=" + std::to_string(errno) + "]"
+        );
+    }
+    entries[id] = Entry {descriptor, std::move(handler), interest};
+    return id;
+}
+
+void SocketsReactor::modify(uint64_t id, int interest) {
+    std::lock_guard lock(mutex);
+    auto found = entries.find(id);
+    if (found == entries.end() || found->second.interest == interest) {
+        return;
+    }
+    found->second.interest = interest;
+    epoll_event event {};
+    event.events = to_epoll_events(interest);
+    event.data.u64 = id;
+    epoll_ctl(pollDescriptor, EPOLL_CTL_MOD, found->second.descriptor, &event);
+}
+
+void SocketsReactor::remove(uint64_t id) {
+    std::lock_guard lock(mutex);
+    auto found = entries.find(id);
+    if (found == entries.end()) {
+        return;
+    }
+    epoll_ctl(pollDescriptor, EPOLL_CTL_DEL, found->second.descriptor, nullptr);
+    entries.erase(found);
+    deadlines.erase(id);
+}
+
+void SocketsReactor::run() {
+    epoll_event events[MAX_EVENTS];
+    while (running) {
+        int count = epoll_wait(
+            pollDescriptor, events, MAX_EVENTS, getWaitTimeout()
+        );
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            logger.error() << "epoll_wait failed [errno=" << errno << "]";
+            break;
+        }
+        for (int i = 0; i < count; ++i) {
+            const auto& event = events[i];
+            if (event.data.u64 == WAKE_ID) {
+                uint64_t value;
+                [[maybe_unused]] auto res =
+                    read(wakeDescriptor, &value, sizeof(value));
+                continue;
+            }
+            bool failed = event.events & (EPOLLERR | EPOLLHUP);
+            dispatch(
+                event.data.u64,
+                failed || (event.events & (EPOLLIN | EPOLLRDHUP)),
+                failed || (event.events & EPOLLOUT)
+            );
+        }
+        dispatchDeadlines();
+    }
+}
+
+#else // poll
+
+#ifdef _WIN32
+#define poll WSAPoll
+using pollfd_t = WSAPOLLFD;
+static inline int close_wake_socket(socket_t descriptor) {
+    return closesocket(descriptor);
+}
+#else
+using pollfd_t = pollfd;
+static inline int close_wake_socket(socket_t descriptor) {
+    return close(descriptor);
+}
+#endif
+
+/// Пробуждение poll: UDP-сокет, подключённый к самому себе
+static socket_t create_wake_socket() {
+    socket_t descriptor = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t len = sizeof(address);
+    if (bind(descriptor, (sockaddr*)&address, sizeof(address)) < 0 ||
+        getsockname(descriptor, (sockaddr*)&address, &len) < 0 ||
+        connect(descriptor, (sockaddr*)&address, sizeof(address)) < 0) {
+        close_wake_socket(descriptor);
+        throw std::runtime_error("could not create reactor wake socket");
+    }
+#ifdef _WIN32
+    u_long mode = 1;
+    ioctlsocket(descriptor, FIONBIO, &mode);
+#else
+    fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+#endif
+    return descriptor;
+}
+
+SocketsReactor::SocketsReactor() {
+    pollDescriptor = wakeDescriptor = create_wake_socket();
+    thread = std::thread([this]() { run(); });
+}
+
+SocketsReactor::~SocketsReactor() {
+    running = false;
+    wake();
+    thread.join();
+    close_wake_socket(wakeDescriptor);
+}
+
+void SocketsReactor::wake() {
+    char value = 1;
+    send(wakeDescriptor, &value, 1, 0);
+}
+
+uint64_t SocketsReactor::add(
+    socket_t descriptor, std::weak_ptr<Handler> handler, int interest
+) {
+    uint64_t id;
+    {
+        std::lock_guard lock(mutex);
+        id = nextId++;
+        entries[id] = Entry {descriptor, std::move(handler), interest};
+    }
+    wake();
+    return id;
+}
+
+void SocketsReactor::modify(uint64_t id, int interest) {
+    {
+        std::lock_guard lock(mutex);
+        auto found = entries.find(id);
+        if (found == entries.end() || found->second.interest == interest) {
+            return;
+        }
+        found->second.interest = interest;
+    }
+    wake();
+}
+
+void SocketsReactor::remove(uint64_t id) {
+    {
+        std::lock_guard lock(mutex);
+        entries.erase(id);
+        deadlines.erase(id);
+    }
+    wake();
+}
+
+void SocketsReactor::run() {
+    std::vector<pollfd_t> fds;
+    std::vector<uint64_t> ids;
+    while (running) {
+        fds.clear();
+        ids.clear();
+        fds.push_back(pollfd_t {wakeDescriptor, POLLIN, 0});
+        ids.push_back(WAKE_ID);
+        {
+            std::lock_guard lock(mutex);
+            for (const auto& [id, entry] : entries) {
+                short events = 0;
+                if (entry.interest & READ) events |= POLLIN;
+                if (entry.interest & WRITE) events |= POLLOUT;
+                fds.push_back(pollfd_t {entry.descriptor, events, 0});
+                ids.push_back(id);
+            }
+        }
+        int count = poll(fds.data(), fds.size(), getWaitTimeout());
+        if (count < 0) {
+#ifndef _WIN32
+            if (errno == EINTR) continue;
+#endif
+            logger.error() << "poll failed";
+            break;
+        }
+        for (size_t i = 0; i < fds.size() && count > 0; ++i) {
+            const auto& fd = fds[i];
+            if (fd.revents == 0) continue;
+            count--;
+            if (ids[i] == WAKE_ID) {
+                char buffer[64];
+                while (recv(wakeDescriptor, buffer, sizeof(buffer), 0) > 0);
+                continue;
+            }
+            bool failed = fd.revents & (POLLERR | POLLHUP);
+            dispatch(
+                ids[i],
+                failed || (fd.revents & POLLIN),
+                failed || (fd.revents & POLLOUT)
+            );
+        }
+        dispatchDeadlines();
+    }
+}
+
+#endif // USE_EPOLL
+
+void SocketsReactor::dispatch(uint64_t id, bool readable, bool writable) {
+    std::shared_ptr<Handler> handler;
+    {
+        std::lock_guard lock(mutex);
+        auto found = entries.find(id);
+        if (found == entries.end()) {
+            return;
+        }
+        handler = found->second.handler.lock();
+    }
+    if (handler) {
+        handler->onSocketEvents(readable, writable);
+    }
+}
+
+void SocketsReactor::setDeadline(uint64_t id, clock::time_point deadline) {
+    {
+        std::lock_guard lock(mutex);
+        if (entries.find(id) == entries.end()) {
+            return;
+        }
+        deadlines[id] = deadline;
+    }
+    wake();
+}
+
+int SocketsReactor::getWaitTimeout() {
+    std::lock_guard lock(mutex);
+    if (deadlines.empty()) {
+        return -1;
+    }
+    auto nearest = clock::time_point::max();
+    for (const auto& [_, deadline] : deadlines) {
+        nearest = std::min(nearest, deadline);
+    }
+    auto now = clock::now();
+    if (nearest <= now) {
+        return 0;
+    }
+    // Округление вверх, чтобы не проснуться раньше срока
+    auto ms = std::chrono::ceil<std::chrono::milliseconds>(nearest - now);
+    return static_cast<int>(std::min<int64_t>(ms.count(), INT32_MAX));
+}
+
+void SocketsReactor::dispatchDeadlines() {
+    std::vector<std::shared_ptr<Handler>> expired;
+    {
+        std::lock_guard lock(mutex);
+        if (deadlines.empty()) {
+            return;
+        }
+        auto now = clock::now();
+        for (auto it = deadlines.begin(); it != deadlines.end();) {
+            if (it->second > now) {
+                ++it;
+                continue;
+            }
+            auto found = entries.find(it->first);
+            if (found != entries.end()) {
+                if (auto handler = found->second.handler.lock()) {
+                    expired.push_back(std::move(handler));
+                }
+            }
+            it = deadlines.erase(it);
+        }
+    }
+    for (const auto& handler : expired) {
+        handler->onDeadline();
+    }
+}
+
+SocketsReactor& SocketsReactor::get() {
+    static SocketsReactor reactor;
+    return reactor;
+}
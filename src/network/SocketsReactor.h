@@ -0,0 +1,92 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include <typedefs.h>
+
+namespace network {
+#ifdef _WIN32
+    using socket_t = uintptr_t;
+#else
+    using socket_t = int;
+#endif
+
+    /// @brief Цикл событий сокетов в одном потоке ввода-вывода.
+    /// Использует epoll в Linux и poll (WSAPoll) на остальных платформах.
+    /// Сокеты должны быть неблокирующими; события level-triggered.
+    class SocketsReactor {
+    public:
+        enum Interest : int {
+            READ = 1,
+            WRITE = 2,
+        };
+
+        class Handler {
+        public:
+            virtual ~Handler() = default;
+
+            /// @brief Вызывается в потоке реактора.
+            /// Ошибки и закрытие сокета сообщаются как готовность к чтению
+            /// и записи, чтобы обработчик получил их из recv/send
+            virtual void onSocketEvents(bool readable, bool writable) = 0;
+
+            /// @brief Вызывается в потоке реактора по наступлении срока,
+            /// заданного setDeadline
+            virtual void onDeadline() {}
+        };
+
+        using clock = std::chrono::steady_clock;
+
+        SocketsReactor();
+        ~SocketsReactor();
+
+        /// @brief Регистрирует сокет. Реактор не владеет обработчиком
+        /// @return идентификатор регистрации (никогда не переиспользуется)
+        uint64_t add(
+            socket_t descriptor, std::weak_ptr<Handler> handler, int interest
+        );
+
+        void modify(uint64_t id, int interest);
+
+        /// @brief Снимает сокет с регистрации. Должен вызываться до закрытия
+        /// сокета. Обработчик ещё может получить уже выбранные события
+        void remove(uint64_t id);
+
+        /// @brief Задаёт однократный срок, по наступлении которого
+        /// обработчик получит onDeadline. Срок снимается вместе с remove
+        void setDeadline(uint64_t id, clock::time_point deadline);
+
+        /// @brief Общий реактор, запускаемый при первом обращении
+        static SocketsReactor& get();
+    private:
+        struct Entry {
+            socket_t descriptor;
+            std::weak_ptr<Handler> handler;
+            int interest;
+        };
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+        /// Сроки немногих сокетов, ожидающих onDeadline
+        std::unordered_map<uint64_t, clock::time_point> deadlines;
+        uint64_t nextId = 1;
+        std::atomic<bool> running = true;
+        /// epoll или пробуждающий сокет poll
+        socket_t pollDescriptor;
+        socket_t wakeDescriptor;
+        std::thread thread;
+
+        void wake();
+        void run();
+        void dispatch(uint64_t id, bool readable, bool writable);
+        /// @return время ожидания событий до ближайшего срока в мс;
+        /// -1 - без ограничения
+        int getWaitTimeout();
+        void dispatchDeadlines();
+    };
+}
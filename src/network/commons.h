@@ -59,8 +59,12 @@ namespace network {
     public:
         virtual ~Connection() = default;
 
+        /// @brief Закрывает соединение. Без discardAll неотправленные данные
+        /// TCP ещё дописываются в фоне, ограниченное время
         virtual void close(bool discardAll=false) = 0;
 
+        /// @return число принятых к отправке байт; меньше length, если
+        /// очередь отправки заполнена
         virtual int send(const char* buffer, size_t length) = 0;
 
         virtual size_t pullUpload() = 0;
@@ -25,6 +25,8 @@
 #include <graphics/core/DrawContext.h>
 #include <objects/Entt_Entity.h>
 #include <math/util.h>
+#include <coders/binary_json.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("entities");
 
@@ -55,6 +57,19 @@ entityid_t Entities::spawn(
     dv::value args,
     dv::value saved,
     entityid_t uid
+) {
+    entityid_t id = create(def, position, uid);
+    dv::value componentsMap = nullptr;
+    if (saved != nullptr) {
+        componentsMap = saved["comps"];
+        loadEntity(saved, get(id).value());
+    }
+    finishSpawn(def, id, std::move(args), componentsMap);
+    return id;
+}
+
+entityid_t Entities::create(
+    const Entity& def, glm::vec3 position, entityid_t uid
 ) {
     rigging::SkeletonConfig* skeleton = nullptr;
     if (assets) {
@@ -82,7 +97,7 @@ entityid_t Entities::spawn(
     entities[id] = entity;
     uids[entity] = id;
     registry->emplace<EntityId>(entity, id, def);
-    const auto& tsf = registry->emplace<Transform>(
+    registry->emplace<Transform>(
         entity,
         position,
         glm::vec3(1.0f),
@@ -109,20 +124,26 @@ entityid_t Entities::spawn(
         );
         scripting.components.emplace_back(std::move(component));
     }
-    dv::value componentsMap = nullptr;
-    if (saved != nullptr) {
-        componentsMap = saved["comps"];
-        loadEntity(saved, get(id).value());
-    }
+    return id;
+}
+
+void Entities::finishSpawn(
+    const Entity& def,
+    entityid_t id,
+    dv::value args,
+    const dv::value& componentsMap
+) {
+    auto entity = entities.at(id);
+    const auto& tsf = registry->get<Transform>(entity);
+    auto& body = registry->get<Rigidbody>(entity);
     body.hitbox.position = tsf.pos;
     scripting::on_entity_spawn(
         def,
         id,
-        scripting.components,
+        registry->get<ScriptComponents>(entity).components,
         args,
         componentsMap
     );
-    return id;
 }
 
 void Entities::despawn(entityid_t id) {
@@ -165,16 +186,91 @@ void Entities::loadEntity(const dv::value& map, Entt_Entity entity) {
     }
 }
 
-void Entities::loadEntities(dv::value root) {
+void Entities::loadEntity(json::BinaryReader& reader) {
+    // Порядок полей не гарантирован, а def и uid нужны для создания
+    // сущности: сначала они ищутся с пропуском остальных полей
+    size_t start = reader.position();
+    std::string defname;
+    entityid_t uid = 0;
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "def") {
+            defname = reader.readString();
+        } else if (key == "uid") {
+            uid = reader.readInteger();
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+
+    auto& def = level.content.entities.require(defname);
+    entityid_t id = create(def, {}, uid);
+    dv::value componentsMap = nullptr;
+    reader.seek(start);
+    loadEntity(reader, get(id).value(), componentsMap);
+    finishSpawn(def, id, nullptr, componentsMap);
+}
+
+void Entities::loadEntity(
+    json::BinaryReader& reader, Entt_Entity entity, dv::value& componentsMap
+) {
+    auto& transform = entity.getTransform();
+    auto& body = entity.getRigidbody();
+    auto skeleton = entity.getSkeleton();
+
+    std::string skeletonName;
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == COMP_TRANSFORM) {
+            transform.deserialize(reader);
+        } else if (key == COMP_RIGIDBODY) {
+            body.deserialize(reader);
+        } else if (key == "comps") {
+            componentsMap = reader.readValue();
+        } else if (key == "skeleton-name") {
+            skeletonName = reader.readString();
+        } else if (key == COMP_SKELETON && skeleton && skeleton->config) {
+            skeleton->deserialize(reader);
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+
+    if (skeleton == nullptr || skeleton->config == nullptr) return;
+    if (!skeletonName.empty() && skeletonName != skeleton->config->getName()) {
+        skeleton->config = assets->getShared<rigging::SkeletonConfig>(skeletonName);
+    }
+}
+
+bool Entities::loadEntities(json::BinaryReader& reader) {
     clean();
-    const auto& list = root["data"];
-    for (auto& map : list) {
-        try {
-            loadEntity(map);
-        } catch (const std::runtime_error& err) {
-            logger.error() << "Could not read entity: " << err.what();
+    bool empty = true;
+    reader.beginObject();
+    while (reader.hasNext()) {
+        empty = false;
+        if (reader.readKey() != "data") {
+            reader.skipValue();
+            continue;
         }
+        reader.beginList();
+        while (reader.hasNext()) {
+            size_t start = reader.position();
+            try {
+                loadEntity(reader);
+            } catch (const std::runtime_error& err) {
+                logger.error() << "Could not read entity: " << err.what();
+                reader.seek(start);
+                reader.skipValue();
+            }
+        }
+        reader.endList();
     }
+    reader.endObject();
+    return !empty;
 }
 
 std::optional<Entities::RaycastResult> Entities::rayCast(
@@ -225,6 +321,7 @@ void Entities::onSave(const Entt_Entity& entity) {
 }
 
 void Entities::update(float deltaTime) {
+    PROFILE_ZONE("entities.update");
     if (int parts = updateSparkClock.update(deltaTime)) {
         for (int i = 0; i < parts; ++i) {
             scripting::on_entities_update(
@@ -395,6 +492,7 @@ void Entities::preparePhysics(float delta) {
 }
 
 void Entities::updatePhysics(float delta) {
+    PROFILE_ZONE("entities.physics");
     preparePhysics(delta);
 
     auto view = registry->view<EntityId, Transform, Rigidbody>();
@@ -429,17 +527,17 @@ void Entities::updatePhysics(float delta) {
     }
 }
 
-dv::value Entities::serialize(const std::vector<Entt_Entity>& entities) {
-    auto list = dv::list();
+void Entities::serialize(
+    const std::vector<Entt_Entity>& entities, json::BinaryWriter& writer
+) {
     for (auto& entity : entities) {
         const EntityId& eid = entity.getID();
         if (!entity.getDef().save.enabled || eid.destroyFlag) continue;
         level.entities->onSave(entity);
         if (!eid.destroyFlag) {
-            list.add(entity.serialize());
+            entity.serialize(writer);
         }
     }
-    return list;
 }
 
 void Entities::despawn(std::vector<Entt_Entity> entities) {
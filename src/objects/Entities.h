@@ -29,6 +29,10 @@ namespace rigging {
     class SkeletonConfig;
 }
 class DrawContext;
+namespace json {
+    class BinaryWriter;
+    class BinaryReader;
+}
 
 class Entities final {
     std::unique_ptr<entt::registry> registry;
@@ -44,6 +48,20 @@ class Entities final {
         Rigidbody& body, const Transform& tsf, std::vector<Sensor*>& sensors
     );
     void preparePhysics(float deltaTime);
+
+    /// Создаёт сущность без загрузки сохранённых данных и событий скриптов
+    entityid_t create(const Entity& def, glm::vec3 position, entityid_t uid);
+    void finishSpawn(
+        const Entity& def,
+        entityid_t id,
+        dv::value args,
+        const dv::value& componentsMap
+    );
+    void loadEntity(
+        json::BinaryReader& reader,
+        Entt_Entity entity,
+        dv::value& componentsMap
+    );
 public:
     Entities(Level& level);
 
@@ -93,7 +111,10 @@ public:
         const RaycastSettings& settings
     );
 
-    void loadEntities(dv::value map);
+    /// @brief Загружает сущности чанка из BJSON без построения дерева dv
+    /// @return false, если документ пуст
+    bool loadEntities(json::BinaryReader& reader);
+    void loadEntity(json::BinaryReader& reader);
     void loadEntity(const dv::value& map);
     void loadEntity(const dv::value& map, Entt_Entity entity);
     void onSave(const Entt_Entity& entity);
@@ -102,7 +123,10 @@ public:
     std::vector<Entt_Entity> getAllInside(AABB aabb);
     std::vector<Entt_Entity> getAllInRadius(glm::vec3 center, float radius);
 
-    dv::value serialize(const std::vector<Entt_Entity>& entities);
+    /// @brief Записывает сохраняемые сущности элементами текущего списка
+    void serialize(
+        const std::vector<Entt_Entity>& entities, json::BinaryWriter& writer
+    );
 
     void setNextID(entityid_t id) {
         nextID = id;
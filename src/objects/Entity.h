@@ -9,10 +9,7 @@
 #include <math/AABB.h>
 #include <physics/Hitbox.h>
 #include <data/dv.h>
-
-namespace rigging {
-    class SkeletonConfig;
-}
+#include <objects/rigging.h>
 
 struct ComponentInstance {
     std::string component;
@@ -38,10 +35,7 @@ struct Entity {
 
     struct {
         bool enabled = true;
-        struct {
-            bool textures = false;
-            bool pose = false;
-        } skeleton;
+        rigging::SkeletonSaveFlags skeleton;
         struct {
             bool velocity = true;
             bool settings = true;
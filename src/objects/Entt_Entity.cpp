@@ -9,6 +9,7 @@
 #include <objects/Entity.h>
 #include <objects/rigging.h>
 #include <logic/scripting/scripting.h>
+#include <coders/binary_json.h>
 
 static inline std::string SAVED_DATA_VARNAME = "SAVED_DATA";
 
@@ -42,7 +43,7 @@ void Entt_Entity::setRig(std::shared_ptr<const rigging::SkeletonConfig> rigConfi
     skeleton.setConfig(std::move(rigConfig));
 }
 
-dv::value Entt_Entity::serialize() const {
+void Entt_Entity::serialize(json::BinaryWriter& writer) const {
     const auto& eid = getID();
     const auto& def = eid.def;
     const auto& transform = getTransform();
@@ -50,34 +51,37 @@ dv::value Entt_Entity::serialize() const {
     auto skeleton = getSkeleton();
     const auto& scripts = getScripting();
 
-    auto root = dv::object();
-    root["def"] = def.name;
-    root["uid"] = eid.uid;
+    writer.beginObject();
+    writer.put("def", def.name);
+    writer.put("uid", eid.uid);
 
-    root[COMP_TRANSFORM] = transform.serialize();
-    root[COMP_RIGIDBODY] =
-        rigidbody.serialize(def.save.body.velocity, def.save.body.settings);
+    writer.putKey(COMP_TRANSFORM);
+    transform.serialize(writer);
+    writer.putKey(COMP_RIGIDBODY);
+    rigidbody.serialize(
+        writer, def.save.body.velocity, def.save.body.settings
+    );
 
     if (skeleton != nullptr && skeleton->config != nullptr) {
         if (skeleton->config->getName() != def.skeletonName) {
-            root["skeleton-name"] = skeleton->config->getName();
+            writer.put("skeleton-name", skeleton->config->getName());
         }
         if (def.save.skeleton.pose || def.save.skeleton.textures) {
-            root[COMP_SKELETON] = skeleton->serialize(
-                def.save.skeleton.pose, def.save.skeleton.textures
-            );
+            writer.putKey(COMP_SKELETON);
+            skeleton->serialize(writer, def.save.skeleton);
         }
     }
     if (!scripts.components.empty()) {
-        auto& compsMap = root.object("comps");
+        writer.beginObject("comps");
         for (auto& comp : scripts.components) {
             if (comp->env == nullptr) continue;
             auto data =
                 scripting::get_component_value(comp->env, SAVED_DATA_VARNAME);
-            compsMap[comp->name] = data;
+            writer.put(comp->name, data);
         }
+        writer.endObject();
     }
-    return root;
+    writer.endObject();
 }
 
 EntityId& Entt_Entity::getID() const {
@@ -23,6 +23,10 @@ namespace rigging {
     class SkeletonConfig;
 }
 
+namespace json {
+    class BinaryWriter;
+}
+
 struct EntityId {
     entityid_t uid;
     const Entity& def;
@@ -46,7 +50,7 @@ public:
         registry(registry),
         entity(entity) {}
 
-    dv::value serialize() const;
+    void serialize(json::BinaryWriter& writer) const;
 
     EntityId& getID() const;
 
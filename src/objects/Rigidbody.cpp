@@ -5,27 +5,30 @@
 #include <objects/Entity.h>
 #include <objects/Entities.h>
 #include <objects/Entt_Entity.h>
+#include <coders/binary_json.h>
 #include <data/dv_util.h>
 #include <logic/scripting/scripting.h>
 
-dv::value Rigidbody::serialize(bool saveVelocity, bool saveBodySettings) const {
-    auto bodymap = dv::object();
+void Rigidbody::serialize(
+    json::BinaryWriter& writer, bool saveVelocity, bool saveBodySettings
+) const {
+    writer.beginObject();
     if (!enabled) {
-        bodymap["enabled"] = false;
+        writer.put("enabled", false);
     }
     if (saveVelocity) {
-        bodymap["vel"] = dv::to_value(hitbox.velocity);
+        writer.putVec("vel", hitbox.velocity);
     }
     if (saveBodySettings) {
-        bodymap["damping"] = hitbox.linearDamping;
-        bodymap["type"] = BodyTypeMeta.getNameString(hitbox.type);
+        writer.put("damping", hitbox.linearDamping);
+        writer.put("type", BodyTypeMeta.getNameString(hitbox.type));
         if (hitbox.crouching) {
-            bodymap["crouch"] = hitbox.crouching;
+            writer.put("crouch", hitbox.crouching);
         }
-        bodymap["mass"] = mass;
-        bodymap["elasticity"] = elasticity;
+        writer.put("mass", mass);
+        writer.put("elasticity", elasticity);
     }
-    return bodymap;
+    writer.endObject();
 }
 
 void Rigidbody::deserialize(const dv::value& root) {
@@ -33,10 +36,33 @@ void Rigidbody::deserialize(const dv::value& root) {
     std::string bodyTypeName;
     root.at("type").get(bodyTypeName);
     BodyTypeMeta.getItem(bodyTypeName, hitbox.type);
-    root["crouch"].asBoolean(hitbox.crouching);
-    root["damping"].asNumber(hitbox.linearDamping);
-    root["mass"].asNumber(mass);
-    root["elasticity"].asNumber(elasticity);
+    root.at("crouch").get(hitbox.crouching);
+    root.at("damping").get(hitbox.linearDamping);
+    root.at("mass").get(mass);
+    root.at("elasticity").get(elasticity);
+}
+
+void Rigidbody::deserialize(json::BinaryReader& reader) {
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "vel") {
+            reader.readVec(hitbox.velocity);
+        } else if (key == "type") {
+            BodyTypeMeta.getItem(reader.readString(), hitbox.type);
+        } else if (key == "crouch") {
+            hitbox.crouching = reader.readBoolean();
+        } else if (key == "damping") {
+            hitbox.linearDamping = reader.readNumber();
+        } else if (key == "mass") {
+            mass = reader.readNumber();
+        } else if (key == "elasticity") {
+            elasticity = reader.readNumber();
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
 }
 
 template <void (*callback)(const Entt_Entity&, size_t, entityid_t)>
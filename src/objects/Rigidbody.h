@@ -10,6 +10,11 @@
 class Entities;
 struct Entity;
 
+namespace json {
+    class BinaryWriter;
+    class BinaryReader;
+}
+
 struct Rigidbody {
     bool enabled = true;
     Hitbox hitbox;
@@ -17,8 +22,11 @@ struct Rigidbody {
     float mass;
     float elasticity;
 
-    dv::value serialize(bool saveVelocity, bool saveBodySettings) const;
+    void serialize(
+        json::BinaryWriter& writer, bool saveVelocity, bool saveBodySettings
+    ) const;
     void deserialize(const dv::value& root);
+    void deserialize(json::BinaryReader& reader);
 
     void initialize(
         const Entity& def,
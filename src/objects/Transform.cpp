@@ -2,6 +2,7 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <coders/binary_json.h>
 #include <data/dv_util.h>
 #include <math/util.h>
 #include <debug/Logger.h>
@@ -18,16 +19,16 @@ void Transform::refresh() {
     dirty = false;
 }
 
-dv::value Transform::serialize() const {
-    auto tsfmap = dv::object();
-    tsfmap["pos"] = dv::to_value(pos);
+void Transform::serialize(json::BinaryWriter& writer) const {
+    writer.beginObject();
+    writer.putVec("pos", pos);
     if (size != glm::vec3(1.0f)) {
-        tsfmap["size"] = dv::to_value(size);
+        writer.putVec("size", size);
     }
     if (rot != glm::mat3(1.0f)) {
-        tsfmap["rot"] = dv::to_value(rot);
+        writer.putVec("rot", rot);
     }
-    return tsfmap;
+    writer.endObject();
 }
 
 void Transform::deserialize(const dv::value& root) {
@@ -36,6 +37,23 @@ void Transform::deserialize(const dv::value& root) {
     dv::get_mat(root, "rot", rot);
 }
 
+void Transform::deserialize(json::BinaryReader& reader) {
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "pos") {
+            reader.readVec(pos);
+        } else if (key == "size") {
+            reader.readVec(size);
+        } else if (key == "rot") {
+            reader.readVec(rot);
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+}
+
 bool Transform::checkValue(const glm::vec3& vector, std::string_view name) {
     if (util::is_nan_or_inf(vector)) {
         auto message = 
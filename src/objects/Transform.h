@@ -10,6 +10,11 @@
 
 #include <data/dv_fwd.h>
 
+namespace json {
+    class BinaryWriter;
+    class BinaryReader;
+}
+
 struct Transform {
     static inline constexpr float EPSILON = 1e-7f;
     glm::vec3 pos;
@@ -21,8 +26,9 @@ struct Transform {
     glm::vec3 displayPos;
     glm::vec3 displaySize;
 
-    dv::value serialize() const;
+    void serialize(json::BinaryWriter& writer) const;
     void deserialize(const dv::value& root);
+    void deserialize(json::BinaryReader& reader);
 
     void refresh();
 
@@ -6,6 +6,7 @@
 #include <assets/Assets.h>
 #include <graphics/commons/Model.h>
 #include <coders/json.h>
+#include <coders/binary_json.h>
 #include <debug/Logger.h>
 #include <graphics/render/ModelBatch.h>
 #include <data/dv_util.h>
@@ -52,21 +53,25 @@ Skeleton::Skeleton(
     }
 }
 
-dv::value Skeleton::serialize(bool saveTextures, bool savePose) const {
-    auto root = dv::object();
-    if (saveTextures) {
-        auto& map = root.object("textures");
+void Skeleton::serialize(
+    json::BinaryWriter& writer, const SkeletonSaveFlags& flags
+) const {
+    writer.beginObject();
+    if (flags.textures) {
+        writer.beginObject("textures");
         for (auto& [slot, texture] : textures) {
-            map[slot] = texture;
+            writer.put(slot, texture);
         }
+        writer.endObject();
     }
-    if (savePose) {
-        auto& list = root.list("pose");
+    if (flags.pose) {
+        writer.beginList("pose");
         for (auto& mat : pose.matrices) {
-            list.add(dv::to_value(mat));
+            writer.addVec(mat);
         }
+        writer.endList();
     }
-    return root;
+    writer.endObject();
 }
 
 void Skeleton::deserialize(const dv::value& root) {
@@ -85,6 +90,35 @@ void Skeleton::deserialize(const dv::value& root) {
     }
 }
 
+void Skeleton::deserialize(json::BinaryReader& reader) {
+    reader.beginObject();
+    while (reader.hasNext()) {
+        auto key = reader.readKey();
+        if (key == "textures") {
+            reader.beginObject();
+            while (reader.hasNext()) {
+                std::string slot(reader.readKey());
+                textures[slot] = reader.readString();
+            }
+            reader.endObject();
+        } else if (key == "pose") {
+            auto& matrices = pose.matrices;
+            reader.beginList();
+            for (size_t i = 0; reader.hasNext(); ++i) {
+                if (i < matrices.size()) {
+                    reader.readVec(matrices[i]);
+                } else {
+                    reader.skipValue();
+                }
+            }
+            reader.endList();
+        } else {
+            reader.skipValue();
+        }
+    }
+    reader.endObject();
+}
+
 void Skeleton::setConfig(std::shared_ptr<const SkeletonConfig> rigConfig) {
     config = std::move(rigConfig);
 
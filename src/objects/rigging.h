@@ -13,6 +13,11 @@
 #include <data/dv_fwd.h>
 #include <util/Interpolation.h>
 
+namespace json {
+    class BinaryWriter;
+    class BinaryReader;
+}
+
 class Assets;
 class ModelBatch;
 
@@ -80,6 +85,12 @@ namespace rigging {
         bool visible: 1;
     };
 
+    /// @brief Какие части состояния скелета сохраняются вместе с сущностью
+    struct SkeletonSaveFlags {
+        bool textures = false;
+        bool pose = false;
+    };
+
     struct Skeleton {
         std::shared_ptr<const SkeletonConfig> config;
         Pose pose;
@@ -94,8 +105,11 @@ namespace rigging {
 
         Skeleton(std::shared_ptr<const SkeletonConfig> config);
 
-        dv::value serialize(bool saveTextures, bool savePose) const;
+        void serialize(
+            json::BinaryWriter& writer, const SkeletonSaveFlags& flags
+        ) const;
         void deserialize(const dv::value& root);
+        void deserialize(json::BinaryReader& reader);
 
         void setConfig(std::shared_ptr<const SkeletonConfig> config);
     };
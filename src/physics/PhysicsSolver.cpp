@@ -11,6 +11,7 @@
 #include <voxels/Block.h>
 #include <voxels/voxel.h>
 #include <debug/Logger.h>
+#include <debug/Profiler.h>
 
 namespace PhysicsSolver_Consts {
     inline constexpr float EPS = 0.03f; // Маленькое значение
@@ -389,6 +390,7 @@ void PhysicsSolver::step(
     float delta,
     uint substeps
 ) {
+    PROFILE_ZONE("physics.step");
     for (auto hitbox : hitboxes) {
         hitbox->groundMaterial.clear();
         hitbox->prevGrounded = hitbox->grounded;
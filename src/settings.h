@@ -20,6 +20,10 @@ struct ChunksSettings {
     IntegerSetting loadSpeed {4, 1, 32};
     IntegerSetting loadDistance {22, 3, 80};
     IntegerSetting padding {2, 1, 8};
+    /// Потоки генерации биомов и карт высот (1 - без рабочих потоков)
+    IntegerSetting generatorWorkers {4, -4, 32};
+    /// Миллисекунды тика на предварительную генерацию области
+    IntegerSetting pregenSpeed {25, 1, 1000};
 };
 
 struct CameraSettings {
@@ -36,6 +40,8 @@ struct GraphicsSettings {
     BoolSetting backlight {true};
     BoolSetting denseRender {true};
     BoolSetting frustumCulling {true};
+    /// Отсечение секций чанков, перекрытых непрозрачными блоками
+    BoolSetting occlusionCulling {true};
     IntegerSetting skyboxResolution {64 + 32, 64, 128};
     IntegerSetting chunkMaxVertices {200'000, 0, 4'000'000};
     IntegerSetting chunkMaxVerticesDense {800'000, 0, 8'000'000};
@@ -45,6 +51,15 @@ struct GraphicsSettings {
     IntegerSetting ssao {1, 0, 2};
     IntegerSetting shadowsQuality {0, 0, 3};
     IntegerSetting denseRenderDistance {56, 0, 10'000};
+    /// Расстояние (в чанках), начиная с которого чанки рисуются упрощёнными
+    /// мешами; каждое следующее кольцо вдвое дальше. 0 - отключено
+    IntegerSetting lodDistance {12, 0, 128};
+    /// Сохранять меши впервые построенных чанков на диск и переиспользовать
+    /// их при следующей загрузке
+    BoolSetting meshCache {false};
+    /// Лимит памяти (МиБ) буферов мешей, ожидающих загрузки на GPU:
+    /// меши сверх лимита откладываются и перестраиваются позже
+    IntegerSetting meshBuffersLimit {256, 16, 4096};
     BoolSetting softLighting {true};
     IntegerSetting cloudsQuality {2, 0, 2};
 };
@@ -79,6 +94,8 @@ struct AudioSettings {
     StringSetting inputDevice {"auto"};
 
     BoolSetting acousticEffects {true};
+    /// Лимит памяти (МиБ) кэша декодированных коротких звуков
+    IntegerSetting pcmCacheLimit {32, 0, 1024};
 };
 
 struct NetworkSettings {
@@ -18,6 +18,8 @@ namespace util {
         OutCallback outCallback;
 
         size_t valuesCount = 0;
+        /// Значения, удалённые через remove и clear (но не сдвигом окна)
+        size_t removedCount = 0;
 
         void translate(TCoord dx, TCoord dz) {
             if (dx == 0 && dz == 0) {
@@ -108,6 +110,7 @@ namespace util {
             }
             if (element && !value) {
                 valuesCount--;
+                removedCount++;
             }
             element = std::move(value);
             return true;
@@ -119,8 +122,14 @@ namespace util {
             if (lx < 0 || lz < 0 || lx >= sizeX || lz >= sizeZ) {
                 return;
             }
-            if (outCallback) outCallback(x, z, firstBuffer[lz * sizeX + lx]);
-            firstBuffer[lz * sizeX + lx] = T{};
+            auto& element = firstBuffer[lz * sizeX + lx];
+            if (element == T{}) {
+                return;
+            }
+            if (outCallback) outCallback(x, z, element);
+            element = T{};
+            valuesCount--;
+            removedCount++;
         }
 
         void setOutCallback(const OutCallback& callback) {
@@ -168,9 +177,13 @@ namespace util {
                     auto i = z * sizeX + x;
                     auto value = firstBuffer[i];
                     firstBuffer[i] = {};
-                    if (outCallback && value != T{}) {
+                    if (value == T{}) {
+                        continue;
+                    }
+                    if (outCallback) {
                         outCallback(x + offsetX, z + offsetZ, value);
                     }
+                    removedCount++;
                 }
             }
             valuesCount = 0;
@@ -200,6 +213,12 @@ namespace util {
             return valuesCount;
         }
 
+        /// @brief Число значений, удалённых через remove и clear.
+        /// Позволяет заметить удаление, не просматривая всё окно
+        size_t getRemovedCount() const {
+            return removedCount;
+        }
+
         TCoord area() const {
             return sizeX * sizeZ;
         }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+namespace util {
+    /// @brief Кольцевой буфер тривиально копируемых элементов с ростом
+    /// ёмкости (всегда степень двойки).
+    /// Позволяет писать напрямую в свободные участки (например, через readv)
+    template <typename T>
+    class RingBuffer {
+        static_assert(std::is_trivially_copyable_v<T>);
+    public:
+        struct Span {
+            T* data;
+            size_t size;
+        };
+
+        explicit RingBuffer(size_t initCapacity = 4096)
+            : capacity(ceil_pow2(initCapacity)),
+              buffer(std::make_unique<T[]>(capacity)) {}
+
+        size_t size() const {
+            return length;
+        }
+
+        bool empty() const {
+            return length == 0;
+        }
+
+        size_t getCapacity() const {
+            return capacity;
+        }
+
+        /// @brief Гарантирует наличие места под count элементов
+        void reserve(size_t count) {
+            if (capacity - length >= count) {
+                return;
+            }
+            size_t newCapacity = ceil_pow2(length + count);
+            auto newBuffer = std::make_unique<T[]>(newCapacity);
+            peek(newBuffer.get(), length);
+            buffer = std::move(newBuffer);
+            capacity = newCapacity;
+            front = 0;
+        }
+
+        /// @brief Свободные участки в порядке записи (второй может быть пуст)
+        std::array<Span, 2> writable() {
+            size_t back = (front + length) & (capacity - 1);
+            size_t free = capacity - length;
+            size_t first = std::min(free, capacity - back);
+            return {
+                Span {buffer.get() + back, first},
+                Span {buffer.get(), free - first}
+            };
+        }
+
+        /// @brief Помечает count элементов, записанных через writable(),
+        /// как добавленные
+        void commit(size_t count) {
+            length += count;
+        }
+
+        void write(const T* src, size_t count) {
+            reserve(count);
+            auto spans = writable();
+            size_t first = std::min(count, spans[0].size);
+            std::memcpy(spans[0].data, src, first * sizeof(T));
+            std::memcpy(spans[1].data, src + first, (count - first) * sizeof(T));
+            commit(count);
+        }
+
+        /// @brief Копирует до count элементов из начала, не извлекая их
+        /// @return число скопированных элементов
+        size_t peek(T* dst, size_t count) const {
+            count = std::min(count, length);
+            size_t first = std::min(count, capacity - front);
+            std::memcpy(dst, buffer.get() + front, first * sizeof(T));
+            std::memcpy(dst + first, buffer.get(), (count - first) * sizeof(T));
+            return count;
+        }
+
+        /// @brief Извлекает до count элементов из начала
+        /// @return число извлечённых элементов
+        size_t read(T* dst, size_t count) {
+            count = peek(dst, count);
+            front = (front + count) & (capacity - 1);
+            length -= count;
+            return count;
+        }
+
+        void clear() {
+            front = 0;
+            length = 0;
+        }
+    private:
+        size_t capacity;
+        std::unique_ptr<T[]> buffer;
+        size_t front = 0;
+        size_t length = 0;
+
+        static size_t ceil_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+    };
+}
@@ -75,6 +75,7 @@ namespace util {
         std::queue<T> jobs; ///< Очередь заданий, ожидающих выполнения
         std::queue<ThreadPoolResult<T, R>> results; ///< Очередь готовых результатов
         std::mutex resultsMutex; ///< Мьютекс для синхронизации доступа к очереди результатов
+        std::condition_variable resultsCondition; ///< Условная переменная для уведомления о готовых результатах
 
         std::vector<std::thread> threads; ///< Контейнер рабочих потоков
         std::condition_variable jobsMutexCondition; ///< Условная переменная для уведомления потоков о новых заданиях
@@ -124,6 +125,7 @@ namespace util {
                         if (!standaloneResults) locked = true;
                         busyWorkers--;
                     }
+                    resultsCondition.notify_all();
                     if (!standaloneResults){
                         std::unique_lock<std::mutex> lock(mutex);
                         variable.wait(lock, [&] {
@@ -136,8 +138,13 @@ namespace util {
                         onJobFailed(job);
                     }
                     if (stopOnFail) {
-                        std::lock_guard<std::mutex> lock(jobsMutex);
-                        failed = true;
+                        {
+                            std::lock_guard<std::mutex> lock(jobsMutex);
+                            failed = true;
+                        }
+                        // Ожидающий результатов должен увидеть ошибку
+                        std::lock_guard<std::mutex> lock(resultsMutex);
+                        resultsCondition.notify_all();
                     }
                     debug::Logger::getInstance().error() << "['" << name << "' Thread Pool] Uncaught exception: " << err.what();
                 }
@@ -230,6 +237,7 @@ namespace util {
             }
 
             jobsMutexCondition.notify_all();
+            resultsCondition.notify_all();
             for (auto& thread : threads) {
                 thread.join();
             }
@@ -311,6 +319,19 @@ namespace util {
             return resultsProcessed;
         }
 
+        /**
+         * @brief Блокирует вызывающий поток, пока не появится готовый результат,
+         * задание не завершится ошибкой или пул не остановится.
+         *
+         * Сами результаты обрабатываются последующим вызовом pullResults().
+         */
+        void waitForResults() {
+            std::unique_lock<std::mutex> lock(resultsMutex);
+            resultsCondition.wait(lock, [this] {
+                return !results.empty() || failed || !working;
+            });
+        }
+
         /**
          * @brief Добавляет задание в очередь.
          * @param job Умный указатель на задание.
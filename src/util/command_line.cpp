@@ -65,10 +65,18 @@ static bool perform_keyword(
             params.sps = reader.nextInt();
             return true;
         }, "<sps>", "headless mode spark(tick)-rate (default - 20)."),
+        ArgC("--pregen", [&params, &reader]() -> bool {
+            params.pregenRadius = reader.nextInt();
+            return true;
+        }, "<radius>", "headless mode: pre-generate chunks in radius around 0, 0."),
         ArgC("--version", []() -> bool {
             std::cout << ENGINE_VERSION_STRING << std::endl;
             return false;
         }, "", "display the engine version."),
+        ArgC("--trace", [&params, &reader]() -> bool {
+            params.traceFile = reader.next();
+            return true;
+        }, "<path>", "write profiler trace (Chrome trace JSON) of the session."),
         ArgC("--dbg-server", [&params, &reader]() -> bool {
             params.debugServerString = reader.next();
             return true;
@@ -1,8 +1,9 @@
 #pragma once
 
 #include <vector>
-#include <algorithm>
 #include <string>
+#include <cstdint>
+#include <algorithm>
 
 namespace util {
     template<typename Iter>
@@ -23,6 +24,44 @@ namespace util {
         }
     }
 
+    /// @brief Устойчивая поразрядная (LSD) сортировка по возрастанию старших
+    /// 32 бит элементов. Младшие биты на порядок не влияют: в них обычно
+    /// хранится индекс сортируемого объекта. Проходы по байтам, одинаковым
+    /// у всех элементов, пропускаются
+    /// @param buffer рабочий буфер, размер подгоняется под items
+    inline void radix_sort_keys(
+        std::vector<uint64_t>& items, std::vector<uint64_t>& buffer
+    ) {
+        size_t count = items.size();
+        if (count < 2) {
+            return;
+        }
+        buffer.resize(count);
+        size_t histograms[4][256] {};
+        for (uint64_t item : items) {
+            for (int pass = 0; pass < 4; ++pass) {
+                histograms[pass][(item >> (32 + pass * 8)) & 0xFF]++;
+            }
+        }
+        for (int pass = 0; pass < 4; ++pass) {
+            int shift = 32 + pass * 8;
+            auto& histogram = histograms[pass];
+            if (histogram[(items[0] >> shift) & 0xFF] == count) {
+                continue;
+            }
+            size_t offset = 0;
+            for (auto& bucket : histogram) {
+                size_t size = bucket;
+                bucket = offset;
+                offset += size;
+            }
+            for (uint64_t item : items) {
+                buffer[histogram[(item >> shift) & 0xFF]++] = item;
+            }
+            items.swap(buffer);
+        }
+    }
+
     /**
      * @brief Проверяет, содержится ли значение в векторе.
      * @tparam T Тип элементов вектора (должен поддерживать сравнение через operator==).
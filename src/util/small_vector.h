@@ -0,0 +1,229 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <initializer_list>
+
+namespace util {
+    /// @brief Вектор с встроенным буфером на capacity элементов.
+    /// Пока элементы помещаются в буфер, память в куче не выделяется.
+    /// Как и std::vector, при росте перемещает элементы
+    template<typename T, size_t capacity>
+    class small_vector {
+        static_assert(capacity > 0);
+    public:
+        small_vector() : data_(inline_ptr()), size_(0), capacity_(capacity) {}
+
+        small_vector(const small_vector& other) : small_vector() {
+            reserve(other.size_);
+            for (const auto& value : other) {
+                new (data_ + size_) T(value);
+                size_++;
+            }
+        }
+
+        small_vector(small_vector&& other) noexcept : small_vector() {
+            take(std::move(other));
+        }
+
+        small_vector(std::initializer_list<T> init) : small_vector() {
+            reserve(init.size());
+            for (const auto& value : init) {
+                new (data_ + size_) T(value);
+                size_++;
+            }
+        }
+
+        ~small_vector() {
+            clear();
+            deallocate();
+        }
+
+        small_vector& operator=(const small_vector& other) {
+            if (this != &other) {
+                small_vector copy(other);
+                clear();
+                take(std::move(copy));
+            }
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept {
+            if (this != &other) {
+                clear();
+                take(std::move(other));
+            }
+            return *this;
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (size_ < capacity_) {
+                T* ptr = new (data_ + size_) T(std::forward<Args>(args)...);
+                size_++;
+                return *ptr;
+            }
+            // Аргументы могут ссылаться на элементы самого вектора,
+            // поэтому новый элемент создаётся до переноса старых
+            size_t newCapacity = capacity_ * 2;
+            T* newData = std::allocator<T>().allocate(newCapacity);
+            T* ptr;
+            try {
+                ptr = new (newData + size_) T(std::forward<Args>(args)...);
+            } catch (...) {
+                std::allocator<T>().deallocate(newData, newCapacity);
+                throw;
+            }
+            relocate(newData, newCapacity);
+            size_++;
+            return *ptr;
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() {
+            if (size_ == 0) {
+                throw std::underflow_error("small vector is empty");
+            }
+            data_[--size_].~T();
+        }
+
+        /// @brief Удаляет элемент, сохраняя порядок остальных
+        T* erase(T* pos) {
+            T* last = data_ + size_ - 1;
+            for (T* it = pos; it != last; ++it) {
+                *it = std::move(*(it + 1));
+            }
+            last->~T();
+            size_--;
+            return pos;
+        }
+
+        void reserve(size_t count) {
+            if (count > capacity_) {
+                grow(count);
+            }
+        }
+
+        void clear() {
+            for (size_t i = 0; i < size_; ++i) {
+                data_[i].~T();
+            }
+            size_ = 0;
+        }
+
+        T& operator[](size_t index) {
+            return data_[index];
+        }
+
+        const T& operator[](size_t index) const {
+            return data_[index];
+        }
+
+        T& back() {
+            return data_[size_ - 1];
+        }
+
+        const T& back() const {
+            return data_[size_ - 1];
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        /// @brief Элементы хранятся во встроенном буфере
+        bool is_inline() const {
+            return data_ == inline_ptr();
+        }
+
+        T* data() {
+            return data_;
+        }
+
+        const T* data() const {
+            return data_;
+        }
+
+        T* begin() {
+            return data_;
+        }
+
+        T* end() {
+            return data_ + size_;
+        }
+
+        const T* begin() const {
+            return data_;
+        }
+
+        const T* end() const {
+            return data_ + size_;
+        }
+    private:
+        alignas(alignof(T)) char buffer[sizeof(T) * capacity];
+        T* data_;
+        size_t size_;
+        size_t capacity_;
+
+        T* inline_ptr() {
+            return reinterpret_cast<T*>(buffer);
+        }
+
+        const T* inline_ptr() const {
+            return reinterpret_cast<const T*>(buffer);
+        }
+
+        void grow(size_t newCapacity) {
+            relocate(std::allocator<T>().allocate(newCapacity), newCapacity);
+        }
+
+        void relocate(T* newData, size_t newCapacity) {
+            for (size_t i = 0; i < size_; ++i) {
+                new (newData + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+            deallocate();
+            data_ = newData;
+            capacity_ = newCapacity;
+        }
+
+        void deallocate() {
+            if (!is_inline()) {
+                std::allocator<T>().deallocate(data_, capacity_);
+                data_ = inline_ptr();
+                capacity_ = capacity;
+            }
+        }
+
+        /// Забирает элементы other; текущий вектор должен быть пуст
+        void take(small_vector&& other) noexcept {
+            deallocate();
+            if (other.is_inline()) {
+                for (size_t i = 0; i < other.size_; ++i) {
+                    new (data_ + i) T(std::move(other.data_[i]));
+                }
+                size_ = other.size_;
+                other.clear();
+            } else {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_ptr();
+                other.size_ = 0;
+                other.capacity_ = capacity;
+            }
+        }
+    };
+}
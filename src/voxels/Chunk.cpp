@@ -8,6 +8,7 @@
 
 #include <items/Inventory.h>
 #include <voxels/voxel.h>
+#include <voxels/voxel_scan.h>
 #include <lighting/Lightmap.h>
 #include <content/ContentReport.h>
 #include <util/data_io.h>
@@ -27,19 +28,14 @@ Chunk::Chunk(
 
 void Chunk::updateHeights() {
     flags.dirtyHeights = false;
-	for (uint i = 0; i < CHUNK_VOLUME; ++i) {
-		if (voxels[i].id != 0) {
-			bottom = i / (CHUNK_DEPTH * CHUNK_WIDTH);
-			break;
-		}
-	}
-
-	for (int i = CHUNK_VOLUME - 1; i >= 0; --i) {
-		if (voxels[i].id != 0) {
-			top = i / (CHUNK_DEPTH * CHUNK_WIDTH) + 1;
-			break;
-		}
-	}
+    int first = voxel_scan::find_first_nonzero(voxels, CHUNK_VOLUME);
+    if (first >= 0) {
+        bottom = first / (CHUNK_DEPTH * CHUNK_WIDTH);
+    }
+    int last = voxel_scan::find_last_nonzero(voxels, CHUNK_VOLUME);
+    if (last >= 0) {
+        top = last / (CHUNK_DEPTH * CHUNK_WIDTH) + 1;
+    }
 }
 
 void Chunk::addBlockInventory(std::shared_ptr<Inventory> inventory, uint x, uint y, uint z) {
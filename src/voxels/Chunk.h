@@ -39,9 +39,10 @@ public:
         bool inventoriesRemoved : 1;
     } flags {};
 
-    std::shared_ptr<Lightmap> lightmap; // Карта освещения чанка
+    /// Битовая маска вертикальных секций, чей меш требует перестроения
+    uint32_t dirtySections = 0;
 
-    uint64_t lastRandomSparkId = -1;
+    std::shared_ptr<Lightmap> lightmap; // Карта освещения чанка
 
     ChunkInventoriesMap inventories;
 
@@ -60,8 +61,37 @@ public:
     void removeBlockInventory(uint x, uint y, uint z);
 	void setBlockInventories(ChunkInventoriesMap map);
 
-    inline void setModifiedAndUnsaved() {
+    /// Маска, включающая все секции чанка
+    static constexpr uint32_t ALL_SECTIONS = (1U << CHUNK_SECTIONS) - 1;
+
+    /**
+     * @brief Возвращает маску секций, пересекающихся с диапазоном высот.
+     * @param y0,y1 Границы диапазона (включительно), обрезаются до высоты чанка.
+     */
+    static constexpr uint32_t sectionsMask(int y0, int y1) {
+        y0 = (y0 < 0 ? 0 : y0) / CHUNK_SECTION_HEIGHT;
+        y1 = (y1 >= CHUNK_HEIGHT ? CHUNK_HEIGHT - 1 : y1) / CHUNK_SECTION_HEIGHT;
+        return ((2U << y1) - 1) & ~((1U << y0) - 1);
+    }
+
+    inline void setModified() {
+        flags.modified = true;
+        dirtySections = ALL_SECTIONS;
+    }
+
+    /// Помечает изменённым уровень y: его секцию и соседнюю, если y на границе
+    inline void setModified(int y) {
         flags.modified = true;
+        dirtySections |= sectionsMask(y - 1, y + 1);
+    }
+
+    inline void setModifiedAndUnsaved() {
+        setModified();
+        flags.unsaved = true;
+    }
+
+    inline void setModifiedAndUnsaved(int y) {
+        setModified(y);
         flags.unsaved = true;
     }
 
@@ -374,7 +374,7 @@ static inline void sample_chunk(
     bool backlight
 ) {
     const auto cvoxels = chunk.voxels;
-    const auto clights = chunk.lightmap ? chunk.lightmap->getLights() : nullptr;
+    const auto clights = chunk.lightmap.get();
     for (int ly = pos.y; ly < pos.y + size.y; ++ly) {
         for (
             int lz = std::max(pos.z, cz * CHUNK_DEPTH);
@@ -398,7 +398,7 @@ static inline void sample_chunk(
                 );
                 auto& vox = voxels[vidx];
                 vox = cvoxels[cidx];
-                light_t light = clights ? clights[cidx] : Lightmap::SUN_LIGHT_ONLY;
+                light_t light = clights ? clights->get(cidx) : Lightmap::SUN_LIGHT_ONLY;
                 if (backlight) {
                     const auto block = defs.get(vox.id);
                     if (block && block->lightPassing) {
@@ -419,7 +419,7 @@ void Chunks::getVoxels(
     bool backlight,
     int top
 ) const {
-    int h = std::min<int>(size.y, top);
+    int h = std::min<int>(size.y, top - pos.y);
 
     int scx = floordiv<CHUNK_WIDTH>(pos.x);
     int scz = floordiv<CHUNK_DEPTH>(pos.z);
@@ -119,17 +119,25 @@ public:
         int top = CHUNK_HEIGHT
     ) const;
 
+    /**
+     * @brief Заполняет объём вокселями и светом.
+     * @param top Верхняя граница копируемых уровней (абсолютная высота).
+     * @param bottom Нижняя граница копируемых уровней относительно объёма;
+     * уровни ниже неё остаются нетронутыми.
+     */
     template <int w, int h, int d>
     void getVoxels(
         StaticVoxelsVolume<w, h, d>& volume,
         bool backlight = false,
-        int top = CHUNK_HEIGHT
+        int top = CHUNK_HEIGHT,
+        int bottom = 0
     ) const {
+        size_t offset = vox_index(0, bottom, 0, w, d);
         getVoxels(
-            volume.getVoxels(),
-            volume.getLights(),
-            {volume.getX(), volume.getY(), volume.getZ()},
-            {w, h, d},
+            volume.getVoxels() + offset,
+            volume.getLights() + offset,
+            {volume.getX(), volume.getY() + bottom, volume.getZ()},
+            {w, h - bottom, d},
             backlight,
             top
         );
@@ -155,6 +163,10 @@ public:
         return areaMap.getBuffer();
     }
 
+    const util::AreaMap2D<std::shared_ptr<Chunk>, int32_t>& getAreaMap() const {
+        return areaMap;
+    }
+
     int32_t getWidth() const {
         return areaMap.getWidth();
     }
@@ -15,7 +15,8 @@
 #include <core_content_defs.h>
 #include <items/Inventories.h>
 #include <objects/Entities.h>
-#include <coders/json.h>
+#include <coders/binary_json.h>
+#include <coders/zip.h>
 #include <voxels/blocks_agent.h>
 #include <world/LevelEvents.h>
 #include <objects/Entt_Entity.h>
@@ -118,12 +119,11 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z, bool lighting) {
             load_inventories(regions, *chunk, indices.blocks)
         );
 
-        auto entitiesData = regions.fetchEntities(
-            chunk->chunk_x, chunk->chunk_z
-        );
-        if (entitiesData.getType() == dv::value_type::Object) {
-            level.entities->loadEntities(std::move(entitiesData));
-            chunk->flags.entities = true;
+        if (auto entitiesData =
+                regions.fetchEntities(chunk->chunk_x, chunk->chunk_z)) {
+            if (level.entities->loadEntities(*entitiesData)) {
+                chunk->flags.entities = true;
+            }
         }
 
         chunk->flags.loaded = true;
@@ -133,9 +133,18 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z, bool lighting) {
     }
 
     if (chunk->lightmap) {
-        if (regions.getLights(chunk->chunk_x, chunk->chunk_z, voxelDataBuffer.get())) {
-            chunk->lightmap->decode(voxelDataBuffer.get());
-            chunk->flags.loadedLights = true;
+        uint32_t lightsSize;
+        if (regions.getLights(
+                chunk->chunk_x, chunk->chunk_z, voxelDataBuffer.get(), lightsSize
+            )) {
+            if (chunk->lightmap->decode(voxelDataBuffer.get(), lightsSize)) {
+                chunk->flags.loadedLights = true;
+            } else {
+                // Свет будет построен заново
+                logger.warning() << "Corrupted lights of chunk "
+                                 << chunk->chunk_x << "x " << chunk->chunk_z
+                                 << "z";
+            }
         }
     }
 
@@ -191,15 +200,23 @@ void GlobalChunks::save(Chunk* chunk) {
 
     AABB aabb = chunk->getAABB();
     auto entities = level.entities->getAllInside(aabb);
-    auto root = dv::object();
-    root["data"] = level.entities->serialize(entities);
     if (!entities.empty()) {
         chunk->flags.entities = true;
     }
-    level.getWorld().wfile->getRegions().put(
-        chunk,
-        chunk->flags.entities ? json::to_binary(root, true) : std::vector<ubyte>()
-    );
+    std::vector<ubyte> entitiesData;
+    if (chunk->flags.entities) {
+        entitiesBuffer.clear();
+        json::BinaryWriter writer(entitiesBuffer);
+        writer.beginObject();
+        writer.beginList("data");
+        level.entities->serialize(entities, writer);
+        writer.endList();
+        writer.endObject();
+        entitiesData = zip::compress(
+            entitiesBuffer.data(), entitiesBuffer.size()
+        );
+    }
+    level.getWorld().wfile->getRegions().put(chunk, std::move(entitiesData));
 }
 
 void GlobalChunks::saveAll() {
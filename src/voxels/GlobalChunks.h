@@ -11,6 +11,7 @@
 #include <typedefs.h>
 #include <voxels/voxel.h>
 #include <delegates.h>
+#include <coders/byte_utils.h>
 
 class Chunk;
 class Level;
@@ -33,6 +34,8 @@ class GlobalChunks {
     std::unordered_map<uint64_t, std::shared_ptr<Chunk>> chunksMap;
     std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>> pinnedChunks;
     std::unordered_map<ptrdiff_t, int> refCounters;
+    /// Переиспользуемый буфер сериализации сущностей чанка
+    ByteBuilder entitiesBuffer;
 
     consumer<Chunk&> onUnload;
 public:
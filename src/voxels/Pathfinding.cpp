@@ -5,6 +5,7 @@
 #include <voxels/Chunk.h>
 #include <voxels/blocks_agent.h>
 #include <content/Content.h>
+#include <debug/Profiler.h>
 
 inline constexpr float SQRT2 = 1.4142135623730951f;
 
@@ -72,6 +73,7 @@ bool Pathfinding::removeAgent(int id) {
 }
 
 void Pathfinding::performAllAsync(int stepsPerAgent) {
+    PROFILE_ZONE("pathfinding");
     for (auto& [_, agent] : agents) {
         if (agent.state.finished) continue;
         perform(agent, stepsPerAgent);
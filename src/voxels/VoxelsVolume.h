@@ -148,6 +148,14 @@ public:
         return lights;
     }
 
+    const voxel* getVoxels() const {
+        return voxels;
+    }
+
+    const light_t* getLights() const {
+        return lights;
+    }
+
     blockid_t pickBlockId(uint bx, uint by, uint bz) const {
         bx -= x;
         by -= y;
@@ -74,20 +74,20 @@ void blocks_agent::on_chunk_remove(
 
 template <class Storage>
 static void mark_neighboirs_modified(
-    Storage& chunks, int32_t cx, int32_t cz, int32_t lx, int32_t lz
+    Storage& chunks, int32_t cx, int32_t cz, int32_t lx, int32_t y, int32_t lz
 ) {
     Chunk* chunk;
     if (lx == 0 && (chunk = blocks_agent::get_chunk(chunks, cx - 1, cz))) {
-        chunk->flags.modified = true;
+        chunk->setModified(y);
     }
     if (lz == 0 && (chunk = blocks_agent::get_chunk(chunks, cx, cz - 1))) {
-        chunk->flags.modified = true;
+        chunk->setModified(y);
     }
     if (lx == CHUNK_WIDTH - 1 && (chunk = blocks_agent::get_chunk(chunks, cx + 1, cz))) {
-        chunk->flags.modified = true;
+        chunk->setModified(y);
     }
     if (lz == CHUNK_DEPTH - 1 && (chunk = blocks_agent::get_chunk(chunks, cx, cz + 1))) {
-        chunk->flags.modified = true;
+        chunk->setModified(y);
     }
 }
 
@@ -148,13 +148,13 @@ static void initialize_block(
     const auto& def = indices.blocks.require(id);
     vox.id = id;
     vox.state = state;
-    chunk.setModifiedAndUnsaved();
+    chunk.setModifiedAndUnsaved(y);
     if (!state.segment && def.rt.extended) {
         blocks_agent::restore_segments(chunks, def, state, x, y, z);
     }
 
     refresh_chunk_heights(chunk, id == BLOCK_AIR, y);
-    mark_neighboirs_modified(chunks, cx, cz, lx, lz);
+    mark_neighboirs_modified(chunks, cx, cz, lx, y, lz);
 
     uint8_t bits = get_events_bits(def);
     if (bits == 0) return;
@@ -420,7 +420,7 @@ inline void get_voxels_impl(
                 }
             } else {
                 const voxel* cvoxels = chunk->voxels;
-                const light_t* clights = chunk->lightmap ? chunk->lightmap->getLights() : nullptr;
+                const Lightmap* clights = chunk->lightmap.get();
                 for (int ly = y; ly < y + h; ++ly) {
                     for (int lz = std::max(z, cz * CHUNK_DEPTH); lz < std::min(z + d, (cz + 1) * CHUNK_DEPTH); ++lz) {
                         for (int lx = std::max(x, cx * CHUNK_WIDTH); lx < std::min(x + w, (cx + 1) * CHUNK_WIDTH); ++lx) {
@@ -433,7 +433,7 @@ inline void get_voxels_impl(
                                 CHUNK_DEPTH
                             );
                             voxels[vidx] = cvoxels[cidx];
-                            light_t light = clights ? clights[cidx] : Lightmap::SUN_LIGHT_ONLY;
+                            light_t light = clights ? clights->get(cidx) : Lightmap::SUN_LIGHT_ONLY;
                             if (backlight) {
                                 const auto block = blocks.get(voxels[vidx].id);
                                 if (block && block->lightPassing) {
@@ -244,7 +244,7 @@ namespace blocks_agent {
                         int cz = floordiv<CHUNK_DEPTH>(pos.z);
                         auto chunk = get_chunk(chunks, cx, cz);
                         assert(chunk != nullptr);
-                        chunk->setModifiedAndUnsaved();
+                        chunk->setModifiedAndUnsaved(pos.y);
                         segmentBlocks.emplace_back(pos);
                     }
                 }
@@ -289,7 +289,7 @@ namespace blocks_agent {
             int cz = floordiv<CHUNK_DEPTH>(z);
             auto chunk = get_chunk(chunks, cx, cz);
             assert(chunk != nullptr);
-            chunk->setModifiedAndUnsaved();
+            chunk->setModifiedAndUnsaved(y);
         }
     }
 
@@ -0,0 +1,106 @@
+#include <voxels/voxel_scan.h>
+
+#include <constants.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VOXEL_SCAN_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static_assert(CHUNK_WIDTH == 16, "rows are scanned as 16 voxels");
+static_assert(sizeof(voxel) == 4 && sizeof(blockid_t) == 2);
+
+static inline int lowest_bit(uint32_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+static inline int highest_bit(uint32_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return static_cast<int>(index);
+#else
+    return 31 - __builtin_clz(value);
+#endif
+}
+
+uint32_t voxel_scan::zero_mask(const voxel* row) {
+#ifdef VOXEL_SCAN_SSE2
+    // Идентификатор - младшие 16 бит каждого 32-битного вокселя
+    const __m128i idMask = _mm_set1_epi32(0xFFFF);
+    const __m128i zero = _mm_setzero_si128();
+    auto src = reinterpret_cast<const __m128i*>(row);
+    __m128i eq0 = _mm_cmpeq_epi32(
+        _mm_and_si128(_mm_loadu_si128(src), idMask), zero
+    );
+    __m128i eq1 = _mm_cmpeq_epi32(
+        _mm_and_si128(_mm_loadu_si128(src + 1), idMask), zero
+    );
+    __m128i eq2 = _mm_cmpeq_epi32(
+        _mm_and_si128(_mm_loadu_si128(src + 2), idMask), zero
+    );
+    __m128i eq3 = _mm_cmpeq_epi32(
+        _mm_and_si128(_mm_loadu_si128(src + 3), idMask), zero
+    );
+    // 32-битные результаты сжимаются до байтов: бит на воксель
+    __m128i packed = _mm_packs_epi16(
+        _mm_packs_epi32(eq0, eq1), _mm_packs_epi32(eq2, eq3)
+    );
+    return static_cast<uint32_t>(_mm_movemask_epi8(packed));
+#else
+    uint32_t mask = 0;
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        mask |= static_cast<uint32_t>(row[x].id == 0) << x;
+    }
+    return mask;
+#endif
+}
+
+uint32_t voxel_scan::props_mask(
+    const voxel* row, const ubyte* props, ubyte bits
+) {
+    constexpr uint32_t FULL_ROW = (1U << CHUNK_WIDTH) - 1;
+    uint32_t air = zero_mask(row);
+    uint32_t mask = (props[0] & bits) == bits ? air : 0;
+    // Таблица читается только для непустых вокселей
+    for (uint32_t rest = ~air & FULL_ROW; rest; rest &= rest - 1) {
+        int x = lowest_bit(rest);
+        if ((props[row[x].id] & bits) == bits) {
+            mask |= 1U << x;
+        }
+    }
+    return mask;
+}
+
+int voxel_scan::find_first_nonzero(const voxel* voxels, int count) {
+    constexpr uint32_t FULL_ROW = (1U << CHUNK_WIDTH) - 1;
+    for (int i = 0; i < count; i += CHUNK_WIDTH) {
+        uint32_t nonzero = ~zero_mask(voxels + i) & FULL_ROW;
+        if (nonzero) {
+            return i + lowest_bit(nonzero);
+        }
+    }
+    return -1;
+}
+
+int voxel_scan::find_last_nonzero(const voxel* voxels, int count) {
+    constexpr uint32_t FULL_ROW = (1U << CHUNK_WIDTH) - 1;
+    for (int i = count - CHUNK_WIDTH; i >= 0; i -= CHUNK_WIDTH) {
+        uint32_t nonzero = ~zero_mask(voxels + i) & FULL_ROW;
+        if (nonzero) {
+            return i + highest_bit(nonzero);
+        }
+    }
+    return -1;
+}
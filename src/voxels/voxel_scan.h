@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <typedefs.h>
+#include <voxels/voxel.h>
+
+/// @brief Просмотр вокселей рядами по CHUNK_WIDTH (16) за раз.
+///
+/// Идентификаторы ряда проверяются на ноль (воздух) векторно, если доступен
+/// SSE2; таблица свойств блоков читается только для непустых вокселей
+namespace voxel_scan {
+    /// @param count число вокселей, кратное CHUNK_WIDTH
+    /// @return индекс первого вокселя с ненулевым id или -1
+    int find_first_nonzero(const voxel* voxels, int count);
+
+    /// @param count число вокселей, кратное CHUNK_WIDTH
+    /// @return индекс последнего вокселя с ненулевым id или -1
+    int find_last_nonzero(const voxel* voxels, int count);
+
+    /// @return маска вокселей ряда (бит x) с нулевым id
+    uint32_t zero_mask(const voxel* row);
+
+    /// @brief Маска вокселей ряда (бит x), у блоков которых установлены
+    /// биты bits в таблице свойств (ContentIndices::getBlockProps)
+    uint32_t props_mask(const voxel* row, const ubyte* props, ubyte bits);
+}
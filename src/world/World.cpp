@@ -21,6 +21,7 @@
 #include <world/generator/Generator.h>
 #include <settings.h>
 #include <objects/Entities.h>
+#include <debug/Profiler.h>
 
 static debug::Logger logger("world");
 
@@ -67,6 +68,7 @@ void World::writeResources(const Content& content) {
 }
 
 void World::write(Level& level) {
+    PROFILE_ZONE("world.write");
     level.chunks->saveAll();
     info.nextEntityId = level.entities->peekNextID();
 
@@ -175,8 +175,15 @@ void WorldConverter::upgradeRegion(
     const io::path& file, int x, int z, RegionLayerIndex layer
 ) const {
     auto path = wfile->getRegions().getRegionFilePath(layer, x, z);
-    auto bytes = io::read_bytes_buffer(path);
-    auto buffer = compatibility::convert_region_2to3(bytes, layer);
+    auto buffer = io::read_bytes_buffer(path);
+    uint version = compatibility::get_region_version(buffer);
+    if (version >= REGION_FORMAT_VERSION) {
+        return;
+    }
+    if (version < 3) {
+        buffer = compatibility::convert_region_2to3(buffer, layer);
+    }
+    buffer = compatibility::convert_region_3to4(buffer);
     io::write_bytes(path, buffer.data(), buffer.size());
 }
 
@@ -9,6 +9,7 @@
 #include <items/Inventory.h>
 #include <debug/Logger.h>
 #include <coders/binary_json.h>
+#include <coders/zip.h>
 #include <lighting/Lightmap.h>
 
 static debug::Logger logger("world-regions");
@@ -82,6 +83,29 @@ void RegionsLayer::writeAll() {
     }
 }
 
+void RegionsLayer::flushRegion(int x, int z) {
+    std::unique_ptr<WorldRegion> region;
+    {
+        std::lock_guard lock(mapMutex);
+        auto found = regions.find({x, z});
+        if (found == regions.end()) {
+            return;
+        }
+        region = std::move(found->second);
+        regions.erase(found);
+    }
+    if (region->getChunks() != nullptr && region->isUnsaved()) {
+        // Закрывает и открытый для чтения файл региона
+        writeRegion(x, z, region.get());
+        return;
+    }
+    std::lock_guard lock(regFilesMutex);
+    auto file = openRegFiles.find({x, z});
+    if (file != openRegFiles.end() && !file->second->inUse) {
+        closeRegFile({x, z});
+    }
+}
+
 void WorldRegions::put(
     int x, int z,
     RegionLayerIndex layerID,
@@ -114,14 +138,17 @@ static std::unique_ptr<ubyte[]> write_inventories(
     const ChunkInventoriesMap& inventories, uint32_t& datasize
 ) {
     ByteBuilder builder;
+    ByteBuilder document;
     builder.putInt32(inventories.size());
     for (auto& entry : inventories) {
         builder.putInt32(entry.first);
-        auto map = entry.second->serialize();
-        auto bytes = json::to_binary(map, true);
+        document.clear();
+        json::BinaryWriter writer(document);
+        entry.second->serialize(writer);
+        auto bytes = zip::compress(document.data(), document.size());
         builder.putInt32(bytes.size());
         builder.put(bytes.data(), bytes.size());
-    }   
+    }
     auto datavec = builder.data();
     datasize = builder.size();
     auto data = std::make_unique<ubyte[]>(datasize);
@@ -138,10 +165,10 @@ static ChunkInventoriesMap load_inventories(
     for (int i = 0; i < count; ++i) {
         uint index = reader.getInt32();
         uint size = reader.getInt32();
-        auto map = json::from_binary(reader.pointer(), size);
+        json::BinaryReader document(reader.pointer(), size);
         reader.skip(size);
         auto inv = std::make_shared<Inventory>(0, 0);
-        inv->deserialize(map);
+        inv->deserialize(document);
         inventories[index] = std::move(inv);
     }
     return inventories;
@@ -167,11 +194,13 @@ void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
     );
 
     if (doWriteLights && chunk->flags.lighted && chunk->lightmap) {
+        uint32_t datasize;
+        auto data = chunk->lightmap->encode(datasize);
         put(
             chunk->chunk_x, chunk->chunk_z,
             REGION_LAYER_LIGHTS, 
-            chunk->lightmap->encode(),
-            LIGHTMAP_DATA_LEN
+            std::move(data),
+            datasize
         );
     }
     if (!chunk->inventories.empty() || chunk->flags.inventoriesRemoved) {
@@ -217,9 +246,8 @@ bool WorldRegions::getVoxels(int x, int z, ubyte* dst) {
     return true;
 }
 
-bool WorldRegions::getLights(int x, int z, ubyte* dst) {
+bool WorldRegions::getLights(int x, int z, ubyte* dst, uint32_t& srcSize) {
     uint32_t size;
-    uint32_t srcSize;
     auto& layer = layers[REGION_LAYER_LIGHTS];
     auto* bytes = layer.getData(x, z, size, srcSize);
     if (bytes == nullptr) return false;
@@ -315,16 +343,16 @@ void WorldRegions::processBlocksData(int x, int z, const BlockDataProc& func) {
     }
 }
 
-dv::value WorldRegions::fetchEntities(int x, int z) {
+std::unique_ptr<json::BinaryReader> WorldRegions::fetchEntities(
+    int x, int z
+) {
     if (generatorTestMode) return nullptr;
 
     uint32_t bytesSize;
     uint32_t srcSize;
     const ubyte* data = layers[REGION_LAYER_ENTITIES].getData(x, z, bytesSize, srcSize);
     if (data == nullptr) return nullptr;
-    auto map = json::from_binary(data, bytesSize);
-    if (map.size() == 0) return nullptr;
-    return map;
+    return std::make_unique<json::BinaryReader>(data, bytesSize);
 }
 
 void WorldRegions::processRegion(
@@ -375,6 +403,26 @@ void WorldRegions::writeAll() {
     }
 }
 
+void WorldRegions::flushRegion(int x, int z) {
+    for (auto& layer : layers) {
+        io::create_directories(layer.folder);
+        layer.flushRegion(x, z);
+    }
+}
+
+bool WorldRegions::isRegionResident(int x, int z) {
+    for (auto& layer : layers) {
+        if (layer.getRegion(x, z)) {
+            return true;
+        }
+        std::lock_guard lock(layer.regFilesMutex);
+        if (layer.openRegFiles.find({x, z}) != layer.openRegFiles.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void WorldRegions::deleteRegion(RegionLayerIndex layerid, int x, int z) {
     auto& layer = layers[layerid];
     if (layer.getRegFile({x, z}, false)) {
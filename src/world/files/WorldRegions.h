@@ -20,6 +20,10 @@
 #include <coders/compression.h>
 #include <world/files/world_regions_fwd.h>
 
+namespace json {
+    class BinaryReader;
+}
+
 namespace RegionConsts {
     inline constexpr uint SIZE_BIT = 5; // Размер региона 
     inline constexpr uint SIZE = 1 << SIZE_BIT; // Длина региона в чанках
@@ -146,6 +150,9 @@ struct RegionsLayer {
 
     void writeRegion(int x, int y, WorldRegion* entry);
     void writeAll();
+    /// @brief Записывает регион, если он изменён, выгружает его из памяти
+    /// и закрывает его файл
+    void flushRegion(int x, int z);
 
     [[nodiscard]] static std::unique_ptr<ubyte[]> readChunkData(
         int x, int z, uint32_t& size, uint32_t& srcSize, regFile* rfile
@@ -173,9 +180,11 @@ public:
     );
 
     bool getVoxels(int x, int z, ubyte* dst);
-    bool getLights(int x, int z, ubyte* dst);
+    /// @param srcSize размер распакованных данных освещения
+    bool getLights(int x, int z, ubyte* dst, uint32_t& srcSize);
     ChunkInventoriesMap fetchInventories(int x, int z);
-    dv::value fetchEntities(int x, int z);
+    /// @return потоковый читатель данных сущностей чанка или nullptr
+    std::unique_ptr<json::BinaryReader> fetchEntities(int x, int z);
 
     BlocksMetadata getBlocksData(int x, int z);
 
@@ -196,6 +205,14 @@ public:
 
     void writeAll();
 
+    /// @brief Записывает регион всех слоёв и освобождает его память.
+    /// Чанки, сохранённые в него позже, дописываются к файлу
+    void flushRegion(int x, int z);
+
+    /// @return true, если регион какого-либо слоя находится в памяти
+    /// или его файл открыт
+    bool isRegionResident(int x, int z);
+
     void deleteRegion(RegionLayerIndex layerID, int x, int z);
 
     static bool parseRegionFilename(const std::string& name, int& x, int& z);
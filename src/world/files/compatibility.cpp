@@ -110,3 +110,24 @@ util::Buffer<ubyte> compatibility::convert_region_2to3(
     }
     return util::Buffer<ubyte>(builder.build().data(), builder.size());
 }
+
+/// Смещение байта версии: после ".CHROMAREG\0"
+static inline constexpr size_t REGION_VERSION_OFFSET = 11;
+
+uint compatibility::get_region_version(const util::Buffer<ubyte>& src) {
+    if (src.size() <= REGION_VERSION_OFFSET) {
+        throw std::runtime_error("incomplete region file header");
+    }
+    return src[REGION_VERSION_OFFSET];
+}
+
+util::Buffer<ubyte> compatibility::convert_region_3to4(
+    const util::Buffer<ubyte>& src
+) {
+    if (get_region_version(src) != 3) {
+        throw std::invalid_argument("region format 3 expected");
+    }
+    util::Buffer<ubyte> dst(src.data(), src.size());
+    dst[REGION_VERSION_OFFSET] = 4;
+    return dst;
+}
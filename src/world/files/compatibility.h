@@ -5,7 +5,14 @@
 #include <world/files/world_regions_fwd.h>
 
 namespace compatibility {
+    /// @brief Версия формата из заголовка файла региона
+    uint get_region_version(const util::Buffer<ubyte>& src);
+
     util::Buffer<ubyte> convert_region_2to3(
         const util::Buffer<ubyte>& src, RegionLayerIndex layer
     );
+
+    /// @brief Версия 4 отличается посекционным кодированием слоя освещения;
+    /// прежние плоские записи читаются как есть, меняется только заголовок
+    util::Buffer<ubyte> convert_region_3to4(const util::Buffer<ubyte>& src);
 }
@@ -12,5 +12,5 @@ enum RegionLayerIndex : uint {
     REGION_LAYERS_COUNT
 };
 
-inline constexpr uint REGION_FORMAT_VERSION = 3;
+inline constexpr uint REGION_FORMAT_VERSION = 4;
 inline constexpr uint MAX_OPEN_REGION_FILES = 32;
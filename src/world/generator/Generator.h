@@ -98,6 +98,10 @@ class GeneratorScript {
 public:
     virtual ~GeneratorScript() = default;
 
+    /// @brief Создаёт независимый экземпляр того же скрипта для рабочего
+    /// потока генерации. Экземпляры не разделяют изменяемого состояния
+    virtual std::unique_ptr<GeneratorScript> copy() const = 0;
+
     virtual void initialize(uint64_t seed) = 0;
 
     virtual std::shared_ptr<Heightmap> generateHeightmap(
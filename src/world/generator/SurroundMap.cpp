@@ -19,6 +19,16 @@ SurroundMap::SurroundMap(
 void SurroundMap::setLevelCallback(int8_t level, LevelCallback callback) {
     auto& wrapper = levelCallbacks.at(level - 1);
     wrapper.callback = callback;
+    wrapper.batchCallback = nullptr;
+    wrapper.active = callback != nullptr;
+}
+
+void SurroundMap::setLevelBatchCallback(
+    int8_t level, LevelBatchCallback callback
+) {
+    auto& wrapper = levelCallbacks.at(level - 1);
+    wrapper.callback = nullptr;
+    wrapper.batchCallback = callback;
     wrapper.active = callback != nullptr;
 }
 
@@ -26,24 +36,31 @@ void SurroundMap::setOutCallback(util::AreaMap2D<int8_t>::OutCallback callback)
     areaMap.setOutCallback(callback);
 }
 
-void SurroundMap::upgrade(int x, int y, int8_t level) {
+void SurroundMap::upgrade(int x1, int y1, int x2, int y2, int8_t level) {
     auto& callback = levelCallbacks[level - 1];
-    int size = maxLevel - level + 1;
-    for (int ly = -size + 1; ly < size; ++ly) {
-        for (int lx = -size + 1; lx < size; ++lx) {
-            int posX = lx + x;
-            int posY = ly + y;
+    int padding = maxLevel - level;
+    batch.clear();
+    for (int posY = y1 - padding; posY <= y2 + padding; ++posY) {
+        for (int posX = x1 - padding; posX <= x2 + padding; ++posX) {
             int8_t sourceLevel = areaMap.get(posX, posY, 0);
             if (sourceLevel < level - 1) {
                 throw std::runtime_error("Invalid map state");
             }
             if (sourceLevel >= level) continue;
             areaMap.set(posX, posY, level);
-            if (callback.active) {
+            if (!callback.active) {
+                continue;
+            }
+            if (callback.batchCallback) {
+                batch.emplace_back(posX, posY);
+            } else {
                 callback.callback(posX, posY);
             }
         }
     }
+    if (!batch.empty()) {
+        callback.batchCallback(batch);
+    }
 }
 
 void SurroundMap::resize(int maxLevelRadius) {
@@ -51,12 +68,16 @@ void SurroundMap::resize(int maxLevelRadius) {
 }
 
 void SurroundMap::completeAt(int x, int y) {
-    if (!areaMap.isInside(x - maxLevel + 1, y - maxLevel + 1) || !areaMap.isInside(x + maxLevel - 1, y + maxLevel - 1)) {
+    completeArea(x, y, x, y);
+}
+
+void SurroundMap::completeArea(int x1, int y1, int x2, int y2) {
+    if (!areaMap.isInside(x1 - maxLevel + 1, y1 - maxLevel + 1) || !areaMap.isInside(x2 + maxLevel - 1, y2 + maxLevel - 1)) {
         logger.error() << "Upgrade square is not fully inside of area";
         throw std::invalid_argument("Upgrade square is not fully inside of area");
     }
     for (int8_t level = 1; level <= maxLevel; ++level) {
-        upgrade(x, y, level);
+        upgrade(x1, y1, x2, y2, level);
     }
 }
 
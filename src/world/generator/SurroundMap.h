@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <unordered_map>
 #include <functional>
 
@@ -12,24 +13,41 @@
 class SurroundMap {
 public:
     using LevelCallback = std::function<void(int, int)>;
+    /// Получает все позиции, достигшие уровня за один вызов completeAt
+    /// или completeArea
+    using LevelBatchCallback = std::function<void(const std::vector<glm::ivec2>&)>;
     struct LevelCallbackWrapper {
         LevelCallback callback;
+        LevelBatchCallback batchCallback;
         bool active = false;
     };
 private:
     util::AreaMap2D<int8_t> areaMap;
     std::vector<LevelCallbackWrapper> levelCallbacks;
     int8_t maxLevel;
+    std::vector<glm::ivec2> batch;
 
-    void upgrade(int x, int y, int8_t level);
+    /// @brief Поднимает до level позиции прямоугольника x1..x2, y1..y2,
+    /// расширенного на число уровней выше level
+    void upgrade(int x1, int y1, int x2, int y2, int8_t level);
 public:
     SurroundMap(int maxLevelRadius, int8_t maxLevel);
 
     void setLevelCallback(int8_t level, LevelCallback callback);
+
+    /// @brief Устанавливает пакетный колбэк уровня вместо поштучного.
+    /// Колбэки уровня не должны зависеть друг от друга, поэтому позиции
+    /// пакета можно обрабатывать параллельно
+    void setLevelBatchCallback(int8_t level, LevelBatchCallback callback);
     void setOutCallback(util::AreaMap2D<int8_t>::OutCallback callback);
 
     void completeAt(int x, int y);
 
+    /// @brief Завершает все позиции прямоугольника x1..x2, y1..y2
+    /// (включительно). Позиции каждого уровня собираются в один пакет,
+    /// а не по одному на позицию, как при последовательных completeAt
+    void completeArea(int x1, int y1, int x2, int y2);
+
     void setCenter(int x, int y);
 
     void resize(int maxLevelRadius);
@@ -16,16 +16,37 @@
 #include <util/listutil.h>
 #include <math/voxmaths.h>
 #include <math/util.h>
+#include <util/ThreadPool.h>
 
 static debug::Logger logger("world-generator");
 
 static inline constexpr uint MAX_PARAMETERS = 4;
 static inline constexpr uint BASIC_PROTOTYPE_LAYERS = 5;
 
+/// Рабочий поток со своим экземпляром скрипта (отдельным Lua-состоянием)
+class WorldGenerator::PrototypeWorker : public util::Worker<PrototypeJob, int> {
+    WorldGenerator& generator;
+    std::unique_ptr<GeneratorScript> script;
+public:
+    PrototypeWorker(
+        WorldGenerator& generator,
+        std::unique_ptr<GeneratorScript> script,
+        uint64_t seed
+    ) : generator(generator), script(std::move(script)) {
+        this->script->initialize(seed);
+    }
+
+    int operator()(const PrototypeJob& job) override {
+        generator.generateStage(job, *script);
+        return 0;
+    }
+};
+
 WorldGenerator::WorldGenerator(
     const Generator& def,
     const Content& content,
-    uint64_t seed
+    uint64_t seed,
+    int workers
 ) : def(def),
     content(content),
     seed(seed),
@@ -56,11 +77,11 @@ WorldGenerator::WorldGenerator(
     [this](int const x, int const z) {
         generateStructuresWide(requirePrototype(x, z), x, z);
     });
-    surroundMap.setLevelCallback(levels - 3, [this](int const x, int const z) {
-        generateBiomes(requirePrototype(x, z), x, z);
+    surroundMap.setLevelBatchCallback(levels - 3, [this](const auto& positions) {
+        generateBatch(positions, ChunkPrototypeLevel::Biomes);
     });
-    surroundMap.setLevelCallback(levels - 2, [this](int const x, int const z) {
-        generateHeightmap(requirePrototype(x, z), x, z);
+    surroundMap.setLevelBatchCallback(levels - 2, [this](const auto& positions) {
+        generateBatch(positions, ChunkPrototypeLevel::Heightmap);
     });
     surroundMap.setLevelCallback(levels - 1, [this](int const x, int const z) {
         generateStructures(requirePrototype(x, z), x, z);
@@ -72,6 +93,22 @@ WorldGenerator::WorldGenerator(
             def.structures[i]->fragments[j] = def.structures[i]->fragments[j - 1]->rotated(content);
         }
     }
+
+    if (workers != 1) {
+        // Экземпляры скрипта создаются здесь, в вызывающем потоке
+        workersPool = std::make_unique<util::ThreadPool<PrototypeJob, int>>(
+            "world-generator",
+            [this, seed]() {
+                return std::make_unique<PrototypeWorker>(
+                    *this, this->def.script->copy(), seed
+                );
+            },
+            [](int&&) {},
+            workers
+        );
+        logger.info() << "Generation workers: "
+                      << workersPool->getWorkersCount();
+    }
 }
 
 WorldGenerator::~WorldGenerator() {}
@@ -332,12 +369,12 @@ void WorldGenerator::generateStructures(
 }
 
 void WorldGenerator::generateBiomes(
-    ChunkPrototype& prototype, int chunkX, int chunkZ
+    ChunkPrototype& prototype, int chunkX, int chunkZ, GeneratorScript& script
 ) {
     if (prototype.level >= ChunkPrototypeLevel::Biomes) return;
 
     uint bpd = def.biomesBPD;
-    auto biomeParams = def.script->generateParameterMaps(
+    auto biomeParams = script.generateParameterMaps(
         {floordiv(chunkX * CHUNK_WIDTH, bpd), floordiv(chunkZ * CHUNK_DEPTH, bpd)},
         {floordiv(CHUNK_WIDTH, bpd) + 1, floordiv(CHUNK_DEPTH, bpd) + 1},
         bpd
@@ -373,12 +410,12 @@ void WorldGenerator::generateBiomes(
 }
 
 void WorldGenerator::generateHeightmap(
-    ChunkPrototype& prototype, int chunkX, int chunkZ
+    ChunkPrototype& prototype, int chunkX, int chunkZ, GeneratorScript& script
 ) {
     if (prototype.level >= ChunkPrototypeLevel::Heightmap) return;
 
     uint bpd = def.heightsBPD;
-    prototype.heightmap = def.script->generateHeightmap(
+    prototype.heightmap = script.generateHeightmap(
         {floordiv(chunkX * CHUNK_WIDTH, bpd), floordiv(chunkZ * CHUNK_DEPTH, bpd)},
         {floordiv(CHUNK_WIDTH, bpd) + 1, floordiv(CHUNK_DEPTH, bpd) + 1},
         bpd,
@@ -392,6 +429,49 @@ void WorldGenerator::generateHeightmap(
     prototype.level = ChunkPrototypeLevel::Heightmap;
 }
 
+void WorldGenerator::generateStage(
+    const PrototypeJob& job, GeneratorScript& script
+) {
+    switch (job.level) {
+        case ChunkPrototypeLevel::Biomes:
+            generateBiomes(*job.prototype, job.x, job.z, script);
+            break;
+        case ChunkPrototypeLevel::Heightmap:
+            generateHeightmap(*job.prototype, job.x, job.z, script);
+            break;
+        default:
+            throw std::invalid_argument("unsupported prototype level");
+    }
+}
+
+void WorldGenerator::generateBatch(
+    const std::vector<glm::ivec2>& positions, ChunkPrototypeLevel level
+) {
+    if (workersPool == nullptr || positions.size() == 1) {
+        for (const auto& pos : positions) {
+            generateStage(
+                PrototypeJob {&requirePrototype(pos.x, pos.y), pos.x, pos.y, level},
+                *def.script
+            );
+        }
+        return;
+    }
+    // Этап прототипа изменяет только сам прототип
+    for (const auto& pos : positions) {
+        workersPool->enqueueJob(
+            PrototypeJob {&requirePrototype(pos.x, pos.y), pos.x, pos.y, level}
+        );
+    }
+    size_t done = 0;
+    while (done < positions.size()) {
+        if (!workersPool->isActive()) {
+            throw std::runtime_error("world generator workers are stopped");
+        }
+        workersPool->waitForResults();
+        done += workersPool->pullResults();
+    }
+}
+
 void WorldGenerator::update(int centerX, int centerY, int loadDistance) {
     surroundMap.setCenter(centerX, centerY);
     surroundMap.resize(loadDistance);
@@ -462,6 +542,10 @@ void WorldGenerator::generateLand(
     }
 }
 
+void WorldGenerator::prepare(int x1, int z1, int x2, int z2) {
+    surroundMap.completeArea(x1, z1, x2, z2);
+}
+
 void WorldGenerator::generate(voxel* voxels, int chunkX, int chunkZ) {
     surroundMap.completeAt(chunkX, chunkZ);
 
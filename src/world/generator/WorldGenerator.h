@@ -15,6 +15,7 @@
 
 class Content;
 struct Generator;
+class GeneratorScript;
 class Heightmap;
 struct Biome;
 class VoxelFragment;
@@ -38,6 +39,19 @@ struct ChunkPrototype {
     std::vector<std::shared_ptr<Heightmap>> heightmapInputs {};
 };
 
+/// Задание рабочего потока генерации: один этап прототипа чанка
+struct PrototypeJob {
+    ChunkPrototype* prototype = nullptr;
+    int x = 0;
+    int z = 0;
+    ChunkPrototypeLevel level = ChunkPrototypeLevel::Void;
+};
+
+namespace util {
+    template<class T, class R>
+    class ThreadPool;
+}
+
 struct WorldGenDebugInfo {
     int areaOffsetX;
     int areaOffsetZ;
@@ -56,6 +70,11 @@ class WorldGenerator {
 
     SurroundMap surroundMap;
 
+    class PrototypeWorker;
+    /// Рабочие потоки со своими экземплярами скрипта генератора.
+    /// nullptr при однопоточной генерации
+    std::unique_ptr<util::ThreadPool<PrototypeJob, int>> workersPool;
+
     std::unique_ptr<ChunkPrototype> generatePrototype(int x, int z);
 
     ChunkPrototype& requirePrototype(int x, int z);
@@ -64,9 +83,21 @@ class WorldGenerator {
 
     void generateStructures(ChunkPrototype& prototype, int x, int z);
 
-    void generateBiomes(ChunkPrototype& prototype, int x, int z);
+    void generateBiomes(
+        ChunkPrototype& prototype, int x, int z, GeneratorScript& script
+    );
 
-    void generateHeightmap(ChunkPrototype& prototype, int x, int z);
+    void generateHeightmap(
+        ChunkPrototype& prototype, int x, int z, GeneratorScript& script
+    );
+
+    void generateStage(const PrototypeJob& job, GeneratorScript& script);
+
+    /// @brief Выполняет этап для пакета прототипов, параллельно при
+    /// наличии рабочих потоков
+    void generateBatch(
+        const std::vector<glm::ivec2>& positions, ChunkPrototypeLevel level
+    );
 
     void placeStructure(
         const StructurePlacement& placement, int priority,
@@ -124,15 +155,23 @@ class WorldGenerator {
         int x, int z
     );
 public:
+    /// @param workers число рабочих потоков для биомов и карт высот
+    /// (1 - генерация в вызывающем потоке, 0 и меньше - как в ThreadPool)
 	WorldGenerator(
         const Generator& def,
         const Content& content,
-        uint64_t seed
+        uint64_t seed,
+        int workers = 1
     );
     ~WorldGenerator();
 
     void update(int centerX, int centerY, int loadDistance);
 
+    /// @brief Завершает прототипы прямоугольника чанков x1..x2, z1..z2
+    /// (включительно). Этапы биомов и карт высот всей области выполняются
+    /// одним пакетом каждый, что загружает все рабочие потоки
+    void prepare(int x1, int z1, int x2, int z2);
+
 	void generate(voxel* voxels, int x, int z);
 
     WorldGenDebugInfo createDebugInfo() const;
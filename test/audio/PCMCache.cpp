@@ -0,0 +1,66 @@
+#include <audio/PCMCache.h>
+
+#include <gtest/gtest.h>
+
+#include <audio/NoAudio.h>
+
+using namespace audio;
+
+static std::shared_ptr<PCM> make_pcm(size_t size) {
+    return std::make_shared<PCM>(
+        std::vector<char>(size), size / 2, 1, 16, 44100, true
+    );
+}
+
+TEST(PCMCache, EvictsLeastRecentlyUsed) {
+    PCMCache cache(8000);
+    for (char name = 'a'; name < 'i'; ++name) {
+        EXPECT_TRUE(cache.put(std::string(1, name), make_pcm(1000)));
+    }
+    EXPECT_EQ(cache.size(), 8);
+    EXPECT_EQ(cache.getMemoryUsage(), 8000);
+
+    // "a" использован недавно, вытесняется следующий за ним "b"
+    EXPECT_NE(cache.get("a"), nullptr);
+    EXPECT_TRUE(cache.put("i", make_pcm(1000)));
+    EXPECT_EQ(cache.size(), 8);
+    EXPECT_EQ(cache.get("b"), nullptr);
+    EXPECT_NE(cache.get("a"), nullptr);
+    EXPECT_NE(cache.get("i"), nullptr);
+    EXPECT_EQ(cache.getMemoryUsage(), 8000);
+}
+
+TEST(PCMCache, RejectsLongSounds) {
+    PCMCache cache(8000);
+    EXPECT_FALSE(cache.put("long", make_pcm(1001)));
+    EXPECT_EQ(cache.get("long"), nullptr);
+
+    PCMCache disabled(0);
+    EXPECT_FALSE(disabled.put("a", make_pcm(1)));
+}
+
+TEST(PCMCache, ReplaceAndShrink) {
+    PCMCache cache(8000);
+    cache.put("a", make_pcm(500));
+    cache.put("a", make_pcm(300));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.getMemoryUsage(), 300);
+
+    cache.put("b", make_pcm(300));
+    cache.setCapacity(400);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_NE(cache.get("b"), nullptr);
+}
+
+TEST(PCMCache, SharedWithSounds) {
+    PCMCache cache(8000);
+    auto pcm = make_pcm(800);
+    cache.put("step", pcm);
+
+    auto backend = NoAudio::create();
+    auto first = backend->createSound(cache.get("step"), true);
+    auto second = backend->createSound(cache.get("step"), true);
+    EXPECT_EQ(first->getPCM(), pcm);
+    EXPECT_EQ(second->getPCM(), pcm);
+    EXPECT_DOUBLE_EQ(first->getDuration(), pcm->getDuration());
+}
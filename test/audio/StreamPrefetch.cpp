@@ -0,0 +1,149 @@
+#include <audio/StreamPrefetch.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <audio/MemoryPCMStream.h>
+
+using namespace audio;
+
+static void feed(MemoryPCMStream& stream, size_t size, ubyte value) {
+    std::vector<ubyte> bytes(size, value);
+    stream.feed(util::span<ubyte>(bytes.data(), bytes.size()));
+}
+
+TEST(StreamPrefetch, FillAndConsume) {
+    auto source = std::make_shared<MemoryPCMStream>(44100, 1, 8);
+    feed(*source, 100, 1);
+    feed(*source, 100, 2);
+
+    PrefetchStream prefetch(source, 64, 3);
+    EXPECT_EQ(prefetch.front(), nullptr);
+    // Кольцо ограничено тремя блоками
+    EXPECT_EQ(prefetch.fill(), 3);
+    EXPECT_EQ(prefetch.available(), 3);
+    EXPECT_EQ(prefetch.fill(), 0);
+
+    const auto* block = prefetch.front();
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->size, 64);
+    EXPECT_EQ(block->data[0], 1);
+    prefetch.pop();
+    prefetch.pop();
+    block = prefetch.front();
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->size, 64);
+    EXPECT_EQ(block->data[63], 2);
+
+    // Остаток источника - неполный блок
+    EXPECT_EQ(prefetch.fill(), 1);
+    prefetch.pop();
+    block = prefetch.front();
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->size, 8);
+    prefetch.pop();
+    EXPECT_EQ(prefetch.front(), nullptr);
+    EXPECT_EQ(source->available(), 0);
+}
+
+TEST(StreamPrefetch, FillTarget) {
+    auto source = std::make_shared<MemoryPCMStream>(44100, 1, 8);
+    feed(*source, 256, 0);
+    PrefetchStream prefetch(source, 64, 4);
+    EXPECT_EQ(prefetch.fill(1), 1);
+    EXPECT_EQ(prefetch.fill(1), 0);
+    EXPECT_EQ(prefetch.fill(3), 2);
+}
+
+TEST(StreamPrefetch, SeekDropsPrefetched) {
+    auto source = std::make_shared<MemoryPCMStream>(44100, 1, 8);
+    feed(*source, 128, 0);
+    PrefetchStream prefetch(source, 64, 4);
+    prefetch.fill();
+    EXPECT_EQ(prefetch.available(), 2);
+    prefetch.seek(0);
+    EXPECT_EQ(prefetch.available(), 0);
+    EXPECT_EQ(prefetch.front(), nullptr);
+}
+
+TEST(StreamPrefetch, DecoderThread) {
+    auto source = std::make_shared<MemoryPCMStream>(44100, 2, 16);
+    auto prefetch = std::make_shared<PrefetchStream>(source, 1024, 4);
+    StreamDecoder decoder;
+    decoder.add(prefetch);
+
+    feed(*source, 3000, 7);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    size_t received = 0;
+    while (received < 3000 && std::chrono::steady_clock::now() < deadline) {
+        if (const auto* block = prefetch->front()) {
+            EXPECT_EQ(block->data[0], 7);
+            received += block->size;
+            prefetch->pop();
+            decoder.notify();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    EXPECT_EQ(received, 3000);
+
+    prefetch->close();
+    deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (decoder.countStreams() &&
+           std::chrono::steady_clock::now() < deadline) {
+        decoder.notify();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(decoder.countStreams(), 0);
+}
+
+/// Конечный источник с перемоткой, как файловые потоки
+class FinitePCMStream : public PCMStream {
+    size_t total;
+    size_t position = 0;
+public:
+    FinitePCMStream(size_t total) : total(total) {}
+
+    size_t read(char* buffer, size_t bufferSize) override {
+        size_t size = std::min(bufferSize, total - position);
+        std::fill(buffer, buffer + size, 1);
+        position += size;
+        return size;
+    }
+    void close() override {}
+    bool isOpen() const override { return true; }
+    size_t getTotalSamples() const override { return total; }
+    duration_t getTotalDuration() const override { return total / 44100.0; }
+    uint getChannels() const override { return 1; }
+    uint getSampleRate() const override { return 44100; }
+    uint getBitsPerSample() const override { return 8; }
+    bool isSeekable() const override { return true; }
+    void seek(size_t position) override { this->position = position; }
+};
+
+TEST(StreamPrefetch, Exhausted) {
+    auto finite = std::make_shared<FinitePCMStream>(100);
+    PrefetchStream prefetch(finite, 64, 4);
+    EXPECT_EQ(prefetch.fill(), 2);
+    EXPECT_TRUE(prefetch.isExhausted());
+    prefetch.seek(0);
+    EXPECT_FALSE(prefetch.isExhausted());
+    prefetch.setLoop(true);
+    // С повтором источник не заканчивается: кольцо заполняется целиком
+    EXPECT_EQ(prefetch.fill(), 4);
+    EXPECT_FALSE(prefetch.isExhausted());
+
+    // Пустой живой поток - опустошение, а не конец
+    auto live = std::make_shared<MemoryPCMStream>(44100, 1, 8);
+    PrefetchStream stream(live, 64, 4);
+    EXPECT_EQ(stream.fill(), 0);
+    EXPECT_FALSE(stream.isExhausted());
+    feed(*live, 10, 3);
+    EXPECT_EQ(stream.fill(), 1);
+    EXPECT_FALSE(stream.isExhausted());
+    live->close();
+    EXPECT_EQ(stream.fill(), 0);
+    EXPECT_TRUE(stream.isExhausted());
+}
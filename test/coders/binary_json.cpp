@@ -37,3 +37,56 @@ TEST(BJSON, EncodeDecode) {
         }
     }
 }
+
+TEST(BJSON, StreamingWriteRead) {
+    ByteBuilder builder;
+    json::BinaryWriter writer(builder);
+    writer.beginObject();
+    writer.put("id", 70000);
+    writer.put("name", "inventory");
+    writer.put("fields", dv::object({{"durability", 0.5}}));
+    writer.beginList("slots");
+    for (int i = 0; i < 3; i++) {
+        writer.beginObject();
+        writer.put("id", i * 100);
+        writer.put("count", -i);
+        writer.endObject();
+    }
+    writer.endList();
+    writer.put("last", true);
+    writer.endObject();
+
+    auto tree = json::from_binary(builder.data(), builder.size());
+    EXPECT_EQ(tree["id"].asInteger(), 70000);
+    EXPECT_EQ(tree["slots"][2]["id"].asInteger(), 200);
+    EXPECT_EQ(tree["last"].asBoolean(), true);
+    EXPECT_EQ(json::to_binary(tree), builder.build());
+
+    auto compressed = json::to_binary(tree, true);
+    json::BinaryReader reader(compressed.data(), compressed.size());
+    reader.beginObject();
+    EXPECT_EQ(reader.readKey(), "id");
+    EXPECT_EQ(reader.readInteger(), 70000);
+    EXPECT_EQ(reader.readKey(), "name");
+    EXPECT_EQ(reader.readString(), "inventory");
+    EXPECT_EQ(reader.readKey(), "fields");
+    reader.skipValue();
+    EXPECT_EQ(reader.readKey(), "slots");
+    size_t slots = reader.position();
+    reader.skipValue();
+    EXPECT_EQ(reader.readKey(), "last");
+    EXPECT_TRUE(reader.readBoolean());
+    EXPECT_FALSE(reader.hasNext());
+    reader.endObject();
+
+    reader.seek(slots);
+    reader.beginList();
+    int count = 0;
+    while (reader.hasNext()) {
+        auto slot = reader.readValue();
+        EXPECT_EQ(slot["count"].asInteger(), -count);
+        count++;
+    }
+    reader.endList();
+    EXPECT_EQ(count, 3);
+}
@@ -18,3 +18,24 @@ TEST(byte_utils, BytesBuildAndRead) {
     EXPECT_EQ(reader.getInt32(), 123456789);
     EXPECT_EQ(reader.getInt64(), 98765432123456789LL);
 }
+
+TEST(byte_utils, BuilderGrowth) {
+    // Короткие записи не должны перевыделять буфер каждый раз
+    ByteBuilder builder;
+    const ubyte chunk[3] {1, 2, 3};
+    const ubyte* data = builder.data();
+    int reallocations = 0;
+    for (int i = 0; i < 10000; ++i) {
+        builder.put(chunk, sizeof(chunk));
+        builder.putCStr("ab");
+        if (builder.data() != data) {
+            data = builder.data();
+            reallocations++;
+        }
+    }
+    EXPECT_LT(reallocations, 64);
+    ASSERT_EQ(builder.size(), 10000 * 6);
+    EXPECT_EQ(builder.data()[3], 'a');
+    EXPECT_EQ(builder.data()[5], 0);
+    EXPECT_EQ(builder.data()[6 * 9999 + 2], 3);
+}
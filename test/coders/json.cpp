@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include <memory>
 
+#include <coders/commons.h>
 #include <coders/json.h>
 #include <util/stringutil.h>
 
@@ -47,3 +49,37 @@ TEST(JSON, EncodeDecode) {
         }
     }
 }
+
+TEST(JSON, ParseExtensions) {
+    auto object = json::parse(R"({
+        "name": "a\"b\\nA",
+        "list": [1, -2, +3, 0x10, 1.5, 2e3, -inf, nan, null, false,],
+        "nested": {"empty": {}, "ids": [],},
+    })");
+    EXPECT_EQ(object["name"].asString(), "a\"b\\nA");
+    const auto& list = object["list"];
+    ASSERT_EQ(list.size(), 10);
+    EXPECT_EQ(list[0].asInteger(), 1);
+    EXPECT_EQ(list[1].asInteger(), -2);
+    EXPECT_EQ(list[2].asInteger(), 3);
+    EXPECT_EQ(list[3].asInteger(), 16);
+    EXPECT_DOUBLE_EQ(list[4].asNumber(), 1.5);
+    EXPECT_DOUBLE_EQ(list[5].asNumber(), 2000.0);
+    EXPECT_TRUE(std::isinf(list[6].asNumber()) && list[6].asNumber() < 0);
+    EXPECT_TRUE(std::isnan(list[7].asNumber()));
+    EXPECT_EQ(list[8].getType(), dv::value_type::None);
+    EXPECT_FALSE(list[9].asBoolean());
+    EXPECT_TRUE(object["nested"]["empty"].empty());
+
+    // Комментарии и одинарные кавычки разбираются полным парсером
+    auto commented = json::parse("{\n# comment\n\"key\": ['value'] }");
+    EXPECT_EQ(commented["key"][0].asString(), "value");
+}
+
+TEST(JSON, ParseErrors) {
+    EXPECT_THROW(json::parse("{\"a\": 1 \"b\": 2}"), parsing_error);
+    EXPECT_THROW(json::parse("{\"a\": tru}"), parsing_error);
+    EXPECT_THROW(json::parse("[1, 2"), parsing_error);
+    EXPECT_THROW(json::parse("{\"a\": \"b\n\"}"), parsing_error);
+    EXPECT_THROW(json::parse("{\"a\" 1}"), parsing_error);
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <coders/json_structural.h>
+
+TEST(JsonStructural, Positions) {
+    std::string_view source = R"({"a\"b": [1, -2.5, "x,y"], "c" : true})";
+    json::StructuralIndex index;
+    json::build_structural_index(source, index);
+    ASSERT_FALSE(index.requiresFallback);
+
+    std::string structurals;
+    for (uint32_t position : index.positions) {
+        structurals += source[position];
+    }
+    EXPECT_EQ(structurals, "{\":[1,-,\"],\":t}");
+}
+
+TEST(JsonStructural, EscapesAcrossBlocks) {
+    // Последовательности обратных слешей пересекают границу 64-байтных блоков
+    for (size_t padding = 55; padding < 70; ++padding) {
+        std::string source = "[\"" + std::string(padding, 'a') +
+                             "\\\\\\\"\\\\\", \"#'\"]";
+        json::StructuralIndex index;
+        json::build_structural_index(source, index);
+        ASSERT_FALSE(index.requiresFallback) << padding;
+        ASSERT_EQ(index.positions.size(), 5) << padding;
+        EXPECT_EQ(source[index.positions[3]], '"');
+        EXPECT_EQ(index.positions[4], source.size() - 1);
+    }
+}
+
+TEST(JsonStructural, Fallback) {
+    json::StructuralIndex index;
+    json::build_structural_index("{\n# comment\n}", index);
+    EXPECT_TRUE(index.requiresFallback);
+    json::build_structural_index("['single']", index);
+    EXPECT_TRUE(index.requiresFallback);
+    json::build_structural_index("[\"unclosed]", index);
+    EXPECT_TRUE(index.requiresFallback);
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include <content/ContentPack.h>
+#include <content/loading/ContentDocuments.h>
+#include <io/devices/StdfsDevice.h>
+
+namespace fs = std::filesystem;
+
+TEST(ContentDocuments, Preload) {
+    auto folder = fs::temp_directory_path() / "content_documents_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    std::vector<ContentPack> packs(2);
+    for (size_t i = 0; i < packs.size(); ++i) {
+        auto& pack = packs[i];
+        pack.id = "pack" + std::to_string(i);
+        pack.folder = io::path("test:" + pack.id);
+        io::create_directories(pack.folder / "blocks/nested");
+        io::create_directories(pack.folder / "items");
+        for (int j = 0; j < 20; ++j) {
+            io::write_string(
+                pack.folder / ("blocks/block" + std::to_string(j) + ".json"),
+                "{\"index\": " + std::to_string(j) + "}"
+            );
+        }
+        io::write_string(pack.folder / "blocks/nested/inner.json", "{}");
+        io::write_string(pack.folder / "blocks/_skipped.json", "{");
+        io::write_string(pack.folder / "items/broken.json", "{\"a\": ");
+    }
+
+    ContentDocuments documents;
+    documents.preload(packs, 4);
+    EXPECT_EQ(documents.size(), packs.size() * 22);
+
+    auto file = packs[1].folder / "blocks/block7.json";
+    EXPECT_TRUE(documents.exists(file));
+    EXPECT_EQ(documents.read(file)["index"].asInteger(), 7);
+    EXPECT_TRUE(documents.read(packs[0].folder / "blocks/nested/inner.json").empty());
+    // Ошибка разбора сообщается при каждом чтении
+    auto broken = packs[0].folder / "items/broken.json";
+    EXPECT_THROW(documents.read(broken), std::runtime_error);
+    EXPECT_THROW(documents.read(broken), std::runtime_error);
+    // Пропущенные при предзагрузке файлы читаются напрямую
+    EXPECT_THROW(
+        documents.read(packs[0].folder / "blocks/_skipped.json"),
+        std::runtime_error
+    );
+    EXPECT_FALSE(documents.exists(packs[0].folder / "blocks/missing.json"));
+
+    fs::remove_all(folder);
+}
+
+TEST(ContentDocuments, Cache) {
+    auto folder = fs::temp_directory_path() / "content_documents_cache_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    std::vector<ContentPack> packs(1);
+    packs[0].id = "pack";
+    packs[0].folder = io::path("test:pack");
+    io::create_directories(packs[0].folder / "blocks");
+    for (int j = 0; j < 20; ++j) {
+        io::write_string(
+            packs[0].folder / ("blocks/block" + std::to_string(j) + ".json"),
+            "{\"index\": " + std::to_string(j) + ", \"name\": \"b\"}"
+        );
+    }
+    io::write_string(packs[0].folder / "blocks/broken.json", "{\"a\": ");
+    io::path cacheFile = "test:content_cache.bin";
+
+    {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 2);
+        EXPECT_EQ(documents.getCacheHits(), 0);
+        EXPECT_TRUE(documents.saveCache(cacheFile));
+    }
+    {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 2);
+        EXPECT_EQ(documents.getCacheHits(), 20);
+        const auto& root = documents.read(packs[0].folder / "blocks/block3.json");
+        EXPECT_EQ(root["index"].asInteger(), 3);
+        EXPECT_EQ(root["name"].asString(), "b");
+        // Ошибочные файлы не кэшируются, но и не вызывают перезаписи
+        EXPECT_THROW(
+            documents.read(packs[0].folder / "blocks/broken.json"),
+            std::runtime_error
+        );
+        EXPECT_FALSE(documents.saveCache(cacheFile));
+    }
+    io::write_string(
+        packs[0].folder / "blocks/block3.json", "{\"index\": 300}"
+    );
+    io::create_directories(packs[0].folder / "items");
+    io::write_string(packs[0].folder / "items/new.json", "{}");
+    {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 1);
+        EXPECT_EQ(documents.getCacheHits(), 19);
+        EXPECT_EQ(
+            documents.read(packs[0].folder / "blocks/block3.json")["index"]
+                .asInteger(),
+            300
+        );
+        EXPECT_TRUE(documents.saveCache(cacheFile));
+    }
+    // Изменение, не меняющее размер файла, обнаруживается по содержимому
+    io::write_string(
+        packs[0].folder / "blocks/block3.json", "{\"index\": 301}"
+    );
+    {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 1);
+        EXPECT_EQ(documents.getCacheHits(), 20);
+        EXPECT_EQ(
+            documents.read(packs[0].folder / "blocks/block3.json")["index"]
+                .asInteger(),
+            301
+        );
+        EXPECT_TRUE(documents.saveCache(cacheFile));
+    }
+    // Повреждённый кэш игнорируется
+    io::write_string(cacheFile, "CFCD garbage");
+    {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 1);
+        EXPECT_EQ(documents.getCacheHits(), 0);
+        EXPECT_EQ(documents.size(), 22);
+    }
+    fs::remove_all(folder);
+}
+
+TEST(ContentDocuments, NullNotCached) {
+    auto folder = fs::temp_directory_path() / "content_documents_null_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    std::vector<ContentPack> packs(1);
+    packs[0].id = "pack";
+    packs[0].folder = io::path("test:pack");
+    io::create_directories(packs[0].folder / "blocks");
+    io::write_string(packs[0].folder / "blocks/plain.json", "{\"a\": 1}");
+    io::write_string(packs[0].folder / "blocks/null.json", "{\"a\": null}");
+    io::path cacheFile = "test:content_cache.bin";
+
+    {
+        ContentDocuments documents;
+        documents.preload(packs, 1);
+        // Документ с null не представим в BJSON и лишь отмечается в кэше
+        EXPECT_TRUE(documents.saveCache(cacheFile));
+    }
+    for (int i = 0; i < 2; ++i) {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload(packs, 1);
+        EXPECT_EQ(documents.getCacheHits(), 1);
+        EXPECT_TRUE(
+            documents.read(packs[0].folder / "blocks/null.json")["a"].getType() == dv::value_type::None
+        );
+        // Документ с null отмечен в кэше и не вызывает перезаписи
+        EXPECT_FALSE(documents.saveCache(cacheFile));
+    }
+    fs::remove_all(folder);
+}
+
+TEST(ContentDocuments, CacheKeepsOtherPacks) {
+    auto folder = fs::temp_directory_path() / "content_documents_keep_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    std::vector<ContentPack> packs(2);
+    for (size_t i = 0; i < packs.size(); ++i) {
+        auto& pack = packs[i];
+        pack.id = "pack" + std::to_string(i);
+        pack.folder = io::path("test:" + pack.id);
+        io::create_directories(pack.folder / "blocks");
+        io::write_string(
+            pack.folder / "blocks/block.json",
+            "{\"pack\": " + std::to_string(i) + "}"
+        );
+    }
+    io::path cacheFile = "test:content_cache.bin";
+
+    // Паки загружаются по очереди, как в разных мирах
+    for (const auto& pack : packs) {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload({pack}, 1);
+        EXPECT_EQ(documents.getCacheHits(), 0);
+        EXPECT_TRUE(documents.saveCache(cacheFile));
+    }
+    for (const auto& pack : packs) {
+        ContentDocuments documents;
+        documents.loadCache(cacheFile);
+        documents.preload({pack}, 1);
+        EXPECT_EQ(documents.getCacheHits(), 1);
+        EXPECT_FALSE(documents.saveCache(cacheFile));
+    }
+    fs::remove_all(folder);
+}
@@ -27,3 +27,45 @@ TEST(dv, dv) {
         }
     }
 }
+
+TEST(dv, ObjectOrderAndErase) {
+    auto value = dv::object();
+    for (int i = 0; i < 40; i++) {
+        value["key" + std::to_string(i)] = i;
+    }
+    value.erase("key3");
+    value.erase("key20");
+    EXPECT_EQ(value.size(), 38);
+    EXPECT_FALSE(value.has("key3"));
+    EXPECT_EQ(value["key39"].asInteger(), 39);
+
+    int expected = 0;
+    for (const auto& [key, elem] : value.asObject()) {
+        if (expected == 3 || expected == 20) {
+            expected++;
+        }
+        EXPECT_EQ(key, "key" + std::to_string(expected));
+        EXPECT_EQ(elem.asInteger(), expected);
+        expected++;
+    }
+    for (int i = 38; i > 5; i--) {
+        value.erase("key" + std::to_string(i));
+    }
+    EXPECT_EQ(value["key1"].asInteger(), 1);
+    EXPECT_EQ(value["key39"].asInteger(), 39);
+}
+
+TEST(dv, ObjectKeys) {
+    std::string longKey(dv::keys::MAX_LENGTH + 1, 'k');
+    auto value = dv::object({{"a", 1}, {longKey, 2}});
+    auto copy = std::make_shared<dv::objects::Object>(value.asObject());
+    value.erase(longKey);
+    EXPECT_EQ(dv::value(copy)[longKey].asInteger(), 2);
+
+    EXPECT_EQ(dv::keys::intern("a"), dv::keys::intern(std::string("a")));
+    EXPECT_EQ(dv::keys::intern(longKey), nullptr);
+
+    const auto& constValue = value;
+    EXPECT_EQ(constValue["missing"], nullptr);
+    EXPECT_FALSE(value.has("missing"));
+}
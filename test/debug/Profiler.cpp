@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <filesystem>
+
+#include <debug/Profiler.h>
+#include <coders/json.h>
+#include <io/io.h>
+#include <io/devices/StdfsDevice.h>
+
+// Без поддержки профилировщика зоны не записываются
+#ifdef CHROMA_ENABLE_PROFILER
+
+using namespace debug;
+
+namespace fs = std::filesystem;
+
+static void nested_zones() {
+    ProfileZone outer("outer");
+    for (int i = 0; i < 3; ++i) {
+        ProfileZone inner("inner");
+    }
+    ProfileZone other("other");
+}
+
+TEST(Profiler, FrameSummary) {
+    Profiler::setEnabled(true);
+    Profiler::frame();
+    nested_zones();
+    nested_zones();
+    Profiler::frame();
+
+    auto nodes = Profiler::getLastFrame();
+    ASSERT_EQ(nodes.size(), 3);
+    EXPECT_STREQ(nodes[0].name, "outer");
+    EXPECT_EQ(nodes[0].depth, 0);
+    EXPECT_EQ(nodes[0].calls, 2);
+    EXPECT_STREQ(nodes[1].name, "inner");
+    EXPECT_EQ(nodes[1].depth, 1);
+    EXPECT_EQ(nodes[1].calls, 6);
+    EXPECT_STREQ(nodes[2].name, "other");
+    EXPECT_EQ(nodes[2].depth, 1);
+    EXPECT_GE(nodes[0].time, nodes[1].time);
+
+    Profiler::frame();
+    EXPECT_TRUE(Profiler::getLastFrame().empty());
+    Profiler::setEnabled(false);
+}
+
+TEST(Profiler, ScriptZones) {
+    Profiler::setEnabled(true);
+    Profiler::frame();
+    {
+        ProfileZone zone("engine");
+        // Незакрытая зона скрипта закрывается вместе с зоной движка
+        Profiler::beginZone(Profiler::intern("script"), true);
+        Profiler::beginZone(Profiler::intern("script"), true);
+        Profiler::endScriptZone();
+    }
+    // Лишний вызов не закрывает чужих зон
+    Profiler::endScriptZone();
+    Profiler::frame();
+
+    auto nodes = Profiler::getLastFrame();
+    ASSERT_EQ(nodes.size(), 3);
+    EXPECT_STREQ(nodes[0].name, "engine");
+    EXPECT_STREQ(nodes[1].name, "script");
+    EXPECT_EQ(nodes[1].calls, 1);
+    EXPECT_EQ(nodes[2].depth, 2);
+    Profiler::setEnabled(false);
+}
+
+TEST(Profiler, Capture) {
+    auto folder = fs::temp_directory_path() / "profiler_test";
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    Profiler::startCapture();
+    nested_zones();
+    std::thread thread([]() {
+        Profiler::setThreadName("worker \"1\"");
+        ProfileZone zone("job");
+    });
+    thread.join();
+    Profiler::frame();
+    nested_zones();
+    EXPECT_EQ(Profiler::stopCapture("test:trace.json"), 2 * 5 + 1);
+    Profiler::setEnabled(false);
+
+    auto root = json::parse(io::read_string("test:trace.json"));
+    const auto& events = root["traceEvents"];
+    size_t zones = 0;
+    bool namedThread = false;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i];
+        if (event["ph"].asString() == "X") {
+            EXPECT_GE(event["dur"].asNumber(), 0.0);
+            zones++;
+        } else if (event["args"]["name"].asString() == "worker \"1\"") {
+            namedThread = true;
+        }
+    }
+    EXPECT_EQ(zones, 11);
+    EXPECT_TRUE(namedThread);
+    fs::remove_all(folder);
+}
+
+#endif // CHROMA_ENABLE_PROFILER
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include <graphics/core/Atlas.h>
+#include <graphics/core/ImageData.h>
+
+static std::unique_ptr<ImageData> make_image(uint width, uint height, int seed) {
+    auto image = std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
+    ubyte* data = image->getData();
+    for (size_t i = 0; i < image->getDataSize(); ++i) {
+        data[i] = static_cast<ubyte>(i * 31 + seed * 17);
+    }
+    return image;
+}
+
+static AtlasBuilder make_builder() {
+    AtlasBuilder builder;
+    for (int i = 0; i < 200; ++i) {
+        builder.add(
+            "image" + std::to_string(i),
+            make_image(8 + (i * 5) % 25, 8 + (i * 11) % 19, i)
+        );
+    }
+    return builder;
+}
+
+TEST(Atlas, ParallelBuildMatchesSerial) {
+    auto serial = make_builder().build(2, false, 4096, 1);
+    auto parallel = make_builder().build(2, false, 4096, 4);
+
+    const auto& a = *serial->getImage();
+    const auto& b = *parallel->getImage();
+    ASSERT_EQ(a.getWidth(), b.getWidth());
+    ASSERT_EQ(a.getHeight(), b.getHeight());
+    EXPECT_EQ(std::memcmp(a.getData(), b.getData(), a.getDataSize()), 0);
+
+    // Изображение скопировано в свой регион
+    auto image = make_image(8 + (7 * 5) % 25, 8 + (7 * 11) % 19, 7);
+    const auto& region = parallel->get("image7");
+    uint x = region.u1 * b.getWidth();
+    uint y = region.v1 * b.getHeight();
+    for (uint row = 0; row < image->getHeight(); ++row) {
+        EXPECT_EQ(
+            std::memcmp(
+                b.getData() + ((y + row) * b.getWidth() + x) * 4,
+                image->getData() + row * image->getWidth() * 4,
+                image->getWidth() * 4
+            ),
+            0
+        );
+    }
+}
+
+TEST(Atlas, MaxResolution) {
+    EXPECT_THROW(make_builder().build(2, false, 64), std::runtime_error);
+}
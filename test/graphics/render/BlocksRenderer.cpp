@@ -0,0 +1,224 @@
+#include <graphics/render/BlocksRenderer.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <content/Content.h>
+#include <frontend/ContentGfxCache.h>
+#include <math/UVRegion.h>
+
+/// Сравнивает специализированный путь blockCube с универсальным:
+/// проверкой каждой грани через isOpen и построением через faceAO/face
+struct BlocksRendererTester {
+    BlocksRenderer& renderer;
+
+    void bind(const Chunk& chunk, const VoxelsRenderVolume& volume) {
+        renderer.chunk = &chunk;
+        renderer.voxelsBuffer = &volume;
+        renderer.occludersY = std::numeric_limits<int>::min();
+    }
+
+    void clear() {
+        renderer.vertexCount = 0;
+        renderer.vertexOffset = 0;
+        renderer.indexCount = 0;
+    }
+
+    void genericCube(
+        const glm::ivec3& coord,
+        const UVRegion (&faces)[6],
+        const Block& block,
+        blockstate state,
+        bool lights,
+        bool ao
+    ) {
+        auto& r = renderer;
+        const auto& variant = block.getVariantByBits(state.userbits);
+        glm::ivec3 X(1, 0, 0);
+        glm::ivec3 Y(0, 1, 0);
+        glm::ivec3 Z(0, 0, 1);
+        if (block.rotatable) {
+            const auto& orient = block.rotations.variants[state.rotation];
+            X = orient.axes[0];
+            Y = orient.axes[1];
+            Z = orient.axes[2];
+        }
+        const glm::ivec3 axes[6][3] {
+            {X, Y, Z}, {-X, Y, -Z}, {X, -Z, Y},
+            {X, Z, -Y}, {-Z, Y, X}, {Z, Y, -X},
+        };
+        const int sides[6] {5, 4, 3, 2, 1, 0};
+        for (int i = 0; i < 6; ++i) {
+            const auto& [axisX, axisY, axisZ] = axes[i];
+            if (!r.isOpen(coord + axisZ, block, variant)) continue;
+            const auto& region = faces[sides[i]];
+            if (ao) {
+                r.faceAO(coord, axisX, axisY, axisZ, region, lights);
+            } else {
+                auto tint = lights ? r.pickLight(coord + axisZ)
+                                   : glm::vec4(1, 1, 1, 0);
+                r.face(coord, axisX, axisY, axisZ, region, tint, lights);
+            }
+        }
+    }
+
+    void specialisedCube(
+        const glm::ivec3& coord,
+        const UVRegion (&faces)[6],
+        const Block& block,
+        blockstate state,
+        bool lights,
+        bool ao
+    ) {
+        auto& r = renderer;
+        r.updateClosedFaces(coord.y, coord.z);
+        const auto& variant = block.getVariantByBits(state.userbits);
+        uint closed = variant.culling == CullingMode::Default
+                          ? r.closedFaces[coord.x]
+                          : 0;
+        r.blockCube(coord, faces, block, state, lights, ao, closed);
+    }
+
+    size_t vertexCount() const {
+        return renderer.vertexCount;
+    }
+
+    size_t indexCount() const {
+        return renderer.indexCount;
+    }
+
+    const ChunkVertex& vertex(size_t index) const {
+        return renderer.vertexBuffer[index];
+    }
+
+    uint32_t indexAt(size_t index) const {
+        return renderer.indexBuffer[index];
+    }
+};
+
+TEST(BlocksRenderer, CubeMatchesGeneric) {
+    Block air("core:air");
+    air.rt.id = 0;
+    air.defaults.rt.solid = false;
+    air.rt.solid = false;
+
+    Block stone("base:stone");
+    stone.rt.id = 1;
+
+    Block log("base:log");
+    log.rt.id = 2;
+    log.rotatable = true;
+    log.rotations = BlockRotProfile::PIPE;
+
+    Block glass("base:glass");
+    glass.rt.id = 3;
+    glass.defaults.drawGroup = 2;
+
+    Block stairs("base:stairs");
+    stairs.rt.id = 4;
+    stairs.rotatable = true;
+    stairs.rotations = BlockRotProfile::STAIRS;
+
+    Block leaves("base:leaves");
+    leaves.rt.id = 5;
+    leaves.defaults.culling = CullingMode::Optional;
+
+    Block fence("base:fence");
+    fence.rt.id = 6;
+    fence.defaults.culling = CullingMode::Disabled;
+
+    const Block* defs[] {&air, &stone, &log, &glass, &stairs, &leaves, &fence};
+    constexpr int blocksCount = std::size(defs);
+    // Как в ContentIndices
+    ubyte props[blocksCount] {};
+    for (int id = 0; id < blocksCount; ++id) {
+        const auto& variant = defs[id]->defaults;
+        if (variant.rt.solid && variant.drawGroup == 0) {
+            props[id] = BLOCK_PROP_OCCLUDER;
+        }
+    }
+
+    EngineSettings settings {};
+    // Кэш текстур не используется: области граней передаются явно
+    alignas(ContentGfxCache) static char cacheStorage[sizeof(ContentGfxCache)];
+    const auto& cache = *reinterpret_cast<const ContentGfxCache*>(cacheStorage);
+
+    BlocksRenderer generic(1 << 16, defs, props, cache, settings);
+    BlocksRenderer specialised(1 << 16, defs, props, cache, settings);
+    BlocksRendererTester a {generic};
+    BlocksRendererTester b {specialised};
+
+    Chunk chunk(3, -2);
+    auto volume = std::make_unique<VoxelsRenderVolume>();
+    volume->setPosition(
+        chunk.chunk_x * CHUNK_WIDTH - VOXELS_BUFFER_PADDING,
+        0,
+        chunk.chunk_z * CHUNK_DEPTH - VOXELS_BUFFER_PADDING
+    );
+    std::mt19937 rng(5);
+    for (size_t i = 0; i < VoxelsRenderVolume::size; ++i) {
+        // Около 2% - незагруженные соседи (BLOCK_VOID)
+        blockid_t id = rng() % 50 == 0
+                           ? BLOCK_VOID
+                           : (rng() % 3 == 0 ? 0 : rng() % blocksCount);
+        uint8_t rotation = rng() % 6;
+        volume->getVoxels()[i] = voxel {id, blockstate {rotation, 0, 0, 0}};
+        volume->getLights()[i] = rng() & 0xFFFF;
+    }
+    a.bind(chunk, *volume);
+    b.bind(chunk, *volume);
+
+    UVRegion faces[6];
+    for (int i = 0; i < 6; ++i) {
+        faces[i] = UVRegion(i * 0.1f, 0, i * 0.1f + 0.05f, 0.5f);
+    }
+
+    const int layers[] {0, 1, 16, 17, 30, 31, CHUNK_HEIGHT - 2, CHUNK_HEIGHT - 1};
+    size_t vertices = 0;
+    for (int mode = 0; mode < 4; ++mode) {
+        bool lights = mode & 1;
+        bool ao = mode & 2;
+        for (int y : layers) {
+            for (int z = 0; z < CHUNK_DEPTH; ++z) {
+                for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                    const auto& vox = volume->pickBlock(
+                        chunk.chunk_x * CHUNK_WIDTH + x,
+                        y,
+                        chunk.chunk_z * CHUNK_DEPTH + z
+                    );
+                    if (vox.id == BLOCK_AIR || vox.id == BLOCK_VOID) continue;
+
+                    const auto& def = *defs[vox.id];
+                    glm::ivec3 coord(x, y, z);
+                    a.clear();
+                    b.clear();
+                    a.genericCube(coord, faces, def, vox.state, lights, ao);
+                    b.specialisedCube(coord, faces, def, vox.state, lights, ao);
+
+                    ASSERT_EQ(a.vertexCount(), b.vertexCount())
+                        << "mode " << mode << " at " << x << " " << y << " "
+                        << z;
+                    ASSERT_EQ(a.indexCount(), b.indexCount());
+                    for (size_t i = 0; i < a.vertexCount(); ++i) {
+                        const auto& va = a.vertex(i);
+                        const auto& vb = b.vertex(i);
+                        ASSERT_EQ(va.position, vb.position);
+                        ASSERT_EQ(va.uv, vb.uv);
+                        ASSERT_EQ(va.normal, vb.normal);
+                        for (int c = 0; c < 4; ++c) {
+                            // Специализированный путь усредняет освещение
+                            // целочисленно
+                            ASSERT_LE(std::abs(va.color[c] - vb.color[c]), 1);
+                        }
+                    }
+                    for (size_t i = 0; i < a.indexCount(); ++i) {
+                        ASSERT_EQ(a.indexAt(i), b.indexAt(i));
+                    }
+                    vertices += a.vertexCount();
+                }
+            }
+        }
+    }
+    EXPECT_GT(vertices, 0);
+}
@@ -0,0 +1,115 @@
+#include <graphics/render/ChunkMeshCache.h>
+
+#include <gtest/gtest.h>
+
+#include <io/devices/StdfsDevice.h>
+
+namespace fs = std::filesystem;
+
+static ChunkMeshCache::Entry make_entry(int section, uint64_t hash) {
+    ChunkVertex vertices[3] {};
+    for (int i = 0; i < 3; ++i) {
+        vertices[i].position = glm::vec3(i, section, 1);
+        vertices[i].color = {10, 20, 30, static_cast<uint8_t>(i)};
+    }
+
+    ChunkMeshData data {};
+    data.section = section;
+    data.vertices = MeshBuffer<ChunkVertex>(3);
+    std::copy(vertices, vertices + 3, data.vertices.data());
+    data.indices = MeshBuffer<uint32_t>(3);
+    for (uint32_t i = 0; i < 3; ++i) {
+        data.indices[i] = i;
+    }
+    data.sortingMesh.vertices = util::Buffer<ChunkVertex>(vertices, 2);
+    data.sortingMesh.indices = util::Buffer<uint32_t> {1, 0, 1};
+    data.meshAABB = AABB(glm::vec3(0), glm::vec3(16));
+    data.visibility.connect(0, 3);
+    return ChunkMeshCache::Entry {hash, std::move(data)};
+}
+
+TEST(ChunkMeshCache, StoreLoad) {
+    auto folder = fs::temp_directory_path() / "chromaforge_mesh_cache_test";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    ChunkMeshCache cache("test:meshes", 42);
+    cache.store(-3, 5, make_entry(2, 0xDEADBEEF));
+    cache.store(-3, 5, make_entry(7, 123));
+
+    for (int section = 0; section < CHUNK_SECTIONS; ++section) {
+        EXPECT_EQ(
+            cache.load(-3, 5, section).has_value(),
+            section == 2 || section == 7
+        );
+    }
+    auto loaded = cache.load(-3, 5, 2);
+    ASSERT_TRUE(loaded.has_value());
+    const auto& entry = *loaded;
+    EXPECT_EQ(entry.hash, 0xDEADBEEF);
+    EXPECT_EQ(entry.data.section, 2);
+    ASSERT_EQ(entry.data.vertices.size(), 3);
+    EXPECT_EQ(entry.data.vertices[2].position, glm::vec3(2, 2, 1));
+    EXPECT_EQ(entry.data.vertices[2].color[3], 2);
+    ASSERT_EQ(entry.data.indices.size(), 3);
+    EXPECT_EQ(entry.data.indices[2], 2);
+    EXPECT_EQ(entry.data.denseIndices.size(), 0);
+    ASSERT_EQ(entry.data.sortingMesh.vertices.size(), 2);
+    EXPECT_EQ(entry.data.sortingMesh.vertices[1].position, glm::vec3(1, 2, 1));
+    ASSERT_EQ(entry.data.sortingMesh.indices.size(), 3);
+    EXPECT_EQ(entry.data.sortingMesh.indices[0], 1);
+    EXPECT_TRUE(entry.data.visibility.isConnected(3, 0));
+    EXPECT_FALSE(entry.data.visibility.isConnected(1, 0));
+    EXPECT_EQ(entry.data.meshAABB.max(), glm::vec3(16));
+
+    // Перезапись одной секции не затрагивает другие
+    cache.store(-3, 5, make_entry(2, 77));
+    EXPECT_EQ(cache.load(-3, 5, 2)->hash, 77);
+    EXPECT_EQ(cache.load(-3, 5, 7)->hash, 123);
+
+    // Другая соль - другой контент или настройки: записи отбрасываются
+    ChunkMeshCache other("test:meshes", 43);
+    EXPECT_FALSE(other.load(-3, 5, 2).has_value());
+    EXPECT_FALSE(other.load(0, 0, 0).has_value());
+
+    io::remove_device("test");
+    fs::remove_all(folder);
+}
+
+TEST(ChunkMeshCache, Eviction) {
+    auto folder = fs::temp_directory_path() / "chromaforge_mesh_cache_evict";
+    fs::remove_all(folder);
+    fs::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+
+    size_t fileSize;
+    {
+        ChunkMeshCache probe("test:probe", 1);
+        probe.store(0, 0, make_entry(0, 1));
+        fileSize = probe.getSize();
+        ASSERT_GT(fileSize, 0);
+    }
+    // Помещается ровно три файла одного размера
+    ChunkMeshCache cache("test:meshes", 1, fileSize * 3);
+    cache.store(0, 0, make_entry(0, 1));
+    cache.store(1, 0, make_entry(0, 1));
+    cache.store(2, 0, make_entry(0, 1));
+    EXPECT_EQ(cache.getSize(), fileSize * 3);
+
+    // Чтение продлевает жизнь файла: вытесняется (1, 0)
+    EXPECT_TRUE(cache.load(0, 0, 0).has_value());
+    cache.store(3, 0, make_entry(0, 1));
+    EXPECT_LE(cache.getSize(), fileSize * 3);
+    EXPECT_TRUE(cache.load(0, 0, 0).has_value());
+    EXPECT_FALSE(cache.load(1, 0, 0).has_value());
+    EXPECT_TRUE(cache.load(2, 0, 0).has_value());
+    EXPECT_TRUE(cache.load(3, 0, 0).has_value());
+
+    // Лимит применяется и к файлам, оставшимся с прошлого запуска
+    ChunkMeshCache smaller("test:meshes", 1, fileSize);
+    EXPECT_EQ(smaller.getSize(), fileSize);
+
+    io::remove_device("test");
+    fs::remove_all(folder);
+}
@@ -0,0 +1,86 @@
+#include <graphics/render/MeshBuffersPool.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+TEST(MeshBuffersPool, ClassSize) {
+    EXPECT_EQ(MeshBuffersPool::classSize(1), 4096);
+    EXPECT_EQ(MeshBuffersPool::classSize(4096), 4096);
+    EXPECT_EQ(MeshBuffersPool::classSize(4097), 5120);
+    EXPECT_EQ(MeshBuffersPool::classSize(8192), 8192);
+    EXPECT_EQ(MeshBuffersPool::classSize(8193), 10240);
+    for (size_t bytes = 1; bytes < 1'000'000; bytes += 997) {
+        size_t size = MeshBuffersPool::classSize(bytes);
+        EXPECT_GE(size, bytes);
+        EXPECT_LE(size, std::max<size_t>(4096, bytes + bytes / 4));
+    }
+}
+
+TEST(MeshBuffersPool, Reuse) {
+    MeshBuffersPool pool(1 << 20);
+    const void* first;
+    {
+        auto buffer = pool.acquire<uint32_t>(1000, false);
+        ASSERT_TRUE(buffer.has_value());
+        ASSERT_EQ(buffer->size(), 1000);
+        (*buffer)[999] = 42;
+        first = buffer->data();
+        EXPECT_EQ(pool.getStats().usedBytes, 4096);
+    }
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.usedBytes, 0);
+    EXPECT_EQ(stats.allocatedBytes, 4096);
+
+    // Буфер того же класса переиспользуется
+    auto buffer = pool.acquire<uint32_t>(900, false);
+    EXPECT_EQ(buffer->data(), first);
+    EXPECT_EQ(pool.getStats().reused, 1);
+    EXPECT_EQ(pool.getStats().acquired, 2);
+
+    EXPECT_EQ(pool.acquire<uint32_t>(0, false)->data(), nullptr);
+}
+
+TEST(MeshBuffersPool, Limit) {
+    MeshBuffersPool pool(8192);
+    {
+        auto a = pool.acquire<ubyte>(4096, false);
+        auto b = pool.acquire<ubyte>(4096, false);
+        ASSERT_TRUE(a && b);
+        // Лимит не превышается ни с ожиданием, ни без него
+        EXPECT_FALSE(pool.acquire<ubyte>(4096, false).has_value());
+        EXPECT_FALSE(pool.acquire<ubyte>(4096, true).has_value());
+        auto stats = pool.getStats();
+        EXPECT_EQ(stats.usedBytes, 2 * 4096);
+        EXPECT_EQ(stats.waits, 1);
+        EXPECT_EQ(stats.failures, 2);
+    }
+    auto stats = pool.getStats();
+    EXPECT_EQ(stats.usedBytes, 0);
+    EXPECT_LE(stats.allocatedBytes, 8192);
+
+    pool.setLimit(0);
+    EXPECT_EQ(pool.getStats().allocatedBytes, 0);
+
+    // Буфер больше лимита выдаётся только при пустом пуле
+    pool.setLimit(4096);
+    auto big = pool.acquire<ubyte>(16384, false);
+    ASSERT_TRUE(big.has_value());
+    EXPECT_FALSE(pool.acquire<ubyte>(1, false).has_value());
+}
+
+TEST(MeshBuffersPool, WaitForRelease) {
+    MeshBuffersPool pool(4096);
+    auto held = std::make_unique<std::optional<MeshBuffer<ubyte>>>(
+        pool.acquire<ubyte>(4096, false)
+    );
+    std::thread releaser([&held]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        held.reset();
+    });
+    // Ожидающий получает буфер, как только память освобождается
+    auto buffer = pool.acquire<ubyte>(4096, true);
+    releaser.join();
+    EXPECT_TRUE(buffer.has_value());
+}
@@ -0,0 +1,94 @@
+#include <graphics/render/SectionsOcclusion.h>
+
+#include <gtest/gtest.h>
+
+#include <voxels/Block.h>
+
+static constexpr int SECTION_VOLUME =
+    CHUNK_WIDTH * CHUNK_SECTION_HEIGHT * CHUNK_DEPTH;
+
+class SectionsOcclusionTest : public ::testing::Test {
+protected:
+    Block air {"core:air"};
+    Block stone {"base:stone"};
+    const Block* defs[2] {&air, &stone};
+    voxel voxels[CHUNK_VOLUME] {};
+
+    void SetUp() override {
+        air.lightPassing = true;
+        air.defaults.rt.solid = false;
+    }
+
+    void fill(blockid_t id) {
+        for (auto& vox : voxels) {
+            vox.id = id;
+        }
+    }
+};
+
+TEST_F(SectionsOcclusionTest, UniformSections) {
+    fill(0);
+    EXPECT_EQ(
+        compute_section_visibility(voxels, defs, 0).bits,
+        SectionVisibility::ALL_BITS
+    );
+    fill(1);
+    EXPECT_EQ(compute_section_visibility(voxels, defs, 3).bits, 0);
+}
+
+TEST_F(SectionsOcclusionTest, Tunnel) {
+    fill(1);
+    const int section = 2;
+    int y = section * CHUNK_SECTION_HEIGHT + 5;
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        voxels[vox_index(x, y, 7)].id = 0;
+    }
+    auto visibility = compute_section_visibility(voxels, defs, section);
+    EXPECT_TRUE(visibility.isConnected(0, 1));
+    EXPECT_TRUE(visibility.isConnected(1, 0));
+    EXPECT_FALSE(visibility.isConnected(0, 3));
+    EXPECT_FALSE(visibility.isConnected(4, 5));
+
+    // Соседняя секция не затронута
+    EXPECT_EQ(compute_section_visibility(voxels, defs, section + 1).bits, 0);
+}
+
+TEST(SectionsOcclusion, SolidLayerHidesSectionsBelow) {
+    SectionsOcclusion occlusion;
+    const int solidSection = 4;
+    std::vector<glm::ivec3> visible;
+    bool collected = occlusion.collect(
+        glm::vec3(8.5f, 200.0f, 8.5f),
+        {-2, -2},
+        {5, 5},
+        nullptr,
+        [=](int, int section, int) {
+            return section == solidSection
+                ? SectionVisibility {}
+                : SectionVisibility::all();
+        },
+        [&](int x, int section, int z) {
+            visible.push_back({x, section, z});
+        }
+    );
+    ASSERT_TRUE(collected);
+    EXPECT_EQ(visible.at(0), glm::ivec3(0, 200 / CHUNK_SECTION_HEIGHT, 0));
+    for (const auto& pos : visible) {
+        // Сплошной слой виден, но секции под ним - нет
+        EXPECT_GE(pos.y, solidSection);
+    }
+    EXPECT_EQ(visible.size(), 5 * 5 * (CHUNK_SECTIONS - solidSection));
+}
+
+TEST(SectionsOcclusion, CameraOutsideArea) {
+    SectionsOcclusion occlusion;
+    bool collected = occlusion.collect(
+        glm::vec3(1000.0f, 64.0f, 0.0f),
+        {0, 0},
+        {2, 2},
+        nullptr,
+        [](int, int, int) { return SectionVisibility::all(); },
+        [](int, int, int) {}
+    );
+    EXPECT_FALSE(collected);
+}
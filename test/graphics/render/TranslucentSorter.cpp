@@ -0,0 +1,40 @@
+#include <graphics/render/TranslucentSorter.h>
+
+#include <gtest/gtest.h>
+
+static TranslucentGeometry make_row(uint32_t count) {
+    // Треугольники вдоль оси x; вершины треугольника i - 3i, 3i+1, 3i+2
+    TranslucentGeometry geometry;
+    for (uint32_t i = 0; i < count; ++i) {
+        geometry.centroids.emplace_back(i, 0, 0);
+        geometry.indices.insert(geometry.indices.end(), {i * 3, i * 3 + 1, i * 3 + 2});
+    }
+    return geometry;
+}
+
+TEST(TranslucentSorter, FarToNear) {
+    auto geometry = make_row(8);
+    TranslucentSorter sorter;
+    std::vector<uint32_t> indices;
+
+    sorter.sort(geometry, glm::vec3(-1, 0, 0), indices);
+    ASSERT_EQ(indices.size(), geometry.indices.size());
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(indices[i * 3], (7 - i) * 3);
+        EXPECT_EQ(indices[i * 3 + 2], (7 - i) * 3 + 2);
+    }
+
+    sorter.sort(geometry, glm::vec3(100, 0, 0), indices);
+    EXPECT_EQ(indices, geometry.indices);
+}
+
+TEST(TranslucentSorter, EqualDistancesKeepOrder) {
+    auto geometry = make_row(5);
+    for (auto& centroid : geometry.centroids) {
+        centroid = glm::vec3(1, 2, 3);
+    }
+    TranslucentSorter sorter;
+    std::vector<uint32_t> indices;
+    sorter.sort(geometry, glm::vec3(0), indices);
+    EXPECT_EQ(indices, geometry.indices);
+}
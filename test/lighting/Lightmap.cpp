@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <lighting/Lightmap.h>
+
+TEST(Lightmap, Sections) {
+    Lightmap lightmap;
+    EXPECT_EQ(lightmap.countMaterialized(), 0);
+
+    // Запись совпадающего значения не выделяет секцию
+    lightmap.setS(3, 40, 5, 0);
+    EXPECT_EQ(lightmap.countMaterialized(), 0);
+
+    lightmap.setR(3, 40, 5, 7);
+    lightmap.setS(3, 40, 5, 12);
+    EXPECT_EQ(lightmap.countMaterialized(), 1);
+    EXPECT_NE(lightmap.getSection(40 / CHUNK_SECTION_HEIGHT), nullptr);
+    EXPECT_EQ(lightmap.getR(3, 40, 5), 7);
+    EXPECT_EQ(lightmap.getS(3, 40, 5), 12);
+    EXPECT_EQ(lightmap.get(4, 40, 5), 0);
+
+    lightmap.setR(3, 40, 5, 0);
+    lightmap.setS(3, 40, 5, 0);
+    lightmap.compact();
+    EXPECT_EQ(lightmap.countMaterialized(), 0);
+    EXPECT_EQ(lightmap.get(3, 40, 5), 0);
+}
+
+TEST(Lightmap, FillSky) {
+    Lightmap lightmap;
+    lightmap.setB(0, 100, 0, 9);
+    lightmap.fillS(70, CHUNK_HEIGHT, 15);
+    // Целые однородные секции не выделяются, частичная и с синим светом - да
+    EXPECT_EQ(lightmap.countMaterialized(), 2);
+    EXPECT_EQ(lightmap.getS(5, 69, 5), 0);
+    EXPECT_EQ(lightmap.getS(5, 70, 5), 15);
+    EXPECT_EQ(lightmap.getS(15, CHUNK_HEIGHT - 1, 15), 15);
+    EXPECT_EQ(lightmap.getB(0, 100, 0), 9);
+    EXPECT_EQ(lightmap.getS(0, 100, 0), 15);
+}
+
+TEST(Lightmap, EncodeDecode) {
+    Lightmap lightmap;
+    lightmap.fillS(64, CHUNK_HEIGHT, 15);
+    lightmap.setS(1, 20, 2, 6);
+    // Свет блоков не сохраняется, секция кодируется однородной
+    lightmap.setR(0, 200, 0, 3);
+
+    uint32_t size;
+    auto data = lightmap.encode(size);
+    EXPECT_EQ(size, CHUNK_SECTIONS + LIGHTMAP_SECTION_VOLUME / 2);
+
+    Lightmap decoded;
+    ASSERT_TRUE(decoded.decode(data.get(), size));
+    EXPECT_EQ(decoded.countMaterialized(), 1);
+    for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                ASSERT_EQ(decoded.getS(x, y, z), lightmap.getS(x, y, z));
+                ASSERT_EQ(decoded.getR(x, y, z), 0);
+            }
+        }
+    }
+}
+
+TEST(Lightmap, DecodeFlat) {
+    // Прежний формат: по 4 бита неба на блок для всего чанка
+    auto data = std::make_unique<ubyte[]>(LIGHTMAP_DATA_LEN);
+    int skyFrom = 100 * CHUNK_WIDTH * CHUNK_DEPTH;
+    for (int i = 0; i < CHUNK_VOLUME; i += 2) {
+        data[i / 2] = i >= skyFrom ? 0xFF : 0x00;
+    }
+    data[10] = 0x5A;
+
+    Lightmap lightmap;
+    ASSERT_TRUE(lightmap.decode(data.get(), LIGHTMAP_DATA_LEN));
+    EXPECT_EQ(lightmap.countMaterialized(), 2);
+    EXPECT_EQ(lightmap.get(20), Lightmap::combine(0, 0, 0, 0xA));
+    EXPECT_EQ(lightmap.get(21), Lightmap::combine(0, 0, 0, 0x5));
+    EXPECT_EQ(lightmap.getS(0, 99, 0), 0);
+    EXPECT_EQ(lightmap.getS(0, 100, 0), 15);
+    EXPECT_EQ(lightmap.getS(0, 255, 0), 15);
+}
+
+TEST(Lightmap, DecodeCorrupted) {
+    Lightmap source;
+    source.setS(1, 20, 2, 6);
+    uint32_t size;
+    auto data = source.encode(size);
+
+    Lightmap lightmap;
+    lightmap.fillS(0, CHUNK_HEIGHT, 7);
+
+    // Запись обрезана или длиннее, чем требует заголовок
+    EXPECT_FALSE(lightmap.decode(data.get(), size - 1));
+    EXPECT_FALSE(lightmap.decode(data.get(), CHUNK_SECTIONS - 1));
+    auto longer = std::make_unique<ubyte[]>(size + 1);
+    std::copy(data.get(), data.get() + size, longer.get());
+    EXPECT_FALSE(lightmap.decode(longer.get(), size + 1));
+
+    // Значение однородной секции вне диапазона 0..15
+    data[5] = 0x10;
+    EXPECT_FALSE(lightmap.decode(data.get(), size));
+
+    // Отклонённые данные не меняют карту
+    EXPECT_EQ(lightmap.countMaterialized(), 0);
+    EXPECT_EQ(lightmap.getS(1, 20, 2), 7);
+}
+
+TEST(Lightmap, SetRowSky) {
+    Lightmap lightmap;
+    lightmap.setRowS(20, 3, 0, 15);
+    EXPECT_EQ(lightmap.countMaterialized(), 0);
+
+    lightmap.setG(4, 20, 3, 5);
+    lightmap.setRowS(20, 3, 0b10010, 15);
+    lightmap.setRowS(21, 0, 0xFFFF, 9);
+    EXPECT_EQ(lightmap.countMaterialized(), 1);
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        EXPECT_EQ(lightmap.getS(x, 20, 3), (x == 1 || x == 4) ? 15 : 0);
+        EXPECT_EQ(lightmap.getS(x, 21, 0), 9);
+        EXPECT_EQ(lightmap.getS(x, 20, 2), 0);
+    }
+    EXPECT_EQ(lightmap.getG(4, 20, 3), 5);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include <logic/ChunksInterest.h>
+
+struct Rect {
+    glm::ivec2 min;
+    glm::ivec2 max;
+};
+
+/// Число владельцев каждой позиции полным перебором прямоугольников
+static std::map<std::pair<int, int>, uint32_t> brute_force_refs(
+    const std::map<int64_t, Rect>& rects
+) {
+    std::map<std::pair<int, int>, uint32_t> refs;
+    for (const auto& [_, rect] : rects) {
+        for (int z = rect.min.y; z <= rect.max.y; ++z) {
+            for (int x = rect.min.x; x <= rect.max.x; ++x) {
+                refs[{x, z}]++;
+            }
+        }
+    }
+    return refs;
+}
+
+static void expect_matches(
+    const ChunksInterest& interest, const std::map<int64_t, Rect>& rects
+) {
+    auto expected = brute_force_refs(rects);
+    ASSERT_EQ(interest.size(), expected.size());
+    std::map<std::pair<int, int>, uint32_t> actual;
+    for (const auto& pos : interest.getPositions()) {
+        EXPECT_TRUE(actual.emplace(std::make_pair(pos.x, pos.y), 0).second)
+            << "duplicate";
+        actual[{pos.x, pos.y}] = interest.getRefs(pos.x, pos.y);
+    }
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(ChunksInterest, Overlap) {
+    ChunksInterest interest;
+    interest.setArea(1, {0, 0}, {3, 3});
+    interest.setArea(2, {2, 2}, {5, 5});
+    EXPECT_EQ(interest.size(), 16 + 16 - 4);
+    EXPECT_EQ(interest.getRefs(2, 3), 2);
+    EXPECT_EQ(interest.getRefs(0, 0), 1);
+    EXPECT_FALSE(interest.isRequired(6, 6));
+
+    // Полностью совпадающие области не увеличивают множество
+    interest.setArea(3, {0, 0}, {3, 3});
+    EXPECT_EQ(interest.size(), 28);
+    EXPECT_EQ(interest.getRefs(1, 1), 2);
+
+    interest.removeOwner(1);
+    interest.removeOwner(3);
+    EXPECT_EQ(interest.size(), 16);
+    EXPECT_FALSE(interest.isRequired(0, 0));
+    EXPECT_EQ(interest.getRefs(2, 2), 1);
+}
+
+TEST(ChunksInterest, Moves) {
+    ChunksInterest interest;
+    std::map<int64_t, Rect> rects {
+        {1, {{-4, -4}, {4, 4}}},
+        {2, {{0, -2}, {6, 3}}},
+    };
+    for (const auto& [id, rect] : rects) {
+        interest.setArea(id, rect.min, rect.max);
+    }
+    expect_matches(interest, rects);
+
+    const glm::ivec2 moves[] {{1, 0}, {1, 1}, {-3, 2}, {0, -1}, {20, -4}};
+    for (const auto& move : moves) {
+        auto& rect = rects[1];
+        rect.min += move;
+        rect.max += move;
+        interest.setArea(1, rect.min, rect.max);
+        expect_matches(interest, rects);
+
+        auto& other = rects[2];
+        other.min -= move;
+        other.max = other.min + glm::ivec2(3 + move.x % 3, 5);
+        interest.setArea(2, other.min, other.max);
+        expect_matches(interest, rects);
+    }
+}
+
+TEST(ChunksInterest, EndUpdate) {
+    ChunksInterest interest;
+    interest.beginUpdate();
+    interest.setArea(1, {0, 0}, {2, 2});
+    interest.setArea(2, {10, 10}, {11, 11});
+    interest.endUpdate();
+    EXPECT_EQ(interest.size(), 9 + 4);
+
+    // Владелец, чья область не задана в обновлении, больше не учитывается
+    interest.beginUpdate();
+    interest.setArea(1, {0, 0}, {2, 2});
+    interest.endUpdate();
+    EXPECT_EQ(interest.size(), 9);
+    EXPECT_FALSE(interest.isRequired(10, 10));
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include <logic/ChunksLoadQueue.h>
+#include <voxels/Chunk.h>
+
+using AreaMap = ChunksLoadQueue::AreaMap;
+
+/// Отсутствующие чанки зоны загрузки полным просмотром окна, как прежде
+/// делал ChunksController::loadVisible
+static std::set<std::pair<int, int>> brute_force_missing(
+    const AreaMap& area, int padding
+) {
+    int sizeX = area.getWidth();
+    int sizeZ = area.getDepth();
+    int minDistance = ((sizeX - padding * 2) / 2) * ((sizeZ - padding * 2) / 2);
+    std::set<std::pair<int, int>> missing;
+    for (int z = padding; z < sizeZ - padding; ++z) {
+        for (int x = padding; x < sizeX - padding; ++x) {
+            int lx = x - sizeX / 2;
+            int lz = z - sizeZ / 2;
+            if (lx * lx + lz * lz >= minDistance) {
+                continue;
+            }
+            int gx = x + area.getOffsetX();
+            int gz = z + area.getOffsetZ();
+            if (area.get(gx, gz) == nullptr) {
+                missing.emplace(gx, gz);
+            }
+        }
+    }
+    return missing;
+}
+
+static std::set<std::pair<int, int>> select_all(
+    ChunksLoadQueue& queue, const AreaMap& area
+) {
+    std::vector<glm::ivec2> selected;
+    queue.select(area, ChunksLoadFocus {}, queue.size(), selected);
+    std::set<std::pair<int, int>> result;
+    for (const auto& pos : selected) {
+        EXPECT_TRUE(result.emplace(pos.x, pos.y).second) << "duplicate";
+    }
+    return result;
+}
+
+static void fill(AreaMap& area) {
+    for (int z = 0; z < area.getDepth(); ++z) {
+        for (int x = 0; x < area.getWidth(); ++x) {
+            int gx = x + area.getOffsetX();
+            int gz = z + area.getOffsetZ();
+            if (area.get(gx, gz) == nullptr) {
+                area.set(gx, gz, std::make_shared<Chunk>(gx, gz));
+            }
+        }
+    }
+}
+
+TEST(ChunksLoadQueue, Rescan) {
+    AreaMap area(16, 12);
+    area.setCenter(3, -5);
+    ChunksLoadQueue queue;
+    EXPECT_TRUE(queue.update(area, 2));
+    EXPECT_FALSE(queue.update(area, 2));
+    EXPECT_EQ(select_all(queue, area), brute_force_missing(area, 2));
+}
+
+TEST(ChunksLoadQueue, Shift) {
+    AreaMap area(20, 20);
+    area.setCenter(0, 0);
+    fill(area);
+    ChunksLoadQueue queue;
+    queue.update(area, 2);
+    EXPECT_EQ(queue.size(), 0);
+
+    const glm::ivec2 moves[] {{1, 0}, {1, 1}, {-3, 2}, {0, -1}, {7, -4}};
+    glm::ivec2 center {};
+    for (const auto& move : moves) {
+        center += move;
+        area.setCenter(center.x, center.y);
+        EXPECT_TRUE(queue.update(area, 2));
+        EXPECT_EQ(select_all(queue, area), brute_force_missing(area, 2));
+        // Загружается часть очереди, остальное ждёт следующего сдвига
+        std::vector<glm::ivec2> selected;
+        queue.select(area, ChunksLoadFocus {}, 5, selected);
+        for (const auto& pos : selected) {
+            area.set(pos.x, pos.y, std::make_shared<Chunk>(pos.x, pos.y));
+        }
+    }
+}
+
+TEST(ChunksLoadQueue, ExternalRemoval) {
+    AreaMap area(12, 12);
+    area.setCenter(0, 0);
+    fill(area);
+    ChunksLoadQueue queue;
+    queue.update(area, 1);
+    EXPECT_EQ(queue.size(), 0);
+
+    area.remove(0, 0);
+    EXPECT_TRUE(queue.update(area, 1));
+    EXPECT_EQ(select_all(queue, area), brute_force_missing(area, 1));
+    EXPECT_EQ(queue.size(), 1);
+
+    area.remove(1, 1);
+    queue.acceptRemovals(area);
+    EXPECT_FALSE(queue.update(area, 1));
+}
+
+TEST(ChunksLoadQueue, Priority) {
+    AreaMap area(16, 16);
+    area.setCenter(0, 0);
+    ChunksLoadQueue queue;
+    queue.update(area, 1);
+
+    ChunksLoadFocus focus;
+    focus.position = {0.5f, 0.5f};
+    focus.view = {1.0f, 0.0f};
+    // Впереди по взгляду раньше, чем сзади на том же расстоянии
+    EXPECT_LT(focus.priority(4, 0), focus.priority(-4, 0));
+
+    focus.view = {};
+    focus.velocity = {0.0f, -4.0f};
+    EXPECT_LT(focus.priority(0, -4), focus.priority(0, 4));
+    EXPECT_LT(focus.priority(0, -4), focus.priority(4, 0));
+
+    std::vector<glm::ivec2> selected;
+    queue.select(area, focus, 4, selected);
+    ASSERT_EQ(selected.size(), 4);
+    EXPECT_EQ(selected[0], glm::ivec2(0, 0));
+    for (size_t i = 1; i < selected.size(); ++i) {
+        EXPECT_LE(
+            focus.priority(selected[i - 1].x, selected[i - 1].y),
+            focus.priority(selected[i].x, selected[i].y)
+        );
+    }
+}
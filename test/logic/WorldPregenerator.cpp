@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <logic/WorldPregenerator.h>
+
+#include <filesystem>
+
+#include <constants.h>
+#include <io/devices/StdfsDevice.h>
+#include <lighting/Lightmap.h>
+#include <voxels/Chunk.h>
+#include <world/files/WorldRegions.h>
+
+TEST(PregenArea, Rect) {
+    auto area = PregenArea::rect(3, -2, -1, 4);
+    EXPECT_EQ(area.min, glm::ivec2(-1, -2));
+    EXPECT_EQ(area.max, glm::ivec2(3, 4));
+    EXPECT_EQ(area.count(), 5 * 7);
+    EXPECT_TRUE(area.contains(-1, 4));
+    EXPECT_TRUE(area.contains(3, -2));
+    EXPECT_FALSE(area.contains(4, 0));
+    EXPECT_FALSE(area.contains(0, -3));
+}
+
+TEST(PregenArea, Circle) {
+    auto area = PregenArea::circle(10, -10, 2);
+    EXPECT_TRUE(area.contains(10, -10));
+    EXPECT_TRUE(area.contains(12, -10));
+    EXPECT_TRUE(area.contains(11, -9));
+    EXPECT_FALSE(area.contains(12, -8));
+    EXPECT_FALSE(area.contains(13, -10));
+    // 5x5 без четырёх углов и восьми клеток рядом с ними
+    EXPECT_EQ(area.count(), 13);
+
+    EXPECT_EQ(PregenArea::circle(0, 0, 0).count(), 1);
+}
+
+static PregenWork reload(WorldRegions& regions, int x, int z) {
+    // Как GlobalChunks::create при загрузке чанка из регионов
+    Chunk chunk(x, z, std::make_shared<Lightmap>());
+    auto buffer = std::make_unique<ubyte[]>(CHUNK_DATA_LEN);
+    if (regions.getVoxels(x, z, buffer.get())) {
+        EXPECT_TRUE(chunk.decode(buffer.get()));
+        chunk.flags.loaded = true;
+    }
+    uint32_t size;
+    if (regions.getLights(x, z, buffer.get(), size) &&
+        chunk.lightmap->decode(buffer.get(), size)) {
+        chunk.flags.loadedLights = true;
+    }
+    return PregenWork::of(chunk);
+}
+
+static void put_chunk(WorldRegions& regions, int x, int z, bool lighted) {
+    Chunk chunk(x, z, std::make_shared<Lightmap>());
+    chunk.flags.ready = true;
+    chunk.flags.unsaved = true;
+    chunk.flags.lighted = lighted;
+    regions.put(&chunk, {});
+}
+
+static std::filesystem::path make_world_folder() {
+    auto folder = std::filesystem::temp_directory_path() /
+                  "chromaforge_pregen_test";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    io::set_device("test", std::make_shared<io::StdfsDevice>(folder));
+    return folder;
+}
+
+TEST(WorldPregenerator, ResumeSkipsSavedChunks) {
+    make_world_folder();
+    {
+        WorldRegions regions("test:world");
+        put_chunk(regions, 0, 0, true);
+        put_chunk(regions, 1, 0, false);
+        regions.flushRegion(0, 0);
+    }
+    WorldRegions regions("test:world");
+
+    auto saved = reload(regions, 0, 0);
+    EXPECT_TRUE(saved.done());
+
+    auto unlit = reload(regions, 1, 0);
+    EXPECT_FALSE(unlit.generate);
+    EXPECT_TRUE(unlit.light);
+
+    auto missing = reload(regions, 2, 0);
+    EXPECT_TRUE(missing.generate);
+    EXPECT_TRUE(missing.light);
+
+    Chunk lit(3, 0, std::make_shared<Lightmap>());
+    lit.flags.loaded = true;
+    lit.flags.lighted = true;
+    EXPECT_TRUE(PregenWork::of(lit).done());
+}
+
+TEST(WorldPregenerator, FlushRegionUnloads) {
+    make_world_folder();
+    WorldRegions regions("test:world");
+    put_chunk(regions, -1, -1, true);
+    EXPECT_TRUE(regions.isRegionResident(-1, -1));
+
+    regions.flushRegion(-1, -1);
+    EXPECT_FALSE(regions.isRegionResident(-1, -1));
+
+    // Чтение открывает файл региона, сброс закрывает его
+    auto buffer = std::make_unique<ubyte[]>(CHUNK_DATA_LEN);
+    EXPECT_TRUE(regions.getVoxels(-1, -1, buffer.get()));
+    EXPECT_TRUE(regions.isRegionResident(-1, -1));
+    regions.flushRegion(-1, -1);
+    EXPECT_FALSE(regions.isRegionResident(-1, -1));
+}
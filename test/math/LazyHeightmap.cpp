@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <math/LazyHeightmap.h>
+#include <math/Heightmap.h>
+#include <math/FastNoiseLite.h>
+
+using Type = HeightmapOp::Type;
+
+static std::shared_ptr<LazyHeightmap> create_map(uint w, uint h, float base) {
+    auto map = std::make_shared<Heightmap>(w, h);
+    for (uint i = 0; i < w * h; ++i) {
+        map->getValues()[i] = base + (i % 17) * 0.05f;
+    }
+    return std::make_shared<LazyHeightmap>(map);
+}
+
+static HeightmapOp scalar_op(Type type, float value) {
+    HeightmapOp op(type);
+    op.values[0] = value;
+    return op;
+}
+
+static HeightmapOp map_op(Type type, std::shared_ptr<LazyHeightmap> map) {
+    HeightmapOp op(type);
+    op.maps[0] = std::move(map);
+    return op;
+}
+
+TEST(LazyHeightmap, FusedChain) {
+    // больше одного блока и не кратно его размеру
+    uint w = 67, h = 43;
+    auto a = create_map(w, h, 0.1f);
+    auto b = create_map(w, h, 0.7f);
+    std::vector<float> expected(a->getValues(), a->getValues() + w * h);
+    const float* bvalues = b->getValues();
+
+    a->apply(scalar_op(Type::Add, 0.25f));
+    a->apply(map_op(Type::Mul, b));
+    a->apply(HeightmapOp(Type::Abs));
+    a->apply(scalar_op(Type::Pow, 0.5f));
+    a->apply(scalar_op(Type::Max, 0.3f));
+    a->apply(map_op(Type::Min, b));
+    HeightmapOp mix(Type::Mix);
+    mix.values[0] = 2.0f;
+    mix.maps[1] = b;
+    a->apply(mix);
+    EXPECT_EQ(a->getPendingOps(), 7);
+
+    for (uint i = 0; i < w * h; ++i) {
+        float v = expected[i];
+        v = std::abs((v + 0.25f) * bvalues[i]);
+        v = std::max(std::min(std::max(std::pow(v, 0.5f), 0.3f), bvalues[i]), 0.0f);
+        expected[i] = v * (1.0f - bvalues[i]) + 2.0f * bvalues[i];
+    }
+    const float* values = a->getValues();
+    EXPECT_EQ(a->getPendingOps(), 0);
+    for (uint i = 0; i < w * h; ++i) {
+        ASSERT_FLOAT_EQ(values[i], expected[i]) << "at " << i;
+    }
+}
+
+TEST(LazyHeightmap, OperandChangedLater) {
+    uint w = 16, h = 16;
+    auto a = create_map(w, h, 1.0f);
+    auto b = create_map(w, h, 2.0f);
+    std::vector<float> aInitial(a->getValues(), a->getValues() + w * h);
+    std::vector<float> bInitial(b->getValues(), b->getValues() + w * h);
+
+    a->apply(map_op(Type::Add, b));
+    // операция над операндом не должна влиять на уже записанную
+    b->apply(scalar_op(Type::Mul, 10.0f));
+    b->getValues()[0] = -100.0f;
+
+    const float* values = a->getValues();
+    for (uint i = 0; i < w * h; ++i) {
+        EXPECT_FLOAT_EQ(values[i], aInitial[i] + bInitial[i]);
+    }
+    EXPECT_FLOAT_EQ(b->getValues()[1], bInitial[1] * 10.0f);
+}
+
+TEST(LazyHeightmap, SelfOperand) {
+    uint w = 8, h = 8;
+    auto a = create_map(w, h, 1.0f);
+    std::vector<float> initial(a->getValues(), a->getValues() + w * h);
+
+    a->apply(scalar_op(Type::Add, 1.0f));
+    a->apply(map_op(Type::Mul, a));
+    const float* values = a->getValues();
+    for (uint i = 0; i < w * h; ++i) {
+        float v = initial[i] + 1.0f;
+        EXPECT_FLOAT_EQ(values[i], v * v);
+    }
+}
+
+TEST(LazyHeightmap, Noise) {
+    uint w = 40, h = 30;
+    auto a = create_map(w, h, 0.0f);
+    auto shift = create_map(w, h, 3.0f);
+    std::vector<float> expected(a->getValues(), a->getValues() + w * h);
+
+    auto state = fnlCreateState();
+    state.seed = 42;
+    auto noise = std::make_shared<HeightmapNoise>();
+    noise->state = std::make_shared<fnl_state>(state);
+    noise->offset = {10.0f, -5.0f};
+    noise->scale = 0.1f;
+    noise->octaves = 3;
+    noise->multiplier = 0.5f;
+    HeightmapOp op(Type::Noise);
+    op.noise = noise;
+    op.maps[1] = shift;
+    a->apply(op);
+
+    const float* shiftValues = shift->getValues();
+    for (uint y = 0; y < h; ++y) {
+        for (uint x = 0; x < w; ++x) {
+            uint i = y * w + x;
+            for (uint c = 0; c < 3; ++c) {
+                float m = 0.1f * (1 << c);
+                float u = (x + 10.0f) * m;
+                float v = (y - 5.0f) * m + shiftValues[i];
+                expected[i] += fnlGetNoise2D(&state, u, v) /
+                               static_cast<float>(1 << c) * 0.5f;
+            }
+        }
+    }
+    const float* values = a->getValues();
+    for (uint i = 0; i < w * h; ++i) {
+        ASSERT_FLOAT_EQ(values[i], expected[i]) << "at " << i;
+    }
+}
+
+TEST(LazyHeightmap, SmallerOperand) {
+    auto a = create_map(8, 8, 0.0f);
+    auto b = create_map(4, 4, 0.0f);
+    EXPECT_THROW(a->apply(map_op(Type::Add, b)), std::runtime_error);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <math/SkylinePacker.h>
+
+static std::vector<uint32_t> make_sizes(size_t count) {
+    std::vector<uint32_t> sizes;
+    for (size_t i = 0; i < count; ++i) {
+        sizes.push_back(8 + (i * 7) % 41);
+        sizes.push_back(8 + (i * 13) % 29);
+    }
+    return sizes;
+}
+
+TEST(SkylinePacker, NoOverlaps) {
+    const int extension = 2;
+    auto sizes = make_sizes(300);
+    SkylinePacker packer(sizes.data(), sizes.size());
+    ASSERT_TRUE(packer.build(1024, 1024, extension));
+
+    const auto& rects = packer.getResult();
+    ASSERT_EQ(rects.size(), 300);
+    std::vector<bool> seen(rects.size());
+    for (const auto& rect : rects) {
+        EXPECT_FALSE(seen[rect.idx]);
+        seen[rect.idx] = true;
+        EXPECT_EQ(rect.width, sizes[rect.idx * 2]);
+        EXPECT_EQ(rect.height, sizes[rect.idx * 2 + 1]);
+        // Отступ под продление краёв тоже помещается в атлас
+        EXPECT_GE(rect.x, extension);
+        EXPECT_GE(rect.y, extension);
+        EXPECT_LE(rect.x + rect.width + extension, 1024);
+        EXPECT_LE(rect.y + rect.height + extension, 1024);
+    }
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            const auto& a = rects[i];
+            const auto& b = rects[j];
+            bool separate =
+                a.x + a.width + extension <= b.x - extension ||
+                b.x + b.width + extension <= a.x - extension ||
+                a.y + a.height + extension <= b.y - extension ||
+                b.y + b.height + extension <= a.y - extension;
+            EXPECT_TRUE(separate) << a.idx << " and " << b.idx;
+        }
+    }
+}
+
+TEST(SkylinePacker, DoesNotFit) {
+    uint32_t sizes[] {16, 16, 16, 16, 16, 16, 16, 16, 16, 16};
+    SkylinePacker packer(sizes, 10);
+    EXPECT_FALSE(packer.build(32, 32, 0));
+    EXPECT_TRUE(packer.build(64, 32, 0));
+    EXPECT_FALSE(packer.build(64, 32, 1));
+}
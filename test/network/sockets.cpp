@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <network/Network.h>
+
+using namespace std::chrono_literals;
+
+template <typename Predicate>
+static bool wait_for(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+static network::ReadableConnection& get_tcp(
+    network::Network& network, uint64_t id
+) {
+    return dynamic_cast<network::ReadableConnection&>(
+        *network.getConnection(id, true)
+    );
+}
+
+TEST(sockets, TcpLoopback) {
+    network::Network network(nullptr);
+    int port = network.findFreePort();
+    std::atomic<uint64_t> accepted = 0;
+    network.openTcpServer(port, [&](uint64_t, uint64_t id) {
+        accepted = id;
+    });
+    std::atomic<bool> connected = false;
+    uint64_t client = network.connectTcp(
+        "127.0.0.1", port, [&](uint64_t) { connected = true; }, nullptr
+    );
+
+    // Данные, отправленные до подключения, ставятся в очередь
+    std::vector<char> data(1024 * 1024 + 7);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 31);
+    }
+    auto& clientConnection = get_tcp(network, client);
+    EXPECT_EQ(clientConnection.send(data.data(), data.size()), data.size());
+
+    ASSERT_TRUE(wait_for([&]() { return connected && accepted; }));
+    auto& serverConnection = get_tcp(network, accepted);
+
+    std::vector<char> received;
+    std::vector<char> buffer(4096);
+    ASSERT_TRUE(wait_for([&]() {
+        int size = serverConnection.recv(buffer.data(), buffer.size());
+        if (size > 0) {
+            received.insert(received.end(), buffer.data(), buffer.data() + size);
+        }
+        return received.size() >= data.size();
+    }));
+    EXPECT_EQ(received, data);
+
+    serverConnection.send("pong", 4);
+    ASSERT_TRUE(wait_for([&]() { return clientConnection.available() == 4; }));
+    char pong[4];
+    EXPECT_EQ(clientConnection.recv(pong, 4), 4);
+    EXPECT_EQ(std::string(pong, 4), "pong");
+
+    clientConnection.close();
+    EXPECT_EQ(clientConnection.getState(), network::ConnectionState::Closed);
+    EXPECT_TRUE(wait_for([&]() {
+        return serverConnection.getState() == network::ConnectionState::Closed;
+    }));
+    EXPECT_EQ(serverConnection.recv(buffer.data(), buffer.size()), -1);
+}
+
+/// Подключает клиента к новому серверу и ждёт принятия
+static void connect_pair(
+    network::Network& network, uint64_t& client, uint64_t& server
+) {
+    int port = network.findFreePort();
+    std::atomic<uint64_t> accepted = 0;
+    network.openTcpServer(port, [&](uint64_t, uint64_t id) {
+        accepted = id;
+    });
+    std::atomic<bool> connected = false;
+    client = network.connectTcp(
+        "127.0.0.1", port, [&](uint64_t) { connected = true; }, nullptr
+    );
+    ASSERT_TRUE(wait_for([&]() { return connected && accepted; }));
+    server = accepted;
+}
+
+TEST(sockets, TcpCloseDeliversQueue) {
+    network::Network network(nullptr);
+    uint64_t client, server;
+    connect_pair(network, client, server);
+    auto& serverConnection = get_tcp(network, server);
+
+    // Больше буферов ядра: часть данных остаётся в очереди при закрытии
+    std::vector<char> data(8 * 1024 * 1024);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 7);
+    }
+    auto& clientConnection = get_tcp(network, client);
+    ASSERT_EQ(clientConnection.send(data.data(), data.size()), data.size());
+    clientConnection.close();
+    EXPECT_EQ(clientConnection.getState(), network::ConnectionState::Closed);
+    EXPECT_EQ(clientConnection.send("x", 1), 0);
+
+    std::vector<char> received;
+    std::vector<char> buffer(65536);
+    EXPECT_TRUE(wait_for([&]() {
+        int size = serverConnection.recv(buffer.data(), buffer.size());
+        if (size > 0) {
+            received.insert(received.end(), buffer.data(), buffer.data() + size);
+        }
+        return received.size() >= data.size();
+    }));
+    EXPECT_EQ(received, data);
+    EXPECT_TRUE(wait_for([&]() {
+        return serverConnection.getState() == network::ConnectionState::Closed;
+    }));
+}
+
+TEST(sockets, TcpSendBackpressure) {
+    network::Network network(nullptr);
+    uint64_t client, server;
+    connect_pair(network, client, server);
+    auto& clientConnection = get_tcp(network, client);
+
+    // Получатель не читает: очередь заполняется и send принимает не всё
+    std::vector<char> data(1024 * 1024);
+    size_t accepted = 0;
+    int sent = 0;
+    for (int i = 0; i < 256; ++i) {
+        sent = clientConnection.send(data.data(), data.size());
+        accepted += sent;
+        if (sent < static_cast<int>(data.size())) {
+            break;
+        }
+    }
+    EXPECT_LT(sent, static_cast<int>(data.size()));
+    EXPECT_LT(accepted, 128u * 1024 * 1024);
+    EXPECT_EQ(clientConnection.send(data.data(), data.size()), 0);
+    clientConnection.close(true);
+}
+
+TEST(sockets, TcpManyClients) {
+    constexpr int CLIENTS = 64;
+
+    network::Network network(nullptr);
+    int port = network.findFreePort();
+    std::atomic<int> accepted = 0;
+    network.openTcpServer(port, [&](uint64_t, uint64_t) { accepted++; });
+    std::atomic<int> connected = 0;
+    for (int i = 0; i < CLIENTS; ++i) {
+        network.connectTcp(
+            "127.0.0.1", port, [&](uint64_t) { connected++; }, nullptr
+        );
+    }
+    EXPECT_TRUE(wait_for([&]() {
+        return connected == CLIENTS && accepted == CLIENTS;
+    }));
+}
+
+TEST(sockets, UdpLoopback) {
+    network::Network network(nullptr);
+    int port = network.findFreePort();
+    uint64_t serverId = network.openUdpServer(
+        port,
+        [&](uint64_t sid, const std::string& addr, int port, const char* buffer, size_t length) {
+            auto server = dynamic_cast<network::UdpServer*>(
+                network.getServer(sid, true)
+            );
+            server->sendTo(addr, port, buffer, length);
+        }
+    );
+    ASSERT_NE(network.getServer(serverId, true), nullptr);
+
+    std::atomic<size_t> echoed = 0;
+    uint64_t client = network.connectUdp(
+        "127.0.0.1", port, [](uint64_t) {},
+        [&](uint64_t, const char*, size_t length) { echoed += length; }
+    );
+    auto connection = network.getConnection(client, true);
+    EXPECT_EQ(connection->send("hello", 5), 5);
+    EXPECT_TRUE(wait_for([&]() { return echoed == 5; }));
+}
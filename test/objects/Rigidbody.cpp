@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <objects/Rigidbody.h>
+#include <data/dv.h>
+
+static Rigidbody make_body() {
+    Hitbox hitbox(1, BodyType::Dynamic, glm::vec3(0), glm::vec3(0.5f));
+    return Rigidbody {true, std::move(hitbox), {}, 1.0f, 0.0f};
+}
+
+TEST(Rigidbody, Deserialize) {
+    auto root = dv::object();
+    root["vel"] = dv::list({1, 2, 3});
+    root["type"] = "kinematic";
+    root["crouch"] = true;
+    root["damping"] = 2.5;
+    root["mass"] = 3.0;
+    root["elasticity"] = 0.25;
+
+    auto body = make_body();
+    body.deserialize(root);
+    EXPECT_EQ(body.hitbox.velocity, glm::vec3(1, 2, 3));
+    EXPECT_EQ(body.hitbox.type, BodyType::Kinematic);
+    EXPECT_TRUE(body.hitbox.crouching);
+    EXPECT_FLOAT_EQ(body.hitbox.linearDamping, 2.5f);
+    EXPECT_FLOAT_EQ(body.mass, 3.0f);
+    EXPECT_FLOAT_EQ(body.elasticity, 0.25f);
+}
+
+TEST(Rigidbody, DeserializeKeepsMissing) {
+    // Без настроек тела сохраняется только скорость
+    auto root = dv::object();
+    root["vel"] = dv::list({0, -1, 0});
+
+    auto body = make_body();
+    body.hitbox.linearDamping = 0.75f;
+    body.deserialize(root);
+    EXPECT_EQ(body.hitbox.velocity, glm::vec3(0, -1, 0));
+    EXPECT_EQ(body.hitbox.type, BodyType::Dynamic);
+    EXPECT_FALSE(body.hitbox.crouching);
+    EXPECT_FLOAT_EQ(body.hitbox.linearDamping, 0.75f);
+    EXPECT_FLOAT_EQ(body.mass, 1.0f);
+    EXPECT_FLOAT_EQ(body.elasticity, 0.0f);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <objects/rigging.h>
+#include <coders/binary_json.h>
+#include <coders/byte_utils.h>
+#include <data/dv.h>
+
+using namespace rigging;
+
+static dv::value serialize(
+    const Skeleton& skeleton, const SkeletonSaveFlags& flags
+) {
+    ByteBuilder builder;
+    json::BinaryWriter writer(builder);
+    skeleton.serialize(writer, flags);
+    auto bytes = builder.build();
+    return json::from_binary(bytes.data(), bytes.size());
+}
+
+static std::shared_ptr<SkeletonConfig> make_config() {
+    auto root = std::make_unique<Bone>(
+        0, "root", "", std::vector<std::unique_ptr<Bone>> {}, glm::vec3(0)
+    );
+    return std::make_shared<SkeletonConfig>("test", std::move(root), 1);
+}
+
+TEST(Skeleton, SerializeTexturesOnly) {
+    Skeleton skeleton(make_config());
+    skeleton.textures["skin"] = "blocks:stone";
+
+    SkeletonSaveFlags flags {};
+    flags.textures = true;
+    auto root = serialize(skeleton, flags);
+
+    ASSERT_TRUE(root.has("textures"));
+    EXPECT_EQ(root["textures"]["skin"].asString(), "blocks:stone");
+    EXPECT_FALSE(root.has("pose"));
+}
+
+TEST(Skeleton, SerializePoseOnly) {
+    Skeleton skeleton(make_config());
+    skeleton.textures["skin"] = "blocks:stone";
+
+    SkeletonSaveFlags flags {};
+    flags.pose = true;
+    auto root = serialize(skeleton, flags);
+
+    ASSERT_TRUE(root.has("pose"));
+    EXPECT_EQ(root["pose"].size(), 1);
+    EXPECT_FALSE(root.has("textures"));
+}
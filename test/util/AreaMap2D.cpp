@@ -75,3 +75,26 @@ TEST(AreaMap2D, TranslateWithOut) {
     EXPECT_EQ(outside, 15);
     EXPECT_EQ(window.count(), 20);
 }
+
+TEST(AreaMap2D, RemovedCount) {
+    util::AreaMap2D<int> window(4, 4);
+    window.setCenter(0, 0);
+    for (int y = -2; y < 2; y++) {
+        for (int x = -2; x < 2; x++) {
+            window.set(x, y, 1);
+        }
+    }
+    // Сдвиг окна не считается удалением
+    window.setCenter(1, 0);
+    EXPECT_EQ(window.count(), 12);
+    EXPECT_EQ(window.getRemovedCount(), 0);
+
+    window.remove(0, 0);
+    window.remove(0, 0);
+    EXPECT_EQ(window.count(), 11);
+    EXPECT_EQ(window.getRemovedCount(), 1);
+
+    window.clear();
+    EXPECT_EQ(window.count(), 0);
+    EXPECT_EQ(window.getRemovedCount(), 12);
+}
@@ -0,0 +1,52 @@
+#include <util/RingBuffer.h>
+
+#include <gtest/gtest.h>
+
+TEST(RingBuffer, WrapAround) {
+    util::RingBuffer<int> buffer(8);
+    int values[6] {1, 2, 3, 4, 5, 6};
+    buffer.write(values, 6);
+
+    int out[8];
+    EXPECT_EQ(buffer.read(out, 4), 4);
+    EXPECT_EQ(out[3], 4);
+
+    // Запись через край буфера
+    buffer.write(values, 5);
+    EXPECT_EQ(buffer.size(), 7);
+    EXPECT_EQ(buffer.getCapacity(), 8);
+    EXPECT_EQ(buffer.read(out, 8), 7);
+    int expected[7] {5, 6, 1, 2, 3, 4, 5};
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(out[i], expected[i]);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, GrowKeepsOrder) {
+    util::RingBuffer<char> buffer(4);
+    buffer.write("abc", 3);
+    char out[16];
+    buffer.read(out, 2);
+    buffer.write("defghij", 7);
+    EXPECT_GE(buffer.getCapacity(), 8);
+    EXPECT_EQ(buffer.read(out, sizeof(out)), 8);
+    EXPECT_EQ(std::string(out, 8), "cdefghij");
+}
+
+TEST(RingBuffer, WritableSpans) {
+    util::RingBuffer<char> buffer(8);
+    buffer.write("abcdef", 6);
+    char out[8];
+    buffer.read(out, 4);
+
+    auto spans = buffer.writable();
+    EXPECT_EQ(spans[0].size + spans[1].size, 6);
+    EXPECT_EQ(spans[0].size, 2);
+    std::memcpy(spans[0].data, "gh", 2);
+    std::memcpy(spans[1].data, "ij", 2);
+    buffer.commit(4);
+
+    EXPECT_EQ(buffer.read(out, sizeof(out)), 6);
+    EXPECT_EQ(std::string(out, 6), "efghij");
+}
@@ -0,0 +1,55 @@
+#include <util/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace {
+    class SlowSquare : public util::Worker<int, int> {
+    public:
+        int operator()(const int& job) override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            if (job < 0) {
+                throw std::runtime_error("negative job");
+            }
+            return job * job;
+        }
+    };
+}
+
+TEST(ThreadPool, WaitForResults) {
+    int sum = 0;
+    util::ThreadPool<int, int> pool(
+        "test",
+        []() { return std::make_unique<SlowSquare>(); },
+        [&sum](int&& result) { sum += result; },
+        2
+    );
+    for (int i = 1; i <= 10; ++i) {
+        pool.enqueueJob(int(i));
+    }
+    size_t done = 0;
+    while (done < 10) {
+        pool.waitForResults();
+        size_t pulled = pool.pullResults();
+        // Ожидание возвращается только с готовым результатом
+        EXPECT_GT(pulled, 0);
+        done += pulled;
+    }
+    EXPECT_EQ(sum, 385);
+}
+
+TEST(ThreadPool, WaitForResultsFailed) {
+    int sum = 0;
+    util::ThreadPool<int, int> pool(
+        "test",
+        []() { return std::make_unique<SlowSquare>(); },
+        [&sum](int&& result) { sum += result; },
+        2
+    );
+    pool.enqueueJob(-1);
+    // Без результата ожидание прерывается ошибкой задания
+    pool.waitForResults();
+    EXPECT_THROW(pool.pullResults(), std::runtime_error);
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <util/listutil.h>
+
+TEST(listutil, RadixSortKeys) {
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> items;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint64_t key = random() & 0xFFFFFFFF;
+        items.push_back((key << 32) | i);
+    }
+    auto expected = items;
+    std::stable_sort(
+        expected.begin(), expected.end(), [](uint64_t a, uint64_t b) {
+            return (a >> 32) < (b >> 32);
+        }
+    );
+    std::vector<uint64_t> buffer;
+    util::radix_sort_keys(items, buffer);
+    EXPECT_EQ(items, expected);
+}
+
+TEST(listutil, RadixSortKeysStable) {
+    // Равные ключи и одинаковые старшие байты (пропускаемые проходы)
+    std::vector<uint64_t> items;
+    for (uint32_t i = 0; i < 100; ++i) {
+        uint64_t key = 0x12340000 | (i % 3);
+        items.push_back((key << 32) | (99 - i));
+    }
+    std::vector<uint64_t> buffer;
+    util::radix_sort_keys(items, buffer);
+    for (size_t i = 1; i < items.size(); ++i) {
+        uint32_t prevKey = items[i - 1] >> 32;
+        uint32_t key = items[i] >> 32;
+        ASSERT_LE(prevKey, key);
+        if (prevKey == key) {
+            // Порядок построения сохраняется
+            ASSERT_GT(
+                static_cast<uint32_t>(items[i - 1]),
+                static_cast<uint32_t>(items[i])
+            );
+        }
+    }
+}
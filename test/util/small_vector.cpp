@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include <util/small_vector.h>
+
+using namespace util;
+
+TEST(util, small_vector) {
+    small_vector<std::string, 2> vec;
+    vec.push_back("hello");
+    vec.push_back("world");
+    ASSERT_TRUE(vec.is_inline());
+    vec.push_back(vec[0]);
+    ASSERT_FALSE(vec.is_inline());
+    ASSERT_EQ(3, vec.size());
+    ASSERT_EQ("hello", vec.back());
+
+    vec.erase(vec.begin());
+    ASSERT_EQ(2, vec.size());
+    ASSERT_EQ("world", vec[0]);
+    ASSERT_EQ("hello", vec[1]);
+
+    small_vector<std::string, 2> moved(std::move(vec));
+    ASSERT_TRUE(vec.empty());
+    ASSERT_EQ(2, moved.size());
+
+    small_vector<std::string, 2> copy(moved);
+    moved.clear();
+    ASSERT_EQ("world", copy[0]);
+    ASSERT_EQ("hello", copy[1]);
+}
@@ -24,3 +24,27 @@ TEST(Chunk, EncodeDecode) {
         );
     }
 }
+
+TEST(Chunk, DirtySections) {
+    Chunk chunk(0, 0);
+    EXPECT_EQ(chunk.dirtySections, 0);
+
+    chunk.setModified(CHUNK_SECTION_HEIGHT + 5);
+    EXPECT_TRUE(chunk.flags.modified);
+    EXPECT_EQ(chunk.dirtySections, 0b10U);
+
+    chunk.dirtySections = 0;
+    chunk.setModified(CHUNK_SECTION_HEIGHT * 2);
+    EXPECT_EQ(chunk.dirtySections, 0b110U);
+
+    chunk.dirtySections = 0;
+    chunk.setModified(0);
+    EXPECT_EQ(chunk.dirtySections, 0b1U);
+
+    chunk.dirtySections = 0;
+    chunk.setModified(CHUNK_HEIGHT - 1);
+    EXPECT_EQ(chunk.dirtySections, 1U << (CHUNK_SECTIONS - 1));
+
+    chunk.setModified();
+    EXPECT_EQ(chunk.dirtySections, Chunk::ALL_SECTIONS);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <constants.h>
+#include <voxels/voxel_scan.h>
+
+TEST(voxel_scan, FindNonzero) {
+    std::vector<voxel> voxels(CHUNK_WIDTH * 64);
+    EXPECT_EQ(voxel_scan::find_first_nonzero(voxels.data(), voxels.size()), -1);
+    EXPECT_EQ(voxel_scan::find_last_nonzero(voxels.data(), voxels.size()), -1);
+
+    // Состояние блока не делает воксель непустым
+    voxels[5].state.userbits = 0xFF;
+    voxels[700].state.rotation = 3;
+    EXPECT_EQ(voxel_scan::find_first_nonzero(voxels.data(), voxels.size()), -1);
+
+    voxels[37].id = 2;
+    voxels[901].id = 0x8000;
+    voxels[902].id = 1;
+    EXPECT_EQ(voxel_scan::find_first_nonzero(voxels.data(), voxels.size()), 37);
+    EXPECT_EQ(voxel_scan::find_last_nonzero(voxels.data(), voxels.size()), 902);
+}
+
+TEST(voxel_scan, RowMasks) {
+    // Чётные идентификаторы пропускают свет, 0 - воздух
+    std::vector<ubyte> props(64);
+    for (size_t id = 0; id < props.size(); ++id) {
+        props[id] = (id % 2 == 0) ? 1 : 0;
+    }
+    props[6] |= 2;
+
+    std::mt19937 rng(42);
+    voxel row[CHUNK_WIDTH] {};
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        uint32_t zeros = 0;
+        uint32_t passing = 0;
+        uint32_t both = 0;
+        for (int x = 0; x < CHUNK_WIDTH; ++x) {
+            row[x].id = rng() % 4 == 0 ? 0 : rng() % props.size();
+            row[x].state.userbits = rng() % 256;
+            zeros |= (row[x].id == 0) << x;
+            passing |= (props[row[x].id] & 1) << x;
+            both |= ((props[row[x].id] & 3) == 3) << x;
+        }
+        ASSERT_EQ(voxel_scan::zero_mask(row), zeros);
+        ASSERT_EQ(voxel_scan::props_mask(row, props.data(), 1), passing);
+        ASSERT_EQ(voxel_scan::props_mask(row, props.data(), 3), both);
+    }
+}
@@ -30,3 +30,58 @@ TEST(SurroundMap, InitTest) {
     map.completeAt(x - 1, y);
     EXPECT_EQ(affected, maxLevel * 2 - 1);
 }
+
+TEST(SurroundMap, BatchCallback) {
+    int8_t maxLevel = 5;
+
+    SurroundMap map(50, maxLevel);
+    int batches = 0;
+    size_t affected = 0;
+
+    map.setLevelBatchCallback(2, [&](const std::vector<glm::ivec2>& batch) {
+        batches++;
+        affected += batch.size();
+        for (const auto& pos : batch) {
+            EXPECT_EQ(map.at(pos.x, pos.y), 2);
+        }
+    });
+    map.setCenter(0, 0);
+    map.completeAt(0, 0);
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(affected, (maxLevel * 2 - 3) * (maxLevel * 2 - 3));
+
+    affected = 0;
+    map.completeAt(1, 0);
+    EXPECT_EQ(batches, 2);
+    EXPECT_EQ(affected, maxLevel * 2 - 3);
+}
+
+TEST(SurroundMap, CompleteArea) {
+    int8_t maxLevel = 4;
+    int width = 6;
+    int depth = 3;
+
+    SurroundMap map(50, maxLevel);
+    int batches = 0;
+    size_t affected = 0;
+
+    map.setLevelBatchCallback(maxLevel, [&](const std::vector<glm::ivec2>& batch) {
+        batches++;
+        affected += batch.size();
+    });
+    map.setCenter(0, 0);
+    map.completeArea(0, 0, width - 1, depth - 1);
+    EXPECT_EQ(batches, 1);
+    EXPECT_EQ(affected, width * depth);
+
+    for (int y = 0; y < depth; y++) {
+        for (int x = 0; x < width; x++) {
+            EXPECT_EQ(map.at(x, y), maxLevel);
+        }
+    }
+    EXPECT_EQ(map.at(-maxLevel + 1, 0), 1);
+
+    // Позиции внутри уже завершённой области не поднимаются повторно
+    map.completeAt(1, 1);
+    EXPECT_EQ(batches, 1);
+}